@@ -2,6 +2,7 @@
 #include "division_engine_core/types/division_lifecycle.h"
 #include "division_engine_core/font.h"
 #include "division_engine_core/render_pass_instance.h"
+#include <division_engine_core/binding_group.h>
 #include <division_engine_core/io_utility.h>
 #include <division_engine_core/render_pass_descriptor.h>
 #include <division_engine_core/renderer.h>
@@ -9,6 +10,7 @@
 #include <division_engine_core/texture.h>
 #include <division_engine_core/uniform_buffer.h>
 #include <division_engine_core/vertex_buffer.h>
+#include <division_engine_core/vertex_layout.h>
 
 #include <assert.h>
 #include <memory.h>
@@ -30,6 +32,7 @@ typedef struct UserData_
 
     DivisionIdWithBinding uniform_buffer;
     DivisionIdWithBinding texture;
+    uint32_t binding_group_id;
 } UserData_;
 
 static void error_callback(DivisionContext* ctx, int error_code, const char* message);
@@ -63,6 +66,24 @@ typedef struct VertexData
     float uv[2];
 } VertexData;
 
+typedef struct InstanceData
+{
+    float local_to_world[16];
+} InstanceData;
+
+static const DivisionVertexLayoutAttribute VERTEX_ATTRIBUTES[] = {
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(VertexData, position, DIVISION_FVEC3, 0),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(VertexData, color, DIVISION_FVEC4, 1),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(VertexData, uv, DIVISION_FVEC2, 2),
+};
+static const DivisionVertexLayoutAttribute INSTANCE_ATTRIBUTES[] = {
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(InstanceData, local_to_world, DIVISION_FMAT4X4, 3),
+};
+static const DivisionVertexLayout VERTEX_LAYOUT =
+    DIVISION_VERTEX_LAYOUT(VertexData, VERTEX_ATTRIBUTES);
+static const DivisionVertexLayout INSTANCE_LAYOUT =
+    DIVISION_VERTEX_LAYOUT(InstanceData, INSTANCE_ATTRIBUTES);
+
 int main()
 {
     DivisionSettings settings = {
@@ -106,6 +127,16 @@ void init_callback(DivisionContext* ctx)
     example_write_font_character(ctx);
     example_create_textures(ctx, &user_data->texture);
 
+    DivisionBindingGroup binding_group = {
+        .uniform_fragment_buffers = &user_data->uniform_buffer,
+        .uniform_fragment_buffer_count = 1,
+        .fragment_textures = &user_data->texture,
+        .fragment_texture_count = 1,
+    };
+    division_engine_binding_group_alloc(
+        ctx, &binding_group, &user_data->binding_group_id
+    );
+
     DivisionRenderPassDescriptor render_pass_desc = {
         .alpha_blending_options =
             (DivisionAlphaBlendingOptions){
@@ -132,13 +163,11 @@ void draw_callback(DivisionContext* ctx)
         .vertex_count = user_data->vertex_count,
         .instance_count = user_data->instance_count,
         .index_count = user_data->index_count,
-        .uniform_vertex_buffer_count = 0,
-        .uniform_fragment_buffers = &user_data->uniform_buffer,
-        .uniform_fragment_buffer_count = 1,
-        .fragment_textures = &user_data->texture,
-        .fragment_texture_count = 1,
         .render_pass_descriptor_id = user_data->render_pass_desc_id,
-        .capabilities_mask = DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING,
+        .binding_group_id = user_data->binding_group_id,
+        .capabilities_mask =
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING |
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP,
     };
 
     DivisionColor clear_color = {0., 0., 0., 1.};
@@ -225,28 +254,18 @@ void example_create_vertex_buffer(
 
     uint32_t indices[] = {0, 1, 2, 2, 3, 0};
 
-    float local_to_word_mat[] = {
-        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, // 1
-        1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1  // 2
+    InstanceData instances[] = {
+        {.local_to_world = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}},
+        {.local_to_world = {1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1}},
     };
 
     uint32_t vertex_count = sizeof(vd) / sizeof(VertexData);
     uint32_t index_count = sizeof(indices) / sizeof(int32_t);
-    uint32_t instance_count = sizeof(local_to_word_mat) / (sizeof(float) * 16);
+    uint32_t instance_count = sizeof(instances) / sizeof(InstanceData);
 
-    DivisionVertexAttributeSettings vertex_attrs[] = {
-        {.type = DIVISION_FVEC3, .location = 0},
-        {.type = DIVISION_FVEC4, .location = 1},
-        {.type = DIVISION_FVEC2, .location = 2},
-    };
-    DivisionVertexAttributeSettings instance_attrs[] = {
-        {.type = DIVISION_FMAT4X4, .location = 3}};
-
-    DivisionVertexBufferSettings vertex_buffer_settings = {
-        .per_vertex_attributes = vertex_attrs,
-        .per_instance_attributes = instance_attrs,
-        .per_vertex_attribute_count = 3,
-        .per_instance_attribute_count = 1,
+    DivisionVertexBufferLayoutSettings vertex_buffer_settings = {
+        .per_vertex_layout = &VERTEX_LAYOUT,
+        .per_instance_layout = &INSTANCE_LAYOUT,
         .size =
             (DivisionVertexBufferSize){
                 .vertex_count = vertex_count,
@@ -257,13 +276,15 @@ void example_create_vertex_buffer(
     };
 
     uint32_t vertex_buffer;
-    division_engine_vertex_buffer_alloc(ctx, &vertex_buffer_settings, &vertex_buffer);
+    division_engine_vertex_buffer_alloc_with_layout(
+        ctx, &vertex_buffer_settings, &vertex_buffer
+    );
 
     DivisionVertexBufferBorrowedData vb_borrowed;
     division_engine_vertex_buffer_borrow_data(ctx, vertex_buffer, &vb_borrowed);
 
     memcpy(vb_borrowed.vertex_data_ptr, vd, sizeof(vd));
-    memcpy(vb_borrowed.instance_data_ptr, local_to_word_mat, sizeof(local_to_word_mat));
+    memcpy(vb_borrowed.instance_data_ptr, instances, sizeof(instances));
     memcpy(vb_borrowed.index_data_ptr, indices, sizeof(indices));
 
     division_engine_vertex_buffer_return_data(ctx, vertex_buffer, &vb_borrowed);
@@ -280,15 +301,15 @@ void example_create_uniform_buffer(
 {
     float testVec[] = {0.5, 0.5, 0.5, 1};
 
-    DivisionUniformBufferDescriptor buff = {.data_bytes = sizeof(testVec)};
+    DivisionUniformBufferDescriptor buff = {
+        .data_bytes = sizeof(testVec),
+        .capabilities_mask = DIVISION_UNIFORM_BUFFER_CAPABILITY_SHARED_STORAGE,
+    };
 
     uint32_t uniform_buffer;
     division_engine_uniform_buffer_alloc(ctx, buff, &uniform_buffer);
 
-    float* uniform_ptr =
-        (float*)division_engine_uniform_buffer_borrow_data_pointer(ctx, uniform_buffer);
-    memcpy(uniform_ptr, testVec, sizeof(testVec));
-    division_engine_uniform_buffer_return_data_pointer(ctx, uniform_buffer, uniform_ptr);
+    division_engine_uniform_buffer_set_data(ctx, uniform_buffer, testVec);
 
     *out_uniform_buffer = (DivisionIdWithBinding){
         .id = uniform_buffer,
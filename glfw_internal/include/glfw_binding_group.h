@@ -0,0 +1,22 @@
+#pragma once
+
+#include "glad_restrict.h"
+
+/*
+ *  GL names and ranges of the binding group, resolved at the creation. Every array
+ *  covers the binding points from the lowest one to the highest one of the group, the
+ *  gaps are bound to 0. All the arrays share one allocation, which starts at the
+ *  uniform offsets
+ */
+typedef struct DivisionBindingGroupInternalPlatform_
+{
+    GLintptr* gl_uniform_offsets;
+    GLsizeiptr* gl_uniform_sizes;
+    GLuint* gl_uniform_buffers;
+    GLuint first_uniform_binding;
+    GLsizei uniform_binding_count;
+
+    GLuint* gl_textures;
+    GLuint first_texture_unit;
+    GLsizei texture_unit_count;
+} DivisionBindingGroupInternalPlatform_;
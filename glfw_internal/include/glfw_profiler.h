@@ -0,0 +1,10 @@
+#pragma once
+
+#include "glad_restrict.h"
+
+// Timestamp queries of all the frame slots, which are indexed by the core profiler
+typedef struct DivisionProfilerInternalPlatform_
+{
+    GLuint* gl_queries;
+    GLsizei query_count;
+} DivisionProfilerInternalPlatform_;
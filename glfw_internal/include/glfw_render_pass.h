@@ -1,10 +1,111 @@
 #pragma once
 
 #include "glad_restrict.h"
+#include "glfw_state_cache.h"
+
+#include "division_engine_core/types/settings.h"
+
+#include <stdbool.h>
+#include <stdint.h>
 
 typedef struct DivisionRenderPassInternalPlatform_
 {
-    GLenum gl_blend_src;
-    GLenum gl_blend_dst;
-    GLenum gl_blend_equation;
+    // The depth writes without the depth test enable it with GL_ALWAYS
+    DivisionGlPipelineState_ pipeline_state;
 } DivisionRenderPassInternalPlatform_;
+
+// Commands of glMultiDraw*Indirect are written to the buffer every frame
+typedef struct DivisionRenderPassDrawInternalPlatform_
+{
+    GLuint gl_indirect_buffer;
+    size_t indirect_buffer_size;
+
+    void* indirect_commands;
+    size_t indirect_commands_capacity;
+
+    DivisionGlStateCache_ state_cache;
+
+    // Kept contents of the partial redraw, blitted to the window by the end of frame.
+    // Created by the first frame and recreated by the resize
+    GLuint gl_offscreen_framebuffer;
+    GLuint gl_offscreen_color;
+    GLuint gl_offscreen_depth_stencil;
+    int32_t offscreen_width;
+    int32_t offscreen_height;
+} DivisionRenderPassDrawInternalPlatform_;
+
+static inline void division_glfw_offscreen_target_free(
+    DivisionRenderPassDrawInternalPlatform_* draw_impl
+)
+{
+    if (draw_impl->gl_offscreen_framebuffer == 0)
+    {
+        return;
+    }
+
+    glDeleteFramebuffers(1, &draw_impl->gl_offscreen_framebuffer);
+    glDeleteRenderbuffers(1, &draw_impl->gl_offscreen_color);
+    if (draw_impl->gl_offscreen_depth_stencil != 0)
+    {
+        glDeleteRenderbuffers(1, &draw_impl->gl_offscreen_depth_stencil);
+    }
+
+    draw_impl->gl_offscreen_framebuffer = 0;
+    draw_impl->gl_offscreen_color = 0;
+    draw_impl->gl_offscreen_depth_stencil = 0;
+    draw_impl->offscreen_width = 0;
+    draw_impl->offscreen_height = 0;
+}
+
+// Recreates the target if its size differs, the attachments match the window ones
+static inline bool division_glfw_offscreen_target_resize(
+    DivisionRenderPassDrawInternalPlatform_* draw_impl,
+    int32_t width,
+    int32_t height,
+    DivisionDepthStencilFormat depth_format
+)
+{
+    if (draw_impl->gl_offscreen_framebuffer != 0 &&
+        draw_impl->offscreen_width == width && draw_impl->offscreen_height == height)
+    {
+        return true;
+    }
+
+    division_glfw_offscreen_target_free(draw_impl);
+
+    GLuint gl_framebuffer;
+    glCreateFramebuffers(1, &gl_framebuffer);
+    glCreateRenderbuffers(1, &draw_impl->gl_offscreen_color);
+    glNamedRenderbufferStorage(draw_impl->gl_offscreen_color, GL_RGBA8, width, height);
+    glNamedFramebufferRenderbuffer(
+        gl_framebuffer,
+        GL_COLOR_ATTACHMENT0,
+        GL_RENDERBUFFER,
+        draw_impl->gl_offscreen_color
+    );
+
+    if (depth_format != DIVISION_DEPTH_STENCIL_FORMAT_NONE)
+    {
+        bool has_stencil = depth_format == DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8;
+        glCreateRenderbuffers(1, &draw_impl->gl_offscreen_depth_stencil);
+        glNamedRenderbufferStorage(
+            draw_impl->gl_offscreen_depth_stencil,
+            has_stencil ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT32F,
+            width,
+            height
+        );
+        glNamedFramebufferRenderbuffer(
+            gl_framebuffer,
+            has_stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT,
+            GL_RENDERBUFFER,
+            draw_impl->gl_offscreen_depth_stencil
+        );
+    }
+
+    draw_impl->gl_offscreen_framebuffer = gl_framebuffer;
+    draw_impl->offscreen_width = width;
+    draw_impl->offscreen_height = height;
+
+    return glCheckNamedFramebufferStatus(gl_framebuffer, GL_DRAW_FRAMEBUFFER) ==
+           GL_FRAMEBUFFER_COMPLETE;
+}
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "glad_restrict.h"
+
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/utility.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DIVISION_GLFW_STATE_CACHE_BINDING_COUNT 32
+#define DIVISION_GLFW_STATE_UNKNOWN ((GLuint) -1)
+
+/*
+ *  Fixed-function state of a render pass, resolved to the GL values by its allocation.
+ *  The fields are 4 bytes wide without the padding, so the blocks are compared by memcmp.
+ *  The options of the disabled blending and depth test have the GL defaults
+ */
+typedef struct DivisionGlPipelineState_
+{
+    GLuint blend_enabled;
+    GLenum blend_src;
+    GLenum blend_dst;
+    GLenum blend_equation;
+    float blend_color[4];
+    GLuint color_mask;
+    GLuint depth_test_enabled;
+    GLenum depth_func;
+    GLuint depth_write;
+} DivisionGlPipelineState_;
+
+/*
+ *  Shadow copy of the GL state changed by the draw loop. Redundant binds and
+ *  fixed-function changes are skipped and counted in the render pass state stats.
+ *  Other modules change the bindings outside of the cache, so it is invalidated
+ *  at the start of every draw. Bindings above the cached slot count are always issued
+ */
+typedef struct DivisionGlStateCache_
+{
+    GLuint vertex_array;
+    GLuint array_buffer;
+    GLuint element_array_buffer;
+    GLuint draw_indirect_buffer;
+    GLuint program;
+    GLuint uniform_buffers[DIVISION_GLFW_STATE_CACHE_BINDING_COUNT];
+    // Uniform buffers are bound by ranges, pooled buffers share the gl buffers
+    GLintptr uniform_buffer_offsets[DIVISION_GLFW_STATE_CACHE_BINDING_COUNT];
+    GLsizeiptr uniform_buffer_sizes[DIVISION_GLFW_STATE_CACHE_BINDING_COUNT];
+    GLuint textures[DIVISION_GLFW_STATE_CACHE_BINDING_COUNT];
+
+    DivisionGlPipelineState_ pipeline;
+    bool blend_color_known;
+    // Enabled for the strip topologies only, the lists use every index value
+    GLuint primitive_restart;
+
+    DivisionRenderStateStats* stats;
+} DivisionGlStateCache_;
+
+static inline bool division_glfw_state_cache_skip_(
+    DivisionGlStateCache_* cache, bool is_same
+)
+{
+    if (is_same)
+    {
+        cache->stats->skipped_state_changes++;
+    }
+    else
+    {
+        cache->stats->issued_state_changes++;
+    }
+
+    return is_same;
+}
+
+static inline void division_glfw_state_cache_invalidate(DivisionGlStateCache_* cache)
+{
+    DivisionRenderStateStats* stats = cache->stats;
+
+    // All bytes set gives DIVISION_GLFW_STATE_UNKNOWN for every object name
+    memset(cache, 0xFF, sizeof(DivisionGlStateCache_));
+    cache->blend_color_known = false;
+    cache->stats = stats;
+}
+
+static inline void division_glfw_state_cache_bind_vertex_array(
+    DivisionGlStateCache_* cache, GLuint gl_vao
+)
+{
+    if (division_glfw_state_cache_skip_(cache, cache->vertex_array == gl_vao))
+    {
+        return;
+    }
+
+    glBindVertexArray(gl_vao);
+    cache->vertex_array = gl_vao;
+
+    // The index buffer binding is a part of the vertex array state
+    cache->element_array_buffer = DIVISION_GLFW_STATE_UNKNOWN;
+}
+
+static inline void division_glfw_state_cache_bind_buffer(
+    DivisionGlStateCache_* cache, GLenum gl_target, GLuint gl_buffer
+)
+{
+    GLuint* bound;
+    switch (gl_target)
+    {
+    case GL_ARRAY_BUFFER:
+        bound = &cache->array_buffer;
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        bound = &cache->element_array_buffer;
+        break;
+    case GL_DRAW_INDIRECT_BUFFER:
+        bound = &cache->draw_indirect_buffer;
+        break;
+    default:
+        glBindBuffer(gl_target, gl_buffer);
+        cache->stats->issued_state_changes++;
+        return;
+    }
+
+    if (division_glfw_state_cache_skip_(cache, *bound == gl_buffer))
+    {
+        return;
+    }
+
+    glBindBuffer(gl_target, gl_buffer);
+    *bound = gl_buffer;
+}
+
+static inline void division_glfw_state_cache_use_program(
+    DivisionGlStateCache_* cache, GLuint gl_program
+)
+{
+    if (division_glfw_state_cache_skip_(cache, cache->program == gl_program))
+    {
+        return;
+    }
+
+    glUseProgram(gl_program);
+    cache->program = gl_program;
+}
+
+static inline void division_glfw_state_cache_bind_uniform_buffer_range(
+    DivisionGlStateCache_* cache,
+    GLuint binding,
+    GLuint gl_buffer,
+    GLintptr offset,
+    GLsizeiptr size
+)
+{
+    bool is_cached = binding < DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+    if (division_glfw_state_cache_skip_(
+            cache,
+            is_cached && cache->uniform_buffers[binding] == gl_buffer &&
+                cache->uniform_buffer_offsets[binding] == offset &&
+                cache->uniform_buffer_sizes[binding] == size
+        ))
+    {
+        return;
+    }
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, gl_buffer, offset, size);
+    if (is_cached)
+    {
+        cache->uniform_buffers[binding] = gl_buffer;
+        cache->uniform_buffer_offsets[binding] = offset;
+        cache->uniform_buffer_sizes[binding] = size;
+    }
+}
+
+static inline void division_glfw_state_cache_bind_texture_unit(
+    DivisionGlStateCache_* cache, GLuint unit, GLuint gl_texture
+)
+{
+    bool is_cached = unit < DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+    if (division_glfw_state_cache_skip_(
+            cache, is_cached && cache->textures[unit] == gl_texture
+        ))
+    {
+        return;
+    }
+
+    glBindTextureUnit(unit, gl_texture);
+    if (is_cached)
+    {
+        cache->textures[unit] = gl_texture;
+    }
+}
+
+// Multi-bind of consecutive binding points, skipped if all of them are bound already
+static inline void division_glfw_state_cache_bind_uniform_buffers(
+    DivisionGlStateCache_* cache,
+    GLuint first,
+    GLsizei count,
+    const GLuint* gl_buffers,
+    const GLintptr* offsets,
+    const GLsizeiptr* sizes
+)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    bool is_cached = first + count <= DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+    bool is_same =
+        is_cached &&
+        memcmp(&cache->uniform_buffers[first], gl_buffers, sizeof(GLuint[count])) == 0 &&
+        memcmp(&cache->uniform_buffer_offsets[first], offsets, sizeof(GLintptr[count])) ==
+            0 &&
+        memcmp(&cache->uniform_buffer_sizes[first], sizes, sizeof(GLsizeiptr[count])) ==
+            0;
+    if (division_glfw_state_cache_skip_(cache, is_same))
+    {
+        return;
+    }
+
+    glBindBuffersRange(GL_UNIFORM_BUFFER, first, count, gl_buffers, offsets, sizes);
+    for (GLsizei i = 0; i < count && first + i < DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+         i++)
+    {
+        cache->uniform_buffers[first + i] = gl_buffers[i];
+        cache->uniform_buffer_offsets[first + i] = offsets[i];
+        cache->uniform_buffer_sizes[first + i] = sizes[i];
+    }
+}
+
+static inline void division_glfw_state_cache_bind_texture_units(
+    DivisionGlStateCache_* cache, GLuint first, GLsizei count, const GLuint* gl_textures
+)
+{
+    bool is_cached = first + count <= DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+    if (count == 0 ||
+        division_glfw_state_cache_skip_(
+            cache,
+            is_cached &&
+                memcmp(&cache->textures[first], gl_textures, sizeof(GLuint[count])) == 0
+        ))
+    {
+        return;
+    }
+
+    glBindTextures(first, count, gl_textures);
+    for (GLsizei i = 0; i < count && first + i < DIVISION_GLFW_STATE_CACHE_BINDING_COUNT;
+         i++)
+    {
+        cache->textures[first + i] = gl_textures[i];
+    }
+}
+
+static inline void division_glfw_state_cache_set_blend_enabled(
+    DivisionGlStateCache_* cache, bool enabled
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->pipeline.blend_enabled == (GLuint) enabled
+        ))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_BLEND);
+    }
+    else
+    {
+        glDisable(GL_BLEND);
+    }
+    cache->pipeline.blend_enabled = (GLuint) enabled;
+}
+
+static inline void division_glfw_state_cache_set_blend_func(
+    DivisionGlStateCache_* cache, GLenum gl_src, GLenum gl_dst
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache,
+            cache->pipeline.blend_src == gl_src && cache->pipeline.blend_dst == gl_dst
+        ))
+    {
+        return;
+    }
+
+    glBlendFunc(gl_src, gl_dst);
+    cache->pipeline.blend_src = gl_src;
+    cache->pipeline.blend_dst = gl_dst;
+}
+
+static inline void division_glfw_state_cache_set_blend_equation(
+    DivisionGlStateCache_* cache, GLenum gl_equation
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->pipeline.blend_equation == gl_equation
+        ))
+    {
+        return;
+    }
+
+    glBlendEquation(gl_equation);
+    cache->pipeline.blend_equation = gl_equation;
+}
+
+static inline void division_glfw_state_cache_set_blend_color(
+    DivisionGlStateCache_* cache, const float color[4]
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache,
+            cache->blend_color_known &&
+                memcmp(
+                    cache->pipeline.blend_color,
+                    color,
+                    sizeof(cache->pipeline.blend_color)
+                ) == 0
+        ))
+    {
+        return;
+    }
+
+    glBlendColor(color[0], color[1], color[2], color[3]);
+    memcpy(cache->pipeline.blend_color, color, sizeof(cache->pipeline.blend_color));
+    cache->blend_color_known = true;
+}
+
+static inline void division_glfw_state_cache_set_color_mask(
+    DivisionGlStateCache_* cache, DivisionColorMask color_mask
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->pipeline.color_mask == (GLuint) color_mask
+        ))
+    {
+        return;
+    }
+
+    glColorMask(
+        DIVISION_MASK_HAS_FLAG(color_mask, DIVISION_COLOR_MASK_R),
+        DIVISION_MASK_HAS_FLAG(color_mask, DIVISION_COLOR_MASK_G),
+        DIVISION_MASK_HAS_FLAG(color_mask, DIVISION_COLOR_MASK_B),
+        DIVISION_MASK_HAS_FLAG(color_mask, DIVISION_COLOR_MASK_A)
+    );
+    cache->pipeline.color_mask = (GLuint) color_mask;
+}
+
+static inline void division_glfw_state_cache_set_depth_test_enabled(
+    DivisionGlStateCache_* cache, bool enabled
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->pipeline.depth_test_enabled == (GLuint) enabled
+        ))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_DEPTH_TEST);
+    }
+    else
+    {
+        glDisable(GL_DEPTH_TEST);
+    }
+    cache->pipeline.depth_test_enabled = (GLuint) enabled;
+}
+
+static inline void division_glfw_state_cache_set_depth_func(
+    DivisionGlStateCache_* cache, GLenum gl_func
+)
+{
+    if (division_glfw_state_cache_skip_(cache, cache->pipeline.depth_func == gl_func))
+    {
+        return;
+    }
+
+    glDepthFunc(gl_func);
+    cache->pipeline.depth_func = gl_func;
+}
+
+// The depth mask applies to the depth clears too
+static inline void division_glfw_state_cache_set_depth_write(
+    DivisionGlStateCache_* cache, bool enabled
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->pipeline.depth_write == (GLuint) enabled
+        ))
+    {
+        return;
+    }
+
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    cache->pipeline.depth_write = (GLuint) enabled;
+}
+
+static inline void division_glfw_state_cache_set_primitive_restart(
+    DivisionGlStateCache_* cache, bool enabled
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache, cache->primitive_restart == (GLuint) enabled
+        ))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    }
+    else
+    {
+        glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    }
+    cache->primitive_restart = (GLuint) enabled;
+}
+
+// The same state is skipped by one comparison, otherwise only its changed parts are set
+static inline void division_glfw_state_cache_set_pipeline_state(
+    DivisionGlStateCache_* cache, const DivisionGlPipelineState_* state
+)
+{
+    if (division_glfw_state_cache_skip_(
+            cache,
+            cache->blend_color_known &&
+                memcmp(&cache->pipeline, state, sizeof(DivisionGlPipelineState_)) == 0
+        ))
+    {
+        return;
+    }
+
+    division_glfw_state_cache_set_blend_enabled(cache, state->blend_enabled);
+    division_glfw_state_cache_set_blend_func(cache, state->blend_src, state->blend_dst);
+    division_glfw_state_cache_set_blend_equation(cache, state->blend_equation);
+    division_glfw_state_cache_set_blend_color(cache, state->blend_color);
+    division_glfw_state_cache_set_color_mask(
+        cache, (DivisionColorMask) state->color_mask
+    );
+    division_glfw_state_cache_set_depth_test_enabled(cache, state->depth_test_enabled);
+    division_glfw_state_cache_set_depth_func(cache, state->depth_func);
+    division_glfw_state_cache_set_depth_write(cache, state->depth_write);
+}
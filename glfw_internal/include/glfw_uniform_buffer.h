@@ -2,7 +2,43 @@
 
 #include "glad_restrict.h"
 
+#include "division_engine_core/data_structures/free_list_allocator.h"
+#include "division_engine_core/uniform_buffer.h"
+
+#define DIVISION_GLFW_UNIFORM_BUFFER_NO_POOL -1
+
 typedef struct DivisionUniformBufferInternal_
 {
     GLuint gl_buffer;
+
+    // Pooled buffers don't own gl objects, they are the ranges of the pool pages
+    int32_t pool_id;
+    uint32_t pool_slot;
+    GLintptr offset;
+    GLsizeiptr size;
 } DivisionUniformBufferInternal_;
+
+/*
+ *  Shared storage of a size class. The slots of the size class are spread over the
+ *  fixed size pages, which are never reallocated, so the gl names of the pooled
+ *  buffers stay valid, e.g. inside of the binding groups. Borrowing maps the page,
+ *  so one buffer of the page can be borrowed at a time
+ */
+typedef struct DivisionUniformBufferPoolInternalPlatform_
+{
+    GLuint* gl_pages;
+    size_t page_count;
+
+    // Manages the slot indices of all the pages, a slot is a unit of the allocator
+    DivisionFreeListAllocator slot_allocator;
+    size_t slot_size;
+    uint32_t slots_per_page;
+} DivisionUniformBufferPoolInternalPlatform_;
+
+typedef struct DivisionUniformRingInternal_
+{
+    GLuint gl_buffer;
+
+    // Signaled when the GPU has finished the draws of the frame region
+    GLsync frame_fences[DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT];
+} DivisionUniformRingInternal_;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "glad_restrict.h"
+
+#include "division_engine_core/types/upload_queue.h"
+
+typedef struct DivisionGlUploadFence_
+{
+    DivisionUploadFence fence;
+    GLsync gl_sync;
+} DivisionGlUploadFence_;
+
+typedef struct DivisionUploadQueueInternalPlatform_
+{
+    GLuint gl_staging_buffer;
+
+    // Fences of the submitted batches, the oldest first
+    DivisionGlUploadFence_* fences;
+    size_t fences_count;
+    size_t fences_capacity;
+
+    DivisionUploadFence completed_fence;
+} DivisionUploadQueueInternalPlatform_;
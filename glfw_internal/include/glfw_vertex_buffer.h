@@ -2,10 +2,69 @@
 
 #include "glad_restrict.h"
 
+#include "division_engine_core/data_structures/free_list_allocator.h"
+#include "division_engine_core/types/vertex_buffer.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#define DIVISION_GLFW_VERTEX_BUFFER_NO_POOL -1
+
 typedef struct DivisionVertexBufferInternalPlatform_
 {
     GLuint gl_vao;
     GLuint gl_vbo;
     GLuint gl_index_buffer;
     GLenum gl_topology;
+    GLenum gl_index_type;
+
+    // Pooled buffers don't own gl objects, they refer to the pool ones by the offsets
+    int32_t pool_id;
+    uint32_t base_vertex;
+    uint32_t base_instance;
+    uint32_t first_index;
 } DivisionVertexBufferInternalPlatform_;
+
+/*
+ * Shared storage for the buffers with the same attribute layout.
+ * Vertices, instances and indices live in separate gl buffers, which are attached to
+ * the single vao by binding points, so the pool can grow without touching the
+ * attribute formats
+ */
+typedef struct DivisionVertexBufferPoolInternalPlatform_
+{
+    GLuint gl_vao;
+    GLuint gl_vbo;
+    GLuint gl_instance_vbo;
+    GLuint gl_index_buffer;
+
+    DivisionFreeListAllocator vertex_allocator;
+    DivisionFreeListAllocator instance_allocator;
+    DivisionFreeListAllocator index_allocator;
+
+    DivisionVertexAttributeSettings* per_vertex_attributes;
+    DivisionVertexAttributeSettings* per_instance_attributes;
+    // Offsets differ for the same attributes when the layout is pre-baked
+    DivisionVertexAttribute* per_vertex_attribute_offsets;
+    DivisionVertexAttribute* per_instance_attribute_offsets;
+    int32_t per_vertex_attribute_count;
+    int32_t per_instance_attribute_count;
+    size_t per_vertex_data_size;
+    size_t per_instance_data_size;
+    size_t index_size;
+} DivisionVertexBufferPoolInternalPlatform_;
+
+typedef struct DivisionGlBufferRange_
+{
+    GLuint gl_buffer;
+    size_t offset;
+} DivisionGlBufferRange_;
+
+// Location of the buffer data, pooled buffers store it inside of the pool gl buffers
+DivisionGlBufferRange_ division_glfw_vertex_buffer_vertices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
+DivisionGlBufferRange_ division_glfw_vertex_buffer_instances_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
+DivisionGlBufferRange_ division_glfw_vertex_buffer_indices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
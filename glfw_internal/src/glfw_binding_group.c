@@ -0,0 +1,199 @@
+#include "division_engine_core/platform_internal/platform_binding_group.h"
+
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/utility.h"
+
+#include "glfw_binding_group.h"
+#include "glfw_texture.h"
+#include "glfw_uniform_buffer.h"
+
+#include <stdlib.h>
+
+static inline void get_binding_range_(
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count,
+    GLuint* first_binding,
+    GLuint* last_binding
+);
+static inline void set_uniform_bindings_(
+    const DivisionUniformBufferSystemContext* uniform_buff_ctx,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count,
+    GLuint first_uniform,
+    DivisionBindingGroupInternalPlatform_* group_impl
+);
+
+bool division_engine_internal_platform_binding_group_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->binding_group_context->binding_groups_impl = NULL;
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_context_free(DivisionContext* ctx)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+
+    for (size_t i = 0; i < binding_group_ctx->binding_group_count; i++)
+    {
+        free(binding_group_ctx->binding_groups_impl[i].gl_uniform_offsets);
+    }
+    free(binding_group_ctx->binding_groups_impl);
+}
+
+bool division_engine_internal_platform_binding_group_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionBindingGroupInternalPlatform_* binding_groups_impl = realloc(
+        binding_group_ctx->binding_groups_impl,
+        sizeof(DivisionBindingGroupInternalPlatform_[new_size])
+    );
+    if (binding_groups_impl == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = binding_group_ctx->binding_group_count; i < new_size; i++)
+    {
+        binding_groups_impl[i] = (DivisionBindingGroupInternalPlatform_){0};
+    }
+    binding_group_ctx->binding_groups_impl = binding_groups_impl;
+
+    return true;
+}
+
+bool division_engine_internal_platform_binding_group_impl_init_element(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionUniformBufferSystemContext* uniform_buff_ctx = ctx->uniform_buffer_context;
+    DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    const DivisionBindingGroup* group =
+        &binding_group_ctx->binding_groups[binding_group_id];
+
+    // Vertex and fragment uniform buffers share the binding points in GL
+    GLuint first_uniform = UINT32_MAX, last_uniform = 0;
+    get_binding_range_(
+        group->uniform_vertex_buffers,
+        group->uniform_vertex_buffer_count,
+        &first_uniform,
+        &last_uniform
+    );
+    get_binding_range_(
+        group->uniform_fragment_buffers,
+        group->uniform_fragment_buffer_count,
+        &first_uniform,
+        &last_uniform
+    );
+
+    GLuint first_texture = UINT32_MAX, last_texture = 0;
+    get_binding_range_(
+        group->fragment_textures,
+        group->fragment_texture_count,
+        &first_texture,
+        &last_texture
+    );
+
+    GLsizei uniform_count =
+        first_uniform <= last_uniform ? (GLsizei) (last_uniform - first_uniform + 1) : 0;
+    GLsizei texture_count =
+        first_texture <= last_texture ? (GLsizei) (last_texture - first_texture + 1) : 0;
+
+    size_t ranges_size = (sizeof(GLintptr) + sizeof(GLsizeiptr)) * uniform_count;
+    size_t names_size = sizeof(GLuint[uniform_count + texture_count]);
+    uint8_t* gl_data = calloc(DIVISION_MAX(ranges_size + names_size, 1), 1);
+    if (gl_data == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the binding group names");
+        return false;
+    }
+
+    GLuint* gl_names = (GLuint*) (gl_data + ranges_size);
+    DivisionBindingGroupInternalPlatform_ group_impl = {
+        .gl_uniform_offsets = (GLintptr*) gl_data,
+        .gl_uniform_sizes = (GLsizeiptr*) (gl_data + sizeof(GLintptr[uniform_count])),
+        .gl_uniform_buffers = gl_names,
+        .first_uniform_binding = uniform_count > 0 ? first_uniform : 0,
+        .uniform_binding_count = uniform_count,
+        .gl_textures = gl_names + uniform_count,
+        .first_texture_unit = texture_count > 0 ? first_texture : 0,
+        .texture_unit_count = texture_count,
+    };
+
+    set_uniform_bindings_(
+        uniform_buff_ctx,
+        group->uniform_vertex_buffers,
+        group->uniform_vertex_buffer_count,
+        first_uniform,
+        &group_impl
+    );
+    set_uniform_bindings_(
+        uniform_buff_ctx,
+        group->uniform_fragment_buffers,
+        group->uniform_fragment_buffer_count,
+        first_uniform,
+        &group_impl
+    );
+
+    for (int32_t i = 0; i < group->fragment_texture_count; i++)
+    {
+        const DivisionIdWithBinding* binding = &group->fragment_textures[i];
+        group_impl.gl_textures[binding->shader_location - first_texture] =
+            tex_ctx->textures_impl[binding->id].gl_texture;
+    }
+
+    binding_group_ctx->binding_groups_impl[binding_group_id] = group_impl;
+
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_free(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+    DivisionBindingGroupInternalPlatform_* group_impl =
+        &ctx->binding_group_context->binding_groups_impl[binding_group_id];
+
+    free(group_impl->gl_uniform_offsets);
+    *group_impl = (DivisionBindingGroupInternalPlatform_){0};
+}
+
+void get_binding_range_(
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count,
+    GLuint* first_binding,
+    GLuint* last_binding
+)
+{
+    for (int32_t i = 0; i < binding_count; i++)
+    {
+        *first_binding = DIVISION_MIN(*first_binding, bindings[i].shader_location);
+        *last_binding = DIVISION_MAX(*last_binding, bindings[i].shader_location);
+    }
+}
+
+// Pooled buffers are the ranges of the shared gl buffers, so every binding is a range
+void set_uniform_bindings_(
+    const DivisionUniformBufferSystemContext* uniform_buff_ctx,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count,
+    GLuint first_uniform,
+    DivisionBindingGroupInternalPlatform_* group_impl
+)
+{
+    for (int32_t i = 0; i < binding_count; i++)
+    {
+        const DivisionUniformBufferInternal_* buffer_impl =
+            &uniform_buff_ctx->uniform_buffers_impl[bindings[i].id];
+        GLuint binding = bindings[i].shader_location - first_uniform;
+
+        group_impl->gl_uniform_buffers[binding] = buffer_impl->gl_buffer;
+        group_impl->gl_uniform_offsets[binding] = buffer_impl->offset;
+        group_impl->gl_uniform_sizes[binding] = buffer_impl->size;
+    }
+}
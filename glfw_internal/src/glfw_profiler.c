@@ -0,0 +1,85 @@
+#include "division_engine_core/platform_internal/platform_profiler.h"
+
+#include "glfw_profiler.h"
+
+#include <stdlib.h>
+
+bool division_engine_internal_platform_profiler_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    GLsizei query_count =
+        DIVISION_PROFILER_QUERY_FRAMES * DIVISION_PROFILER_MAX_SCOPES * 2;
+
+    DivisionProfilerInternalPlatform_* profiler_impl =
+        malloc(sizeof(DivisionProfilerInternalPlatform_));
+    GLuint* gl_queries = malloc(sizeof(GLuint[query_count]));
+    if (profiler_impl == NULL || gl_queries == NULL)
+    {
+        free(profiler_impl);
+        free(gl_queries);
+        return false;
+    }
+
+    // Timestamps are used instead of elapsed time queries, because they can be nested
+    glGenQueries(query_count, gl_queries);
+    profiler_impl->gl_queries = gl_queries;
+    profiler_impl->query_count = query_count;
+
+    profiler_ctx->profiler_impl = profiler_impl;
+    profiler_ctx->has_gpu_timers = true;
+
+    return true;
+}
+
+void division_engine_internal_platform_profiler_context_free(DivisionContext* ctx)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    DivisionProfilerInternalPlatform_* profiler_impl = profiler_ctx->profiler_impl;
+
+    glDeleteQueries(profiler_impl->query_count, profiler_impl->gl_queries);
+    free(profiler_impl->gl_queries);
+    free(profiler_impl);
+}
+
+void division_engine_internal_platform_profiler_timestamp(
+    DivisionContext* ctx, uint32_t query_index
+)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    DivisionProfilerInternalPlatform_* profiler_impl = profiler_ctx->profiler_impl;
+    glQueryCounter(profiler_impl->gl_queries[query_index], GL_TIMESTAMP);
+}
+
+bool division_engine_internal_platform_profiler_read_timestamps(
+    DivisionContext* ctx,
+    uint32_t first_query,
+    uint32_t query_count,
+    bool wait,
+    uint64_t* out_timestamps
+)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    DivisionProfilerInternalPlatform_* profiler_impl = profiler_ctx->profiler_impl;
+    const GLuint* gl_queries = &profiler_impl->gl_queries[first_query];
+
+    // Nested scopes issue their end timestamps in the other order than their indices,
+    // so every query is checked before any result is read
+    for (uint32_t i = 0; !wait && i < query_count; i++)
+    {
+        GLuint is_available = GL_FALSE;
+        glGetQueryObjectuiv(gl_queries[i], GL_QUERY_RESULT_AVAILABLE, &is_available);
+        if (!is_available)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < query_count; i++)
+    {
+        glGetQueryObjectui64v(gl_queries[i], GL_QUERY_RESULT, &out_timestamps[i]);
+    }
+
+    return true;
+}
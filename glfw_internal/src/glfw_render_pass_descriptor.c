@@ -6,6 +6,7 @@
 #include "glfw_render_pass.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 static inline bool try_get_gl_blend_arg(
     DivisionContext* ctx, DivisionAlphaBlend blend_arg, GLenum* out_gl_blend_arg
@@ -13,12 +14,36 @@ static inline bool try_get_gl_blend_arg(
 static inline bool try_get_gl_blend_eq(
     DivisionContext* ctx, DivisionAlphaBlendOperation blend_op, GLenum* out_gl_eq
 );
+static inline bool try_get_gl_compare_func(
+    DivisionContext* ctx, DivisionCompareFunction compare, GLenum* out_gl_func
+);
 
 bool division_engine_internal_platform_render_pass_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
 {
-    ctx->render_pass_context->render_passes_descriptors_impl = NULL;
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    pass_ctx->render_passes_descriptors_impl = NULL;
+    pass_ctx->draw_impl = malloc(sizeof(DivisionRenderPassDrawInternalPlatform_));
+    if (pass_ctx->draw_impl == NULL)
+    {
+        return false;
+    }
+
+    // The indirect buffer is created on the first batched draw
+    *pass_ctx->draw_impl = (DivisionRenderPassDrawInternalPlatform_){
+        .gl_indirect_buffer = 0,
+        .indirect_buffer_size = 0,
+        .indirect_commands = NULL,
+        .indirect_commands_capacity = 0,
+        .state_cache = {.stats = &pass_ctx->state_stats},
+        .gl_offscreen_framebuffer = 0,
+        .gl_offscreen_color = 0,
+        .gl_offscreen_depth_stencil = 0,
+        .offscreen_width = 0,
+        .offscreen_height = 0,
+    };
+    division_glfw_state_cache_invalidate(&pass_ctx->draw_impl->state_cache);
 
     return true;
 }
@@ -31,6 +56,15 @@ void division_engine_internal_platform_render_pass_context_free(DivisionContext*
         division_engine_internal_platform_render_pass_free(ctx, i);
     }
     free(pass_ctx->render_passes_descriptors_impl);
+
+    DivisionRenderPassDrawInternalPlatform_* draw_impl = pass_ctx->draw_impl;
+    if (draw_impl->gl_indirect_buffer != 0)
+    {
+        glDeleteBuffers(1, &draw_impl->gl_indirect_buffer);
+    }
+    free(draw_impl->indirect_commands);
+    division_glfw_offscreen_target_free(draw_impl);
+    free(draw_impl);
 }
 
 bool division_engine_internal_platform_render_pass_realloc(
@@ -58,29 +92,64 @@ bool division_engine_internal_platform_render_pass_impl_init_element(
     DivisionRenderPassInternalPlatform_* pass_impl =
         &pass_ctx->render_passes_descriptors_impl[render_pass_id];
 
-    if (DIVISION_MASK_HAS_FLAG(
-            pass_desc->capabilities_mask, 
+    DivisionGlPipelineState_ state = {
+        .blend_enabled = DIVISION_MASK_HAS_FLAG(
+            pass_desc->capabilities_mask,
             DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND
-        ))
+        ),
+        .blend_src = GL_ONE,
+        .blend_dst = GL_ZERO,
+        .blend_equation = GL_FUNC_ADD,
+        .blend_color = {0, 0, 0, 0},
+        .color_mask = (GLuint) pass_desc->color_mask,
+        .depth_test_enabled = DIVISION_MASK_HAS_FLAG(
+            pass_desc->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST
+        ),
+        .depth_func = GL_LESS,
+        .depth_write = DIVISION_MASK_HAS_FLAG(
+            pass_desc->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_WRITE
+        ),
+    };
+
+    if (state.blend_enabled)
     {
         const DivisionAlphaBlendingOptions* blend_options = &pass_desc->alpha_blending_options;
 
-        if (!try_get_gl_blend_arg(ctx, blend_options->src, &pass_impl->gl_blend_src) ||
-            !try_get_gl_blend_arg(ctx, blend_options->dst, &pass_impl->gl_blend_dst) ||
-            !try_get_gl_blend_eq(
-                ctx, blend_options->operation, &pass_impl->gl_blend_equation
-            ))
+        if (!try_get_gl_blend_arg(ctx, blend_options->src, &state.blend_src) ||
+            !try_get_gl_blend_arg(ctx, blend_options->dst, &state.blend_dst) ||
+            !try_get_gl_blend_eq(ctx, blend_options->operation, &state.blend_equation))
         {
             return false;
         }
+        memcpy(
+            state.blend_color,
+            blend_options->constant_blend_color,
+            sizeof(state.blend_color)
+        );
+    }
+
+    // GL writes the depth only with the depth test enabled
+    if (state.depth_test_enabled)
+    {
+        if (!try_get_gl_compare_func(ctx, pass_desc->depth_compare, &state.depth_func))
+        {
+            return false;
+        }
+    }
+    else if (state.depth_write)
+    {
+        state.depth_test_enabled = true;
+        state.depth_func = GL_ALWAYS;
     }
     else
     {
-        pass_impl->gl_blend_src = 0;
-        pass_impl->gl_blend_dst = 0;
-        pass_impl->gl_blend_equation = 0;
+        state.depth_write = true;
     }
 
+    pass_impl->pipeline_state = state;
+
     return true;
 }
 
@@ -172,3 +241,39 @@ bool try_get_gl_blend_eq(
         return false;
     }
 }
+
+bool try_get_gl_compare_func(
+    DivisionContext* ctx, DivisionCompareFunction compare, GLenum* out_gl_func
+)
+{
+    switch (compare)
+    {
+    case DIVISION_COMPARE_LESS:
+        *out_gl_func = GL_LESS;
+        return true;
+    case DIVISION_COMPARE_LESS_EQUAL:
+        *out_gl_func = GL_LEQUAL;
+        return true;
+    case DIVISION_COMPARE_EQUAL:
+        *out_gl_func = GL_EQUAL;
+        return true;
+    case DIVISION_COMPARE_GREATER:
+        *out_gl_func = GL_GREATER;
+        return true;
+    case DIVISION_COMPARE_GREATER_EQUAL:
+        *out_gl_func = GL_GEQUAL;
+        return true;
+    case DIVISION_COMPARE_NOT_EQUAL:
+        *out_gl_func = GL_NOTEQUAL;
+        return true;
+    case DIVISION_COMPARE_ALWAYS:
+        *out_gl_func = GL_ALWAYS;
+        return true;
+    case DIVISION_COMPARE_NEVER:
+        *out_gl_func = GL_NEVER;
+        return true;
+    default:
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown CompareFunction to GL mapping");
+        return false;
+    }
+}
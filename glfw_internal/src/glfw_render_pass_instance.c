@@ -1,7 +1,9 @@
 #include "division_engine_core/platform_internal/platform_render_pass_descriptor.h"
 #include "division_engine_core/platform_internal/platform_render_pass_instance.h"
 
+#include "division_engine_core/binding_group.h"
 #include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/render_pass_instance.h"
 #include "division_engine_core/shader.h"
 #include "division_engine_core/texture.h"
 #include "division_engine_core/utility.h"
@@ -9,20 +11,172 @@
 #include "division_engine_core/uniform_buffer.h"
 #include "division_engine_core/renderer.h"
 
+#include "glfw_binding_group.h"
 #include "glfw_render_pass.h"
 #include "glfw_shader.h"
+#include "glfw_state_cache.h"
 #include "glfw_texture.h"
 #include "glfw_uniform_buffer.h"
 #include "glfw_vertex_buffer.h"
 #include <stdint.h>
+#include <stdlib.h>
+
+// Layouts of the commands read by glMultiDrawElementsIndirect / glMultiDrawArraysIndirect
+typedef struct GlDrawElementsIndirectCommand_
+{
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+} GlDrawElementsIndirectCommand_;
+
+typedef struct GlDrawArraysIndirectCommand_
+{
+    GLuint count;
+    GLuint instance_count;
+    GLuint first;
+    GLuint base_instance;
+} GlDrawArraysIndirectCommand_;
 
 static inline void bind_uniform_buffer(
-    DivisionUniformBufferSystemContext* ctx, const DivisionIdWithBinding* buffer_binding
+    DivisionGlStateCache_* state_cache,
+    DivisionUniformBufferSystemContext* ctx,
+    const DivisionIdWithBinding* buffer_binding
+);
+static inline void bind_instance_bindings(
+    DivisionGlStateCache_* state_cache,
+    DivisionUniformBufferSystemContext* uniform_buff_ctx,
+    DivisionTextureSystemContext* tex_ctx,
+    const DivisionRenderPassInstance* pass_instance
+);
+static inline void bind_binding_group(
+    DivisionGlStateCache_* state_cache,
+    const DivisionBindingGroupInternalPlatform_* group_impl
+);
+static inline void bind_uniform_ring_ranges(
+    DivisionGlStateCache_* state_cache,
+    const DivisionUniformRingInternal_* ring_impl,
+    const DivisionRenderPassInstance* pass_instance
+);
+static inline void draw_arrays(
+    const DivisionVertexBufferInternalPlatform_* vb_internal,
+    const DivisionRenderPassInstance* pass_instance,
+    GLint first_vertex,
+    bool instanced
+);
+static inline void multi_draw_indirect(
+    DivisionContext* ctx,
+    const DivisionVertexBufferInternalPlatform_* vb_internal,
+    const DivisionRenderPassInstance* pass_instances,
+    uint32_t draw_count,
+    bool indexed
+);
+static inline bool upload_indirect_commands(
+    DivisionRenderPassDrawInternalPlatform_* draw_impl, size_t commands_size
+);
+static inline void clear_depth_stencil(
+    DivisionGlStateCache_* state_cache, DivisionDepthStencilFormat format, float depth
+);
+static inline void invalidate_default_color(void);
+static inline void invalidate_default_depth_stencil(DivisionDepthStencilFormat format);
+static inline bool begin_partial_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
 );
+static inline void end_partial_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+);
+
+void division_engine_internal_platform_render_pass_instance_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+    DivisionGlStateCache_* state_cache =
+        &ctx->render_pass_context->draw_impl->state_cache;
+    DivisionDepthStencilFormat depth_format = ctx->renderer_context->depth_stencil_format;
+
+    if (ctx->render_pass_context->partial_redraw && begin_partial_frame(ctx, frame))
+    {
+        return;
+    }
+
+    // Clears are masked like the draws, so the cleared attachments are unmasked first
+    division_glfw_state_cache_invalidate(state_cache);
+
+    switch (frame->color_load_action)
+    {
+    case DIVISION_LOAD_ACTION_CLEAR:
+        division_glfw_state_cache_set_color_mask(state_cache, DIVISION_COLOR_MASK_RGBA);
+        glClearBufferfv(GL_COLOR, 0, (const GLfloat*) &frame->clear_color);
+        break;
+    case DIVISION_LOAD_ACTION_DONT_CARE:
+        invalidate_default_color();
+        break;
+    case DIVISION_LOAD_ACTION_LOAD:
+    default:
+        break;
+    }
+
+    if (depth_format == DIVISION_DEPTH_STENCIL_FORMAT_NONE)
+    {
+        return;
+    }
+
+    switch (frame->depth_load_action)
+    {
+    case DIVISION_LOAD_ACTION_CLEAR:
+        clear_depth_stencil(state_cache, depth_format, frame->clear_depth);
+        break;
+    case DIVISION_LOAD_ACTION_DONT_CARE:
+        invalidate_default_depth_stencil(depth_format);
+        break;
+    case DIVISION_LOAD_ACTION_LOAD:
+    default:
+        break;
+    }
+}
+
+void division_engine_internal_platform_render_pass_instance_end_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+    DivisionDepthStencilFormat depth_format = ctx->renderer_context->depth_stencil_format;
+
+    if (ctx->render_pass_context->partial_redraw)
+    {
+        if (ctx->render_pass_context->draw_impl->gl_offscreen_framebuffer != 0)
+        {
+            end_partial_frame(ctx, frame);
+            return;
+        }
+
+        // The frame was drawn to the window, see begin_partial_frame
+        division_engine_internal_platform_render_pass_instance_set_scissor(ctx, NULL);
+    }
+
+    if (depth_format != DIVISION_DEPTH_STENCIL_FORMAT_NONE &&
+        frame->depth_store_action == DIVISION_STORE_ACTION_DONT_CARE)
+    {
+        invalidate_default_depth_stencil(depth_format);
+    }
+}
+
+void division_engine_internal_platform_render_pass_instance_set_scissor(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+)
+{
+    if (rect == NULL)
+    {
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(rect->x, rect->y, rect->width, rect->height);
+}
 
 void division_engine_internal_platform_render_pass_instance_draw(
     DivisionContext* ctx,
-    const DivisionColor* clear_color,
     const DivisionRenderPassInstance* render_pass_instances,
     uint32_t render_pass_instance_count
 )
@@ -32,98 +186,117 @@ void division_engine_internal_platform_render_pass_instance_draw(
     DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
     DivisionShaderSystemContext* shader_ctx = ctx->shader_context;
     DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionGlStateCache_* state_cache = &render_pass_ctx->draw_impl->state_cache;
 
-    glClearBufferfv(GL_COLOR, 0, (const GLfloat*)clear_color);
+    division_glfw_state_cache_invalidate(state_cache);
 
-    for (int32_t i = 0; i < render_pass_instance_count; i++)
+    uint32_t batch_count;
+    for (uint32_t i = 0; i < render_pass_instance_count; i += batch_count)
     {
         const DivisionRenderPassInstance* pass_instance = &render_pass_instances[i];
+
+        // Compatible neighbours share the state setup below and a single draw call
+        batch_count = 1;
+        while (i + batch_count < render_pass_instance_count &&
+               division_engine_render_pass_instance_can_batch(
+                   pass_instance, &render_pass_instances[i + batch_count]
+               ))
+        {
+            batch_count++;
+        }
+
         uint32_t pass_desc_id = pass_instance->render_pass_descriptor_id;
         const DivisionRenderPassDescriptor* pass_desc =
             &render_pass_ctx->render_pass_descriptors[pass_desc_id];
         DivisionRenderPassInternalPlatform_* pass_desc_impl =
             &render_pass_ctx->render_passes_descriptors_impl[pass_desc_id];
+        const DivisionVertexBuffer* vertex_buffer =
+            &vert_buff_ctx->buffers[pass_desc->vertex_buffer_id];
         DivisionVertexBufferInternalPlatform_ vb_internal =
             vert_buff_ctx->buffers_impl[pass_desc->vertex_buffer_id];
         DivisionShaderInternal_ shader_internal =
             shader_ctx->shaders_impl[pass_desc->shader_program];
-        const float* const_blend_color =
-            pass_desc->alpha_blending_options.constant_blend_color;
-
-        glBindVertexArray(vb_internal.gl_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vb_internal.gl_vbo);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vb_internal.gl_index_buffer);
-        glUseProgram(shader_internal.gl_shader_program);
 
-        for (int uniform_idx = 0;
-             uniform_idx < pass_instance->uniform_vertex_buffer_count;
-             uniform_idx++)
+        division_glfw_state_cache_bind_vertex_array(state_cache, vb_internal.gl_vao);
+        if (vb_internal.pool_id == DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
         {
-            bind_uniform_buffer(
-                uniform_buff_ctx, &pass_instance->uniform_vertex_buffers[uniform_idx]
+            division_glfw_state_cache_bind_buffer(
+                state_cache, GL_ARRAY_BUFFER, vb_internal.gl_vbo
             );
-        }
-
-        for (int uniform_idx = 0;
-             uniform_idx < pass_instance->uniform_fragment_buffer_count;
-             uniform_idx++)
-        {
-            bind_uniform_buffer(
-                uniform_buff_ctx, &pass_instance->uniform_fragment_buffers[uniform_idx]
+            division_glfw_state_cache_bind_buffer(
+                state_cache, GL_ELEMENT_ARRAY_BUFFER, vb_internal.gl_index_buffer
             );
         }
 
-        for (int frag_tex_idx = 0; frag_tex_idx < pass_instance->fragment_texture_count;
-             frag_tex_idx++)
-        {
-            DivisionIdWithBinding tex_bind =
-                pass_instance->fragment_textures[frag_tex_idx];
-            DivisionTextureImpl_* tex_impl = &tex_ctx->textures_impl[tex_bind.id];
+        size_t index_size =
+            vb_internal.gl_index_type == GL_UNSIGNED_SHORT ? sizeof(uint16_t)
+                                                           : sizeof(uint32_t);
+        const void* first_index_ptr =
+            (const void*) (vb_internal.first_index * index_size);
+        GLint base_vertex =
+            (GLint) (pass_instance->first_vertex + vb_internal.base_vertex);
 
-            glBindTextureUnit(tex_bind.shader_location, tex_impl->gl_texture);
-        }
+        division_glfw_state_cache_use_program(
+            state_cache, shader_internal.gl_shader_program
+        );
 
         if (DIVISION_MASK_HAS_FLAG(
-                pass_desc->capabilities_mask,
-                DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND
+                pass_instance->capabilities_mask,
+                DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
             ))
         {
-            glEnable(GL_BLEND);
-
-            glBlendFunc(pass_desc_impl->gl_blend_src, pass_desc_impl->gl_blend_dst);
-            glBlendEquation(pass_desc_impl->gl_blend_equation);
-            glBlendColor(
-                const_blend_color[0],
-                const_blend_color[1],
-                const_blend_color[2],
-                const_blend_color[3]
+            bind_binding_group(
+                state_cache,
+                &binding_group_ctx->binding_groups_impl[pass_instance->binding_group_id]
             );
         }
         else
         {
-            glDisable(GL_BLEND);
+            bind_instance_bindings(state_cache, uniform_buff_ctx, tex_ctx, pass_instance);
         }
+        bind_uniform_ring_ranges(state_cache, uniform_buff_ctx->ring_impl, pass_instance);
 
-        glColorMask(
-            DIVISION_MASK_HAS_FLAG(pass_desc->color_mask, DIVISION_COLOR_MASK_R),
-            DIVISION_MASK_HAS_FLAG(pass_desc->color_mask, DIVISION_COLOR_MASK_G),
-            DIVISION_MASK_HAS_FLAG(pass_desc->color_mask, DIVISION_COLOR_MASK_B),
-            DIVISION_MASK_HAS_FLAG(pass_desc->color_mask, DIVISION_COLOR_MASK_A)
+        division_glfw_state_cache_set_pipeline_state(
+            state_cache, &pass_desc_impl->pipeline_state
         );
 
-        if (DIVISION_MASK_HAS_FLAG(
-                pass_desc->capabilities_mask,
-                DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
-            ))
+        // Matches Metal, which restarts the strips only at the maximum index value
+        division_glfw_state_cache_set_primitive_restart(
+            state_cache,
+            vb_internal.gl_topology == GL_TRIANGLE_STRIP ||
+                vb_internal.gl_topology == GL_LINE_STRIP
+        );
+
+        bool instanced = DIVISION_MASK_HAS_FLAG(
+            pass_instance->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
+        );
+
+        if (batch_count > 1)
+        {
+            multi_draw_indirect(
+                ctx,
+                &vb_internal,
+                pass_instance,
+                batch_count,
+                vertex_buffer->settings.size.index_count > 0
+            );
+        }
+        else if (vertex_buffer->settings.size.index_count == 0)
+        {
+            draw_arrays(&vb_internal, pass_instance, base_vertex, instanced);
+        }
+        else if (instanced)
         {
             glDrawElementsInstancedBaseVertexBaseInstance(
                 vb_internal.gl_topology,
                 (int) pass_instance->index_count,
-                GL_UNSIGNED_INT,
-                NULL,
+                vb_internal.gl_index_type,
+                first_index_ptr,
                 (int) pass_instance->instance_count,
-                (int) pass_instance->first_vertex,
-                pass_instance->first_instance
+                base_vertex,
+                pass_instance->first_instance + vb_internal.base_instance
             );
         }
         else
@@ -131,20 +304,391 @@ void division_engine_internal_platform_render_pass_instance_draw(
             glDrawElementsBaseVertex(
                 vb_internal.gl_topology,
                 (int) pass_instance->index_count,
-                GL_UNSIGNED_INT,
-                NULL,
-                (int) pass_instance->first_vertex
+                vb_internal.gl_index_type,
+                first_index_ptr,
+                base_vertex
             );
         }
     }
+
+    division_glfw_state_cache_bind_buffer(state_cache, GL_DRAW_INDIRECT_BUFFER, 0);
+    division_glfw_state_cache_bind_vertex_array(state_cache, 0);
 }
 
 void bind_uniform_buffer(
-    DivisionUniformBufferSystemContext* ctx, const DivisionIdWithBinding* buffer_binding
+    DivisionGlStateCache_* state_cache,
+    DivisionUniformBufferSystemContext* ctx,
+    const DivisionIdWithBinding* buffer_binding
+)
+{
+    const DivisionUniformBufferInternal_* buffer_impl =
+        &ctx->uniform_buffers_impl[buffer_binding->id];
+
+    division_glfw_state_cache_bind_uniform_buffer_range(
+        state_cache,
+        buffer_binding->shader_location,
+        buffer_impl->gl_buffer,
+        buffer_impl->offset,
+        buffer_impl->size
+    );
+}
+
+void bind_instance_bindings(
+    DivisionGlStateCache_* state_cache,
+    DivisionUniformBufferSystemContext* uniform_buff_ctx,
+    DivisionTextureSystemContext* tex_ctx,
+    const DivisionRenderPassInstance* pass_instance
+)
+{
+    for (int uniform_idx = 0; uniform_idx < pass_instance->uniform_vertex_buffer_count;
+         uniform_idx++)
+    {
+        bind_uniform_buffer(
+            state_cache,
+            uniform_buff_ctx,
+            &pass_instance->uniform_vertex_buffers[uniform_idx]
+        );
+    }
+
+    for (int uniform_idx = 0; uniform_idx < pass_instance->uniform_fragment_buffer_count;
+         uniform_idx++)
+    {
+        bind_uniform_buffer(
+            state_cache,
+            uniform_buff_ctx,
+            &pass_instance->uniform_fragment_buffers[uniform_idx]
+        );
+    }
+
+    for (int frag_tex_idx = 0; frag_tex_idx < pass_instance->fragment_texture_count;
+         frag_tex_idx++)
+    {
+        DivisionIdWithBinding tex_bind = pass_instance->fragment_textures[frag_tex_idx];
+        DivisionTextureImpl_* tex_impl = &tex_ctx->textures_impl[tex_bind.id];
+
+        division_glfw_state_cache_bind_texture_unit(
+            state_cache, tex_bind.shader_location, tex_impl->gl_texture
+        );
+    }
+}
+
+// The group names are resolved already, so every kind of binding is one multi-bind
+void bind_binding_group(
+    DivisionGlStateCache_* state_cache,
+    const DivisionBindingGroupInternalPlatform_* group_impl
+)
+{
+    division_glfw_state_cache_bind_uniform_buffers(
+        state_cache,
+        group_impl->first_uniform_binding,
+        group_impl->uniform_binding_count,
+        group_impl->gl_uniform_buffers,
+        group_impl->gl_uniform_offsets,
+        group_impl->gl_uniform_sizes
+    );
+    division_glfw_state_cache_bind_texture_units(
+        state_cache,
+        group_impl->first_texture_unit,
+        group_impl->texture_unit_count,
+        group_impl->gl_textures
+    );
+}
+
+void bind_uniform_ring_ranges(
+    DivisionGlStateCache_* state_cache,
+    const DivisionUniformRingInternal_* ring_impl,
+    const DivisionRenderPassInstance* pass_instance
 )
 {
-    uint32_t buffer_id = buffer_binding->id;
-    GLuint gl_uniform_buff = ctx->uniform_buffers_impl[buffer_id].gl_buffer;
+    for (int32_t i = 0; i < pass_instance->uniform_ring_binding_count; i++)
+    {
+        const DivisionUniformRingBinding* ring_binding =
+            &pass_instance->uniform_ring_bindings[i];
+
+        division_glfw_state_cache_bind_uniform_buffer_range(
+            state_cache,
+            ring_binding->shader_location,
+            ring_impl->gl_buffer,
+            (GLintptr) ring_binding->offset,
+            (GLsizeiptr) ring_binding->size
+        );
+    }
+}
+
+void draw_arrays(
+    const DivisionVertexBufferInternalPlatform_* vb_internal,
+    const DivisionRenderPassInstance* pass_instance,
+    GLint first_vertex,
+    bool instanced
+)
+{
+    if (instanced)
+    {
+        glDrawArraysInstancedBaseInstance(
+            vb_internal->gl_topology,
+            first_vertex,
+            (int) pass_instance->vertex_count,
+            (int) pass_instance->instance_count,
+            pass_instance->first_instance + vb_internal->base_instance
+        );
+    }
+    else
+    {
+        glDrawArrays(
+            vb_internal->gl_topology, first_vertex, (int) pass_instance->vertex_count
+        );
+    }
+}
+
+void multi_draw_indirect(
+    DivisionContext* ctx,
+    const DivisionVertexBufferInternalPlatform_* vb_internal,
+    const DivisionRenderPassInstance* pass_instances,
+    uint32_t draw_count,
+    bool indexed
+)
+{
+    DivisionRenderPassDrawInternalPlatform_* draw_impl =
+        ctx->render_pass_context->draw_impl;
+    size_t command_size = indexed ? sizeof(GlDrawElementsIndirectCommand_)
+                                  : sizeof(GlDrawArraysIndirectCommand_);
+    size_t commands_size = command_size * draw_count;
+
+    if (commands_size > draw_impl->indirect_commands_capacity)
+    {
+        void* commands = realloc(draw_impl->indirect_commands, commands_size);
+        if (commands == NULL)
+        {
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate indirect commands");
+            return;
+        }
+
+        draw_impl->indirect_commands = commands;
+        draw_impl->indirect_commands_capacity = commands_size;
+    }
 
-    glBindBufferBase(GL_UNIFORM_BUFFER, buffer_binding->shader_location, gl_uniform_buff);
-}
\ No newline at end of file
+    // Capabilities are equal inside of the batch
+    bool instanced = DIVISION_MASK_HAS_FLAG(
+        pass_instances->capabilities_mask,
+        DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
+    );
+
+    for (uint32_t i = 0; i < draw_count; i++)
+    {
+        const DivisionRenderPassInstance* pass_instance = &pass_instances[i];
+        GLuint instance_count = instanced ? pass_instance->instance_count : 1;
+        GLuint base_instance =
+            (instanced ? pass_instance->first_instance : 0) + vb_internal->base_instance;
+
+        if (indexed)
+        {
+            GlDrawElementsIndirectCommand_* commands = draw_impl->indirect_commands;
+            commands[i] = (GlDrawElementsIndirectCommand_){
+                .count = pass_instance->index_count,
+                .instance_count = instance_count,
+                .first_index = vb_internal->first_index,
+                .base_vertex =
+                    (GLint) (pass_instance->first_vertex + vb_internal->base_vertex),
+                .base_instance = base_instance,
+            };
+        }
+        else
+        {
+            GlDrawArraysIndirectCommand_* commands = draw_impl->indirect_commands;
+            commands[i] = (GlDrawArraysIndirectCommand_){
+                .count = pass_instance->vertex_count,
+                .instance_count = instance_count,
+                .first = pass_instance->first_vertex + vb_internal->base_vertex,
+                .base_instance = base_instance,
+            };
+        }
+    }
+
+    if (!upload_indirect_commands(draw_impl, commands_size))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to create the indirect buffer");
+        return;
+    }
+
+    division_glfw_state_cache_bind_buffer(
+        &draw_impl->state_cache, GL_DRAW_INDIRECT_BUFFER, draw_impl->gl_indirect_buffer
+    );
+
+    if (indexed)
+    {
+        glMultiDrawElementsIndirect(
+            vb_internal->gl_topology,
+            vb_internal->gl_index_type,
+            NULL,
+            (GLsizei) draw_count,
+            0
+        );
+    }
+    else
+    {
+        glMultiDrawArraysIndirect(
+            vb_internal->gl_topology, NULL, (GLsizei) draw_count, 0
+        );
+    }
+}
+
+bool upload_indirect_commands(
+    DivisionRenderPassDrawInternalPlatform_* draw_impl, size_t commands_size
+)
+{
+    if (draw_impl->gl_indirect_buffer == 0)
+    {
+        glCreateBuffers(1, &draw_impl->gl_indirect_buffer);
+        if (draw_impl->gl_indirect_buffer == 0)
+        {
+            return false;
+        }
+    }
+
+    // Orphans the storage, so the previous draws keep reading their own commands
+    draw_impl->indirect_buffer_size =
+        DIVISION_MAX(draw_impl->indirect_buffer_size, commands_size);
+    glNamedBufferData(
+        draw_impl->gl_indirect_buffer,
+        (GLsizeiptr) draw_impl->indirect_buffer_size,
+        NULL,
+        GL_STREAM_DRAW
+    );
+    glNamedBufferSubData(
+        draw_impl->gl_indirect_buffer,
+        0,
+        (GLsizeiptr) commands_size,
+        draw_impl->indirect_commands
+    );
+
+    return true;
+}
+
+void clear_depth_stencil(
+    DivisionGlStateCache_* state_cache, DivisionDepthStencilFormat format, float depth
+)
+{
+    division_glfw_state_cache_set_depth_write(state_cache, true);
+
+    if (format == DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8)
+    {
+        glClearBufferfi(GL_DEPTH_STENCIL, 0, depth, 0);
+    }
+    else
+    {
+        glClearBufferfv(GL_DEPTH, 0, &depth);
+    }
+}
+
+// Lets the driver skip loading or storing the color of the window, e.g. on tiled GPUs
+void invalidate_default_color(void)
+{
+    const GLenum attachment = GL_COLOR;
+    glInvalidateNamedFramebufferData(0, 1, &attachment);
+}
+
+/*
+ *  GLFW has no swap-preserve, so the frames are drawn into the offscreen target, which
+ *  keeps the contents outside of the dirty rects. The clears are scissored by the rects,
+ *  the don't care loads would drop the kept contents and are skipped. Returns false if
+ *  the target can't be created, the frame is drawn to the window as a whole then
+ */
+bool begin_partial_frame(DivisionContext* ctx, const DivisionFrameDescriptor* frame)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionRendererSystemContext* renderer_ctx = ctx->renderer_context;
+    DivisionRenderPassDrawInternalPlatform_* draw_impl = render_pass_ctx->draw_impl;
+    DivisionGlStateCache_* state_cache = &draw_impl->state_cache;
+    DivisionDepthStencilFormat depth_format = renderer_ctx->depth_stencil_format;
+
+    if (!division_glfw_offscreen_target_resize(
+            draw_impl,
+            renderer_ctx->frame_buffer_width,
+            renderer_ctx->frame_buffer_height,
+            depth_format
+        ))
+    {
+        // The incomplete target is created again by the next frame
+        division_glfw_offscreen_target_free(draw_impl);
+        division_engine_render_pass_instance_redraw_whole_frame(ctx);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to create the partial redraw target");
+        return false;
+    }
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_impl->gl_offscreen_framebuffer);
+    division_glfw_state_cache_invalidate(state_cache);
+    division_glfw_state_cache_set_color_mask(state_cache, DIVISION_COLOR_MASK_RGBA);
+
+    bool clear_color = frame->color_load_action == DIVISION_LOAD_ACTION_CLEAR;
+    bool clear_depth = depth_format != DIVISION_DEPTH_STENCIL_FORMAT_NONE &&
+                       frame->depth_load_action == DIVISION_LOAD_ACTION_CLEAR;
+
+    for (uint32_t i = 0; i < render_pass_ctx->frame_dirty_rect_count; i++)
+    {
+        division_engine_internal_platform_render_pass_instance_set_scissor(
+            ctx, &render_pass_ctx->frame_dirty_rects[i]
+        );
+
+        if (clear_color)
+        {
+            glClearBufferfv(GL_COLOR, 0, (const GLfloat*) &frame->clear_color);
+        }
+
+        if (clear_depth)
+        {
+            clear_depth_stencil(state_cache, depth_format, frame->clear_depth);
+        }
+    }
+
+    return true;
+}
+
+void end_partial_frame(DivisionContext* ctx, const DivisionFrameDescriptor* frame)
+{
+    DivisionRenderPassDrawInternalPlatform_* draw_impl =
+        ctx->render_pass_context->draw_impl;
+    DivisionDepthStencilFormat depth_format = ctx->renderer_context->depth_stencil_format;
+    GLint width = draw_impl->offscreen_width;
+    GLint height = draw_impl->offscreen_height;
+
+    if (depth_format != DIVISION_DEPTH_STENCIL_FORMAT_NONE &&
+        frame->depth_store_action == DIVISION_STORE_ACTION_DONT_CARE)
+    {
+        const GLenum attachment =
+            depth_format == DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8
+                ? GL_DEPTH_STENCIL_ATTACHMENT
+                : GL_DEPTH_ATTACHMENT;
+        glInvalidateNamedFramebufferData(
+            draw_impl->gl_offscreen_framebuffer, 1, &attachment
+        );
+    }
+
+    // The blit is scissored and masked like the draws, the whole window is overwritten
+    division_engine_internal_platform_render_pass_instance_set_scissor(ctx, NULL);
+    division_glfw_state_cache_set_color_mask(
+        &draw_impl->state_cache, DIVISION_COLOR_MASK_RGBA
+    );
+    glBlitNamedFramebuffer(
+        draw_impl->gl_offscreen_framebuffer,
+        0,
+        0,
+        0,
+        width,
+        height,
+        0,
+        0,
+        width,
+        height,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+}
+
+void invalidate_default_depth_stencil(DivisionDepthStencilFormat format)
+{
+    const GLenum attachments[] = {GL_DEPTH, GL_STENCIL};
+    GLsizei attachment_count =
+        format == DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8 ? 2 : 1;
+    glInvalidateNamedFramebufferData(0, attachment_count, attachments);
+}
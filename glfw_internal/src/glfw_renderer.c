@@ -53,6 +53,24 @@ bool division_engine_internal_platform_renderer_alloc(
         return false;
     }
 
+    // The default frame buffer gets the depth attachment of the settings only
+    switch (settings->depth_stencil_format)
+    {
+    case DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8:
+        glfwWindowHint(GLFW_DEPTH_BITS, 24);
+        glfwWindowHint(GLFW_STENCIL_BITS, 8);
+        break;
+    case DIVISION_DEPTH_STENCIL_FORMAT_DEPTH32:
+        glfwWindowHint(GLFW_DEPTH_BITS, 32);
+        glfwWindowHint(GLFW_STENCIL_BITS, 0);
+        break;
+    case DIVISION_DEPTH_STENCIL_FORMAT_NONE:
+    default:
+        glfwWindowHint(GLFW_DEPTH_BITS, 0);
+        glfwWindowHint(GLFW_STENCIL_BITS, 0);
+        break;
+    }
+
     GLFWwindow* window = glfwCreateWindow(
         (int)settings->window_width,
         (int)settings->window_height,
@@ -130,7 +148,7 @@ void division_engine_internal_platform_renderer_run_loop(DivisionContext* ctx)
             ctx->state.delta_time = delta_time;
 
             handle_input(window, ctx);
-            ctx->lifecycle.draw_callback(ctx);
+            division_engine_renderer_draw(ctx);
             glfwSwapBuffers(window);
         }
 
@@ -1,7 +1,17 @@
 #include "division_engine_core/platform_internal/platform_uniform_buffer.h"
 
+#include "division_engine_core/utility.h"
+
 #include "glfw_uniform_buffer.h"
 #include <stdlib.h>
+#include <string.h>
+
+#define RING_MAP_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+// Size classes double from the smallest slot, larger blocks get their own buffers
+#define UNIFORM_POOL_MIN_SLOT_SIZE 256
+#define UNIFORM_POOL_SIZE_CLASS_COUNT 7
+#define UNIFORM_POOL_PAGE_SIZE (64 * 1024)
 
 static inline GLuint get_gl_uniform_buffer(
     const DivisionContext* ctx, uint32_t division_buffer
@@ -10,17 +20,62 @@ static inline GLuint get_gl_uniform_buffer(
     return ctx->uniform_buffer_context->uniform_buffers_impl[division_buffer].gl_buffer;
 }
 
+static inline bool init_pooled_element_(DivisionContext* ctx, uint32_t buffer_id);
+static inline bool create_pools_(DivisionUniformBufferSystemContext* uniform_buffer_ctx);
+static inline bool pool_alloc_slot_(
+    DivisionUniformBufferPoolInternalPlatform_* pool, uint32_t* out_slot
+);
+
 bool division_engine_internal_platform_uniform_buffer_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
 {
+    DivisionUniformRingInternal_* ring_impl =
+        malloc(sizeof(DivisionUniformRingInternal_));
+    if (ring_impl == NULL)
+    {
+        return false;
+    }
+
+    *ring_impl = (DivisionUniformRingInternal_){.gl_buffer = 0, .frame_fences = {0}};
     ctx->uniform_buffer_context->uniform_buffers_impl = NULL;
+    ctx->uniform_buffer_context->ring_impl = ring_impl;
     return true;
 }
 
 void division_engine_internal_platform_uniform_buffer_context_free(DivisionContext* ctx)
 {
-    free(ctx->uniform_buffer_context->uniform_buffers_impl);
+    DivisionUniformRingInternal_* ring_impl = ctx->uniform_buffer_context->ring_impl;
+
+    for (size_t i = 0; i < DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT; i++)
+    {
+        if (ring_impl->frame_fences[i] != 0)
+        {
+            glDeleteSync(ring_impl->frame_fences[i]);
+        }
+    }
+
+    if (ring_impl->gl_buffer != 0)
+    {
+        glUnmapNamedBuffer(ring_impl->gl_buffer);
+        glDeleteBuffers(1, &ring_impl->gl_buffer);
+    }
+
+    free(ring_impl);
+
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    for (size_t i = 0; i < uniform_buffer_ctx->pools_count; i++)
+    {
+        DivisionUniformBufferPoolInternalPlatform_* pool =
+            &uniform_buffer_ctx->pools_impl[i];
+
+        glDeleteBuffers((GLsizei) pool->page_count, pool->gl_pages);
+        free(pool->gl_pages);
+        division_free_list_allocator_free(&pool->slot_allocator);
+    }
+
+    free(uniform_buffer_ctx->pools_impl);
+    free(uniform_buffer_ctx->uniform_buffers_impl);
 }
 
 bool division_engine_internal_platform_uniform_buffer_realloc(
@@ -43,13 +98,27 @@ bool division_engine_internal_platform_uniform_buffer_impl_init_element(
     DivisionUniformBufferDescriptor* buffer =
         &uniform_buffer_ctx->uniform_buffers[buffer_id];
 
+    if (DIVISION_MASK_HAS_FLAG(
+            buffer->capabilities_mask, DIVISION_UNIFORM_BUFFER_CAPABILITY_SHARED_STORAGE
+        ) &&
+        init_pooled_element_(ctx, buffer_id))
+    {
+        return true;
+    }
+
     GLuint gl_buff;
     glGenBuffers(1, &gl_buff);
     glBindBuffer(GL_UNIFORM_BUFFER, gl_buff);
-    glNamedBufferData(gl_buff, (GLsizeiptr)buffer->data_bytes, NULL, GL_DYNAMIC_COPY);
+    glNamedBufferData(gl_buff, (GLsizeiptr)buffer->data_bytes, NULL, GL_DYNAMIC_DRAW);
 
     uniform_buffer_ctx->uniform_buffers_impl[buffer_id] =
-        (DivisionUniformBufferInternal_){.gl_buffer = gl_buff};
+        (DivisionUniformBufferInternal_){
+            .gl_buffer = gl_buff,
+            .pool_id = DIVISION_GLFW_UNIFORM_BUFFER_NO_POOL,
+            .pool_slot = 0,
+            .offset = 0,
+            .size = (GLsizeiptr) buffer->data_bytes,
+        };
 
     return true;
 }
@@ -58,17 +127,37 @@ void division_engine_internal_platform_uniform_buffer_free(
     DivisionContext* ctx, uint32_t buffer_id
 )
 {
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
     DivisionUniformBufferInternal_* buff =
-        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
-    glDeleteBuffers(1, &buff->gl_buffer);
+        &uniform_buffer_ctx->uniform_buffers_impl[buffer_id];
+
+    if (buff->pool_id != DIVISION_GLFW_UNIFORM_BUFFER_NO_POOL)
+    {
+        DivisionUniformBufferPoolInternalPlatform_* pool =
+            &uniform_buffer_ctx->pools_impl[buff->pool_id];
+        division_free_list_allocator_free_range(
+            &pool->slot_allocator, buff->pool_slot, 1
+        );
+    }
+    else
+    {
+        glDeleteBuffers(1, &buff->gl_buffer);
+    }
+
     buff->gl_buffer = 0;
+    buff->pool_id = DIVISION_GLFW_UNIFORM_BUFFER_NO_POOL;
 }
 
 void* division_engine_internal_platform_uniform_buffer_borrow_data_pointer(
     DivisionContext* ctx, uint32_t buffer_id
 )
 {
-    return glMapNamedBuffer(get_gl_uniform_buffer(ctx, buffer_id), GL_READ_WRITE);
+    const DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+
+    return glMapNamedBufferRange(
+        buff->gl_buffer, buff->offset, buff->size, GL_MAP_READ_BIT | GL_MAP_WRITE_BIT
+    );
 }
 
 void division_engine_internal_platform_uniform_buffer_return_data_pointer(
@@ -77,3 +166,186 @@ void division_engine_internal_platform_uniform_buffer_return_data_pointer(
 {
     glUnmapNamedBuffer(get_gl_uniform_buffer(ctx, buffer_id));
 }
+
+void division_engine_internal_platform_uniform_buffer_update_range(
+    DivisionContext* ctx, uint32_t buffer_id, size_t offset, const void* data, size_t size
+)
+{
+    const DivisionUniformBufferDescriptor* buffer =
+        &ctx->uniform_buffer_context->uniform_buffers[buffer_id];
+    const DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+    GLuint gl_buffer = buff->gl_buffer;
+
+    // Invalidated whole buffer gets a new storage instead of waiting for the old one
+    if (buffer->update_policy == DIVISION_UNIFORM_BUFFER_UPDATE_ORPHAN &&
+        buff->pool_id == DIVISION_GLFW_UNIFORM_BUFFER_NO_POOL &&
+        size == buffer->data_bytes)
+    {
+        void* buffer_data = glMapNamedBufferRange(
+            gl_buffer,
+            0,
+            (GLsizeiptr) size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        );
+        if (buffer_data != NULL)
+        {
+            memcpy(buffer_data, data, size);
+            glUnmapNamedBuffer(gl_buffer);
+            return;
+        }
+    }
+
+    glNamedBufferSubData(
+        gl_buffer, buff->offset + (GLintptr) offset, (GLsizeiptr) size, data
+    );
+}
+
+bool division_engine_internal_platform_uniform_buffer_ring_alloc(
+    DivisionContext* ctx, size_t capacity, size_t* out_offset_alignment
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    DivisionUniformRingInternal_* ring_impl = uniform_buffer_ctx->ring_impl;
+
+    GLint offset_alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offset_alignment);
+    *out_offset_alignment = (size_t) (offset_alignment > 0 ? offset_alignment : 1);
+
+    glCreateBuffers(1, &ring_impl->gl_buffer);
+    glNamedBufferStorage(
+        ring_impl->gl_buffer, (GLsizeiptr) capacity, NULL, RING_MAP_FLAGS
+    );
+    uniform_buffer_ctx->ring_data = glMapNamedBufferRange(
+        ring_impl->gl_buffer, 0, (GLsizeiptr) capacity, RING_MAP_FLAGS
+    );
+
+    return uniform_buffer_ctx->ring_data != NULL;
+}
+
+void division_engine_internal_platform_uniform_buffer_ring_end_frame(
+    DivisionContext* ctx, uint32_t frame, uint32_t next_frame
+)
+{
+    DivisionUniformRingInternal_* ring_impl = ctx->uniform_buffer_context->ring_impl;
+
+    ring_impl->frame_fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    GLsync next_fence = ring_impl->frame_fences[next_frame];
+    if (next_fence != 0)
+    {
+        glClientWaitSync(next_fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(next_fence);
+        ring_impl->frame_fences[next_frame] = 0;
+    }
+}
+
+bool init_pooled_element_(DivisionContext* ctx, uint32_t buffer_id)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    size_t data_bytes = uniform_buffer_ctx->uniform_buffers[buffer_id].data_bytes;
+
+    if (uniform_buffer_ctx->pools_count == 0 && !create_pools_(uniform_buffer_ctx))
+    {
+        return false;
+    }
+
+    int32_t pool_id = 0;
+    while (pool_id < (int32_t) uniform_buffer_ctx->pools_count &&
+           uniform_buffer_ctx->pools_impl[pool_id].slot_size < data_bytes)
+    {
+        pool_id++;
+    }
+
+    // Too large for the size classes, the buffer is created as a usual one
+    if (pool_id == (int32_t) uniform_buffer_ctx->pools_count)
+    {
+        return false;
+    }
+
+    DivisionUniformBufferPoolInternalPlatform_* pool =
+        &uniform_buffer_ctx->pools_impl[pool_id];
+    uint32_t slot;
+    if (!pool_alloc_slot_(pool, &slot))
+    {
+        return false;
+    }
+
+    uniform_buffer_ctx->uniform_buffers_impl[buffer_id] =
+        (DivisionUniformBufferInternal_){
+            .gl_buffer = pool->gl_pages[slot / pool->slots_per_page],
+            .pool_id = pool_id,
+            .pool_slot = slot,
+            .offset = (GLintptr) ((slot % pool->slots_per_page) * pool->slot_size),
+            .size = (GLsizeiptr) data_bytes,
+        };
+
+    return true;
+}
+
+// The slots are aligned, as the smallest slot size is a multiple of the offset alignment
+bool create_pools_(DivisionUniformBufferSystemContext* uniform_buffer_ctx)
+{
+    DivisionUniformBufferPoolInternalPlatform_* pools = calloc(
+        UNIFORM_POOL_SIZE_CLASS_COUNT, sizeof(DivisionUniformBufferPoolInternalPlatform_)
+    );
+    if (pools == NULL)
+    {
+        return false;
+    }
+
+    GLint offset_alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offset_alignment);
+    size_t alignment = (size_t) DIVISION_MAX(offset_alignment, 1);
+    size_t slot_size =
+        (UNIFORM_POOL_MIN_SLOT_SIZE + alignment - 1) / alignment * alignment;
+
+    size_t pools_count = 0;
+    while (pools_count < UNIFORM_POOL_SIZE_CLASS_COUNT &&
+           slot_size <= UNIFORM_POOL_PAGE_SIZE)
+    {
+        DivisionUniformBufferPoolInternalPlatform_* pool = &pools[pools_count++];
+        pool->slot_size = slot_size;
+        pool->slots_per_page = (uint32_t) (UNIFORM_POOL_PAGE_SIZE / slot_size);
+        division_free_list_allocator_alloc(&pool->slot_allocator, 0);
+
+        slot_size *= 2;
+    }
+
+    uniform_buffer_ctx->pools_impl = pools;
+    uniform_buffer_ctx->pools_count = pools_count;
+
+    return true;
+}
+
+bool pool_alloc_slot_(
+    DivisionUniformBufferPoolInternalPlatform_* pool, uint32_t* out_slot
+)
+{
+    if (division_free_list_allocator_alloc_range(&pool->slot_allocator, 1, out_slot))
+    {
+        return true;
+    }
+
+    GLuint* gl_pages = realloc(pool->gl_pages, sizeof(GLuint[pool->page_count + 1]));
+    if (gl_pages == NULL)
+    {
+        return false;
+    }
+    pool->gl_pages = gl_pages;
+
+    GLuint gl_page;
+    glCreateBuffers(1, &gl_page);
+    glNamedBufferData(
+        gl_page,
+        (GLsizeiptr) (pool->slots_per_page * pool->slot_size),
+        NULL,
+        GL_DYNAMIC_DRAW
+    );
+    pool->gl_pages[pool->page_count++] = gl_page;
+
+    division_free_list_allocator_grow(
+        &pool->slot_allocator, (uint32_t) (pool->page_count * pool->slots_per_page)
+    );
+    return division_free_list_allocator_alloc_range(&pool->slot_allocator, 1, out_slot);
+}
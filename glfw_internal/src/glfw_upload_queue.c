@@ -0,0 +1,250 @@
+#include "division_engine_core/platform_internal/platform_upload_queue.h"
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core/utility.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include "glfw_texture.h"
+#include "glfw_uniform_buffer.h"
+#include "glfw_upload_queue.h"
+#include "glfw_vertex_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define STAGING_MAP_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+static inline bool get_job_buffer_range_(
+    DivisionContext* ctx, const DivisionUploadJob* job, DivisionGlBufferRange_* out_range
+);
+static inline void copy_to_texture_(
+    DivisionContext* ctx, GLuint gl_staging_buffer, const DivisionUploadJob* job
+);
+static inline bool push_fence_(
+    DivisionUploadQueueInternalPlatform_* upload_impl, DivisionGlUploadFence_ fence
+);
+
+bool division_engine_internal_platform_upload_queue_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        malloc(sizeof(DivisionUploadQueueInternalPlatform_));
+    if (upload_impl == NULL)
+    {
+        return false;
+    }
+
+    *upload_impl = (DivisionUploadQueueInternalPlatform_){
+        .gl_staging_buffer = 0,
+        .fences = NULL,
+        .fences_count = 0,
+        .fences_capacity = 0,
+        .completed_fence = 0,
+    };
+    ctx->upload_queue_context->upload_queue_impl = upload_impl;
+
+    return true;
+}
+
+void division_engine_internal_platform_upload_queue_context_free(DivisionContext* ctx)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+
+    for (size_t i = 0; i < upload_impl->fences_count; i++)
+    {
+        glDeleteSync(upload_impl->fences[i].gl_sync);
+    }
+
+    if (upload_impl->gl_staging_buffer != 0)
+    {
+        glUnmapNamedBuffer(upload_impl->gl_staging_buffer);
+        glDeleteBuffers(1, &upload_impl->gl_staging_buffer);
+    }
+
+    free(upload_impl->fences);
+    free(upload_impl);
+}
+
+bool division_engine_internal_platform_upload_queue_staging_alloc(
+    DivisionContext* ctx, size_t capacity
+)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+    DivisionUploadQueueInternalPlatform_* upload_impl = upload_ctx->upload_queue_impl;
+
+    glCreateBuffers(1, &upload_impl->gl_staging_buffer);
+    glNamedBufferStorage(
+        upload_impl->gl_staging_buffer, (GLsizeiptr) capacity, NULL, STAGING_MAP_FLAGS
+    );
+    upload_ctx->staging_data = glMapNamedBufferRange(
+        upload_impl->gl_staging_buffer, 0, (GLsizeiptr) capacity, STAGING_MAP_FLAGS
+    );
+
+    return upload_ctx->staging_data != NULL;
+}
+
+void division_engine_internal_platform_upload_queue_submit(
+    DivisionContext* ctx,
+    const DivisionUploadJob* jobs,
+    size_t job_count,
+    DivisionUploadFence fence
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+    GLuint gl_staging_buffer = upload_impl->gl_staging_buffer;
+
+    for (size_t i = 0; i < job_count; i++)
+    {
+        const DivisionUploadJob* job = &jobs[i];
+
+        if (job->target == DIVISION_UPLOAD_TARGET_TEXTURE)
+        {
+            copy_to_texture_(ctx, gl_staging_buffer, job);
+            continue;
+        }
+
+        DivisionGlBufferRange_ range;
+        if (!get_job_buffer_range_(ctx, job, &range))
+        {
+            continue;
+        }
+
+        glCopyNamedBufferSubData(
+            gl_staging_buffer,
+            range.gl_buffer,
+            (GLintptr) job->staging_offset,
+            (GLintptr) (range.offset + job->dst_offset),
+            (GLsizeiptr) job->size
+        );
+    }
+
+    DivisionGlUploadFence_ upload_fence = {
+        .fence = fence,
+        .gl_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+    };
+    if (!push_fence_(upload_impl, upload_fence))
+    {
+        // Without the fence object the copies are awaited right away
+        glClientWaitSync(upload_fence.gl_sync, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(upload_fence.gl_sync);
+        upload_impl->completed_fence = fence;
+    }
+}
+
+DivisionUploadFence division_engine_internal_platform_upload_queue_completed_fence(
+    DivisionContext* ctx
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+
+    size_t signaled_count = 0;
+    while (signaled_count < upload_impl->fences_count)
+    {
+        DivisionGlUploadFence_* upload_fence = &upload_impl->fences[signaled_count];
+        GLenum status = glClientWaitSync(upload_fence->gl_sync, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+
+        glDeleteSync(upload_fence->gl_sync);
+        upload_impl->completed_fence = upload_fence->fence;
+        signaled_count++;
+    }
+
+    upload_impl->fences_count -= signaled_count;
+    memmove(
+        upload_impl->fences,
+        upload_impl->fences + signaled_count,
+        sizeof(DivisionGlUploadFence_[upload_impl->fences_count])
+    );
+
+    return upload_impl->completed_fence;
+}
+
+bool get_job_buffer_range_(
+    DivisionContext* ctx, const DivisionUploadJob* job, DivisionGlBufferRange_* out_range
+)
+{
+    const DivisionVertexBufferSystemContext* vb_ctx = ctx->vertex_buffer_context;
+    const DivisionUniformBufferInternal_* uniform_impls =
+        ctx->uniform_buffer_context->uniform_buffers_impl;
+
+    switch (job->target)
+    {
+    case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+        *out_range = division_glfw_vertex_buffer_vertices_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+        *out_range =
+            division_glfw_vertex_buffer_instances_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+        *out_range = division_glfw_vertex_buffer_indices_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+        *out_range = (DivisionGlBufferRange_){
+            uniform_impls[job->resource_id].gl_buffer,
+            (size_t) uniform_impls[job->resource_id].offset,
+        };
+        return true;
+    default:
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown upload target");
+        return false;
+    }
+}
+
+void copy_to_texture_(
+    DivisionContext* ctx, GLuint gl_staging_buffer, const DivisionUploadJob* job
+)
+{
+    DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    const DivisionTexture* tex = &tex_ctx->textures[job->resource_id];
+    const DivisionTextureImpl_* tex_impl = &tex_ctx->textures_impl[job->resource_id];
+
+    // Pixels are read from the bound unpack buffer at the offset passed as the pointer
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, gl_staging_buffer);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, tex_impl->pixel_byte_alignment);
+    glTextureSubImage2D(
+        tex_impl->gl_texture,
+        0,
+        0,
+        0,
+        (GLsizei) tex->width,
+        (GLsizei) tex->height,
+        tex_impl->gl_texture_format,
+        GL_UNSIGNED_BYTE,
+        (const void*) job->staging_offset
+    );
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+bool push_fence_(
+    DivisionUploadQueueInternalPlatform_* upload_impl, DivisionGlUploadFence_ fence
+)
+{
+    if (upload_impl->fences_count == upload_impl->fences_capacity)
+    {
+        size_t new_capacity = DIVISION_MAX(upload_impl->fences_capacity * 2, 4);
+        DivisionGlUploadFence_* fences = realloc(
+            upload_impl->fences, sizeof(DivisionGlUploadFence_[new_capacity])
+        );
+        if (fences == NULL)
+        {
+            return false;
+        }
+
+        upload_impl->fences = fences;
+        upload_impl->fences_capacity = new_capacity;
+    }
+
+    upload_impl->fences[upload_impl->fences_count++] = fence;
+    return true;
+}
@@ -8,16 +8,27 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define VERTEX_POOL_VERTEX_BINDING 0
+#define VERTEX_POOL_INSTANCE_BINDING 1
+
+#define VERTEX_POOL_MIN_VERTEX_CAPACITY 4096
+#define VERTEX_POOL_MIN_INSTANCE_CAPACITY 1024
+#define VERTEX_POOL_MIN_INDEX_CAPACITY 16384
+
 typedef struct GlAttrTraits_
 {
     GLenum type;
     int32_t divide_by_components;
+    GLboolean normalized;
+    // Packed formats pass their own component count instead of the attribute one
+    int32_t packed_component_count;
 } GlAttrTraits_;
 
 static inline GlAttrTraits_ get_gl_attr_traits(
     DivisionContext* ctx, DivisionShaderVariableType attributeType
 );
 static inline GLenum topology_to_gl_type(DivisionContext* ctx, DivisionRenderTopology t);
+static inline GLenum index_size_to_gl_type(size_t index_size);
 static inline void enable_gl_attributes(
     DivisionContext* ctx,
     const DivisionVertexAttribute* attributes,
@@ -28,6 +39,36 @@ static inline void enable_gl_attributes(
     bool enable_divisor
 );
 
+static inline bool init_pooled_element_(DivisionContext* ctx, uint32_t buffer_id);
+static inline bool find_or_create_pool_(
+    DivisionContext* ctx, const DivisionVertexBuffer* vertex_buffer, int32_t* out_pool_id
+);
+static inline bool is_pool_layout_equal_(
+    const DivisionVertexBufferPoolInternalPlatform_* pool,
+    const DivisionVertexBuffer* vertex_buffer
+);
+static inline void set_pool_attribute_formats_(
+    DivisionContext* ctx,
+    GLuint gl_vao,
+    const DivisionVertexAttribute* attributes,
+    const DivisionVertexAttributeSettings* attribute_settings,
+    int32_t attribute_count,
+    GLuint binding
+);
+static inline bool pool_alloc_range_(
+    DivisionFreeListAllocator* allocator,
+    GLuint* gl_buffer,
+    size_t element_size,
+    uint32_t element_count,
+    uint32_t min_capacity,
+    uint32_t* out_offset
+);
+static inline void attach_pool_buffers_(
+    const DivisionVertexBufferPoolInternalPlatform_* pool
+);
+static inline void free_pool_(DivisionVertexBufferPoolInternalPlatform_* pool);
+
+
 bool division_engine_internal_platform_vertex_buffer_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
@@ -41,6 +82,12 @@ void division_engine_internal_platform_vertex_buffer_context_free(DivisionContex
 {
     DivisionVertexBufferSystemContext* vertex_buffer_ctx = ctx->vertex_buffer_context;
 
+    for (size_t i = 0; i < vertex_buffer_ctx->pools_count; i++)
+    {
+        free_pool_(&vertex_buffer_ctx->pools_impl[i]);
+    }
+
+    free(vertex_buffer_ctx->pools_impl);
     free(vertex_buffer_ctx->buffers_impl);
 }
 
@@ -51,19 +98,34 @@ GlAttrTraits_ get_gl_attr_traits(
     switch (attributeType)
     {
     case DIVISION_DOUBLE:
-        return (GlAttrTraits_){GL_DOUBLE, 1};
+        return (GlAttrTraits_){GL_DOUBLE, 1, GL_FALSE, 0};
     case DIVISION_INTEGER:
-        return (GlAttrTraits_){GL_INT, 1};
+        return (GlAttrTraits_){GL_INT, 1, GL_FALSE, 0};
     case DIVISION_FLOAT:
     case DIVISION_FVEC2:
     case DIVISION_FVEC3:
     case DIVISION_FVEC4:
-        return (GlAttrTraits_){GL_FLOAT, 1};
+        return (GlAttrTraits_){GL_FLOAT, 1, GL_FALSE, 0};
     case DIVISION_FMAT4X4:
-        return (GlAttrTraits_){GL_FLOAT, 4};
+        return (GlAttrTraits_){GL_FLOAT, 4, GL_FALSE, 0};
+    case DIVISION_HVEC2:
+    case DIVISION_HVEC4:
+        return (GlAttrTraits_){GL_HALF_FLOAT, 1, GL_FALSE, 0};
+    case DIVISION_UBYTE4_NORM:
+        return (GlAttrTraits_){GL_UNSIGNED_BYTE, 1, GL_TRUE, 0};
+    case DIVISION_BYTE4_NORM:
+        return (GlAttrTraits_){GL_BYTE, 1, GL_TRUE, 0};
+    case DIVISION_USHORT2_NORM:
+    case DIVISION_USHORT4_NORM:
+        return (GlAttrTraits_){GL_UNSIGNED_SHORT, 1, GL_TRUE, 0};
+    case DIVISION_SHORT2_NORM:
+    case DIVISION_SHORT4_NORM:
+        return (GlAttrTraits_){GL_SHORT, 1, GL_TRUE, 0};
+    case DIVISION_INT_2_10_10_10_REV_NORM:
+        return (GlAttrTraits_){GL_INT_2_10_10_10_REV, 1, GL_TRUE, 4};
     default: {
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown attribute type");
-        return (GlAttrTraits_){0, 0};
+        return (GlAttrTraits_){0, 0, GL_FALSE, 0};
     }
     }
 }
@@ -78,12 +140,21 @@ GLenum topology_to_gl_type(DivisionContext* ctx, DivisionRenderTopology t)
         return GL_LINES;
     case DIVISION_TOPOLOGY_POINTS:
         return GL_POINTS;
+    case DIVISION_TOPOLOGY_TRIANGLE_STRIP:
+        return GL_TRIANGLE_STRIP;
+    case DIVISION_TOPOLOGY_LINE_STRIP:
+        return GL_LINE_STRIP;
     default:
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown type of topology");
         exit(EXIT_FAILURE);
     }
 }
 
+GLenum index_size_to_gl_type(size_t index_size)
+{
+    return index_size == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
 bool division_engine_internal_platform_vertex_buffer_realloc(
     DivisionContext* ctx, size_t new_size
 )
@@ -103,10 +174,21 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
     DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
     const DivisionVertexBuffer* vb = &vertex_ctx->buffers[buffer_id];
     const DivisionVertexBufferSettings* vb_settings = &vb->settings;
-    const DivisionVertexBufferSize* vb_size = &vb_settings->size;
+    const DivisionVertexBufferSize* vb_capacity = &vb->capacity;
+
+    if (DIVISION_MASK_HAS_FLAG(
+            vb_settings->capabilities_mask,
+            DIVISION_VERTEX_BUFFER_CAPABILITY_SHARED_STORAGE
+        ))
+    {
+        return init_pooled_element_(ctx, buffer_id);
+    }
 
+    size_t index_size = division_engine_vertex_buffer_index_size(vb);
     DivisionVertexBufferInternalPlatform_ vertex_buffer_impl = {
         .gl_topology = topology_to_gl_type(ctx, vb->settings.topology),
+        .gl_index_type = index_size_to_gl_type(index_size),
+        .pool_id = DIVISION_GLFW_VERTEX_BUFFER_NO_POOL,
     };
 
     glGenVertexArrays(1, &vertex_buffer_impl.gl_vao);
@@ -117,7 +199,7 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
 
     glBufferData(
         GL_ELEMENT_ARRAY_BUFFER,
-        (GLsizei)sizeof(uint32_t[vb_size->index_count]),
+        (GLsizei)division_engine_vertex_buffer_indices_capacity_bytes(vb),
         NULL,
         GL_DYNAMIC_DRAW
     );
@@ -125,10 +207,7 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
     glGenBuffers(1, &vertex_buffer_impl.gl_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_impl.gl_vbo);
 
-    size_t per_vertex_data_size = vb->per_vertex_data_size;
-    size_t per_instance_data_size = vb->per_instance_data_size;
-    size_t vertex_count = vb_size->vertex_count;
-    size_t instance_count = vb_size->instance_count;
+    size_t vertex_capacity = vb_capacity->vertex_count;
 
     enable_gl_attributes(
         ctx,
@@ -147,7 +226,7 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
             vb->per_instance_attributes,
             vb_settings->per_instance_attributes,
             vb_settings->per_instance_attribute_count,
-            vb->per_vertex_data_size * vertex_count,
+            vb->per_vertex_data_size * vertex_capacity,
             vb->per_instance_data_size,
             true
         );
@@ -155,8 +234,8 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
 
     glBufferData(
         GL_ARRAY_BUFFER,
-        (GLsizei)(division_engine_vertex_buffer_vertices_bytes(vb) +
-                  division_engine_vertex_buffer_instances_bytes(vb)),
+        (GLsizei)(division_engine_vertex_buffer_vertices_capacity_bytes(vb) +
+                  division_engine_vertex_buffer_instances_capacity_bytes(vb)),
         NULL,
         GL_DYNAMIC_DRAW
     );
@@ -173,15 +252,39 @@ void division_engine_internal_platform_vertex_buffer_free(
     DivisionContext* ctx, uint32_t buffer_id
 )
 {
-    DivisionVertexBufferInternalPlatform_ buffer_impl =
-        ctx->vertex_buffer_context->buffers_impl[buffer_id];
-    glDeleteBuffers(1, &buffer_impl.gl_vbo);
-    glDeleteBuffers(1, &buffer_impl.gl_index_buffer);
-    glDeleteVertexArrays(1, &buffer_impl.gl_vao);
-
-    buffer_impl.gl_vbo = 0;
-    buffer_impl.gl_vao = 0;
-    buffer_impl.gl_index_buffer = 0;
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+    const DivisionVertexBuffer* vb = &vertex_ctx->buffers[buffer_id];
+    DivisionVertexBufferInternalPlatform_* buffer_impl =
+        &vertex_ctx->buffers_impl[buffer_id];
+
+    if (buffer_impl->pool_id != DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        DivisionVertexBufferPoolInternalPlatform_* pool =
+            &vertex_ctx->pools_impl[buffer_impl->pool_id];
+
+        division_free_list_allocator_free_range(
+            &pool->vertex_allocator, buffer_impl->base_vertex, vb->capacity.vertex_count
+        );
+        division_free_list_allocator_free_range(
+            &pool->instance_allocator,
+            buffer_impl->base_instance,
+            vb->capacity.instance_count
+        );
+        division_free_list_allocator_free_range(
+            &pool->index_allocator, buffer_impl->first_index, vb->capacity.index_count
+        );
+    }
+    else
+    {
+        glDeleteBuffers(1, &buffer_impl->gl_vbo);
+        glDeleteBuffers(1, &buffer_impl->gl_index_buffer);
+        glDeleteVertexArrays(1, &buffer_impl->gl_vao);
+    }
+
+    buffer_impl->gl_vbo = 0;
+    buffer_impl->gl_vao = 0;
+    buffer_impl->gl_index_buffer = 0;
+    buffer_impl->pool_id = DIVISION_GLFW_VERTEX_BUFFER_NO_POOL;
 }
 
 bool division_engine_internal_platform_vertex_buffer_borrow_data_pointer(
@@ -195,6 +298,40 @@ bool division_engine_internal_platform_vertex_buffer_borrow_data_pointer(
         &vertex_buffer_ctx->buffers_impl[buffer_id];
     const DivisionVertexBuffer* vertex_buffer = &vertex_buffer_ctx->buffers[buffer_id];
 
+    if (vb->pool_id != DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        DivisionGlBufferRange_ ranges[] = {
+            division_glfw_vertex_buffer_vertices_range(vertex_buffer_ctx, buffer_id),
+            division_glfw_vertex_buffer_instances_range(vertex_buffer_ctx, buffer_id),
+            division_glfw_vertex_buffer_indices_range(vertex_buffer_ctx, buffer_id),
+        };
+        size_t sizes[] = {
+            division_engine_vertex_buffer_vertices_capacity_bytes(vertex_buffer),
+            division_engine_vertex_buffer_instances_capacity_bytes(vertex_buffer),
+            division_engine_vertex_buffer_indices_capacity_bytes(vertex_buffer),
+        };
+        void* ptrs[3] = {NULL, NULL, NULL};
+
+        for (int i = 0; i < 3; i++)
+        {
+            if (sizes[i] > 0)
+            {
+                ptrs[i] = glMapNamedBufferRange(
+                    ranges[i].gl_buffer,
+                    (GLintptr) ranges[i].offset,
+                    (GLsizeiptr) sizes[i],
+                    GL_MAP_READ_BIT | GL_MAP_WRITE_BIT
+                );
+            }
+        }
+
+        out_borrow_data->vertex_data_ptr = ptrs[0];
+        out_borrow_data->instance_data_ptr = ptrs[1];
+        out_borrow_data->index_data_ptr = ptrs[2];
+
+        return true;
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, vb->gl_vbo);
     void* vbo_ptr = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
 
@@ -203,7 +340,7 @@ bool division_engine_internal_platform_vertex_buffer_borrow_data_pointer(
 
     out_borrow_data->vertex_data_ptr = vbo_ptr;
     out_borrow_data->instance_data_ptr =
-        vbo_ptr + division_engine_vertex_buffer_vertices_bytes(vertex_buffer);
+        vbo_ptr + division_engine_vertex_buffer_vertices_capacity_bytes(vertex_buffer);
 
     out_borrow_data->index_data_ptr = idx_ptr;
 
@@ -216,8 +353,31 @@ void division_engine_internal_platform_vertex_buffer_return_data_pointer(
     DivisionVertexBufferBorrowedData* out_borrow_data
 )
 {
+    DivisionVertexBufferSystemContext* vertex_buffer_ctx = ctx->vertex_buffer_context;
     DivisionVertexBufferInternalPlatform_* vb =
-        &ctx->vertex_buffer_context->buffers_impl[buffer_id];
+        &vertex_buffer_ctx->buffers_impl[buffer_id];
+
+    if (vb->pool_id != DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        const DivisionVertexBufferPoolInternalPlatform_* pool =
+            &vertex_buffer_ctx->pools_impl[vb->pool_id];
+
+        if (out_borrow_data->vertex_data_ptr != NULL)
+        {
+            glUnmapNamedBuffer(pool->gl_vbo);
+        }
+        if (out_borrow_data->instance_data_ptr != NULL)
+        {
+            glUnmapNamedBuffer(pool->gl_instance_vbo);
+        }
+        if (out_borrow_data->index_data_ptr != NULL)
+        {
+            glUnmapNamedBuffer(pool->gl_index_buffer);
+        }
+
+        return;
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, vb->gl_vbo);
     glUnmapBuffer(GL_ARRAY_BUFFER);
 
@@ -234,41 +394,47 @@ void division_engine_internal_platform_vertex_buffer_copy_data(
 {
     DivisionVertexBufferSystemContext* vb_context = ctx->vertex_buffer_context;
     const DivisionVertexBuffer* src_vb = &vb_context->buffers[src_buffer];
-    const DivisionVertexBufferInternalPlatform_* src_vb_impl =
-        &vb_context->buffers_impl[src_buffer];
-    DivisionVertexBuffer* dst_vb = &vb_context->buffers[dst_buffer];
-    DivisionVertexBufferInternalPlatform_* dst_vb_impl =
-        &vb_context->buffers_impl[dst_buffer];
-
-    const size_t src_vertices_bytes =
-        division_engine_vertex_buffer_vertices_bytes(src_vb);
-    const size_t dst_vertices_bytes =
-        division_engine_vertex_buffer_vertices_bytes(dst_vb);
+    const DivisionVertexBuffer* dst_vb = &vb_context->buffers[dst_buffer];
 
+    DivisionGlBufferRange_ src_vertices =
+        division_glfw_vertex_buffer_vertices_range(vb_context, src_buffer);
+    DivisionGlBufferRange_ dst_vertices =
+        division_glfw_vertex_buffer_vertices_range(vb_context, dst_buffer);
     glCopyNamedBufferSubData(
-        src_vb_impl->gl_vbo,
-        dst_vb_impl->gl_vbo,
-        0,
-        0,
-        DIVISION_MIN(src_vertices_bytes, dst_vertices_bytes)
+        src_vertices.gl_buffer,
+        dst_vertices.gl_buffer,
+        (long) src_vertices.offset,
+        (long) dst_vertices.offset,
+        DIVISION_MIN(
+            division_engine_vertex_buffer_vertices_bytes(src_vb),
+            division_engine_vertex_buffer_vertices_bytes(dst_vb)
+        )
     );
 
+    DivisionGlBufferRange_ src_instances =
+        division_glfw_vertex_buffer_instances_range(vb_context, src_buffer);
+    DivisionGlBufferRange_ dst_instances =
+        division_glfw_vertex_buffer_instances_range(vb_context, dst_buffer);
     glCopyNamedBufferSubData(
-        src_vb_impl->gl_vbo,
-        dst_vb_impl->gl_vbo,
-        (long) src_vertices_bytes,
-        (long) dst_vertices_bytes,
+        src_instances.gl_buffer,
+        dst_instances.gl_buffer,
+        (long) src_instances.offset,
+        (long) dst_instances.offset,
         DIVISION_MIN(
             division_engine_vertex_buffer_instances_bytes(src_vb),
             division_engine_vertex_buffer_instances_bytes(dst_vb)
         )
     );
 
+    DivisionGlBufferRange_ src_indices =
+        division_glfw_vertex_buffer_indices_range(vb_context, src_buffer);
+    DivisionGlBufferRange_ dst_indices =
+        division_glfw_vertex_buffer_indices_range(vb_context, dst_buffer);
     glCopyNamedBufferSubData(
-        src_vb_impl->gl_index_buffer,
-        dst_vb_impl->gl_index_buffer,
-        0,
-        0,
+        src_indices.gl_buffer,
+        dst_indices.gl_buffer,
+        (long) src_indices.offset,
+        (long) dst_indices.offset,
         DIVISION_MIN(
             division_engine_vertex_buffer_indices_bytes(src_vb),
             division_engine_vertex_buffer_indices_bytes(dst_vb)
@@ -307,6 +473,11 @@ void enable_gl_attributes(
         size_t gl_comp_size = gl_comp_count * at->base_size;
         size_t attr_base_offset = attributes_offset + at->offset;
 
+        if (gl_attr_traits.packed_component_count > 0)
+        {
+            gl_comp_count = gl_attr_traits.packed_component_count;
+        }
+
         for (int comp_idx = 0; comp_idx < gl_attr_traits.divide_by_components; comp_idx++)
         {
             GLuint gl_location = setting->location + comp_idx;
@@ -316,7 +487,7 @@ void enable_gl_attributes(
                 gl_location,
                 gl_comp_count,
                 gl_attr_traits.type,
-                GL_FALSE,
+                gl_attr_traits.normalized,
                 (GLsizei)(attributes_data_size),
                 (void*)(attr_base_offset + comp_idx * gl_comp_size)
             );
@@ -327,4 +498,429 @@ void enable_gl_attributes(
             }
         }
     }
-}
\ No newline at end of file
+}
+
+bool init_pooled_element_(DivisionContext* ctx, uint32_t buffer_id)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+    const DivisionVertexBuffer* vb = &vertex_ctx->buffers[buffer_id];
+
+    int32_t pool_id;
+    if (!find_or_create_pool_(ctx, vb, &pool_id))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to create vertex buffer pool");
+        return false;
+    }
+
+    DivisionVertexBufferPoolInternalPlatform_* pool = &vertex_ctx->pools_impl[pool_id];
+    DivisionVertexBufferInternalPlatform_ vertex_buffer_impl = {
+        .gl_vao = pool->gl_vao,
+        .gl_vbo = 0,
+        .gl_index_buffer = 0,
+        .gl_topology = topology_to_gl_type(ctx, vb->settings.topology),
+        .gl_index_type = index_size_to_gl_type(pool->index_size),
+        .pool_id = pool_id,
+    };
+
+    bool has_vertices = pool_alloc_range_(
+        &pool->vertex_allocator,
+        &pool->gl_vbo,
+        vb->per_vertex_data_size,
+        vb->capacity.vertex_count,
+        VERTEX_POOL_MIN_VERTEX_CAPACITY,
+        &vertex_buffer_impl.base_vertex
+    );
+    bool has_instances =
+        has_vertices && pool_alloc_range_(
+                            &pool->instance_allocator,
+                            &pool->gl_instance_vbo,
+                            vb->per_instance_data_size,
+                            vb->capacity.instance_count,
+                            VERTEX_POOL_MIN_INSTANCE_CAPACITY,
+                            &vertex_buffer_impl.base_instance
+                        );
+    bool has_indices =
+        has_instances && pool_alloc_range_(
+                             &pool->index_allocator,
+                             &pool->gl_index_buffer,
+                             pool->index_size,
+                             vb->capacity.index_count,
+                             VERTEX_POOL_MIN_INDEX_CAPACITY,
+                             &vertex_buffer_impl.first_index
+                         );
+
+    if (!has_indices)
+    {
+        // The ranges taken before the failed one are returned to the pool
+        if (has_instances)
+        {
+            division_free_list_allocator_free_range(
+                &pool->instance_allocator,
+                vertex_buffer_impl.base_instance,
+                vb->capacity.instance_count
+            );
+        }
+        if (has_vertices)
+        {
+            division_free_list_allocator_free_range(
+                &pool->vertex_allocator,
+                vertex_buffer_impl.base_vertex,
+                vb->capacity.vertex_count
+            );
+        }
+
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Vertex buffer pool is out of memory");
+        return false;
+    }
+
+    attach_pool_buffers_(pool);
+    vertex_ctx->buffers_impl[buffer_id] = vertex_buffer_impl;
+
+    return true;
+}
+
+bool find_or_create_pool_(
+    DivisionContext* ctx, const DivisionVertexBuffer* vertex_buffer, int32_t* out_pool_id
+)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+
+    for (size_t i = 0; i < vertex_ctx->pools_count; i++)
+    {
+        if (is_pool_layout_equal_(&vertex_ctx->pools_impl[i], vertex_buffer))
+        {
+            *out_pool_id = (int32_t) i;
+            return true;
+        }
+    }
+
+    const DivisionVertexBufferSettings* vb_settings = &vertex_buffer->settings;
+    size_t new_pools_count = vertex_ctx->pools_count + 1;
+    DivisionVertexBufferPoolInternalPlatform_* pools = realloc(
+        vertex_ctx->pools_impl,
+        sizeof(DivisionVertexBufferPoolInternalPlatform_[new_pools_count])
+    );
+    if (pools == NULL)
+    {
+        return false;
+    }
+    vertex_ctx->pools_impl = pools;
+
+    int32_t per_vertex_attr_count = vb_settings->per_vertex_attribute_count;
+    int32_t per_instance_attr_count = vb_settings->per_instance_attribute_count;
+    DivisionVertexAttributeSettings* per_vertex_attributes =
+        malloc(sizeof(DivisionVertexAttributeSettings[per_vertex_attr_count]));
+    DivisionVertexAttributeSettings* per_instance_attributes =
+        malloc(sizeof(DivisionVertexAttributeSettings[per_instance_attr_count]));
+    DivisionVertexAttribute* per_vertex_attribute_offsets =
+        malloc(sizeof(DivisionVertexAttribute[per_vertex_attr_count]));
+    DivisionVertexAttribute* per_instance_attribute_offsets =
+        malloc(sizeof(DivisionVertexAttribute[per_instance_attr_count]));
+
+    // Empty attribute arrays may be NULL, they are never read
+    if ((per_vertex_attr_count > 0 &&
+         (per_vertex_attributes == NULL || per_vertex_attribute_offsets == NULL)) ||
+        (per_instance_attr_count > 0 &&
+         (per_instance_attributes == NULL || per_instance_attribute_offsets == NULL)))
+    {
+        free(per_vertex_attributes);
+        free(per_instance_attributes);
+        free(per_vertex_attribute_offsets);
+        free(per_instance_attribute_offsets);
+        return false;
+    }
+
+    DivisionVertexBufferPoolInternalPlatform_ pool = {
+        .per_vertex_attributes = per_vertex_attributes,
+        .per_instance_attributes = per_instance_attributes,
+        .per_vertex_attribute_offsets = per_vertex_attribute_offsets,
+        .per_instance_attribute_offsets = per_instance_attribute_offsets,
+        .per_vertex_attribute_count = per_vertex_attr_count,
+        .per_instance_attribute_count = per_instance_attr_count,
+        .per_vertex_data_size = vertex_buffer->per_vertex_data_size,
+        .per_instance_data_size = vertex_buffer->per_instance_data_size,
+        .index_size = division_engine_vertex_buffer_index_size(vertex_buffer),
+    };
+    if (per_vertex_attr_count > 0)
+    {
+        memcpy(
+            pool.per_vertex_attributes,
+            vb_settings->per_vertex_attributes,
+            sizeof(DivisionVertexAttributeSettings[pool.per_vertex_attribute_count])
+        );
+        memcpy(
+            pool.per_vertex_attribute_offsets,
+            vertex_buffer->per_vertex_attributes,
+            sizeof(DivisionVertexAttribute[pool.per_vertex_attribute_count])
+        );
+    }
+    if (per_instance_attr_count > 0)
+    {
+        memcpy(
+            pool.per_instance_attributes,
+            vb_settings->per_instance_attributes,
+            sizeof(DivisionVertexAttributeSettings[pool.per_instance_attribute_count])
+        );
+        memcpy(
+            pool.per_instance_attribute_offsets,
+            vertex_buffer->per_instance_attributes,
+            sizeof(DivisionVertexAttribute[pool.per_instance_attribute_count])
+        );
+    }
+
+    division_free_list_allocator_alloc(&pool.vertex_allocator, 0);
+    division_free_list_allocator_alloc(&pool.instance_allocator, 0);
+    division_free_list_allocator_alloc(&pool.index_allocator, 0);
+
+    glCreateVertexArrays(1, &pool.gl_vao);
+    glCreateBuffers(1, &pool.gl_vbo);
+    glCreateBuffers(1, &pool.gl_instance_vbo);
+    glCreateBuffers(1, &pool.gl_index_buffer);
+
+    set_pool_attribute_formats_(
+        ctx,
+        pool.gl_vao,
+        vertex_buffer->per_vertex_attributes,
+        vb_settings->per_vertex_attributes,
+        vb_settings->per_vertex_attribute_count,
+        VERTEX_POOL_VERTEX_BINDING
+    );
+
+    if (vb_settings->per_instance_attribute_count > 0)
+    {
+        set_pool_attribute_formats_(
+            ctx,
+            pool.gl_vao,
+            vertex_buffer->per_instance_attributes,
+            vb_settings->per_instance_attributes,
+            vb_settings->per_instance_attribute_count,
+            VERTEX_POOL_INSTANCE_BINDING
+        );
+        glVertexArrayBindingDivisor(pool.gl_vao, VERTEX_POOL_INSTANCE_BINDING, 1);
+    }
+
+    *out_pool_id = (int32_t) vertex_ctx->pools_count;
+    vertex_ctx->pools_impl[vertex_ctx->pools_count] = pool;
+    vertex_ctx->pools_count = new_pools_count;
+
+    return true;
+}
+
+bool is_pool_layout_equal_(
+    const DivisionVertexBufferPoolInternalPlatform_* pool,
+    const DivisionVertexBuffer* vertex_buffer
+)
+{
+    const DivisionVertexBufferSettings* vb_settings = &vertex_buffer->settings;
+
+    return pool->per_vertex_attribute_count == vb_settings->per_vertex_attribute_count &&
+           pool->per_instance_attribute_count ==
+               vb_settings->per_instance_attribute_count &&
+           pool->per_vertex_data_size == vertex_buffer->per_vertex_data_size &&
+           pool->per_instance_data_size == vertex_buffer->per_instance_data_size &&
+           pool->index_size == division_engine_vertex_buffer_index_size(vertex_buffer) &&
+           memcmp(
+               pool->per_vertex_attributes,
+               vb_settings->per_vertex_attributes,
+               sizeof(DivisionVertexAttributeSettings[pool->per_vertex_attribute_count])
+           ) == 0 &&
+           memcmp(
+               pool->per_instance_attributes,
+               vb_settings->per_instance_attributes,
+               sizeof(DivisionVertexAttributeSettings[pool->per_instance_attribute_count])
+           ) == 0 &&
+           memcmp(
+               pool->per_vertex_attribute_offsets,
+               vertex_buffer->per_vertex_attributes,
+               sizeof(DivisionVertexAttribute[pool->per_vertex_attribute_count])
+           ) == 0 &&
+           memcmp(
+               pool->per_instance_attribute_offsets,
+               vertex_buffer->per_instance_attributes,
+               sizeof(DivisionVertexAttribute[pool->per_instance_attribute_count])
+           ) == 0;
+}
+
+void set_pool_attribute_formats_(
+    DivisionContext* ctx,
+    GLuint gl_vao,
+    const DivisionVertexAttribute* attributes,
+    const DivisionVertexAttributeSettings* attribute_settings,
+    int32_t attribute_count,
+    GLuint binding
+)
+{
+    for (int32_t i = 0; i < attribute_count; i++)
+    {
+        const DivisionVertexAttribute* at = &attributes[i];
+        const DivisionVertexAttributeSettings* setting = &attribute_settings[i];
+        GlAttrTraits_ gl_attr_traits = get_gl_attr_traits(ctx, setting->type);
+        int gl_comp_count = at->component_count / gl_attr_traits.divide_by_components;
+        size_t gl_comp_size = gl_comp_count * at->base_size;
+
+        if (gl_attr_traits.packed_component_count > 0)
+        {
+            gl_comp_count = gl_attr_traits.packed_component_count;
+        }
+
+        for (int comp_idx = 0; comp_idx < gl_attr_traits.divide_by_components; comp_idx++)
+        {
+            GLuint gl_location = setting->location + comp_idx;
+
+            glEnableVertexArrayAttrib(gl_vao, gl_location);
+            glVertexArrayAttribFormat(
+                gl_vao,
+                gl_location,
+                gl_comp_count,
+                gl_attr_traits.type,
+                gl_attr_traits.normalized,
+                (GLuint) (at->offset + comp_idx * gl_comp_size)
+            );
+            glVertexArrayAttribBinding(gl_vao, gl_location, binding);
+        }
+    }
+}
+
+bool pool_alloc_range_(
+    DivisionFreeListAllocator* allocator,
+    GLuint* gl_buffer,
+    size_t element_size,
+    uint32_t element_count,
+    uint32_t min_capacity,
+    uint32_t* out_offset
+)
+{
+    if (division_free_list_allocator_alloc_range(allocator, element_count, out_offset))
+    {
+        return true;
+    }
+
+    uint64_t old_capacity = allocator->capacity;
+    uint64_t new_capacity = DIVISION_MAX(old_capacity * 2, old_capacity + element_count);
+    new_capacity = DIVISION_MAX(new_capacity, min_capacity);
+    if (new_capacity > UINT32_MAX)
+    {
+        return false;
+    }
+
+    GLuint new_buffer;
+    glCreateBuffers(1, &new_buffer);
+    glNamedBufferData(
+        new_buffer, (GLsizeiptr) (new_capacity * element_size), NULL, GL_DYNAMIC_DRAW
+    );
+
+    if (old_capacity > 0)
+    {
+        glCopyNamedBufferSubData(
+            *gl_buffer, new_buffer, 0, 0, (GLsizeiptr) (old_capacity * element_size)
+        );
+    }
+
+    glDeleteBuffers(1, gl_buffer);
+    *gl_buffer = new_buffer;
+
+    division_free_list_allocator_grow(allocator, (uint32_t) new_capacity);
+    return division_free_list_allocator_alloc_range(allocator, element_count, out_offset);
+}
+
+void attach_pool_buffers_(const DivisionVertexBufferPoolInternalPlatform_* pool)
+{
+    glVertexArrayVertexBuffer(
+        pool->gl_vao,
+        VERTEX_POOL_VERTEX_BINDING,
+        pool->gl_vbo,
+        0,
+        (GLsizei) pool->per_vertex_data_size
+    );
+
+    if (pool->per_instance_attribute_count > 0)
+    {
+        glVertexArrayVertexBuffer(
+            pool->gl_vao,
+            VERTEX_POOL_INSTANCE_BINDING,
+            pool->gl_instance_vbo,
+            0,
+            (GLsizei) pool->per_instance_data_size
+        );
+    }
+
+    glVertexArrayElementBuffer(pool->gl_vao, pool->gl_index_buffer);
+}
+
+void free_pool_(DivisionVertexBufferPoolInternalPlatform_* pool)
+{
+    glDeleteVertexArrays(1, &pool->gl_vao);
+    glDeleteBuffers(1, &pool->gl_vbo);
+    glDeleteBuffers(1, &pool->gl_instance_vbo);
+    glDeleteBuffers(1, &pool->gl_index_buffer);
+
+    division_free_list_allocator_free(&pool->vertex_allocator);
+    division_free_list_allocator_free(&pool->instance_allocator);
+    division_free_list_allocator_free(&pool->index_allocator);
+
+    free(pool->per_vertex_attributes);
+    free(pool->per_instance_attributes);
+    free(pool->per_vertex_attribute_offsets);
+    free(pool->per_instance_attribute_offsets);
+}
+
+DivisionGlBufferRange_ division_glfw_vertex_buffer_vertices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBuffer* vb = &vb_ctx->buffers[buffer_id];
+    const DivisionVertexBufferInternalPlatform_* vb_impl =
+        &vb_ctx->buffers_impl[buffer_id];
+
+    if (vb_impl->pool_id == DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        return (DivisionGlBufferRange_){vb_impl->gl_vbo, 0};
+    }
+
+    return (DivisionGlBufferRange_){
+        vb_ctx->pools_impl[vb_impl->pool_id].gl_vbo,
+        vb_impl->base_vertex * vb->per_vertex_data_size,
+    };
+}
+
+DivisionGlBufferRange_ division_glfw_vertex_buffer_instances_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBuffer* vb = &vb_ctx->buffers[buffer_id];
+    const DivisionVertexBufferInternalPlatform_* vb_impl =
+        &vb_ctx->buffers_impl[buffer_id];
+
+    if (vb_impl->pool_id == DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        return (DivisionGlBufferRange_){
+            vb_impl->gl_vbo,
+            division_engine_vertex_buffer_vertices_capacity_bytes(vb),
+        };
+    }
+
+    return (DivisionGlBufferRange_){
+        vb_ctx->pools_impl[vb_impl->pool_id].gl_instance_vbo,
+        vb_impl->base_instance * vb->per_instance_data_size,
+    };
+}
+
+DivisionGlBufferRange_ division_glfw_vertex_buffer_indices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBufferInternalPlatform_* vb_impl =
+        &vb_ctx->buffers_impl[buffer_id];
+
+    if (vb_impl->pool_id == DIVISION_GLFW_VERTEX_BUFFER_NO_POOL)
+    {
+        return (DivisionGlBufferRange_){vb_impl->gl_index_buffer, 0};
+    }
+
+    const DivisionVertexBufferPoolInternalPlatform_* pool =
+        &vb_ctx->pools_impl[vb_impl->pool_id];
+    return (DivisionGlBufferRange_){
+        pool->gl_index_buffer,
+        vb_impl->first_index * pool->index_size,
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "context.h"
+#include "types/binding_group.h"
+#include "types/render_pass_instance.h"
+#include "utility.h"
+
+#include "data_structures/unordered_id_table.h"
+
+#include <division_engine_core_export.h>
+
+typedef struct DivisionBindingGroupSystemContext
+{
+    DivisionUnorderedIdTable id_table;
+    DivisionBindingGroup* binding_groups;
+    struct DivisionBindingGroupInternalPlatform_* binding_groups_impl;
+    size_t binding_group_count;
+} DivisionBindingGroupSystemContext;
+
+bool division_engine_binding_group_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+);
+void division_engine_binding_group_system_context_free(DivisionContext* ctx);
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     *  Binding groups are immutable sets of the uniform buffers and textures of draws.
+     *  The binding arrays are copied and the platform resolves the resources once, so
+     *  an instance with DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP binds all
+     *  of them at once by the group id. The resources must outlive the group
+     */
+    DIVISION_EXPORT bool division_engine_binding_group_alloc(
+        DivisionContext* ctx,
+        const DivisionBindingGroup* binding_group,
+        uint32_t* out_binding_group_id
+    );
+
+    DIVISION_EXPORT void division_engine_binding_group_free(
+        DivisionContext* ctx, uint32_t binding_group_id
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+// Bindings of the instance, either from its binding group or from its own arrays
+static inline DivisionBindingGroup division_engine_render_pass_instance_bindings(
+    const DivisionContext* ctx, const DivisionRenderPassInstance* render_pass_instance
+)
+{
+    if (DIVISION_MASK_HAS_FLAG(
+            render_pass_instance->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+        ))
+    {
+        return ctx->binding_group_context
+            ->binding_groups[render_pass_instance->binding_group_id];
+    }
+
+    DivisionBindingGroup bindings;
+    bindings.uniform_vertex_buffers = render_pass_instance->uniform_vertex_buffers;
+    bindings.uniform_fragment_buffers = render_pass_instance->uniform_fragment_buffers;
+    bindings.fragment_textures = render_pass_instance->fragment_textures;
+    bindings.uniform_vertex_buffer_count =
+        render_pass_instance->uniform_vertex_buffer_count;
+    bindings.uniform_fragment_buffer_count =
+        render_pass_instance->uniform_fragment_buffer_count;
+    bindings.fragment_texture_count = render_pass_instance->fragment_texture_count;
+
+    return bindings;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "context.h"
+#include "types/binding_group.h"
+#include "types/capture.h"
+#include "types/color.h"
+#include "types/dirty_rects.h"
+#include "types/render_pass_descriptor.h"
+#include "types/render_pass_instance.h"
+#include "types/shader.h"
+#include "types/texture.h"
+#include "types/uniform_buffer.h"
+#include "types/upload_queue.h"
+#include "types/vertex_buffer.h"
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_CAPTURE_MAGIC 0x50435644u
+#define DIVISION_CAPTURE_VERSION 4
+// Every field of a record starts at the multiple of the alignment
+#define DIVISION_CAPTURE_ALIGNMENT 8
+
+/*
+ *  Capture file is the header and the records of the engine calls in their order.
+ *  Fields are written as the structs of the engine, so a capture is replayed by the
+ *  build of the same version and the same architecture
+ */
+typedef enum DivisionCaptureCommand
+{
+    DIVISION_CAPTURE_SHADER_PROGRAM_ALLOC = 1,
+    DIVISION_CAPTURE_SHADER_PROGRAM_FREE = 2,
+    DIVISION_CAPTURE_VERTEX_BUFFER_ALLOC = 3,
+    DIVISION_CAPTURE_VERTEX_BUFFER_FREE = 4,
+    DIVISION_CAPTURE_VERTEX_BUFFER_RESIZE = 5,
+    DIVISION_CAPTURE_VERTEX_BUFFER_DATA = 6,
+    DIVISION_CAPTURE_UNIFORM_BUFFER_ALLOC = 7,
+    DIVISION_CAPTURE_UNIFORM_BUFFER_FREE = 8,
+    DIVISION_CAPTURE_UNIFORM_BUFFER_DATA = 9,
+    DIVISION_CAPTURE_UNIFORM_BUFFER_UPDATE = 10,
+    DIVISION_CAPTURE_TEXTURE_ALLOC = 11,
+    DIVISION_CAPTURE_TEXTURE_FREE = 12,
+    DIVISION_CAPTURE_TEXTURE_DATA = 13,
+    DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_ALLOC = 14,
+    DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_FREE = 15,
+    DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_UPDATE = 16,
+    DIVISION_CAPTURE_BINDING_GROUP_ALLOC = 17,
+    DIVISION_CAPTURE_BINDING_GROUP_FREE = 18,
+    DIVISION_CAPTURE_UPLOAD = 19,
+    DIVISION_CAPTURE_UPLOAD_FLUSH = 20,
+    DIVISION_CAPTURE_UNIFORM_RING_DATA = 21,
+    DIVISION_CAPTURE_SUBMIT = 22,
+    DIVISION_CAPTURE_BEGIN_FRAME = 23,
+    DIVISION_CAPTURE_END_FRAME = 24,
+    DIVISION_CAPTURE_MARK_DIRTY = 25,
+} DivisionCaptureCommand;
+
+typedef struct DivisionCaptureFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+} DivisionCaptureFileHeader;
+
+typedef struct DivisionCaptureRecordHeader
+{
+    uint64_t payload_size;
+    uint32_t command;
+    uint32_t reserved;
+} DivisionCaptureRecordHeader;
+
+// Capture is active while the file is open
+typedef struct DivisionCaptureSystemContext
+{
+    FILE* file;
+
+    // Payload of the record being written
+    uint8_t* record;
+    size_t record_size;
+    size_t record_capacity;
+    bool record_failed;
+} DivisionCaptureSystemContext;
+
+// Starts the capture, if the settings have the capture path
+bool division_engine_capture_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+);
+void division_engine_capture_system_context_free(DivisionContext* ctx);
+
+/*
+ *  Calls of the engine, recorded after they have succeeded. Resources are recorded
+ *  with their ids, the replay checks that the same ids are given back.
+ *  Calls do nothing, when the capture isn't active
+ */
+void division_engine_capture_shader_program_alloc(
+    DivisionContext* ctx,
+    const DivisionShaderSourceDescriptor* descriptors,
+    int32_t descriptor_count,
+    uint32_t shader_program_id
+);
+
+// Records the free and the other calls, which have only the resource id
+void division_engine_capture_resource_command(
+    DivisionContext* ctx, DivisionCaptureCommand command, uint32_t resource_id
+);
+
+void division_engine_capture_upload_flush(DivisionContext* ctx);
+
+// The layout is taken from the allocated buffer, so every alloc variant is recorded
+void division_engine_capture_vertex_buffer_alloc(
+    DivisionContext* ctx, uint32_t vertex_buffer_id
+);
+void division_engine_capture_vertex_buffer_resize(
+    DivisionContext* ctx, uint32_t vertex_buffer_id, DivisionVertexBufferSize new_size
+);
+void division_engine_capture_vertex_buffer_data(
+    DivisionContext* ctx,
+    uint32_t vertex_buffer_id,
+    const DivisionVertexBufferSize* size,
+    const void* vertex_data,
+    const void* index_data,
+    const void* instance_data
+);
+
+void division_engine_capture_uniform_buffer_alloc(
+    DivisionContext* ctx, DivisionUniformBufferDescriptor buffer, uint32_t buffer_id
+);
+void division_engine_capture_uniform_buffer_update(
+    DivisionContext* ctx,
+    DivisionCaptureCommand command,
+    uint32_t buffer_id,
+    size_t offset,
+    const void* data,
+    size_t size
+);
+
+void division_engine_capture_texture_alloc(
+    DivisionContext* ctx, const DivisionTexture* texture, uint32_t texture_id
+);
+void division_engine_capture_texture_data(
+    DivisionContext* ctx, uint32_t texture_id, const void* data
+);
+
+void division_engine_capture_render_pass_descriptor(
+    DivisionContext* ctx,
+    DivisionCaptureCommand command,
+    uint32_t render_pass_id,
+    const DivisionRenderPassDescriptor* render_pass
+);
+
+void division_engine_capture_binding_group_alloc(
+    DivisionContext* ctx, const DivisionBindingGroup* binding_group, uint32_t group_id
+);
+
+void division_engine_capture_upload(
+    DivisionContext* ctx,
+    const DivisionUploadStaging* staging,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t dst_offset
+);
+
+void division_engine_capture_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+);
+
+// Records the uniform ring data of the frame so far, then the instances
+void division_engine_capture_submit(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instances,
+    uint32_t render_pass_instance_count
+);
+
+void division_engine_capture_end_frame(DivisionContext* ctx);
+
+void division_engine_capture_mark_dirty(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+);
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     *  Re-executes the capture on the context as fast as possible, without the run
+     *  loop. The context must be fresh, so the replayed resources get the captured
+     *  ids. Shaders are replayed from the captured sources, so the capture is
+     *  replayed by the platform it was made on, or by a platform which doesn't
+     *  compile shaders. Uniform ring bindings keep the offset alignment of the
+     *  capturing device. Returns false if the file is broken or a call has failed,
+     *  the stats count the commands replayed before the failure then
+     */
+    DIVISION_EXPORT bool division_engine_capture_replay(
+        DivisionContext* ctx, const char* path, DivisionCaptureReplayStats* out_stats
+    );
+
+#ifdef __cplusplus
+}
+#endif
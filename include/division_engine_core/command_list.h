@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "context.h"
+#include "types/color.h"
+#include "types/command_list.h"
+#include "types/id.h"
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_COMMAND_LIST_MAX_BINDINGS 16
+#define DIVISION_COMMAND_LIST_NO_DESCRIPTOR UINT32_MAX
+#define DIVISION_COMMAND_LIST_NO_BINDING_GROUP UINT32_MAX
+#define DIVISION_COMMAND_LIST_DATA_ALIGNMENT 8
+
+/*
+ *  Command lists record draws and data copies without touching the context or the
+ *  graphics API, so every thread can fill its own list at the same time. A list is
+ *  recorded by one thread at a time and is submitted on the render thread after the
+ *  recording is finished. The resources used by the commands are created beforehand.
+ *
+ *  Draws take the render pass descriptor and the bindings set by the last bind calls.
+ *  Bindings and copied bytes are stored in the list, so the recorded pointers don't
+ *  have to outlive the recording. Reset keeps the memory of the list, so recording
+ *  doesn't allocate after the list has grown to the size of the frame
+ */
+typedef struct DivisionCommandList
+{
+    DivisionCommand* commands;
+    size_t command_count;
+    size_t command_capacity;
+
+    // Binding sets of the draws and the bytes of the copies
+    uint8_t* data;
+    size_t data_size;
+    size_t data_capacity;
+
+    uint32_t draw_count;
+
+    uint32_t render_pass_descriptor_id;
+    DivisionIdWithBinding uniform_vertex_buffers[DIVISION_COMMAND_LIST_MAX_BINDINGS];
+    DivisionIdWithBinding uniform_fragment_buffers[DIVISION_COMMAND_LIST_MAX_BINDINGS];
+    DivisionIdWithBinding fragment_textures[DIVISION_COMMAND_LIST_MAX_BINDINGS];
+    int32_t uniform_vertex_buffer_count;
+    int32_t uniform_fragment_buffer_count;
+    int32_t fragment_texture_count;
+    uint32_t binding_group_id;
+
+    // The last stored binding set is reused by the draws until the bindings change
+    size_t bindings_offset;
+    bool bindings_dirty;
+} DivisionCommandList;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT bool division_command_list_alloc(
+        DivisionCommandList* list, size_t command_capacity, size_t data_capacity
+    );
+    DIVISION_EXPORT void division_command_list_free(DivisionCommandList* list);
+
+    // Removes the commands and the bindings, but keeps the memory
+    DIVISION_EXPORT void division_command_list_reset(DivisionCommandList* list);
+
+    DIVISION_EXPORT void division_command_list_bind_render_pass_descriptor(
+        DivisionCommandList* list, uint32_t render_pass_descriptor_id
+    );
+
+    /*
+     *  Binding to a shader location which is already bound replaces the resource.
+     *  Returns false if there are DIVISION_COMMAND_LIST_MAX_BINDINGS bindings already
+     */
+    DIVISION_EXPORT bool division_command_list_bind_uniform_vertex_buffer(
+        DivisionCommandList* list, DivisionIdWithBinding buffer_binding
+    );
+    DIVISION_EXPORT bool division_command_list_bind_uniform_fragment_buffer(
+        DivisionCommandList* list, DivisionIdWithBinding buffer_binding
+    );
+    DIVISION_EXPORT bool division_command_list_bind_fragment_texture(
+        DivisionCommandList* list, DivisionIdWithBinding texture_binding
+    );
+
+    // While a binding group is bound, the draws take it instead of the other bindings
+    DIVISION_EXPORT void division_command_list_bind_binding_group(
+        DivisionCommandList* list, uint32_t binding_group_id
+    );
+
+    /*
+     *  Removes the buffer and texture bindings and the binding group,
+     *  the render pass descriptor stays bound
+     */
+    DIVISION_EXPORT void division_command_list_clear_bindings(DivisionCommandList* list);
+
+    // Returns false if no render pass descriptor is bound or the list failed to grow
+    DIVISION_EXPORT bool division_command_list_draw(
+        DivisionCommandList* list, const DivisionCommandDrawRange* draw_range
+    );
+
+    /*
+     *  Copies the bytes to the target of the upload queue (see upload_queue.h),
+     *  the data is stored in the list and can be reused right after the call.
+     *  Returns false if the data is NULL while the size is not zero
+     */
+    DIVISION_EXPORT bool division_command_list_copy(
+        DivisionCommandList* list,
+        DivisionUploadTarget target,
+        uint32_t resource_id,
+        size_t dst_offset,
+        const void* data,
+        size_t size
+    );
+
+    DIVISION_EXPORT bool division_command_list_set_uniform_data(
+        DivisionCommandList* list,
+        uint32_t uniform_buffer_id,
+        size_t dst_offset,
+        const void* data,
+        size_t size
+    );
+
+    /*
+     *  Replays the lists in their order on the render thread inside of one frame,
+     *  cleared with the color. The draws recorded before a copy are submitted before
+     *  it is enqueued to the upload queue, so every draw sees the data of the copies
+     *  recorded before it only. The draws between the copies go to a single
+     *  division_engine_render_pass_instance_submit. Must not be called inside of
+     *  a begun frame
+     */
+    DIVISION_EXPORT void division_engine_command_list_submit(
+        DivisionContext* ctx,
+        const DivisionColor* clear_color,
+        const DivisionCommandList* command_lists,
+        uint32_t command_list_count
+    );
+
+#ifdef __cplusplus
+}
+#endif
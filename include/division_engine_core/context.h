@@ -21,6 +21,10 @@ struct DivisionRenderPassSystemContext;
 struct DivisionTextureSystemContext;
 struct DivisionInputSystemContext;
 struct DivisionFontSystemContext;
+struct DivisionUploadQueueSystemContext;
+struct DivisionBindingGroupSystemContext;
+struct DivisionProfilerSystemContext;
+struct DivisionCaptureSystemContext;
 
 typedef struct DivisionContext
 {
@@ -35,6 +39,10 @@ typedef struct DivisionContext
     struct DivisionRenderPassSystemContext* render_pass_context;
     struct DivisionInputSystemContext* input_context;
     struct DivisionFontSystemContext* font_context;
+    struct DivisionUploadQueueSystemContext* upload_queue_context;
+    struct DivisionBindingGroupSystemContext* binding_group_context;
+    struct DivisionProfilerSystemContext* profiler_context;
+    struct DivisionCaptureSystemContext* capture_context;
 
     void* user_data;
 } DivisionContext;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "division_engine_core_export.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    The data structure manages ranges of some linear storage (e.g. a big GPU buffer).
+    It doesn't own the storage itself, it only tracks which parts of it are free.
+    Free ranges are kept sorted by offset, allocation is first fit and freed ranges
+    are merged with their neighbours
+*/
+typedef struct DivisionFreeListRange
+{
+    uint32_t offset;
+    uint32_t size;
+} DivisionFreeListRange;
+
+typedef struct DivisionFreeListAllocator
+{
+    DivisionFreeListRange* free_ranges;
+    size_t free_ranges_count;
+    size_t free_ranges_capacity;
+    uint32_t capacity;
+} DivisionFreeListAllocator;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT void division_free_list_allocator_alloc(
+        DivisionFreeListAllocator* allocator, uint32_t capacity
+    );
+    DIVISION_EXPORT void division_free_list_allocator_free(
+        DivisionFreeListAllocator* allocator
+    );
+
+    DIVISION_EXPORT bool division_free_list_allocator_alloc_range(
+        DivisionFreeListAllocator* allocator, uint32_t size, uint32_t* out_offset
+    );
+    DIVISION_EXPORT void division_free_list_allocator_free_range(
+        DivisionFreeListAllocator* allocator, uint32_t offset, uint32_t size
+    );
+
+    // Appends [capacity, new_capacity) to the managed storage
+    DIVISION_EXPORT void division_free_list_allocator_grow(
+        DivisionFreeListAllocator* allocator, uint32_t new_capacity
+    );
+
+    // Returns true if no range is allocated
+    DIVISION_EXPORT bool division_free_list_allocator_is_empty(
+        const DivisionFreeListAllocator* allocator
+    );
+
+#ifdef __cplusplus
+}
+#endif
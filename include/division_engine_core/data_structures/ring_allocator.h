@@ -0,0 +1,51 @@
+#pragma once
+
+#include "division_engine_core_export.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    The data structure manages a circular storage (e.g. a persistently mapped staging
+    buffer), where ranges are allocated at the head and released in the same order
+    from the tail. Head and tail are monotonic positions, the offset in the storage is
+    the position modulo capacity. An allocation never wraps around the end of the
+    storage, the rest of the storage is skipped instead
+*/
+typedef struct DivisionRingAllocator
+{
+    uint64_t head;
+    uint64_t tail;
+    size_t capacity;
+} DivisionRingAllocator;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT void division_ring_allocator_init(
+        DivisionRingAllocator* allocator, size_t capacity
+    );
+
+    // Alignment must be a power of two
+    DIVISION_EXPORT bool division_ring_allocator_alloc_range(
+        DivisionRingAllocator* allocator,
+        size_t size,
+        size_t alignment,
+        size_t* out_offset
+    );
+
+    // Releases every range allocated before the head was at `position`
+    DIVISION_EXPORT void division_ring_allocator_release(
+        DivisionRingAllocator* allocator, uint64_t position
+    );
+
+    DIVISION_EXPORT size_t division_ring_allocator_used_size(
+        const DivisionRingAllocator* allocator
+    );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "types/dirty_rects.h"
+
+#include <division_engine_core_export.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     *  Adds the rectangle clipped by the frame size to the set of the disjoint ones.
+     *  Overlapping rectangles are replaced by their bounds. If the set is full, the
+     *  rectangle is merged with the one which grows the covered area the least.
+     *  Empty rectangles are ignored. The set holds DIVISION_DIRTY_RECT_CAPACITY of them
+     */
+    DIVISION_EXPORT void division_dirty_rects_add(
+        DivisionDirtyRect* rects,
+        uint32_t* rect_count,
+        DivisionDirtyRect rect,
+        int32_t frame_width,
+        int32_t frame_height
+    );
+
+    // Pixels covered by the disjoint rectangles
+    DIVISION_EXPORT uint64_t division_dirty_rects_area(
+        const DivisionDirtyRect* rects, uint32_t rect_count
+    );
+
+#ifdef __cplusplus
+}
+#endif
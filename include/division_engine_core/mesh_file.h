@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types/vertex_buffer.h"
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_MESH_FILE_MAGIC 0x48534D44u // "DMSH"
+#define DIVISION_MESH_FILE_VERSION 1
+#define DIVISION_MESH_FILE_BLOB_ALIGNMENT 16
+
+/*
+ *  Binary mesh container, which is uploaded to a vertex buffer without parsing:
+ *  1. DivisionMeshFileHeader
+ *  2. per vertex, then per instance DivisionMeshFileAttribute records
+ *  3. vertex, index and instance data blobs, each aligned to
+ *     DIVISION_MESH_FILE_BLOB_ALIGNMENT bytes, in the layout of the vertex buffer data
+ *  All values are in the native byte order
+ */
+typedef struct DivisionMeshFileAttribute
+{
+    int32_t type;
+    int32_t location;
+} DivisionMeshFileAttribute;
+
+typedef struct DivisionMeshFileBlob
+{
+    uint64_t offset;
+    uint64_t size;
+} DivisionMeshFileBlob;
+
+typedef struct DivisionMeshFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t instance_count;
+    int32_t topology;
+    uint32_t capabilities_mask;
+    int32_t per_vertex_attribute_count;
+    int32_t per_instance_attribute_count;
+    uint32_t reserved;
+    DivisionMeshFileBlob vertices;
+    DivisionMeshFileBlob indices;
+    DivisionMeshFileBlob instances;
+} DivisionMeshFileHeader;
+
+// Source of the writer, data sizes are in bytes
+typedef struct DivisionMeshFileData
+{
+    DivisionVertexBufferConstSettings settings;
+    const void* vertex_data;
+    const void* index_data;
+    const void* instance_data;
+    size_t vertex_data_size;
+    size_t index_data_size;
+    size_t instance_data_size;
+} DivisionMeshFileData;
+
+// Validated view of the memory mapped file
+typedef struct DivisionMeshFile
+{
+    const DivisionMeshFileHeader* header;
+    const DivisionMeshFileAttribute* per_vertex_attributes;
+    const DivisionMeshFileAttribute* per_instance_attributes;
+    const void* vertex_data;
+    const void* index_data;
+    const void* instance_data;
+
+    void* mapping;
+    size_t mapping_size;
+} DivisionMeshFile;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT bool division_mesh_file_write(
+        const char* path, const DivisionMeshFileData* data
+    );
+
+    // The file stays mapped until division_mesh_file_unmap
+    DIVISION_EXPORT bool division_mesh_file_map(
+        const char* path, DivisionMeshFile* out_file
+    );
+
+    DIVISION_EXPORT void division_mesh_file_unmap(DivisionMeshFile* file);
+
+#ifdef __cplusplus
+}
+#endif
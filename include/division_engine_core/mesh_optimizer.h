@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_MESH_DEFAULT_CACHE_SIZE 16
+#define DIVISION_MESH_DEFAULT_OVERDRAW_THRESHOLD 1.05f
+#define DIVISION_MESH_UNUSED_VERTEX UINT32_MAX
+
+/*
+ *  Post-transform vertex cache statistics, measured with a FIFO cache simulation.
+ *  acmr - average cache miss ratio, transformed vertices per triangle (0.5 - 3)
+ *  atvr - average transformed vertex ratio, transformed vertices per used vertex (1 - 6)
+ */
+typedef struct DivisionMeshCacheStats
+{
+    float acmr;
+    float atvr;
+    uint32_t transformed_vertex_count;
+} DivisionMeshCacheStats;
+
+typedef struct DivisionMeshOptimizeReport
+{
+    DivisionMeshCacheStats before;
+    DivisionMeshCacheStats after;
+    size_t vertex_count;
+} DivisionMeshOptimizeReport;
+
+/*
+ *  CPU side optimizations of triangle lists before the upload to the vertex buffer.
+ *  All functions are deterministic. Index arrays are triangle lists of uint32_t,
+ *  optimizations return false if the index count isn't a multiple of 3.
+ *  Destination and source index arrays can be the same unless noted otherwise.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT DivisionMeshCacheStats division_mesh_analyze_vertex_cache(
+        const uint32_t* indices,
+        size_t index_count,
+        size_t vertex_count,
+        uint32_t cache_size
+    );
+
+    // Reorders triangles for the post-transform vertex cache with the Tipsify algorithm
+    DIVISION_EXPORT bool division_mesh_optimize_vertex_cache(
+        uint32_t* dst_indices,
+        const uint32_t* indices,
+        size_t index_count,
+        size_t vertex_count,
+        uint32_t cache_size
+    );
+
+    /*
+     *  Splits cache optimized triangles into clusters and sorts them, so the ones facing
+     *  outwards of the mesh are drawn first. The threshold limits the acmr loss, e.g.
+     *  1.05 allows the clusters to be 5% worse for the vertex cache.
+     *  Positions are 3 floats at the start of every `position_stride` bytes
+     */
+    DIVISION_EXPORT bool division_mesh_optimize_overdraw(
+        uint32_t* dst_indices,
+        const uint32_t* indices,
+        size_t index_count,
+        const float* positions,
+        size_t position_stride,
+        size_t vertex_count,
+        uint32_t cache_size,
+        float threshold
+    );
+
+    /*
+     *  Fills the remap table so the vertices are stored in the order they are first
+     *  referenced. Vertices without references get DIVISION_MESH_UNUSED_VERTEX.
+     *  Returns the count of the referenced vertices
+     */
+    DIVISION_EXPORT size_t division_mesh_optimize_vertex_fetch_remap(
+        uint32_t* dst_remap,
+        const uint32_t* indices,
+        size_t index_count,
+        size_t vertex_count
+    );
+
+    DIVISION_EXPORT void division_mesh_remap_indices(
+        uint32_t* dst_indices,
+        const uint32_t* indices,
+        size_t index_count,
+        const uint32_t* remap
+    );
+
+    // The destination must not overlap the source vertices
+    DIVISION_EXPORT void division_mesh_remap_vertices(
+        void* dst_vertices,
+        const void* vertices,
+        size_t vertex_count,
+        size_t vertex_size,
+        const uint32_t* remap
+    );
+
+    /*
+     *  Runs the vertex cache, overdraw and vertex fetch optimizations in place.
+     *  Positions are 3 floats at `position_offset` bytes of every vertex.
+     *  Unused vertices are removed, the new vertex count is written to the report
+     */
+    DIVISION_EXPORT bool division_mesh_optimize(
+        uint32_t* indices,
+        size_t index_count,
+        void* vertices,
+        size_t vertex_count,
+        size_t vertex_size,
+        size_t position_offset,
+        DivisionMeshOptimizeReport* out_report
+    );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "context.h"
+#include "types/profiler.h"
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_PROFILER_MAX_LABELS 64
+#define DIVISION_PROFILER_MAX_SCOPES 256
+#define DIVISION_PROFILER_MAX_DEPTH 16
+// Count of the frames, which timings are kept for every label
+#define DIVISION_PROFILER_HISTORY_FRAMES 8
+// Frames recorded before the GPU timers of the oldest one are awaited
+#define DIVISION_PROFILER_QUERY_FRAMES 4
+#define DIVISION_PROFILER_NO_SCOPE UINT32_MAX
+
+#define DIVISION_PROFILER_LABEL_DRAW_CALLBACK 0
+#define DIVISION_PROFILER_LABEL_SUBMIT 1
+
+/*
+ *  Profiler scopes are compiled only with DIVISION_PROFILER_ENABLED,
+ *  so the instrumentation costs nothing in the other builds
+ */
+#if DIVISION_PROFILER_ENABLED
+#define DIVISION_PROFILER_BEGIN(ctx, label_id) \
+    division_engine_profiler_begin(ctx, label_id)
+#define DIVISION_PROFILER_END(ctx) division_engine_profiler_end(ctx)
+#else
+#define DIVISION_PROFILER_BEGIN(ctx, label_id) ((void) 0)
+#define DIVISION_PROFILER_END(ctx) ((void) 0)
+#endif
+
+typedef struct DivisionProfilerScope
+{
+    uint32_t label_id;
+    double cpu_begin_ms;
+    double cpu_end_ms;
+} DivisionProfilerScope;
+
+// Scopes of a recorded frame, which GPU timers may be still running
+typedef struct DivisionProfilerFrame
+{
+    DivisionProfilerScope scopes[DIVISION_PROFILER_MAX_SCOPES];
+    uint32_t scope_count;
+} DivisionProfilerFrame;
+
+typedef struct DivisionProfilerSystemContext
+{
+    bool enabled;
+    bool has_gpu_timers;
+
+    const char* labels[DIVISION_PROFILER_MAX_LABELS];
+    uint32_t label_count;
+
+    DivisionProfilerFrame frames[DIVISION_PROFILER_QUERY_FRAMES];
+    uint64_t recorded_frame_count;
+    uint64_t resolved_frame_count;
+
+    // Indices of the open scopes in the current frame, the innermost last
+    uint32_t open_scopes[DIVISION_PROFILER_MAX_DEPTH];
+    uint32_t open_scope_count;
+    // Scopes opened above DIVISION_PROFILER_MAX_DEPTH, they are closed first
+    uint32_t overflow_scope_count;
+
+    DivisionProfilerTiming history[DIVISION_PROFILER_HISTORY_FRAMES]
+                                  [DIVISION_PROFILER_MAX_LABELS];
+
+    struct DivisionProfilerInternalPlatform_* profiler_impl;
+} DivisionProfilerSystemContext;
+
+bool division_engine_profiler_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+);
+
+void division_engine_profiler_system_context_free(DivisionContext* ctx);
+
+// Resolves the timings of the finished frames, called after every draw callback
+void division_engine_profiler_end_frame(DivisionContext* ctx);
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Disabled profiler records nothing, the recorded frames are dropped on a switch
+    DIVISION_EXPORT void division_engine_profiler_set_enabled(
+        DivisionContext* ctx, bool enabled
+    );
+
+    /*
+     *  The name isn't copied, it must outlive the context.
+     *  Returns false if there are DIVISION_PROFILER_MAX_LABELS labels already
+     */
+    DIVISION_EXPORT bool division_engine_profiler_register_label(
+        DivisionContext* ctx, const char* name, uint32_t* out_label_id
+    );
+
+    /*
+     *  CPU and GPU time between begin and end is added to the label. Scopes are
+     *  nested and are used on the render thread. Prefer DIVISION_PROFILER_BEGIN and
+     *  DIVISION_PROFILER_END, they are compiled out without the profiler
+     */
+    DIVISION_EXPORT void division_engine_profiler_begin(
+        DivisionContext* ctx, uint32_t label_id
+    );
+    DIVISION_EXPORT void division_engine_profiler_end(DivisionContext* ctx);
+
+    /*
+     *  Writes the timings of the label for the last resolved frames, the oldest
+     *  first. GPU timers are read a few frames later without waiting, so the last
+     *  frames are not resolved yet. Returns the count of the written timings
+     */
+    DIVISION_EXPORT uint32_t division_engine_profiler_get_timings(
+        DivisionContext* ctx,
+        uint32_t label_id,
+        DivisionProfilerTiming* out_timings,
+        uint32_t max_timing_count
+    );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_RADIX_SORT_BITS 8
+#define DIVISION_RADIX_SORT_BUCKET_COUNT (1 << DIVISION_RADIX_SORT_BITS)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     *  Stable LSD radix sort of 64 bit keys in ascending order, the values are moved
+     *  with their keys. Temporary arrays hold `count` elements each, the result is
+     *  always written back to `keys` and `values`.
+     *  Passes over the bytes which are the same for every key are skipped
+     */
+    DIVISION_EXPORT void division_radix_sort_u64(
+        uint64_t* keys,
+        uint32_t* values,
+        uint64_t* tmp_keys,
+        uint32_t* tmp_values,
+        size_t count
+    );
+
+#ifdef __cplusplus
+}
+#endif
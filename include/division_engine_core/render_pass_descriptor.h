@@ -4,19 +4,94 @@
 #include <stdint.h>
 
 #include "context.h"
+#include "types/dirty_rects.h"
 #include "types/render_pass_descriptor.h"
+#include "types/render_pass_instance.h"
 
 #include "data_structures/ordered_id_table.h"
 #include "data_structures/unordered_id_table.h"
 
 #include <division_engine_core_export.h>
 
+// Pipeline state changes of the draws. Backends without state filtering leave them zero
+typedef struct DivisionRenderStateStats
+{
+    uint64_t issued_state_changes;
+    uint64_t skipped_state_changes;
+} DivisionRenderStateStats;
+
+typedef struct DivisionRenderMergeStats
+{
+    uint64_t submitted_draws;
+    uint64_t merged_draws;
+} DivisionRenderMergeStats;
+
+// Pixels of the last begun frame, which are cleared and drawn by it
+typedef struct DivisionRedrawStats
+{
+    uint32_t dirty_rect_count;
+    uint64_t touched_pixels;
+    uint64_t frame_pixels;
+    float touched_percent;
+} DivisionRedrawStats;
+
 typedef struct DivisionRenderPassSystemContext
 {
     DivisionUnorderedIdTable id_table;
     DivisionRenderPassDescriptor* render_pass_descriptors;
     struct DivisionRenderPassInternalPlatform_* render_passes_descriptors_impl;
+    // Descriptors of the same state share the id, it is freed by the last owner.
+    // Zero count marks the free slot
+    uint32_t* render_pass_hashes;
+    uint32_t* render_pass_ref_counts;
     int32_t render_pass_count;
+
+    // Open addressing map of the state hashes to the ids of the live descriptors.
+    // Buckets keep the id plus one, zero is the empty bucket
+    uint32_t* shared_buckets;
+    size_t shared_bucket_capacity;
+    size_t shared_bucket_count;
+
+    // State of the borrowed descriptor, which is restored if the returned one fails
+    DivisionRenderPassDescriptor borrowed_render_pass;
+    uint32_t borrowed_render_pass_id;
+    bool is_render_pass_borrowed;
+
+    // Platform state of the draw submission, e.g. the indirect command buffer
+    struct DivisionRenderPassDrawInternalPlatform_* draw_impl;
+    DivisionRenderStateStats state_stats;
+    DivisionRenderMergeStats merge_stats;
+
+    // Frame between division_engine_render_pass_instance_begin_frame and end_frame
+    DivisionFrameDescriptor frame;
+    bool frame_begun;
+
+    // Partial redraw mode of the settings. Rects marked for the next frame are moved
+    // to the frame ones by its beginning, the submits are drawn once for every rect
+    bool partial_redraw;
+    DivisionDirtyRect dirty_rects[DIVISION_DIRTY_RECT_CAPACITY];
+    uint32_t dirty_rect_count;
+    DivisionDirtyRect frame_dirty_rects[DIVISION_DIRTY_RECT_CAPACITY];
+    uint32_t frame_dirty_rect_count;
+    // Size of the kept contents, the whole frame is dirty after its change
+    int32_t redraw_width;
+    int32_t redraw_height;
+    DivisionRedrawStats redraw_stats;
+
+    // Scratch arrays of the sorted draws. Keys and indices have twice the capacity,
+    // the second half is the temporary storage of the radix sort
+    uint64_t* sort_keys;
+    uint32_t* sort_indices;
+    DivisionRenderPassInstance* sorted_instances;
+    size_t sort_capacity;
+
+    // Scratch array of the draws replayed from the command lists
+    DivisionRenderPassInstance* submit_instances;
+    size_t submit_capacity;
+
+    // Scratch array of the draws after merging
+    DivisionRenderPassInstance* merged_instances;
+    size_t merge_capacity;
 } DivisionRenderPassSystemContext;
 
 #define DIVISION_GET_RENDER_PASS_DESCRIPTOR(ctx, render_pass_id) \
@@ -33,19 +108,29 @@ extern "C"
 {
 #endif
 
+    // Returns the id of the allocated descriptor with the same state if there is one
     DIVISION_EXPORT bool division_engine_render_pass_descriptor_alloc(
         DivisionContext* ctx,
         const DivisionRenderPassDescriptor* render_pass_descriptor,
         uint32_t* out_render_pass_descriptor_id
     );
 
-    // TODO: delete
+    /*
+     *  TODO: delete
+     *  Returns NULL if the id is shared by several owners, whose state must not change,
+     *  or another descriptor is borrowed. Free the shared id and allocate the new state
+     *  instead of editing it
+     */
     DIVISION_EXPORT DivisionRenderPassDescriptor* division_engine_render_pass_descriptor_borrow(
         DivisionContext* ctx, uint32_t render_pass_id
     );
 
-    // TODO: delete
-    DIVISION_EXPORT void division_engine_render_pass_descriptor_return(
+    /*
+     *  TODO: delete
+     *  Returns false if the descriptor isn't borrowed or the platform rejects the new
+     *  state, the state of the borrow is restored then
+     */
+    DIVISION_EXPORT bool division_engine_render_pass_descriptor_return(
         DivisionContext* ctx,
         uint32_t render_pass_id,
         DivisionRenderPassDescriptor* render_pass_ptr
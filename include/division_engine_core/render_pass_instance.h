@@ -1,18 +1,109 @@
 #pragma once
 
 #include "types/color.h"
+#include "types/dirty_rects.h"
 #include "types/render_pass_instance.h"
+#include "types/vertex_buffer.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <division_engine_core/context.h>
 
+/*
+ *  Sort key bits from the most significant ones:
+ *  layer | translucent | shader | vertex buffer | descriptor | texture set | depth
+ *  Ids wider than their fields are truncated, it only makes the grouping worse
+ */
+#define DIVISION_RENDER_SORT_KEY_LAYER_BITS 8
+#define DIVISION_RENDER_SORT_KEY_TRANSLUCENT_BITS 1
+#define DIVISION_RENDER_SORT_KEY_SHADER_BITS 12
+#define DIVISION_RENDER_SORT_KEY_VERTEX_BUFFER_BITS 12
+#define DIVISION_RENDER_SORT_KEY_DESCRIPTOR_BITS 12
+#define DIVISION_RENDER_SORT_KEY_TEXTURE_SET_BITS 8
+#define DIVISION_RENDER_SORT_KEY_DEPTH_BITS 11
+
+#define DIVISION_RENDER_SORT_KEY_DEPTH_SHIFT 0
+#define DIVISION_RENDER_SORT_KEY_TEXTURE_SET_SHIFT                                      \
+    (DIVISION_RENDER_SORT_KEY_DEPTH_SHIFT + DIVISION_RENDER_SORT_KEY_DEPTH_BITS)
+#define DIVISION_RENDER_SORT_KEY_DESCRIPTOR_SHIFT                                       \
+    (DIVISION_RENDER_SORT_KEY_TEXTURE_SET_SHIFT +                                       \
+     DIVISION_RENDER_SORT_KEY_TEXTURE_SET_BITS)
+#define DIVISION_RENDER_SORT_KEY_VERTEX_BUFFER_SHIFT                                    \
+    (DIVISION_RENDER_SORT_KEY_DESCRIPTOR_SHIFT +                                        \
+     DIVISION_RENDER_SORT_KEY_DESCRIPTOR_BITS)
+#define DIVISION_RENDER_SORT_KEY_SHADER_SHIFT                                           \
+    (DIVISION_RENDER_SORT_KEY_VERTEX_BUFFER_SHIFT +                                     \
+     DIVISION_RENDER_SORT_KEY_VERTEX_BUFFER_BITS)
+#define DIVISION_RENDER_SORT_KEY_TRANSLUCENT_SHIFT                                      \
+    (DIVISION_RENDER_SORT_KEY_SHADER_SHIFT + DIVISION_RENDER_SORT_KEY_SHADER_BITS)
+#define DIVISION_RENDER_SORT_KEY_LAYER_SHIFT                                            \
+    (DIVISION_RENDER_SORT_KEY_TRANSLUCENT_SHIFT +                                       \
+     DIVISION_RENDER_SORT_KEY_TRANSLUCENT_BITS)
+
+#define DIVISION_RENDER_SORT_KEY_FIELD_(value, name)                                    \
+    (((uint64_t) (value) &                                                              \
+      ((UINT64_C(1) << DIVISION_RENDER_SORT_KEY_##name##_BITS) - 1))                    \
+     << DIVISION_RENDER_SORT_KEY_##name##_SHIFT)
+
+/*
+ *  Makes the begun frame of the partial redraw dirty as a whole, e.g. when the platform
+ *  failed to keep the contents. The next frame is dirty as a whole too
+ */
+void division_engine_render_pass_instance_redraw_whole_frame(DivisionContext* ctx);
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+    /*
+     *  Starts the frame with the load action of the descriptor, then any number of
+     *  submits append their draws to it. The frame is presented with
+     *  division_engine_render_pass_instance_end_frame, frames left open by the draw
+     *  callback are ended after it. Returns false if a frame is begun already or
+     *  the color store action isn't DIVISION_STORE_ACTION_STORE
+     */
+    DIVISION_EXPORT bool division_engine_render_pass_instance_begin_frame(
+        DivisionContext* ctx, const DivisionFrameDescriptor* frame
+    );
+
+    /*
+     *  Appends the instances to the begun frame, the upload queue is flushed first.
+     *  Consecutive instances with the same descriptor, capabilities and bindings are
+     *  merged before the platform draw when their ranges continue each other (see
+     *  division_engine_render_pass_instance_merge_ranges). Merged instanced draws see
+     *  gl_InstanceID counting from the first of them, instances with
+     *  DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NO_MERGE are drawn as they are.
+     *  The counts are added to the merge_stats of the render pass context
+     */
+    DIVISION_EXPORT void division_engine_render_pass_instance_submit(
+        DivisionContext* ctx,
+        const DivisionRenderPassInstance* render_pass_instances,
+        uint32_t render_pass_instance_count
+    );
+
+    /*
+     *  Marks the changed rect of the frame buffer in the partial redraw mode of the
+     *  settings. The next begun frame clears and draws inside of the marked rects only,
+     *  the rest keeps the contents of the previous frames. The whole frame is dirty
+     *  after the start and the resize. Does nothing in the full redraw mode
+     */
+    DIVISION_EXPORT void division_engine_render_pass_instance_mark_dirty(
+        DivisionContext* ctx, const DivisionDirtyRect* rect
+    );
+
+    // Applies the store action and presents the frame, the uniform ring moves on
+    DIVISION_EXPORT void division_engine_render_pass_instance_end_frame(
+        DivisionContext* ctx
+    );
+
+    /*
+     *  Draws the whole frame: begins it with the clear, submits the instances and
+     *  ends it. Must not be called inside of a begun frame
+     */
     DIVISION_EXPORT void division_engine_render_pass_instance_draw(
         DivisionContext* ctx,
         const DivisionColor* clear_color,
@@ -20,6 +111,167 @@ extern "C"
         uint32_t render_pass_instance_count
     );
 
+    /*
+     *  Checks whether the second instance can be drawn in the same indirect multi-draw
+     *  as the first one: both have the MULTI_DRAW_INDIRECT capability, the same
+     *  descriptor and the same uniform buffer and texture bindings or binding group.
+     *  Batched draws are issued in the order of the instances, the index of the draw
+     *  inside the batch is available in shaders as gl_DrawID (GLSL 4.60 or
+     *  ARB_shader_draw_parameters). Platforms without indirect draws ignore batching
+     */
+    DIVISION_EXPORT bool division_engine_render_pass_instance_can_batch(
+        const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+    );
+
+    // Sort info can be NULL, then the instance is in the layer 0 at the depth 0
+    DIVISION_EXPORT uint64_t division_engine_render_pass_instance_sort_key(
+        DivisionContext* ctx,
+        const DivisionRenderPassInstance* render_pass_instance,
+        const DivisionRenderPassInstanceSortInfo* sort_info
+    );
+
+    /*
+     *  Opt-in submission mode, which draws the instances in the order of their sort
+     *  keys, so the instances with the same state are drawn together. Opaque instances
+     *  are sorted by the state and then front to back, or only front to back with
+     *  DIVISION_OPAQUE_SORT_FRONT_TO_BACK in the frame descriptor. They must not rely
+     *  on the submission order. Instances with alpha blending keep their submission order
+     *  inside of the layer and are drawn after the opaque ones. Instances are sorted
+     *  inside of the submit only, the earlier submits of the frame are drawn first.
+     *  Sort infos can be NULL, otherwise there is one for every instance
+     */
+    DIVISION_EXPORT void division_engine_render_pass_instance_submit_sorted(
+        DivisionContext* ctx,
+        const DivisionRenderPassInstance* render_pass_instances,
+        const DivisionRenderPassInstanceSortInfo* sort_infos,
+        uint32_t render_pass_instance_count
+    );
+
+    // Same as division_engine_render_pass_instance_draw with the sorted submit
+    DIVISION_EXPORT void division_engine_render_pass_instance_draw_sorted(
+        DivisionContext* ctx,
+        const DivisionColor* clear_color,
+        const DivisionRenderPassInstance* render_pass_instances,
+        const DivisionRenderPassInstanceSortInfo* sort_infos,
+        uint32_t render_pass_instance_count
+    );
+
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
+
+/*
+ *  Non-negative depths keep their order as the float bits, the key takes the exponent
+ *  and the highest mantissa bits. Translucent keys only keep the layer, so a stable
+ *  sort leaves them in the submission order
+ */
+static inline uint64_t division_engine_render_pass_instance_pack_sort_key(
+    uint32_t layer,
+    bool translucent,
+    uint32_t shader,
+    uint32_t vertex_buffer,
+    uint32_t descriptor,
+    uint32_t texture_set,
+    float depth
+)
+{
+    uint64_t key = DIVISION_RENDER_SORT_KEY_FIELD_(layer, LAYER);
+    if (translucent)
+    {
+        return key | DIVISION_RENDER_SORT_KEY_FIELD_(1, TRANSLUCENT);
+    }
+
+    uint32_t depth_bits = 0;
+    if (depth > 0)
+    {
+        memcpy(&depth_bits, &depth, sizeof(depth_bits));
+        depth_bits >>= 31 - DIVISION_RENDER_SORT_KEY_DEPTH_BITS;
+    }
+
+    return key | DIVISION_RENDER_SORT_KEY_FIELD_(shader, SHADER) |
+           DIVISION_RENDER_SORT_KEY_FIELD_(vertex_buffer, VERTEX_BUFFER) |
+           DIVISION_RENDER_SORT_KEY_FIELD_(descriptor, DESCRIPTOR) |
+           DIVISION_RENDER_SORT_KEY_FIELD_(texture_set, TEXTURE_SET) |
+           DIVISION_RENDER_SORT_KEY_FIELD_(depth_bits, DEPTH);
+}
+
+/*
+ *  Moves the depth of an opaque key above its state fields, so the sort draws the
+ *  nearer instances first. Layers and translucent keys keep their order
+ */
+static inline uint64_t division_engine_render_pass_instance_depth_first_sort_key(
+    uint64_t key
+)
+{
+    if ((key & DIVISION_RENDER_SORT_KEY_FIELD_(1, TRANSLUCENT)) != 0)
+    {
+        return key;
+    }
+
+    uint64_t state_mask = (UINT64_C(1) << DIVISION_RENDER_SORT_KEY_TRANSLUCENT_SHIFT) - 1;
+    uint64_t depth_mask = (UINT64_C(1) << DIVISION_RENDER_SORT_KEY_DEPTH_BITS) - 1;
+    uint64_t state = (key & state_mask) >> DIVISION_RENDER_SORT_KEY_DEPTH_BITS;
+    uint64_t depth = (key >> DIVISION_RENDER_SORT_KEY_DEPTH_SHIFT) & depth_mask;
+
+    return (key & ~state_mask) |
+           (depth << (DIVISION_RENDER_SORT_KEY_TRANSLUCENT_SHIFT -
+                      DIVISION_RENDER_SORT_KEY_DEPTH_BITS)) |
+           state;
+}
+
+/*
+ *  Extends the first instance with the range of the next one, if a single draw of the
+ *  result draws the same primitives:
+ *  1. Instanced draws of the same vertices or indices with adjacent instance ranges
+ *  2. Non-indexed draws of list topologies with adjacent vertex ranges, which end on
+ *     a primitive boundary, and with the same instances
+ *  Indexed draws always start at the first index, so their index ranges can't be merged
+ */
+static inline bool division_engine_render_pass_instance_merge_ranges(
+    DivisionRenderPassInstance* merged,
+    const DivisionRenderPassInstance* next,
+    DivisionRenderTopology topology,
+    bool indexed
+)
+{
+    bool instanced = (merged->capabilities_mask &
+                      DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING) != 0;
+    bool same_vertices = merged->first_vertex == next->first_vertex &&
+                         merged->vertex_count == next->vertex_count &&
+                         merged->index_count == next->index_count;
+    bool same_instances = merged->first_instance == next->first_instance &&
+                          merged->instance_count == next->instance_count;
+
+    if (instanced && same_vertices &&
+        merged->first_instance + merged->instance_count == next->first_instance)
+    {
+        merged->instance_count += next->instance_count;
+        return true;
+    }
+
+    uint32_t primitive_size;
+    switch (topology)
+    {
+    case DIVISION_TOPOLOGY_TRIANGLES:
+        primitive_size = 3;
+        break;
+    case DIVISION_TOPOLOGY_LINES:
+        primitive_size = 2;
+        break;
+    case DIVISION_TOPOLOGY_POINTS:
+        primitive_size = 1;
+        break;
+    default:
+        return false;
+    }
+
+    if (!indexed && (!instanced || same_instances) &&
+        merged->vertex_count % primitive_size == 0 &&
+        merged->first_vertex + merged->vertex_count == next->first_vertex)
+    {
+        merged->vertex_count += next->vertex_count;
+        return true;
+    }
+
+    return false;
+}
@@ -9,6 +9,7 @@ typedef struct DivisionRendererSystemContext
 {
     int32_t frame_buffer_width;
     int32_t frame_buffer_height;
+    DivisionDepthStencilFormat depth_stencil_format;
 
     struct DivisionWindowContextPlatformInternal_* window_data;
 } DivisionRendererSystemContext;
@@ -18,6 +19,10 @@ bool division_engine_renderer_system_context_alloc(
 );
 void division_engine_renderer_system_context_free(DivisionContext* ctx);
 
+// Calls the draw callback of the lifecycle, ends the frame left open by it and
+// finishes the frame of the profiler
+void division_engine_renderer_draw(DivisionContext* ctx);
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "context.h"
@@ -44,3 +45,26 @@ extern "C"
 #ifdef __cplusplus
 }
 #endif
+
+// Size of the whole texture data in the source format
+static inline size_t division_engine_texture_data_size(const DivisionTexture* texture)
+{
+    size_t bytes_per_pixel;
+    switch (texture->texture_format)
+    {
+    case DIVISION_TEXTURE_FORMAT_R8Uint:
+        bytes_per_pixel = 1;
+        break;
+    case DIVISION_TEXTURE_FORMAT_RGB24Uint:
+        bytes_per_pixel = 3;
+        break;
+    case DIVISION_TEXTURE_FORMAT_RGBA32Uint:
+        bytes_per_pixel = 4;
+        break;
+    default:
+        bytes_per_pixel = 0;
+        break;
+    }
+
+    return bytes_per_pixel * texture->width * texture->height;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "id.h"
+
+// Resources bound together to the shader locations of a draw
+typedef struct DivisionBindingGroup
+{
+    const DivisionIdWithBinding* uniform_vertex_buffers;
+    const DivisionIdWithBinding* uniform_fragment_buffers;
+    const DivisionIdWithBinding* fragment_textures;
+
+    int32_t uniform_vertex_buffer_count;
+    int32_t uniform_fragment_buffer_count;
+    int32_t fragment_texture_count;
+} DivisionBindingGroup;
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+// Timings of a replayed capture, a frame ends with every replayed end of the frame
+typedef struct DivisionCaptureReplayStats
+{
+    uint64_t command_count;
+    uint32_t frame_count;
+    double total_ms;
+    double min_frame_ms;
+    double max_frame_ms;
+} DivisionCaptureReplayStats;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "render_pass_instance.h"
+#include "upload_queue.h"
+
+typedef enum DivisionCommandType
+{
+    DIVISION_COMMAND_DRAW = 1,
+    DIVISION_COMMAND_COPY = 2,
+} DivisionCommandType;
+
+// Geometry range of a draw, the state comes from the bindings of the command list.
+// DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP is set by the list itself
+typedef struct DivisionCommandDrawRange
+{
+    uint32_t first_vertex;
+    uint32_t first_instance;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t instance_count;
+    DivisionRenderPassInstanceCapabilityMask capabilities_mask;
+} DivisionCommandDrawRange;
+
+typedef struct DivisionCommandDraw
+{
+    DivisionCommandDrawRange range;
+    uint32_t render_pass_descriptor_id;
+    uint32_t binding_group_id;
+
+    // Offset of the uniform vertex buffers, uniform fragment buffers and fragment
+    // textures, stored one after another in the command list data
+    size_t bindings_offset;
+    int32_t uniform_vertex_buffer_count;
+    int32_t uniform_fragment_buffer_count;
+    int32_t fragment_texture_count;
+} DivisionCommandDraw;
+
+typedef struct DivisionCommandCopy
+{
+    DivisionUploadTarget target;
+    uint32_t resource_id;
+    size_t dst_offset;
+    size_t data_offset;
+    size_t size;
+} DivisionCommandCopy;
+
+typedef struct DivisionCommand
+{
+    DivisionCommandType type;
+    union
+    {
+        DivisionCommandDraw draw;
+        DivisionCommandCopy copy;
+    };
+} DivisionCommand;
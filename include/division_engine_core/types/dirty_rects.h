@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+#define DIVISION_DIRTY_RECT_CAPACITY 8
+
+// Rectangle of the frame buffer in pixels, the origin is the bottom left corner
+typedef struct DivisionDirtyRect
+{
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} DivisionDirtyRect;
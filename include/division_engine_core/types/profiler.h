@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+// Time of a label in a frame, the sum of all its scopes
+typedef struct DivisionProfilerTiming
+{
+    uint64_t frame_index;
+    double cpu_ms;
+    // Zero if the platform has no GPU timers
+    double gpu_ms;
+} DivisionProfilerTiming;
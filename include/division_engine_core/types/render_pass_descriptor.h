@@ -18,6 +18,9 @@ typedef enum DivisionRenderPassDescriptorCapabilityMask
 {
     DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_NONE = 0,
     DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND = 1 << 0,
+    // Fragments are compared with the depth attachment by the depth_compare function
+    DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST = 1 << 1,
+    DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_WRITE = 1 << 2,
 } DivisionRenderPassDescriptorCapabilityMask;
 
 typedef enum DivisionAlphaBlend
@@ -48,6 +51,19 @@ typedef enum DivisionAlphaBlendOperation
     DIVISION_ALPHA_BLEND_OP_MAX = 5,
 } DivisionAlphaBlendOperation;
 
+// Zero is LESS, so the nearer fragments pass the test by default
+typedef enum DivisionCompareFunction
+{
+    DIVISION_COMPARE_LESS = 0,
+    DIVISION_COMPARE_LESS_EQUAL = 1,
+    DIVISION_COMPARE_EQUAL = 2,
+    DIVISION_COMPARE_GREATER = 3,
+    DIVISION_COMPARE_GREATER_EQUAL = 4,
+    DIVISION_COMPARE_NOT_EQUAL = 5,
+    DIVISION_COMPARE_ALWAYS = 6,
+    DIVISION_COMPARE_NEVER = 7,
+} DivisionCompareFunction;
+
 typedef struct DivisionAlphaBlendingOptions
 {
     DivisionAlphaBlend src;
@@ -63,4 +79,6 @@ typedef struct DivisionRenderPassDescriptor
     uint32_t vertex_buffer_id;
     DivisionRenderPassDescriptorCapabilityMask capabilities_mask;
     DivisionColorMask color_mask;
+    // Used with DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST only
+    DivisionCompareFunction depth_compare;
 } DivisionRenderPassDescriptor;
\ No newline at end of file
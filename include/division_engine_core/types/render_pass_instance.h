@@ -1,11 +1,19 @@
 #pragma once
 
+#include "color.h"
 #include "id.h"
+#include "uniform_buffer.h"
 
 typedef enum DivisionRenderPassInstanceCapabilityMask
 {
     DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NONE = 0,
     DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING = 1,
+    // Lets the instance share one indirect multi-draw with its compatible neighbours
+    DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_MULTI_DRAW_INDIRECT = 2,
+    // Keeps the instance out of the draw merging, e.g. if the shader uses gl_InstanceID
+    DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NO_MERGE = 4,
+    // Takes the bindings from the binding group, the binding arrays are ignored
+    DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP = 8,
 } DivisionRenderPassInstanceCapabilityMask;
 
 typedef struct DivisionRenderPassInstance
@@ -18,10 +26,66 @@ typedef struct DivisionRenderPassInstance
     DivisionIdWithBinding* uniform_vertex_buffers;
     DivisionIdWithBinding* uniform_fragment_buffers;
     DivisionIdWithBinding* fragment_textures;
+    // Ranges of the uniform ring, bound in addition to the buffers or the binding group
+    const DivisionUniformRingBinding* uniform_ring_bindings;
 
     int32_t uniform_vertex_buffer_count;
     int32_t uniform_fragment_buffer_count;
     int32_t fragment_texture_count;
+    int32_t uniform_ring_binding_count;
     uint32_t render_pass_descriptor_id;
+    uint32_t binding_group_id;
     DivisionRenderPassInstanceCapabilityMask capabilities_mask;
-} DivisionRenderPassInstance;
\ No newline at end of file
+} DivisionRenderPassInstance;
+
+// Application part of the sort key, layers are drawn in the ascending order
+typedef struct DivisionRenderPassInstanceSortInfo
+{
+    uint8_t layer;
+    float depth;
+} DivisionRenderPassInstanceSortInfo;
+// Contents of the frame buffer at the beginning of the frame
+typedef enum DivisionLoadAction
+{
+    DIVISION_LOAD_ACTION_CLEAR = 0,
+    // Keeps the contents of the previous frame, e.g. to draw only the changed parts
+    DIVISION_LOAD_ACTION_LOAD = 1,
+    // Contents are undefined, for frames which cover every pixel with opaque draws
+    DIVISION_LOAD_ACTION_DONT_CARE = 2,
+} DivisionLoadAction;
+
+// Contents of the frame buffer after the end of the frame
+typedef enum DivisionStoreAction
+{
+    DIVISION_STORE_ACTION_STORE = 0,
+    // Contents aren't needed after the frame, tiled GPUs skip writing them back.
+    // Depth and stencil only, the color of the window is presented after the frame
+    DIVISION_STORE_ACTION_DONT_CARE = 1,
+} DivisionStoreAction;
+
+// Order of the opaque instances of the sorted submits
+typedef enum DivisionOpaqueSortOrder
+{
+    // Instances with the same state are drawn together, then front to back
+    DIVISION_OPAQUE_SORT_BY_STATE = 0,
+    // Nearer instances are drawn first, so the early depth test rejects the fragments
+    // hidden behind them. Costs state changes, pays off for the expensive fragments
+    DIVISION_OPAQUE_SORT_FRONT_TO_BACK = 1,
+} DivisionOpaqueSortOrder;
+
+typedef struct DivisionFrameDescriptor
+{
+    // Used by DIVISION_LOAD_ACTION_CLEAR only
+    DivisionColor clear_color;
+    DivisionLoadAction color_load_action;
+    // DIVISION_STORE_ACTION_STORE only, the begin of the frame refuses the others
+    DivisionStoreAction color_store_action;
+
+    // Depth actions are ignored without the depth attachment in the settings.
+    // The depth is usually cleared to 1, the stencil is cleared to 0 with it
+    float clear_depth;
+    DivisionLoadAction depth_load_action;
+    DivisionStoreAction depth_store_action;
+
+    DivisionOpaqueSortOrder opaque_sort_order;
+} DivisionFrameDescriptor;
@@ -1,10 +1,29 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
+// Depth and stencil attachment of the window frame buffer
+typedef enum DivisionDepthStencilFormat
+{
+    DIVISION_DEPTH_STENCIL_FORMAT_NONE = 0,
+    DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8 = 1,
+    DIVISION_DEPTH_STENCIL_FORMAT_DEPTH32 = 2,
+} DivisionDepthStencilFormat;
+
 typedef struct DivisionSettings
 {
     uint32_t window_width;
     uint32_t window_height;
     const char* window_title;
+    // Engine calls are captured to the file for the replay, if the path isn't NULL
+    const char* capture_path;
+    // Frames drawn by the run loop of the null platform, which has no window to close.
+    // One frame is drawn if it is 0
+    uint32_t frame_limit;
+    // Render pass descriptors with the depth capabilities require the depth attachment
+    DivisionDepthStencilFormat depth_stencil_format;
+    // Frames keep their contents and redraw the rectangles marked dirty only, see
+    // division_engine_render_pass_instance_mark_dirty
+    bool partial_redraw;
 } DivisionSettings;
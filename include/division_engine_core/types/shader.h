@@ -16,7 +16,18 @@ typedef enum DivisionShaderVariableType
     DIVISION_FVEC2 = 4,
     DIVISION_FVEC3 = 5,
     DIVISION_FVEC4 = 6,
-    DIVISION_FMAT4X4 = 7
+    DIVISION_FMAT4X4 = 7,
+
+    // Compact vertex attribute formats. Shaders receive them as float vectors
+    DIVISION_HVEC2 = 8,
+    DIVISION_HVEC4 = 9,
+    DIVISION_UBYTE4_NORM = 10,
+    DIVISION_BYTE4_NORM = 11,
+    DIVISION_USHORT2_NORM = 12,
+    DIVISION_USHORT4_NORM = 13,
+    DIVISION_SHORT2_NORM = 14,
+    DIVISION_SHORT4_NORM = 15,
+    DIVISION_INT_2_10_10_10_REV_NORM = 16
 } DivisionShaderVariableType;
 
 typedef struct DivisionShaderSourceDescriptor
@@ -1,8 +1,43 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
+
+typedef enum DivisionUniformBufferUpdatePolicy
+{
+    // The driver copies the data, the draws in flight keep reading the previous data
+    DIVISION_UNIFORM_BUFFER_UPDATE_COPY = 0,
+    // Whole buffer updates write to a new storage, the previous one is released
+    // by the driver, when the draws in flight have finished. Shared storage buffers
+    // can't be orphaned, they are copied
+    DIVISION_UNIFORM_BUFFER_UPDATE_ORPHAN = 1,
+} DivisionUniformBufferUpdatePolicy;
+
+typedef enum DivisionUniformBufferCapabilityMask
+{
+    DIVISION_UNIFORM_BUFFER_CAPABILITY_NONE = 0,
+    // Small long-lived blocks are sub-allocated from the shared buffers by size class
+    DIVISION_UNIFORM_BUFFER_CAPABILITY_SHARED_STORAGE = 1 << 0,
+} DivisionUniformBufferCapabilityMask;
 
 typedef struct DivisionUniformBufferDescriptor
 {
     size_t data_bytes;
-} DivisionUniformBufferDescriptor;
\ No newline at end of file
+    DivisionUniformBufferUpdatePolicy update_policy;
+    DivisionUniformBufferCapabilityMask capabilities_mask;
+} DivisionUniformBufferDescriptor;
+
+// Range of the uniform ring, the data is written by the CPU until the frame ends
+typedef struct DivisionUniformRingRange
+{
+    void* data;
+    uint32_t offset;
+    uint32_t size;
+} DivisionUniformRingRange;
+
+typedef struct DivisionUniformRingBinding
+{
+    uint32_t offset;
+    uint32_t size;
+    uint32_t shader_location;
+} DivisionUniformRingBinding;
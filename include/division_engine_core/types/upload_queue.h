@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fences are increasing numbers, a fence is complete with all the previous ones
+typedef uint64_t DivisionUploadFence;
+
+typedef enum DivisionUploadTarget
+{
+    DIVISION_UPLOAD_TARGET_VERTEX_DATA = 1,
+    DIVISION_UPLOAD_TARGET_INSTANCE_DATA = 2,
+    DIVISION_UPLOAD_TARGET_INDEX_DATA = 3,
+    DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER = 4,
+    DIVISION_UPLOAD_TARGET_TEXTURE = 5,
+} DivisionUploadTarget;
+
+typedef struct DivisionUploadStaging
+{
+    void* data;
+    size_t offset;
+    size_t size;
+} DivisionUploadStaging;
+
+typedef struct DivisionUploadJob
+{
+    DivisionUploadTarget target;
+    uint32_t resource_id;
+    size_t staging_offset;
+    size_t dst_offset;
+    size_t size;
+} DivisionUploadJob;
@@ -3,14 +3,30 @@
 #include "shader.h"
 
 #include <stddef.h>
+#include <stdint.h>
+
+// Strip topologies restart the primitive at the maximum value of the index type.
+// List topologies don't restart, so they can use every index value
+#define DIVISION_PRIMITIVE_RESTART_INDEX_UINT16 UINT16_MAX
+#define DIVISION_PRIMITIVE_RESTART_INDEX_UINT32 UINT32_MAX
 
 typedef enum DivisionRenderTopology
 {
     DIVISION_TOPOLOGY_TRIANGLES = 1,
     DIVISION_TOPOLOGY_POINTS = 2,
-    DIVISION_TOPOLOGY_LINES = 3
+    DIVISION_TOPOLOGY_LINES = 3,
+    DIVISION_TOPOLOGY_TRIANGLE_STRIP = 4,
+    DIVISION_TOPOLOGY_LINE_STRIP = 5,
 } DivisionRenderTopology;
 
+typedef enum DivisionVertexBufferCapabilityMask
+{
+    DIVISION_VERTEX_BUFFER_CAPABILITY_NONE = 0,
+    DIVISION_VERTEX_BUFFER_CAPABILITY_SHRINK_ON_RESIZE = 1 << 0,
+    DIVISION_VERTEX_BUFFER_CAPABILITY_SHARED_STORAGE = 1 << 1,
+    DIVISION_VERTEX_BUFFER_CAPABILITY_UINT16_INDICES = 1 << 2,
+} DivisionVertexBufferCapabilityMask;
+
 typedef struct DivisionVertexBufferSize
 {
     uint32_t vertex_count;
@@ -32,6 +48,7 @@ typedef struct DivisionVertexBufferSettings
     int32_t per_vertex_attribute_count;
     int32_t per_instance_attribute_count;
     DivisionRenderTopology topology;
+    DivisionVertexBufferCapabilityMask capabilities_mask;
 } DivisionVertexBufferSettings;
 
 typedef struct DivisionVertexBufferConstSettings 
@@ -42,6 +59,7 @@ typedef struct DivisionVertexBufferConstSettings
     int32_t per_vertex_attribute_count;
     int32_t per_instance_attribute_count;
     DivisionRenderTopology topology;
+    DivisionVertexBufferCapabilityMask capabilities_mask;
 } DivisionVertexBufferConstSettings;
 
 typedef struct DivisionVertexAttribute
@@ -51,9 +69,33 @@ typedef struct DivisionVertexAttribute
     int32_t component_count;
 } DivisionVertexAttribute;
 
+// Attribute with the offset and traits computed ahead of time, see vertex_layout.h
+typedef struct DivisionVertexLayoutAttribute
+{
+    DivisionVertexAttributeSettings settings;
+    DivisionVertexAttribute attribute;
+} DivisionVertexLayoutAttribute;
+
+typedef struct DivisionVertexLayout
+{
+    const DivisionVertexLayoutAttribute* attributes;
+    int32_t attribute_count;
+    int32_t stride;
+} DivisionVertexLayout;
+
+typedef struct DivisionVertexBufferLayoutSettings
+{
+    DivisionVertexBufferSize size;
+    const DivisionVertexLayout* per_vertex_layout;
+    const DivisionVertexLayout* per_instance_layout;
+    DivisionRenderTopology topology;
+    DivisionVertexBufferCapabilityMask capabilities_mask;
+} DivisionVertexBufferLayoutSettings;
+
 typedef struct DivisionVertexBuffer
 {
     DivisionVertexBufferSettings settings;
+    DivisionVertexBufferSize capacity;
 
     DivisionVertexAttribute* per_vertex_attributes;
     DivisionVertexAttribute* per_instance_attributes;
@@ -10,7 +10,12 @@
 
 #include <division_engine_core_export.h>
 
+#define DIVISION_UNIFORM_RING_FRAME_CAPACITY (4 * 1024 * 1024)
+#define DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT 3
+
 struct DivisionUniformBufferInternal_;
+struct DivisionUniformRingInternal_;
+struct DivisionUniformBufferPoolInternalPlatform_;
 
 typedef struct DivisionUniformBufferSystemContext
 {
@@ -18,6 +23,16 @@ typedef struct DivisionUniformBufferSystemContext
     DivisionUniformBufferDescriptor* uniform_buffers;
     struct DivisionUniformBufferInternal_* uniform_buffers_impl;
     size_t uniform_buffer_count;
+
+    struct DivisionUniformBufferPoolInternalPlatform_* pools_impl;
+    size_t pools_count;
+
+    // Mapped storage of the uniform ring, a region of the frame capacity per frame
+    void* ring_data;
+    size_t ring_alignment;
+    size_t ring_frame_offset;
+    uint32_t ring_frame;
+    struct DivisionUniformRingInternal_* ring_impl;
 } DivisionUniformBufferSystemContext;
 
 bool division_engine_uniform_buffer_system_context_alloc(
@@ -26,6 +41,9 @@ bool division_engine_uniform_buffer_system_context_alloc(
 
 void division_engine_uniform_buffer_system_context_free(DivisionContext* ctx);
 
+// Moves the uniform ring to the region of the next frame, called at the end of the frame
+void division_engine_uniform_buffer_ring_end_frame(DivisionContext* ctx);
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -41,6 +59,10 @@ extern "C"
         DivisionContext* ctx, uint32_t buffer_id
     );
 
+    /*
+     *  Borrowing maps the buffer for reading and writing, so the driver waits for the
+     *  draws in flight which use the buffer. Prefer set_data / update_range to write
+     */
     DIVISION_EXPORT void* division_engine_uniform_buffer_borrow_data_pointer(
         DivisionContext* ctx, uint32_t buffer_id
     );
@@ -48,6 +70,36 @@ extern "C"
         DivisionContext* ctx, uint32_t buffer_id, void* data_pointer
     );
 
+    /*
+     *  Write-only updates, which don't wait for the GPU. The data is copied during
+     *  the call, see DivisionUniformBufferUpdatePolicy for the way it is done.
+     *  Returns false if the range is out of the buffer bounds
+     */
+    DIVISION_EXPORT bool division_engine_uniform_buffer_set_data(
+        DivisionContext* ctx, uint32_t buffer_id, const void* data
+    );
+    DIVISION_EXPORT bool division_engine_uniform_buffer_update_range(
+        DivisionContext* ctx,
+        uint32_t buffer_id,
+        size_t offset,
+        const void* data,
+        size_t size
+    );
+
+    /*
+     *  Transient uniform data of the current frame. The range is sub-allocated from
+     *  the persistently mapped uniform ring with the offset alignment of the device,
+     *  so it costs a pointer bump instead of a buffer and a map. The data is written
+     *  right away and is bound to the draws with the uniform ring bindings of the
+     *  render pass instance. The range is valid until the end of the frame, after
+     *  division_engine_render_pass_instance_end_frame the region is reused when the
+     *  GPU has finished the frame.
+     *  Returns false if the frame has used DIVISION_UNIFORM_RING_FRAME_CAPACITY bytes
+     */
+    DIVISION_EXPORT bool division_engine_uniform_buffer_ring_alloc(
+        DivisionContext* ctx, size_t size, DivisionUniformRingRange* out_range
+    );
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
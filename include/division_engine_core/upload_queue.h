@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "context.h"
+#include "types/upload_queue.h"
+
+#include "data_structures/ring_allocator.h"
+
+#include <division_engine_core_export.h>
+
+#define DIVISION_UPLOAD_QUEUE_STAGING_CAPACITY (16 * 1024 * 1024)
+#define DIVISION_UPLOAD_QUEUE_STAGING_ALIGNMENT 256
+
+typedef struct DivisionUploadBatch
+{
+    DivisionUploadFence fence;
+    uint64_t staging_end;
+} DivisionUploadBatch;
+
+typedef struct DivisionUploadQueueSystemContext
+{
+    DivisionRingAllocator staging_ring;
+    void* staging_data;
+
+    DivisionUploadJob* jobs;
+    size_t jobs_count;
+    size_t jobs_capacity;
+
+    // Submitted batches waiting for their fences, the oldest first
+    DivisionUploadBatch* pending_batches;
+    size_t pending_batches_count;
+    size_t pending_batches_capacity;
+
+    DivisionUploadFence next_fence;
+    DivisionUploadFence completed_fence;
+
+    struct DivisionUploadQueueInternalPlatform_* upload_queue_impl;
+} DivisionUploadQueueSystemContext;
+
+bool division_engine_upload_queue_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+);
+
+void division_engine_upload_queue_system_context_free(DivisionContext* ctx);
+
+/*
+ *  Asynchronous uploads through a persistently mapped staging ring:
+ *  1. division_engine_upload_queue_alloc_staging gives a range of the ring to write to
+ *  2. division_engine_upload_queue_enqueue adds the copy of the range to a resource
+ *  3. the queue is flushed before every division_engine_render_pass_instance_submit
+ *     or with division_engine_upload_queue_flush, the copies run on the GPU timeline
+ *  4. division_engine_upload_queue_is_complete polls the fence of the upload, the ring
+ *     range is reused after the completion
+ *
+ *  The target resource must stay alive and must not be borrowed until the flush
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Returns false if the staging ring has no space left, try again after a flush
+    DIVISION_EXPORT bool division_engine_upload_queue_alloc_staging(
+        DivisionContext* ctx, size_t size, DivisionUploadStaging* out_staging
+    );
+
+    /*
+     *  Buffer targets copy the staging range to `dst_offset` bytes of the vertex,
+     *  instance or index data of the vertex buffer, or of the uniform buffer.
+     *  Texture target replaces the whole texture, the staging range must hold all of
+     *  its pixels in the source format and `dst_offset` must be 0
+     */
+    DIVISION_EXPORT bool division_engine_upload_queue_enqueue(
+        DivisionContext* ctx,
+        const DivisionUploadStaging* staging,
+        DivisionUploadTarget target,
+        uint32_t resource_id,
+        size_t dst_offset,
+        DivisionUploadFence* out_fence
+    );
+
+    DIVISION_EXPORT void division_engine_upload_queue_flush(DivisionContext* ctx);
+
+    DIVISION_EXPORT bool division_engine_upload_queue_is_complete(
+        DivisionContext* ctx, DivisionUploadFence fence
+    );
+
+#ifdef __cplusplus
+}
+#endif
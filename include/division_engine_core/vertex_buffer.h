@@ -7,17 +7,24 @@
 
 #include "context.h"
 #include "types/vertex_buffer.h"
+#include "utility.h"
 
 #include "data_structures/unordered_id_table.h"
 
 #include <division_engine_core_export.h>
 
+#define DIVISION_VERTEX_BUFFER_GROWTH_FACTOR 2
+#define DIVISION_VERTEX_BUFFER_SHRINK_THRESHOLD 4
+
 typedef struct DivisionVertexBufferSystemContext
 {
     DivisionUnorderedIdTable id_table;
     DivisionVertexBuffer* buffers;
     struct DivisionVertexBufferInternalPlatform_* buffers_impl;
     size_t buffers_count;
+
+    struct DivisionVertexBufferPoolInternalPlatform_* pools_impl;
+    size_t pools_count;
 } DivisionVertexBufferSystemContext;
 
 typedef struct DivisionVertexBufferBorrowedData
@@ -45,6 +52,15 @@ extern "C"
      * order they are received
      *  2. Instanced rendering buffer. First goes vertex data,
      *  after - interleaved instance data attributes in the order they are received
+     *
+     *  Buffers with DIVISION_VERTEX_BUFFER_CAPABILITY_SHARED_STORAGE are suballocated
+     *  from storage shared by all buffers with the same attributes layout, so drawing
+     *  them one after another doesn't rebind vertex arrays. Borrowed data pointers stay
+     *  the same, but only one buffer of a shared storage can be borrowed at a time.
+     *  Platforms without shared storage support allocate such buffers as usual
+     *
+     *  Indices are uint32_t, or uint16_t for buffers with
+     *  DIVISION_VERTEX_BUFFER_CAPABILITY_UINT16_INDICES
      */
     DIVISION_EXPORT bool division_engine_vertex_buffer_alloc(
         DivisionContext* ctx,
@@ -52,6 +68,27 @@ extern "C"
         uint32_t* out_vertex_buffer_id
     );
 
+    /*
+     *  Same as division_engine_vertex_buffer_alloc, but the attribute offsets and the
+     *  strides are taken from the pre-baked layouts (see vertex_layout.h) instead of
+     *  being computed, so they can follow the padding of the application structs.
+     *  The per instance layout is NULL for non-instanced buffers
+     */
+    DIVISION_EXPORT bool division_engine_vertex_buffer_alloc_with_layout(
+        DivisionContext* ctx,
+        const DivisionVertexBufferLayoutSettings* vertex_buffer_settings,
+        uint32_t* out_vertex_buffer_id
+    );
+
+    /*
+     *  Allocates a vertex buffer with the layout and size of the mesh file (see
+     *  mesh_file.h) and copies the data blobs straight from the file mapping into the
+     *  borrowed buffer data. The blob sizes must match the buffer layout
+     */
+    DIVISION_EXPORT bool division_engine_vertex_buffer_alloc_from_file(
+        DivisionContext* ctx, const char* path, uint32_t* out_vertex_buffer_id
+    );
+
     DIVISION_EXPORT void division_engine_vertex_buffer_free(
         DivisionContext* ctx, uint32_t vertex_buffer_id
     );
@@ -68,6 +105,14 @@ extern "C"
         DivisionVertexBufferBorrowedData* borrow_data
     );
 
+    /*
+     *  Resizing only changes the logical size while the new size fits the buffer
+     * capacity. Otherwise the capacity grows by DIVISION_VERTEX_BUFFER_GROWTH_FACTOR
+     * and the data is moved to the new storage. A buffer with the
+     * DIVISION_VERTEX_BUFFER_CAPABILITY_SHRINK_ON_RESIZE capability also gives the
+     * memory back when the size drops below 1 / DIVISION_VERTEX_BUFFER_SHRINK_THRESHOLD
+     * of the capacity
+     */
     DIVISION_EXPORT bool division_engine_vertex_buffer_resize(
         DivisionContext* ctx, uint32_t vertex_buffer, DivisionVertexBufferSize new_size
     );
@@ -76,6 +121,18 @@ extern "C"
 }
 #endif
 
+static inline size_t division_engine_vertex_buffer_index_size(
+    const DivisionVertexBuffer* vertex_buffer
+)
+{
+    return DIVISION_MASK_HAS_FLAG(
+               vertex_buffer->settings.capabilities_mask,
+               DIVISION_VERTEX_BUFFER_CAPABILITY_UINT16_INDICES
+           )
+               ? sizeof(uint16_t)
+               : sizeof(uint32_t);
+}
+
 static inline size_t division_engine_vertex_buffer_vertices_bytes(
     const DivisionVertexBuffer* vertex_buffer
 )
@@ -88,7 +145,8 @@ static inline size_t division_engine_vertex_buffer_indices_bytes(
     const DivisionVertexBuffer* vertex_buffer
 )
 {
-    return vertex_buffer->settings.size.index_count * sizeof(uint32_t);
+    return vertex_buffer->settings.size.index_count *
+           division_engine_vertex_buffer_index_size(vertex_buffer);
 }
 
 static inline size_t division_engine_vertex_buffer_instances_bytes(
@@ -97,4 +155,26 @@ static inline size_t division_engine_vertex_buffer_instances_bytes(
 {
     return vertex_buffer->settings.size.instance_count *
            vertex_buffer->per_instance_data_size;
-}
\ No newline at end of file
+}
+
+static inline size_t division_engine_vertex_buffer_vertices_capacity_bytes(
+    const DivisionVertexBuffer* vertex_buffer
+)
+{
+    return vertex_buffer->capacity.vertex_count * vertex_buffer->per_vertex_data_size;
+}
+
+static inline size_t division_engine_vertex_buffer_indices_capacity_bytes(
+    const DivisionVertexBuffer* vertex_buffer
+)
+{
+    return vertex_buffer->capacity.index_count *
+           division_engine_vertex_buffer_index_size(vertex_buffer);
+}
+
+static inline size_t division_engine_vertex_buffer_instances_capacity_bytes(
+    const DivisionVertexBuffer* vertex_buffer
+)
+{
+    return vertex_buffer->capacity.instance_count * vertex_buffer->per_instance_data_size;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types/vertex_buffer.h"
+
+/*
+ *  Compile-time vertex layouts, which are passed to
+ *  division_engine_vertex_buffer_alloc_with_layout. The offsets and the stride come
+ *  from the struct definition, so the layout can't disagree with it:
+ *
+ *  static const DivisionVertexLayoutAttribute vertex_attributes[] = {
+ *      DIVISION_VERTEX_LAYOUT_ATTRIBUTE(VertexData, position, DIVISION_FVEC3, 0),
+ *      DIVISION_VERTEX_LAYOUT_ATTRIBUTE(VertexData, uv, DIVISION_FVEC2, 1),
+ *  };
+ *  static const DivisionVertexLayout vertex_layout =
+ *      DIVISION_VERTEX_LAYOUT(VertexData, vertex_attributes);
+ *
+ *  A member which size doesn't match the attribute type fails the compilation
+ */
+
+#define DIVISION_SHADER_VARIABLE_BASE_SIZE(type)                                        \
+    ((type) == DIVISION_DOUBLE ? 8                                                      \
+     : (type) == DIVISION_HVEC2 || (type) == DIVISION_HVEC4 ||                          \
+             (type) == DIVISION_USHORT2_NORM || (type) == DIVISION_USHORT4_NORM ||      \
+             (type) == DIVISION_SHORT2_NORM || (type) == DIVISION_SHORT4_NORM           \
+         ? 2                                                                            \
+     : (type) == DIVISION_UBYTE4_NORM || (type) == DIVISION_BYTE4_NORM ? 1              \
+                                                                       : 4)
+
+#define DIVISION_SHADER_VARIABLE_COMPONENT_COUNT(type)                                  \
+    ((type) == DIVISION_FMAT4X4 ? 16                                                    \
+     : (type) == DIVISION_FVEC4 || (type) == DIVISION_HVEC4 ||                          \
+             (type) == DIVISION_UBYTE4_NORM || (type) == DIVISION_BYTE4_NORM ||         \
+             (type) == DIVISION_USHORT4_NORM || (type) == DIVISION_SHORT4_NORM          \
+         ? 4                                                                            \
+     : (type) == DIVISION_FVEC3 ? 3                                                     \
+     : (type) == DIVISION_FVEC2 || (type) == DIVISION_HVEC2 ||                          \
+             (type) == DIVISION_USHORT2_NORM || (type) == DIVISION_SHORT2_NORM          \
+         ? 2                                                                            \
+         : 1)
+
+#define DIVISION_SHADER_VARIABLE_SIZE(type)                                             \
+    (DIVISION_SHADER_VARIABLE_BASE_SIZE(type) *                                         \
+     DIVISION_SHADER_VARIABLE_COMPONENT_COUNT(type))
+
+// C++ needs the type to pass the attribute to division::make_vertex_layout
+#ifdef __cplusplus
+#define DIVISION_VERTEX_LAYOUT_ATTRIBUTE_TYPE_ DivisionVertexLayoutAttribute
+#else
+#define DIVISION_VERTEX_LAYOUT_ATTRIBUTE_TYPE_
+#endif
+
+// Evaluates to 0, a negative array size stops the compilation on the size mismatch
+#define DIVISION_VERTEX_LAYOUT_CHECK_SIZE_(Struct, member, type)                        \
+    (0 * (int32_t) sizeof(                                                              \
+             char[sizeof(((Struct*) 0)->member) == DIVISION_SHADER_VARIABLE_SIZE(type)  \
+                      ? 1                                                               \
+                      : -1]                                                             \
+         ))
+
+#define DIVISION_VERTEX_LAYOUT_ATTRIBUTE(Struct, member, attr_type, attr_location)      \
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE_TYPE_{                                             \
+        {(attr_type), (attr_location)},                                                 \
+        {                                                                               \
+            (int32_t) offsetof(Struct, member) +                                        \
+                DIVISION_VERTEX_LAYOUT_CHECK_SIZE_(Struct, member, attr_type),          \
+            DIVISION_SHADER_VARIABLE_BASE_SIZE(attr_type),                              \
+            DIVISION_SHADER_VARIABLE_COMPONENT_COUNT(attr_type),                        \
+        },                                                                              \
+    }
+
+#define DIVISION_VERTEX_LAYOUT(Struct, layout_attributes)                               \
+    {                                                                                   \
+        (layout_attributes),                                                            \
+        (int32_t) (sizeof(layout_attributes) / sizeof((layout_attributes)[0])),         \
+        (int32_t) sizeof(Struct),                                                       \
+    }
+
+#ifdef __cplusplus
+
+/*
+ *  C++ layouts deduce the attribute types from the member types and can be checked
+ *  with static_assert as a whole:
+ *
+ *  constexpr auto vertex_layout = division::make_vertex_layout<VertexData>(
+ *      DIVISION_VERTEX_LAYOUT_MEMBER(VertexData, position, 0),
+ *      DIVISION_VERTEX_LAYOUT_MEMBER(VertexData, uv, 1)
+ *  );
+ *  static_assert(vertex_layout.is_valid());
+ *
+ *  Compact formats are ambiguous (uint16_t[2] can be a half or a normalized short
+ *  vector), so they are declared with DIVISION_VERTEX_LAYOUT_ATTRIBUTE instead
+ */
+
+#define DIVISION_VERTEX_LAYOUT_MEMBER(Struct, member, attr_location)                    \
+    division::make_vertex_layout_attribute<decltype(Struct::member)>(                   \
+        offsetof(Struct, member), (attr_location)                                       \
+    )
+
+namespace division
+{
+
+template <typename T>
+struct VertexAttributeTypeOf;
+
+#define DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(cpp_type, attr_type)                         \
+    template <>                                                                         \
+    struct VertexAttributeTypeOf<cpp_type>                                              \
+    {                                                                                   \
+        static constexpr DivisionShaderVariableType value = attr_type;                  \
+    }
+
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float, DIVISION_FLOAT);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(double, DIVISION_DOUBLE);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(int32_t, DIVISION_INTEGER);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float[2], DIVISION_FVEC2);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float[3], DIVISION_FVEC3);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float[4], DIVISION_FVEC4);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float[16], DIVISION_FMAT4X4);
+DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_(float[4][4], DIVISION_FMAT4X4);
+
+#undef DIVISION_VERTEX_ATTRIBUTE_TYPE_OF_
+
+template <typename Member>
+constexpr DivisionVertexLayoutAttribute make_vertex_layout_attribute(
+    size_t offset, int32_t location
+)
+{
+    constexpr DivisionShaderVariableType type = VertexAttributeTypeOf<Member>::value;
+    static_assert(
+        sizeof(Member) == DIVISION_SHADER_VARIABLE_SIZE(type),
+        "Member size doesn't match the vertex attribute type"
+    );
+
+    return {
+        {type, location},
+        {
+            static_cast<int32_t>(offset),
+            DIVISION_SHADER_VARIABLE_BASE_SIZE(type),
+            DIVISION_SHADER_VARIABLE_COMPONENT_COUNT(type),
+        },
+    };
+}
+
+template <typename Vertex, size_t AttributeCount>
+struct VertexLayout
+{
+    static constexpr int32_t stride = static_cast<int32_t>(sizeof(Vertex));
+    static constexpr int32_t attribute_count = static_cast<int32_t>(AttributeCount);
+
+    DivisionVertexLayoutAttribute attributes[AttributeCount];
+
+    // Every attribute is inside of the vertex and doesn't overlap the others
+    constexpr bool is_valid() const
+    {
+        for (size_t i = 0; i < AttributeCount; i++)
+        {
+            const DivisionVertexAttribute& a = attributes[i].attribute;
+            int32_t a_end = a.offset + a.base_size * a.component_count;
+            if (a.offset < 0 || a_end > stride)
+            {
+                return false;
+            }
+
+            for (size_t j = i + 1; j < AttributeCount; j++)
+            {
+                const DivisionVertexAttribute& b = attributes[j].attribute;
+                int32_t b_end = b.offset + b.base_size * b.component_count;
+                if (a.offset < b_end && b.offset < a_end)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // The layout points to the attributes, so it lives no longer than this object
+    DivisionVertexLayout get() const
+    {
+        return {attributes, attribute_count, stride};
+    }
+};
+
+template <typename Vertex, typename... Attributes>
+constexpr VertexLayout<Vertex, sizeof...(Attributes)> make_vertex_layout(
+    Attributes... attributes
+)
+{
+    static_assert(sizeof...(Attributes) > 0, "Vertex layout must have attributes");
+    return {{attributes...}};
+}
+
+} // namespace division
+
+#endif
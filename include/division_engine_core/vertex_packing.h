@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <division_engine_core_export.h>
+
+/*
+ *  Conversions of float vertex streams into compact attribute formats
+ *  (see DIVISION_HVEC*, DIVISION_*_NORM and DIVISION_INT_2_10_10_10_REV_NORM).
+ *
+ *  Every function takes `count` elements of `components` values each.
+ *  Strides are in bytes, so both source and destination can be interleaved,
+ *  e.g. the destination may point into the data returned by
+ *  division_engine_vertex_buffer_borrow_data. Tightly packed streams are converted
+ *  with SIMD instructions chosen at compile time (AVX2 + F16C, SSE2 or NEON),
+ *  other ones with the scalar code.
+ *
+ *  Results are bit exact with the `_scalar` reference functions:
+ *  - floats are rounded to the nearest even value
+ *  - values out of the normalized range are clamped, NaN is clamped to the lowest value
+ *  - NaN is converted to a quiet half NaN with the truncated payload
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Returns the name of the instruction set used by the packing functions
+    DIVISION_EXPORT const char* division_vertex_packing_simd_name(void);
+
+    // float -> IEEE 754 binary16
+    DIVISION_EXPORT void division_vertex_pack_half(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    // [-1, 1] float -> int16_t
+    DIVISION_EXPORT void division_vertex_pack_snorm16(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    // [0, 1] float -> uint8_t
+    DIVISION_EXPORT void division_vertex_pack_unorm8(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    // float3 normal -> 2 x int16_t octahedral encoding, use with DIVISION_SHORT2_NORM
+    DIVISION_EXPORT void division_vertex_pack_normal_octahedral(
+        void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+    );
+
+    // float4 color -> RGBA8, use with DIVISION_UBYTE4_NORM
+    DIVISION_EXPORT void division_vertex_pack_color_rgba8(
+        void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+    );
+
+    DIVISION_EXPORT void division_vertex_pack_half_scalar(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    DIVISION_EXPORT void division_vertex_pack_snorm16_scalar(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    DIVISION_EXPORT void division_vertex_pack_unorm8_scalar(
+        void* dst,
+        size_t dst_stride,
+        const float* src,
+        size_t src_stride,
+        size_t count,
+        size_t components
+    );
+
+    DIVISION_EXPORT void division_vertex_pack_normal_octahedral_scalar(
+        void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+    );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct DivisionBindingGroupInternalPlatform_
+{
+    // Render pass instances drawn with the group
+    uint64_t draw_count;
+} DivisionBindingGroupInternalPlatform_;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "division_engine_core/context.h"
+
+#include <division_engine_core_export.h>
+
+// Calls of the platform layer, counted since the context initialization
+typedef struct DivisionNullCallStats
+{
+    uint64_t frame_count;
+    // Frames begun with DIVISION_LOAD_ACTION_CLEAR
+    uint64_t clear_count;
+    uint64_t submit_count;
+    // Batches of the compatible instances count as one draw call, like in GL
+    uint64_t draw_call_count;
+    uint64_t render_pass_instance_count;
+
+    uint64_t resource_alloc_count;
+    uint64_t resource_free_count;
+    uint64_t borrow_count;
+    // Uniform buffer ranges and texture data set by the CPU without the upload queue
+    uint64_t update_count;
+    uint64_t upload_job_count;
+    uint64_t uploaded_bytes;
+
+    // Invalid calls are reported to the error callback and skipped
+    uint64_t validation_error_count;
+} DivisionNullCallStats;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT const DivisionNullCallStats* division_engine_null_get_call_stats(
+        const DivisionContext* ctx
+    );
+
+    DIVISION_EXPORT void division_engine_null_reset_call_stats(DivisionContext* ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct DivisionRenderPassInternalPlatform_
+{
+    // Render pass instances drawn with the descriptor
+    uint64_t draw_count;
+} DivisionRenderPassInternalPlatform_;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "division_engine_core/renderer.h"
+
+#include "null_call_stats.h"
+
+// There is no window, the renderer keeps the frame limit and the counters of the calls
+typedef struct DivisionWindowContextPlatformInternal_
+{
+    uint32_t frame_limit;
+    DivisionNullCallStats call_stats;
+} DivisionWindowContextPlatformInternal_;
+
+static inline DivisionNullCallStats* division_null_call_stats(DivisionContext* ctx)
+{
+    return &ctx->renderer_context->window_data->call_stats;
+}
+
+// Reports the misuse, which GL would leave undefined or report asynchronously
+static inline void division_null_validation_error(
+    DivisionContext* ctx, const char* message
+)
+{
+    division_null_call_stats(ctx)->validation_error_count++;
+    DIVISION_THROW_INTERNAL_ERROR(ctx, message);
+}
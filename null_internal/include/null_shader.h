@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct DivisionShaderInternal_
+{
+    // DivisionShaderType of every source, which the program was linked from
+    uint32_t stage_mask;
+} DivisionShaderInternal_;
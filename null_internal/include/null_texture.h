@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct DivisionTextureImpl_
+{
+    uint8_t* data;
+    size_t data_size;
+} DivisionTextureImpl_;
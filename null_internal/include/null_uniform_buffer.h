@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "division_engine_core/uniform_buffer.h"
+
+// Every buffer has its own memory, the shared storage capability is ignored
+typedef struct DivisionUniformBufferInternal_
+{
+    uint8_t* data;
+    bool borrowed;
+} DivisionUniformBufferInternal_;
+
+typedef struct DivisionUniformRingInternal_
+{
+    uint8_t* data;
+    size_t capacity;
+} DivisionUniformRingInternal_;
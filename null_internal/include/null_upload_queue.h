@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "division_engine_core/types/upload_queue.h"
+
+// Copies are done by the CPU on the submit, so every fence is signaled right away
+typedef struct DivisionUploadQueueInternalPlatform_
+{
+    void* staging_data;
+    size_t staging_capacity;
+
+    DivisionUploadFence completed_fence;
+} DivisionUploadQueueInternalPlatform_;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "division_engine_core/vertex_buffer.h"
+
+// Vertices, instances and indices of the buffer capacity, one after another
+typedef struct DivisionVertexBufferInternalPlatform_
+{
+    uint8_t* data;
+    bool borrowed;
+} DivisionVertexBufferInternalPlatform_;
+
+typedef struct DivisionNullBufferRange_
+{
+    uint8_t* data;
+    size_t size;
+} DivisionNullBufferRange_;
+
+DivisionNullBufferRange_ division_null_vertex_buffer_vertices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
+DivisionNullBufferRange_ division_null_vertex_buffer_instances_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
+DivisionNullBufferRange_ division_null_vertex_buffer_indices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+);
@@ -0,0 +1,113 @@
+#include "division_engine_core/platform_internal/platform_binding_group.h"
+
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+
+#include "null_binding_group.h"
+#include "null_renderer.h"
+
+#include <stdlib.h>
+
+static inline bool are_bindings_valid_(
+    const DivisionUnorderedIdTable* id_table,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count
+);
+
+bool division_engine_internal_platform_binding_group_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->binding_group_context->binding_groups_impl = NULL;
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_context_free(DivisionContext* ctx)
+{
+    free(ctx->binding_group_context->binding_groups_impl);
+}
+
+bool division_engine_internal_platform_binding_group_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionBindingGroupInternalPlatform_* binding_groups_impl = realloc(
+        binding_group_ctx->binding_groups_impl,
+        sizeof(DivisionBindingGroupInternalPlatform_[new_size])
+    );
+    if (binding_groups_impl == NULL)
+    {
+        return false;
+    }
+
+    binding_group_ctx->binding_groups_impl = binding_groups_impl;
+
+    return true;
+}
+
+// Resources of the group must outlive it, so they are checked once at the creation
+bool division_engine_internal_platform_binding_group_impl_init_element(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    const DivisionUnorderedIdTable* uniform_ids = &ctx->uniform_buffer_context->id_table;
+    const DivisionBindingGroup* group =
+        &binding_group_ctx->binding_groups[binding_group_id];
+
+    if (!are_bindings_valid_(
+            uniform_ids, group->uniform_vertex_buffers, group->uniform_vertex_buffer_count
+        ) ||
+        !are_bindings_valid_(
+            uniform_ids,
+            group->uniform_fragment_buffers,
+            group->uniform_fragment_buffer_count
+        ))
+    {
+        division_null_validation_error(
+            ctx, "Binding group has an unknown uniform buffer"
+        );
+        return false;
+    }
+
+    if (!are_bindings_valid_(
+            &ctx->texture_context->id_table,
+            group->fragment_textures,
+            group->fragment_texture_count
+        ))
+    {
+        division_null_validation_error(ctx, "Binding group has an unknown texture");
+        return false;
+    }
+
+    binding_group_ctx->binding_groups_impl[binding_group_id] =
+        (DivisionBindingGroupInternalPlatform_){.draw_count = 0};
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_free(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+    division_null_call_stats(ctx)->resource_free_count++;
+}
+
+bool are_bindings_valid_(
+    const DivisionUnorderedIdTable* id_table,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count
+)
+{
+    for (int32_t i = 0; i < binding_count; i++)
+    {
+        if (!division_unordered_id_table_contains(id_table, bindings[i].id))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,33 @@
+#include "division_engine_core/platform_internal/platform_profiler.h"
+
+// There is no GPU, the profiler keeps the CPU timings only
+
+bool division_engine_internal_platform_profiler_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->profiler_context->profiler_impl = NULL;
+    ctx->profiler_context->has_gpu_timers = false;
+    return true;
+}
+
+void division_engine_internal_platform_profiler_context_free(DivisionContext* ctx)
+{
+}
+
+void division_engine_internal_platform_profiler_timestamp(
+    DivisionContext* ctx, uint32_t query_index
+)
+{
+}
+
+bool division_engine_internal_platform_profiler_read_timestamps(
+    DivisionContext* ctx,
+    uint32_t first_query,
+    uint32_t query_count,
+    bool wait,
+    uint64_t* out_timestamps
+)
+{
+    return false;
+}
@@ -0,0 +1,77 @@
+#include "division_engine_core/context.h"
+#include "division_engine_core/platform_internal/platform_render_pass_descriptor.h"
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/shader.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include "null_render_pass.h"
+#include "null_renderer.h"
+
+#include <stdlib.h>
+
+bool division_engine_internal_platform_render_pass_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    pass_ctx->render_passes_descriptors_impl = NULL;
+    pass_ctx->draw_impl = NULL;
+
+    return true;
+}
+
+void division_engine_internal_platform_render_pass_context_free(DivisionContext* ctx)
+{
+    free(ctx->render_pass_context->render_passes_descriptors_impl);
+}
+
+bool division_engine_internal_platform_render_pass_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    pass_ctx->render_passes_descriptors_impl = realloc(
+        pass_ctx->render_passes_descriptors_impl,
+        sizeof(DivisionRenderPassInternalPlatform_[new_size])
+    );
+
+    return pass_ctx->render_passes_descriptors_impl != NULL;
+}
+
+bool division_engine_internal_platform_render_pass_impl_init_element(
+    DivisionContext* ctx, uint32_t render_pass_id
+)
+{
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    const DivisionRenderPassDescriptor* pass_desc =
+        &pass_ctx->render_pass_descriptors[render_pass_id];
+
+    if (!division_unordered_id_table_contains(
+            &ctx->shader_context->id_table, pass_desc->shader_program
+        ))
+    {
+        division_null_validation_error(ctx, "Render pass has an unknown shader program");
+        return false;
+    }
+
+    if (!division_unordered_id_table_contains(
+            &ctx->vertex_buffer_context->id_table, pass_desc->vertex_buffer_id
+        ))
+    {
+        division_null_validation_error(ctx, "Render pass has an unknown vertex buffer");
+        return false;
+    }
+
+    pass_ctx->render_passes_descriptors_impl[render_pass_id] =
+        (DivisionRenderPassInternalPlatform_){.draw_count = 0};
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_render_pass_free(
+    DivisionContext* ctx, uint32_t render_pass_id
+)
+{
+    division_null_call_stats(ctx)->resource_free_count++;
+}
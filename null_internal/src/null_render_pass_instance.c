@@ -0,0 +1,277 @@
+#include "division_engine_core/platform_internal/platform_render_pass_instance.h"
+
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/shader.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/utility.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include "null_binding_group.h"
+#include "null_render_pass.h"
+#include "null_renderer.h"
+#include "null_uniform_buffer.h"
+#include "null_vertex_buffer.h"
+
+static inline bool validate_instance_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* pass_instance
+);
+static inline bool validate_draw_range_(
+    DivisionContext* ctx,
+    const DivisionVertexBuffer* vertex_buffer,
+    const DivisionRenderPassInstance* pass_instance
+);
+static inline bool validate_uniform_bindings_(
+    DivisionContext* ctx, const DivisionIdWithBinding* bindings, int32_t binding_count
+);
+static inline bool validate_ring_bindings_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* pass_instance
+);
+
+void division_engine_internal_platform_render_pass_instance_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+    if (frame->color_load_action == DIVISION_LOAD_ACTION_CLEAR)
+    {
+        division_null_call_stats(ctx)->clear_count++;
+    }
+}
+
+void division_engine_internal_platform_render_pass_instance_set_scissor(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+)
+{
+}
+
+void division_engine_internal_platform_render_pass_instance_end_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+}
+
+/*
+ *  Nothing is drawn, the instances are validated against the resources and counted.
+ *  Invalid instances are reported and skipped
+ */
+void division_engine_internal_platform_render_pass_instance_draw(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instances,
+    uint32_t render_pass_instance_count
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionNullCallStats* call_stats = division_null_call_stats(ctx);
+
+    call_stats->submit_count++;
+
+    const DivisionRenderPassInstance* batch_first = NULL;
+    for (uint32_t i = 0; i < render_pass_instance_count; i++)
+    {
+        const DivisionRenderPassInstance* pass_instance = &render_pass_instances[i];
+        if (!validate_instance_(ctx, pass_instance))
+        {
+            batch_first = NULL;
+            continue;
+        }
+
+        // Compatible neighbours share a single indirect draw in GL
+        if (batch_first == NULL ||
+            !division_engine_render_pass_instance_can_batch(batch_first, pass_instance))
+        {
+            batch_first = pass_instance;
+            call_stats->draw_call_count++;
+        }
+
+        uint32_t pass_desc_id = pass_instance->render_pass_descriptor_id;
+        DivisionRenderPassInternalPlatform_* pass_desc_impl =
+            &render_pass_ctx->render_passes_descriptors_impl[pass_desc_id];
+        pass_desc_impl->draw_count++;
+        call_stats->render_pass_instance_count++;
+
+        if (DIVISION_MASK_HAS_FLAG(
+                pass_instance->capabilities_mask,
+                DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+            ))
+        {
+            DivisionBindingGroupInternalPlatform_* group_impl =
+                &binding_group_ctx->binding_groups_impl[pass_instance->binding_group_id];
+            group_impl->draw_count++;
+        }
+    }
+}
+
+bool validate_instance_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* pass_instance
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionVertexBufferSystemContext* vert_buff_ctx = ctx->vertex_buffer_context;
+
+    uint32_t pass_desc_id = pass_instance->render_pass_descriptor_id;
+    if (!division_unordered_id_table_contains(&render_pass_ctx->id_table, pass_desc_id))
+    {
+        division_null_validation_error(ctx, "Draw has an unknown render pass descriptor");
+        return false;
+    }
+
+    const DivisionRenderPassDescriptor* pass_desc =
+        &render_pass_ctx->render_pass_descriptors[pass_desc_id];
+    if (!division_unordered_id_table_contains(
+            &ctx->shader_context->id_table, pass_desc->shader_program
+        ))
+    {
+        division_null_validation_error(ctx, "Draw uses a freed shader program");
+        return false;
+    }
+
+    if (!division_unordered_id_table_contains(
+            &vert_buff_ctx->id_table, pass_desc->vertex_buffer_id
+        ))
+    {
+        division_null_validation_error(ctx, "Draw uses a freed vertex buffer");
+        return false;
+    }
+
+    // GL doesn't allow the draws from the mapped buffers
+    if (vert_buff_ctx->buffers_impl[pass_desc->vertex_buffer_id].borrowed)
+    {
+        division_null_validation_error(ctx, "Draw uses a borrowed vertex buffer");
+        return false;
+    }
+
+    if (!validate_draw_range_(
+            ctx, &vert_buff_ctx->buffers[pass_desc->vertex_buffer_id], pass_instance
+        ))
+    {
+        return false;
+    }
+
+    if (DIVISION_MASK_HAS_FLAG(
+            pass_instance->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+        ))
+    {
+        if (!division_unordered_id_table_contains(
+                &ctx->binding_group_context->id_table, pass_instance->binding_group_id
+            ))
+        {
+            division_null_validation_error(ctx, "Draw has an unknown binding group");
+            return false;
+        }
+    }
+    else
+    {
+        if (!validate_uniform_bindings_(
+                ctx,
+                pass_instance->uniform_vertex_buffers,
+                pass_instance->uniform_vertex_buffer_count
+            ) ||
+            !validate_uniform_bindings_(
+                ctx,
+                pass_instance->uniform_fragment_buffers,
+                pass_instance->uniform_fragment_buffer_count
+            ))
+        {
+            return false;
+        }
+
+        for (int32_t i = 0; i < pass_instance->fragment_texture_count; i++)
+        {
+            if (!division_unordered_id_table_contains(
+                    &ctx->texture_context->id_table,
+                    pass_instance->fragment_textures[i].id
+                ))
+            {
+                division_null_validation_error(ctx, "Draw has an unknown texture");
+                return false;
+            }
+        }
+    }
+
+    return validate_ring_bindings_(ctx, pass_instance);
+}
+
+bool validate_draw_range_(
+    DivisionContext* ctx,
+    const DivisionVertexBuffer* vertex_buffer,
+    const DivisionRenderPassInstance* pass_instance
+)
+{
+    const DivisionVertexBufferSize* size = &vertex_buffer->settings.size;
+
+    bool in_bounds =
+        size->index_count > 0
+            ? pass_instance->index_count <= size->index_count
+            : (uint64_t) pass_instance->first_vertex + pass_instance->vertex_count <=
+                  size->vertex_count;
+
+    if (DIVISION_MASK_HAS_FLAG(
+            pass_instance->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
+        ))
+    {
+        in_bounds &= (uint64_t) pass_instance->first_instance +
+                         pass_instance->instance_count <=
+                     size->instance_count;
+    }
+
+    if (!in_bounds)
+    {
+        division_null_validation_error(ctx, "Draw range is out of the vertex buffer");
+    }
+
+    return in_bounds;
+}
+
+bool validate_uniform_bindings_(
+    DivisionContext* ctx, const DivisionIdWithBinding* bindings, int32_t binding_count
+)
+{
+    const DivisionUniformBufferSystemContext* uniform_buff_ctx =
+        ctx->uniform_buffer_context;
+
+    for (int32_t i = 0; i < binding_count; i++)
+    {
+        uint32_t buffer_id = bindings[i].id;
+        if (!division_unordered_id_table_contains(&uniform_buff_ctx->id_table, buffer_id))
+        {
+            division_null_validation_error(ctx, "Draw has an unknown uniform buffer");
+            return false;
+        }
+
+        if (uniform_buff_ctx->uniform_buffers_impl[buffer_id].borrowed)
+        {
+            division_null_validation_error(ctx, "Draw uses a borrowed uniform buffer");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool validate_ring_bindings_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* pass_instance
+)
+{
+    const DivisionUniformBufferSystemContext* uniform_buff_ctx =
+        ctx->uniform_buffer_context;
+    const DivisionUniformRingInternal_* ring_impl = uniform_buff_ctx->ring_impl;
+
+    for (int32_t i = 0; i < pass_instance->uniform_ring_binding_count; i++)
+    {
+        const DivisionUniformRingBinding* ring_binding =
+            &pass_instance->uniform_ring_bindings[i];
+
+        if ((uint64_t) ring_binding->offset + ring_binding->size > ring_impl->capacity ||
+            ring_binding->offset % uniform_buff_ctx->ring_alignment != 0)
+        {
+            division_null_validation_error(ctx, "Draw has an invalid uniform ring range");
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,71 @@
+#include "division_engine_core/platform_internal/platform_renderer.h"
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/renderer.h"
+
+#include "null_call_stats.h"
+#include "null_renderer.h"
+
+#include <stdlib.h>
+
+// Frames aren't paced, the delta time is fixed, so the runs are deterministic
+#define DIVISION_NULL_FRAME_DELTA_TIME (1 / 60.0)
+
+bool division_engine_internal_platform_renderer_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionWindowContextPlatformInternal_* window_data =
+        malloc(sizeof(DivisionWindowContextPlatformInternal_));
+    if (window_data == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the null renderer");
+        return false;
+    }
+
+    *window_data = (DivisionWindowContextPlatformInternal_){
+        .frame_limit = settings->frame_limit > 0 ? settings->frame_limit : 1,
+        .call_stats = {0},
+    };
+
+    DivisionRendererSystemContext* renderer_context = ctx->renderer_context;
+    renderer_context->frame_buffer_width = (int32_t) settings->window_width;
+    renderer_context->frame_buffer_height = (int32_t) settings->window_height;
+    renderer_context->window_data = window_data;
+
+    return true;
+}
+
+void division_engine_internal_platform_renderer_free(DivisionContext* ctx)
+{
+    free(ctx->renderer_context->window_data);
+}
+
+void division_engine_internal_platform_renderer_run_loop(DivisionContext* ctx)
+{
+    ctx->lifecycle.init_callback(ctx);
+
+    DivisionWindowContextPlatformInternal_* window_data =
+        ctx->renderer_context->window_data;
+    for (uint32_t i = 0; i < window_data->frame_limit; i++)
+    {
+        ctx->state.delta_time = DIVISION_NULL_FRAME_DELTA_TIME;
+
+        division_engine_renderer_draw(ctx);
+        window_data->call_stats.frame_count++;
+    }
+
+    ctx->lifecycle.free_callback(ctx);
+}
+
+const DivisionNullCallStats* division_engine_null_get_call_stats(
+    const DivisionContext* ctx
+)
+{
+    return &ctx->renderer_context->window_data->call_stats;
+}
+
+void division_engine_null_reset_call_stats(DivisionContext* ctx)
+{
+    ctx->renderer_context->window_data->call_stats = (DivisionNullCallStats){0};
+}
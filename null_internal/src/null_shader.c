@@ -0,0 +1,94 @@
+#include "division_engine_core/context.h"
+#include "division_engine_core/platform_internal/platfrom_shader.h"
+
+#include <stdlib.h>
+
+#include "division_engine_core/shader.h"
+#include "null_renderer.h"
+#include "null_shader.h"
+
+bool division_engine_internal_platform_shader_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->shader_context->shaders_impl = NULL;
+
+    return true;
+}
+
+void division_engine_internal_platform_shader_system_context_free(DivisionContext* ctx)
+{
+    free(ctx->shader_context->shaders_impl);
+}
+
+// Sources aren't compiled, the program only needs a vertex and a fragment stage
+bool division_engine_internal_platform_shader_program_alloc(
+    DivisionContext* ctx,
+    const DivisionShaderSourceDescriptor* settings,
+    int32_t source_count,
+    uint32_t* out_shader_program_id
+)
+{
+    uint32_t stage_mask = 0;
+    for (int i = 0; i < source_count; i++)
+    {
+        const DivisionShaderSourceDescriptor* s = &settings[i];
+        if (s->source == NULL || s->source_size == 0)
+        {
+            division_null_validation_error(ctx, "Shader source is empty");
+            return false;
+        }
+
+        stage_mask |= (uint32_t) s->type;
+    }
+
+    if (stage_mask != (DIVISION_SHADER_VERTEX | DIVISION_SHADER_FRAGMENT))
+    {
+        division_null_validation_error(
+            ctx, "Shader program needs a vertex and a fragment source"
+        );
+        return false;
+    }
+
+    DivisionShaderSystemContext* shader_ctx = ctx->shader_context;
+    uint32_t program_id =
+        division_unordered_id_table_new_id(&ctx->shader_context->id_table);
+
+    if (program_id >= shader_ctx->shader_count)
+    {
+        DivisionShaderInternal_* shaders_impl = realloc(
+            shader_ctx->shaders_impl, sizeof(DivisionShaderInternal_[program_id + 1])
+        );
+
+        if (shaders_impl == NULL)
+        {
+            division_unordered_id_table_remove_id(&shader_ctx->id_table, program_id);
+            DIVISION_THROW_INTERNAL_ERROR(
+                ctx, "Failed to realloc Shader Implementation array"
+            );
+            return false;
+        }
+
+        shader_ctx->shaders_impl = shaders_impl;
+        shader_ctx->shader_count = program_id + 1;
+    }
+
+    shader_ctx->shaders_impl[program_id] =
+        (DivisionShaderInternal_){.stage_mask = stage_mask};
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    *out_shader_program_id = program_id;
+    return true;
+}
+
+void division_engine_internal_platform_shader_program_free(
+    DivisionContext* ctx, uint32_t shader_program_id
+)
+{
+    ctx->shader_context->shaders_impl[shader_program_id].stage_mask = 0;
+    division_null_call_stats(ctx)->resource_free_count++;
+
+    division_unordered_id_table_remove_id(
+        &ctx->shader_context->id_table, shader_program_id
+    );
+}
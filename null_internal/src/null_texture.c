@@ -0,0 +1,92 @@
+#include "division_engine_core/platform_internal/platform_texture.h"
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/texture.h"
+
+#include "null_renderer.h"
+#include "null_texture.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool division_engine_internal_platform_texture_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->texture_context->textures_impl = NULL;
+    return true;
+}
+
+void division_engine_internal_platform_texture_context_free(DivisionContext* ctx)
+{
+    DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    for (uint32_t i = 0; i < tex_ctx->texture_count; i++)
+    {
+        if (division_unordered_id_table_contains(&tex_ctx->id_table, i))
+        {
+            free(tex_ctx->textures_impl[i].data);
+        }
+    }
+    free(tex_ctx->textures_impl);
+}
+
+bool division_engine_internal_platform_texture_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    tex_ctx->textures_impl =
+        realloc(tex_ctx->textures_impl, sizeof(DivisionTextureImpl_[new_size]));
+
+    return tex_ctx->textures_impl != NULL;
+}
+
+bool division_engine_internal_platform_texture_impl_init_new_element(
+    DivisionContext* ctx, uint32_t texture_id
+)
+{
+    DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    DivisionTextureImpl_* tex_impl = &tex_ctx->textures_impl[texture_id];
+    const DivisionTexture* tex = &tex_ctx->textures[texture_id];
+    *tex_impl = (DivisionTextureImpl_){.data = NULL, .data_size = 0};
+
+    size_t data_size = division_engine_texture_data_size(tex);
+    if (data_size == 0)
+    {
+        division_null_validation_error(ctx, "Texture has an unknown format or no pixels");
+        return false;
+    }
+
+    tex_impl->data = calloc(data_size, 1);
+    if (tex_impl->data == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the texture data");
+        return false;
+    }
+
+    tex_impl->data_size = data_size;
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_texture_set_data(
+    DivisionContext* ctx, uint32_t texture_id, const void* data
+)
+{
+    DivisionTextureImpl_* tex_impl = &ctx->texture_context->textures_impl[texture_id];
+
+    memcpy(tex_impl->data, data, tex_impl->data_size);
+    division_null_call_stats(ctx)->update_count++;
+}
+
+void division_engine_internal_platform_texture_free(
+    DivisionContext* ctx, uint32_t texture_id
+)
+{
+    DivisionTextureImpl_* texture = &ctx->texture_context->textures_impl[texture_id];
+    free(texture->data);
+    texture->data = NULL;
+    texture->data_size = 0;
+    division_null_call_stats(ctx)->resource_free_count++;
+}
@@ -0,0 +1,178 @@
+#include "division_engine_core/platform_internal/platform_uniform_buffer.h"
+
+#include "division_engine_core/utility.h"
+
+#include "null_renderer.h"
+#include "null_uniform_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// The smallest alignment of the uniform buffer offsets, which GL allows
+#define UNIFORM_RING_OFFSET_ALIGNMENT 256
+
+bool division_engine_internal_platform_uniform_buffer_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionUniformRingInternal_* ring_impl =
+        malloc(sizeof(DivisionUniformRingInternal_));
+    if (ring_impl == NULL)
+    {
+        return false;
+    }
+
+    *ring_impl = (DivisionUniformRingInternal_){.data = NULL, .capacity = 0};
+    ctx->uniform_buffer_context->uniform_buffers_impl = NULL;
+    ctx->uniform_buffer_context->ring_impl = ring_impl;
+    return true;
+}
+
+void division_engine_internal_platform_uniform_buffer_context_free(DivisionContext* ctx)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+
+    for (uint32_t i = 0; i < uniform_buffer_ctx->uniform_buffer_count; i++)
+    {
+        if (division_unordered_id_table_contains(&uniform_buffer_ctx->id_table, i))
+        {
+            free(uniform_buffer_ctx->uniform_buffers_impl[i].data);
+        }
+    }
+
+    free(uniform_buffer_ctx->ring_impl->data);
+    free(uniform_buffer_ctx->ring_impl);
+    free(uniform_buffer_ctx->uniform_buffers_impl);
+}
+
+bool division_engine_internal_platform_uniform_buffer_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    uniform_buffer_ctx->uniform_buffers_impl = realloc(
+        uniform_buffer_ctx->uniform_buffers_impl,
+        sizeof(DivisionUniformBufferInternal_[new_size])
+    );
+    return uniform_buffer_ctx->uniform_buffers_impl != NULL;
+}
+
+bool division_engine_internal_platform_uniform_buffer_impl_init_element(
+    DivisionContext* ctx, uint32_t buffer_id
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    const DivisionUniformBufferDescriptor* buffer =
+        &uniform_buffer_ctx->uniform_buffers[buffer_id];
+
+    uint8_t* data = calloc(DIVISION_MAX(buffer->data_bytes, 1), 1);
+    uniform_buffer_ctx->uniform_buffers_impl[buffer_id] =
+        (DivisionUniformBufferInternal_){.data = data, .borrowed = false};
+    if (data == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the uniform buffer data");
+        return false;
+    }
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_uniform_buffer_free(
+    DivisionContext* ctx, uint32_t buffer_id
+)
+{
+    DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+
+    if (buff->borrowed)
+    {
+        division_null_validation_error(ctx, "Uniform buffer is freed while borrowed");
+    }
+
+    free(buff->data);
+    buff->data = NULL;
+    buff->borrowed = false;
+    division_null_call_stats(ctx)->resource_free_count++;
+}
+
+void* division_engine_internal_platform_uniform_buffer_borrow_data_pointer(
+    DivisionContext* ctx, uint32_t buffer_id
+)
+{
+    DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+
+    // GL can't map a buffer twice
+    if (buff->borrowed)
+    {
+        division_null_validation_error(ctx, "Uniform buffer is borrowed already");
+        return NULL;
+    }
+
+    buff->borrowed = true;
+    division_null_call_stats(ctx)->borrow_count++;
+
+    return buff->data;
+}
+
+void division_engine_internal_platform_uniform_buffer_return_data_pointer(
+    DivisionContext* ctx, uint32_t buffer_id, void* data_pointer
+)
+{
+    DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+
+    if (!buff->borrowed || data_pointer != buff->data)
+    {
+        division_null_validation_error(ctx, "Uniform buffer pointer isn't borrowed");
+        return;
+    }
+
+    buff->borrowed = false;
+}
+
+void division_engine_internal_platform_uniform_buffer_update_range(
+    DivisionContext* ctx, uint32_t buffer_id, size_t offset, const void* data, size_t size
+)
+{
+    DivisionUniformBufferInternal_* buff =
+        &ctx->uniform_buffer_context->uniform_buffers_impl[buffer_id];
+
+    // GL doesn't allow the sub data updates of a mapped buffer
+    if (buff->borrowed)
+    {
+        division_null_validation_error(ctx, "Uniform buffer is updated while borrowed");
+        return;
+    }
+
+    memcpy(buff->data + offset, data, size);
+    division_null_call_stats(ctx)->update_count++;
+}
+
+bool division_engine_internal_platform_uniform_buffer_ring_alloc(
+    DivisionContext* ctx, size_t capacity, size_t* out_offset_alignment
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    DivisionUniformRingInternal_* ring_impl = uniform_buffer_ctx->ring_impl;
+
+    ring_impl->data = malloc(capacity);
+    if (ring_impl->data == NULL)
+    {
+        return false;
+    }
+
+    ring_impl->capacity = capacity;
+    *out_offset_alignment = UNIFORM_RING_OFFSET_ALIGNMENT;
+    uniform_buffer_ctx->ring_data = ring_impl->data;
+
+    return true;
+}
+
+// Draws are done when they are submitted, so there is nothing to wait for
+void division_engine_internal_platform_uniform_buffer_ring_end_frame(
+    DivisionContext* ctx, uint32_t frame, uint32_t next_frame
+)
+{
+}
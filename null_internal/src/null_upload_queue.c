@@ -0,0 +1,197 @@
+#include "division_engine_core/platform_internal/platform_upload_queue.h"
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include "null_renderer.h"
+#include "null_texture.h"
+#include "null_uniform_buffer.h"
+#include "null_upload_queue.h"
+#include "null_vertex_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static inline const DivisionUnorderedIdTable* get_target_id_table_(
+    const DivisionContext* ctx, DivisionUploadTarget target
+);
+static inline bool get_job_range_(
+    DivisionContext* ctx,
+    const DivisionUploadJob* job,
+    DivisionNullBufferRange_* out_range
+);
+
+bool division_engine_internal_platform_upload_queue_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        malloc(sizeof(DivisionUploadQueueInternalPlatform_));
+    if (upload_impl == NULL)
+    {
+        return false;
+    }
+
+    *upload_impl = (DivisionUploadQueueInternalPlatform_){
+        .staging_data = NULL,
+        .staging_capacity = 0,
+        .completed_fence = 0,
+    };
+    ctx->upload_queue_context->upload_queue_impl = upload_impl;
+
+    return true;
+}
+
+void division_engine_internal_platform_upload_queue_context_free(DivisionContext* ctx)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+
+    free(upload_impl->staging_data);
+    free(upload_impl);
+}
+
+bool division_engine_internal_platform_upload_queue_staging_alloc(
+    DivisionContext* ctx, size_t capacity
+)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+    DivisionUploadQueueInternalPlatform_* upload_impl = upload_ctx->upload_queue_impl;
+
+    upload_impl->staging_data = malloc(capacity);
+    if (upload_impl->staging_data == NULL)
+    {
+        return false;
+    }
+
+    upload_impl->staging_capacity = capacity;
+    upload_ctx->staging_data = upload_impl->staging_data;
+
+    return true;
+}
+
+void division_engine_internal_platform_upload_queue_submit(
+    DivisionContext* ctx,
+    const DivisionUploadJob* jobs,
+    size_t job_count,
+    DivisionUploadFence fence
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+    DivisionNullCallStats* call_stats = division_null_call_stats(ctx);
+
+    for (size_t i = 0; i < job_count; i++)
+    {
+        const DivisionUploadJob* job = &jobs[i];
+
+        DivisionNullBufferRange_ range;
+        if (!get_job_range_(ctx, job, &range))
+        {
+            continue;
+        }
+
+        if (job->dst_offset > range.size || job->size > range.size - job->dst_offset ||
+            job->staging_offset > upload_impl->staging_capacity ||
+            job->size > upload_impl->staging_capacity - job->staging_offset)
+        {
+            division_null_validation_error(ctx, "Upload job is out of the bounds");
+            continue;
+        }
+
+        memcpy(
+            range.data + job->dst_offset,
+            (const uint8_t*) upload_impl->staging_data + job->staging_offset,
+            job->size
+        );
+        call_stats->upload_job_count++;
+        call_stats->uploaded_bytes += job->size;
+    }
+
+    upload_impl->completed_fence = fence;
+}
+
+DivisionUploadFence division_engine_internal_platform_upload_queue_completed_fence(
+    DivisionContext* ctx
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+
+    return upload_impl->completed_fence;
+}
+
+const DivisionUnorderedIdTable* get_target_id_table_(
+    const DivisionContext* ctx, DivisionUploadTarget target
+)
+{
+    switch (target)
+    {
+    case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+    case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+    case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+        return &ctx->vertex_buffer_context->id_table;
+    case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+        return &ctx->uniform_buffer_context->id_table;
+    case DIVISION_UPLOAD_TARGET_TEXTURE:
+        return &ctx->texture_context->id_table;
+    default:
+        return NULL;
+    }
+}
+
+// Jobs of the resources, which are freed before the flush, are reported
+bool get_job_range_(
+    DivisionContext* ctx,
+    const DivisionUploadJob* job,
+    DivisionNullBufferRange_* out_range
+)
+{
+    const DivisionUnorderedIdTable* id_table = get_target_id_table_(ctx, job->target);
+    if (id_table == NULL)
+    {
+        division_null_validation_error(ctx, "Unknown upload target");
+        return false;
+    }
+
+    if (!division_unordered_id_table_contains(id_table, job->resource_id))
+    {
+        division_null_validation_error(ctx, "Upload job targets an unknown resource");
+        return false;
+    }
+
+    const DivisionVertexBufferSystemContext* vb_ctx = ctx->vertex_buffer_context;
+    const DivisionUniformBufferSystemContext* uniform_ctx = ctx->uniform_buffer_context;
+    const DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+
+    switch (job->target)
+    {
+    case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+        *out_range = division_null_vertex_buffer_vertices_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+        *out_range =
+            division_null_vertex_buffer_instances_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+        *out_range = division_null_vertex_buffer_indices_range(vb_ctx, job->resource_id);
+        return true;
+    case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+        *out_range = (DivisionNullBufferRange_){
+            uniform_ctx->uniform_buffers_impl[job->resource_id].data,
+            uniform_ctx->uniform_buffers[job->resource_id].data_bytes,
+        };
+        return true;
+    case DIVISION_UPLOAD_TARGET_TEXTURE:
+        *out_range = (DivisionNullBufferRange_){
+            tex_ctx->textures_impl[job->resource_id].data,
+            tex_ctx->textures_impl[job->resource_id].data_size,
+        };
+        return true;
+    default:
+        return false;
+    }
+}
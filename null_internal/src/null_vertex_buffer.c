@@ -0,0 +1,228 @@
+#include "division_engine_core/platform_internal/platform_vertex_buffer.h"
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/utility.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include "null_renderer.h"
+#include "null_vertex_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static inline size_t get_data_size_(const DivisionVertexBuffer* vb);
+
+bool division_engine_internal_platform_vertex_buffer_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->vertex_buffer_context->buffers_impl = NULL;
+
+    return true;
+}
+
+void division_engine_internal_platform_vertex_buffer_context_free(DivisionContext* ctx)
+{
+    DivisionVertexBufferSystemContext* vertex_buffer_ctx = ctx->vertex_buffer_context;
+
+    for (uint32_t i = 0; i < vertex_buffer_ctx->buffers_count; i++)
+    {
+        if (division_unordered_id_table_contains(&vertex_buffer_ctx->id_table, i))
+        {
+            free(vertex_buffer_ctx->buffers_impl[i].data);
+        }
+    }
+
+    free(vertex_buffer_ctx->buffers_impl);
+}
+
+bool division_engine_internal_platform_vertex_buffer_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+    vertex_ctx->buffers_impl = realloc(
+        vertex_ctx->buffers_impl, sizeof(DivisionVertexBufferInternalPlatform_[new_size])
+    );
+
+    return vertex_ctx->buffers_impl != NULL;
+}
+
+bool division_engine_internal_platform_vertex_buffer_impl_init_element(
+    DivisionContext* ctx, uint32_t buffer_id
+)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+    const DivisionVertexBuffer* vb = &vertex_ctx->buffers[buffer_id];
+
+    uint8_t* data = calloc(DIVISION_MAX(get_data_size_(vb), 1), 1);
+    vertex_ctx->buffers_impl[buffer_id] = (DivisionVertexBufferInternalPlatform_){
+        .data = data,
+        .borrowed = false,
+    };
+    if (data == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the vertex buffer data");
+        return false;
+    }
+    division_null_call_stats(ctx)->resource_alloc_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_vertex_buffer_free(
+    DivisionContext* ctx, uint32_t buffer_id
+)
+{
+    DivisionVertexBufferInternalPlatform_* buffer_impl =
+        &ctx->vertex_buffer_context->buffers_impl[buffer_id];
+
+    if (buffer_impl->borrowed)
+    {
+        division_null_validation_error(ctx, "Vertex buffer is freed while borrowed");
+    }
+
+    free(buffer_impl->data);
+    buffer_impl->data = NULL;
+    buffer_impl->borrowed = false;
+    division_null_call_stats(ctx)->resource_free_count++;
+}
+
+bool division_engine_internal_platform_vertex_buffer_borrow_data_pointer(
+    DivisionContext* ctx,
+    uint32_t buffer_id,
+    DivisionVertexBufferBorrowedData* out_borrow_data
+)
+{
+    DivisionVertexBufferSystemContext* vertex_buffer_ctx = ctx->vertex_buffer_context;
+    DivisionVertexBufferInternalPlatform_* vb =
+        &vertex_buffer_ctx->buffers_impl[buffer_id];
+
+    // GL can't map a buffer twice
+    if (vb->borrowed)
+    {
+        division_null_validation_error(ctx, "Vertex buffer is borrowed already");
+        return false;
+    }
+
+    vb->borrowed = true;
+    out_borrow_data->vertex_data_ptr =
+        division_null_vertex_buffer_vertices_range(vertex_buffer_ctx, buffer_id).data;
+    out_borrow_data->instance_data_ptr =
+        division_null_vertex_buffer_instances_range(vertex_buffer_ctx, buffer_id).data;
+    out_borrow_data->index_data_ptr =
+        division_null_vertex_buffer_indices_range(vertex_buffer_ctx, buffer_id).data;
+    division_null_call_stats(ctx)->borrow_count++;
+
+    return true;
+}
+
+void division_engine_internal_platform_vertex_buffer_return_data_pointer(
+    DivisionContext* ctx,
+    uint32_t buffer_id,
+    DivisionVertexBufferBorrowedData* out_borrow_data
+)
+{
+    DivisionVertexBufferInternalPlatform_* vb =
+        &ctx->vertex_buffer_context->buffers_impl[buffer_id];
+
+    if (!vb->borrowed)
+    {
+        division_null_validation_error(ctx, "Vertex buffer isn't borrowed");
+        return;
+    }
+
+    vb->borrowed = false;
+}
+
+void division_engine_internal_platform_vertex_buffer_copy_data(
+    DivisionContext* ctx, uint32_t src_buffer, uint32_t dst_buffer
+)
+{
+    DivisionVertexBufferSystemContext* vb_context = ctx->vertex_buffer_context;
+    const DivisionVertexBuffer* src_vb = &vb_context->buffers[src_buffer];
+    const DivisionVertexBuffer* dst_vb = &vb_context->buffers[dst_buffer];
+
+    memcpy(
+        division_null_vertex_buffer_vertices_range(vb_context, dst_buffer).data,
+        division_null_vertex_buffer_vertices_range(vb_context, src_buffer).data,
+        DIVISION_MIN(
+            division_engine_vertex_buffer_vertices_bytes(src_vb),
+            division_engine_vertex_buffer_vertices_bytes(dst_vb)
+        )
+    );
+    memcpy(
+        division_null_vertex_buffer_instances_range(vb_context, dst_buffer).data,
+        division_null_vertex_buffer_instances_range(vb_context, src_buffer).data,
+        DIVISION_MIN(
+            division_engine_vertex_buffer_instances_bytes(src_vb),
+            division_engine_vertex_buffer_instances_bytes(dst_vb)
+        )
+    );
+    memcpy(
+        division_null_vertex_buffer_indices_range(vb_context, dst_buffer).data,
+        division_null_vertex_buffer_indices_range(vb_context, src_buffer).data,
+        DIVISION_MIN(
+            division_engine_vertex_buffer_indices_bytes(src_vb),
+            division_engine_vertex_buffer_indices_bytes(dst_vb)
+        )
+    );
+}
+
+void division_engine_internal_platform_vertex_buffer_swap_data(
+    DivisionContext* ctx, uint32_t src_id, uint32_t dst_id
+)
+{
+    DivisionVertexBufferSystemContext* vb_context = ctx->vertex_buffer_context;
+    DIVISION_SWAP(
+        DivisionVertexBufferInternalPlatform_,
+        vb_context->buffers_impl[src_id],
+        vb_context->buffers_impl[dst_id]
+    );
+}
+
+DivisionNullBufferRange_ division_null_vertex_buffer_vertices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBuffer* vb = &vb_ctx->buffers[buffer_id];
+
+    return (DivisionNullBufferRange_){
+        .data = vb_ctx->buffers_impl[buffer_id].data,
+        .size = division_engine_vertex_buffer_vertices_capacity_bytes(vb),
+    };
+}
+
+DivisionNullBufferRange_ division_null_vertex_buffer_instances_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBuffer* vb = &vb_ctx->buffers[buffer_id];
+
+    return (DivisionNullBufferRange_){
+        .data = vb_ctx->buffers_impl[buffer_id].data +
+                division_engine_vertex_buffer_vertices_capacity_bytes(vb),
+        .size = division_engine_vertex_buffer_instances_capacity_bytes(vb),
+    };
+}
+
+DivisionNullBufferRange_ division_null_vertex_buffer_indices_range(
+    const DivisionVertexBufferSystemContext* vb_ctx, uint32_t buffer_id
+)
+{
+    const DivisionVertexBuffer* vb = &vb_ctx->buffers[buffer_id];
+
+    return (DivisionNullBufferRange_){
+        .data = vb_ctx->buffers_impl[buffer_id].data +
+                division_engine_vertex_buffer_vertices_capacity_bytes(vb) +
+                division_engine_vertex_buffer_instances_capacity_bytes(vb),
+        .size = division_engine_vertex_buffer_indices_capacity_bytes(vb),
+    };
+}
+
+size_t get_data_size_(const DivisionVertexBuffer* vb)
+{
+    return division_engine_vertex_buffer_vertices_capacity_bytes(vb) +
+           division_engine_vertex_buffer_instances_capacity_bytes(vb) +
+           division_engine_vertex_buffer_indices_capacity_bytes(vb);
+}
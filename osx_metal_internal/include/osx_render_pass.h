@@ -4,4 +4,14 @@
 
 typedef struct DivisionRenderPassInternalPlatform_ {
     __strong id<MTLRenderPipelineState> mtl_pipeline_state;
+    // nil without the depth attachment
+    __strong id<MTLDepthStencilState> mtl_depth_stencil_state;
 } DivisionRenderPassInternalPlatform_;
+
+// Command buffer and encoder of the begun frame, the submits of the frame append to them
+typedef struct DivisionRenderPassDrawInternalPlatform_ {
+    __strong id<MTLCommandBuffer> mtl_command_buffer;
+    __strong id<MTLRenderCommandEncoder> mtl_render_encoder;
+    // Kept contents of the partial redraw, copied to the drawable by the end of frame
+    __strong id<MTLTexture> mtl_offscreen_texture;
+} DivisionRenderPassDrawInternalPlatform_;
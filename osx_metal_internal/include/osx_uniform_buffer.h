@@ -2,7 +2,17 @@
 
 #include <Metal/Metal.h>
 
+#include "division_engine_core/uniform_buffer.h"
+
 typedef struct DivisionUniformBufferInternal_
 {
     __strong id<MTLBuffer> mtl_buffer;
 } DivisionUniformBufferInternal_;
+
+typedef struct DivisionUniformRingInternal_
+{
+    __strong id<MTLBuffer> mtl_buffer;
+
+    // Counts the free frame regions, signaled by the completion of the frame
+    __strong dispatch_semaphore_t free_frames;
+} DivisionUniformRingInternal_;
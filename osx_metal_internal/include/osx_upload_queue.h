@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Metal/Metal.h>
+#include <stdatomic.h>
+
+#include "division_engine_core/types/upload_queue.h"
+
+typedef struct DivisionUploadQueueInternalPlatform_
+{
+    __strong id<MTLBuffer> mtl_staging_buffer;
+
+    // Written by the completion handlers of the upload command buffers
+    _Atomic(DivisionUploadFence) completed_fence;
+} DivisionUploadQueueInternalPlatform_;
@@ -8,4 +8,5 @@ typedef struct DivisionVertexBufferInternalPlatform_
     __strong id<MTLBuffer> mtl_index_buffer;
     __strong MTLVertexDescriptor* mtl_vertex_descriptor;
     MTLPrimitiveType mtl_primitive_type;
+    MTLIndexType mtl_index_type;
 } DivisionVertexBufferInternalPlatform_;
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "DivisionOSXAppDelegate.h"
 
 #include <division_engine_core/context.h>
+#include <division_engine_core/render_pass_descriptor.h>
 #include <division_engine_core/renderer.h>
 
 #include <CoreFoundation/CoreFoundation.h>
@@ -9,6 +10,9 @@
 #include <stdbool.h>
 
 static NSMenu* createMenuBar(DivisionOSXAppDelegate* app_delegate);
+static MTLPixelFormat division_to_mtl_depth_stencil_format(
+    DivisionDepthStencilFormat format
+);
 
 @implementation DivisionOSXAppDelegate
 - (instancetype)initWithContext:(DivisionContext*)aContext
@@ -65,6 +69,11 @@ static NSMenu* createMenuBar(DivisionOSXAppDelegate* app_delegate);
     id<MTLDevice> device = MTLCreateSystemDefaultDevice();
     view = [[MTKView alloc] initWithFrame:windowFrame device:device];
     [view setColorPixelFormat:MTLPixelFormatBGRA8Unorm_sRGB];
+    // The partial redraw copies its offscreen target to the drawable
+    [view setFramebufferOnly:!context->render_pass_context->partial_redraw];
+    [view setDepthStencilPixelFormat:division_to_mtl_depth_stencil_format(
+                                         context->renderer_context->depth_stencil_format
+                                     )];
 
     CGSize drawableSize =  [view drawableSize];
     context->renderer_context->frame_buffer_width = drawableSize.width;
@@ -123,4 +132,19 @@ NSMenu* createMenuBar(DivisionOSXAppDelegate* app_delegate)
     }
 
     return mainMenu;
-}
\ No newline at end of file
+}
+
+// Apple GPUs have no packed 24 bit depth, the stencil is paired with the float depth
+MTLPixelFormat division_to_mtl_depth_stencil_format(DivisionDepthStencilFormat format)
+{
+    switch (format)
+    {
+    case DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8:
+        return MTLPixelFormatDepth32Float_Stencil8;
+    case DIVISION_DEPTH_STENCIL_FORMAT_DEPTH32:
+        return MTLPixelFormatDepth32Float;
+    case DIVISION_DEPTH_STENCIL_FORMAT_NONE:
+    default:
+        return MTLPixelFormatInvalid;
+    }
+}
@@ -58,7 +58,7 @@ static inline void handle_inputs(
 - (void)drawInMTKView:(nonnull MTKView*)view
 {
     handle_inputs(view, context, keycode_map);
-    context->lifecycle.draw_callback(context);
+    division_engine_renderer_draw(context);
 }
 
 - (void)mtkView:(nonnull MTKView*)view drawableSizeWillChange:(CGSize)size
@@ -0,0 +1,36 @@
+#include "division_engine_core/platform_internal/platform_binding_group.h"
+
+// Metal binds every buffer and texture by its own call, so the draw loop reads the
+// bindings straight from the core binding groups and there is no platform state
+
+bool division_engine_internal_platform_binding_group_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->binding_group_context->binding_groups_impl = NULL;
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_context_free(DivisionContext* ctx)
+{
+}
+
+bool division_engine_internal_platform_binding_group_realloc(
+    DivisionContext* ctx, size_t new_size
+)
+{
+    return true;
+}
+
+bool division_engine_internal_platform_binding_group_impl_init_element(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+    return true;
+}
+
+void division_engine_internal_platform_binding_group_free(
+    DivisionContext* ctx, uint32_t binding_group_id
+)
+{
+}
@@ -4,11 +4,25 @@
 #include "osx_uniform_buffer.h"
 #include "osx_window_context.h"
 
+// Offsets of the constant buffers must be aligned to 256 bytes on macOS
+#define RING_OFFSET_ALIGNMENT 256
+
 bool division_engine_internal_platform_uniform_buffer_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
 {
+    DivisionUniformRingInternal_* ring_impl =
+        calloc(1, sizeof(DivisionUniformRingInternal_));
+    if (ring_impl == NULL)
+    {
+        return false;
+    }
+
+    // The first frame region is taken from the start
+    ring_impl->free_frames =
+        dispatch_semaphore_create(DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT - 1);
     ctx->uniform_buffer_context->uniform_buffers_impl = NULL;
+    ctx->uniform_buffer_context->ring_impl = ring_impl;
     return true;
 }
 
@@ -25,6 +39,11 @@ void division_engine_internal_platform_uniform_buffer_context_free(DivisionConte
     }
 
     free(uniform_buffers_impl);
+
+    DivisionUniformRingInternal_* ring_impl = uniform_buffer_ctx->ring_impl;
+    ring_impl->mtl_buffer = nil;
+    ring_impl->free_frames = nil;
+    free(ring_impl);
 }
 
 void* division_engine_internal_platform_uniform_buffer_borrow_data_pointer(
@@ -45,6 +64,38 @@ void division_engine_internal_platform_uniform_buffer_return_data_pointer(
     [mtl_buffer didModifyRange:NSMakeRange(0, [mtl_buffer length])];
 }
 
+void division_engine_internal_platform_uniform_buffer_update_range(
+    DivisionContext* ctx, uint32_t buffer_id, size_t offset, const void* data, size_t size
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    const DivisionUniformBufferDescriptor* buffer =
+        &uniform_buffer_ctx->uniform_buffers[buffer_id];
+    DivisionUniformBufferInternal_* buffer_impl =
+        &uniform_buffer_ctx->uniform_buffers_impl[buffer_id];
+
+    // Command buffers in flight retain the previous buffer, so it is replaced at once
+    if (buffer->update_policy == DIVISION_UNIFORM_BUFFER_UPDATE_ORPHAN &&
+        size == buffer->data_bytes)
+    {
+        DivisionOSXWindowContext* window_ctx = ctx->renderer_context->window_data;
+        id<MTLDevice> device = window_ctx->app_delegate->viewDelegate->device;
+        id<MTLBuffer> mtl_buffer =
+            [device newBufferWithBytes:data
+                                length:size
+                               options:MTLResourceStorageModeManaged];
+        if (mtl_buffer != nil)
+        {
+            buffer_impl->mtl_buffer = mtl_buffer;
+            return;
+        }
+    }
+
+    uint8_t* buffer_data = [buffer_impl->mtl_buffer contents];
+    memcpy(buffer_data + offset, data, size);
+    [buffer_impl->mtl_buffer didModifyRange:NSMakeRange(offset, size)];
+}
+
 void division_engine_internal_platform_uniform_buffer_free(
     DivisionContext* ctx, uint32_t buffer_id
 )
@@ -91,4 +142,48 @@ bool division_engine_internal_platform_uniform_buffer_impl_init_element(
     internal_buffer->mtl_buffer = mtl_buffer;
 
     return true;
-}
\ No newline at end of file
+}
+
+bool division_engine_internal_platform_uniform_buffer_ring_alloc(
+    DivisionContext* ctx, size_t capacity, size_t* out_offset_alignment
+)
+{
+    DivisionOSXWindowContext* window_ctx = ctx->renderer_context->window_data;
+    id<MTLDevice> device = window_ctx->app_delegate->viewDelegate->device;
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    DivisionUniformRingInternal_* ring_impl = uniform_buffer_ctx->ring_impl;
+
+    ring_impl->mtl_buffer =
+        [device newBufferWithLength:capacity options:MTLResourceStorageModeShared];
+    if (ring_impl->mtl_buffer == nil)
+    {
+        return false;
+    }
+
+    *out_offset_alignment = RING_OFFSET_ALIGNMENT;
+    uniform_buffer_ctx->ring_data = [ring_impl->mtl_buffer contents];
+    return true;
+}
+
+void division_engine_internal_platform_uniform_buffer_ring_end_frame(
+    DivisionContext* ctx, uint32_t frame, uint32_t next_frame
+)
+{
+    @autoreleasepool
+    {
+        DivisionOSXWindowContext* window_ctx = ctx->renderer_context->window_data;
+        id<MTLCommandQueue> commandQueue =
+            window_ctx->app_delegate->viewDelegate->commandQueue;
+        dispatch_semaphore_t free_frames =
+            ctx->uniform_buffer_context->ring_impl->free_frames;
+
+        // The queue runs in order, so the empty buffer completes after the frame draws
+        id<MTLCommandBuffer> cmdBuffer = [commandQueue commandBuffer];
+        [cmdBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+          dispatch_semaphore_signal(free_frames);
+        }];
+        [cmdBuffer commit];
+
+        dispatch_semaphore_wait(free_frames, DISPATCH_TIME_FOREVER);
+    }
+}
@@ -0,0 +1,178 @@
+#include "division_engine_core/platform_internal/platform_texture.h"
+#include "division_engine_core/platform_internal/platform_upload_queue.h"
+
+#include "division_engine_core/renderer.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/vertex_buffer.h"
+#include "osx_texture.h"
+#include "osx_uniform_buffer.h"
+#include "osx_upload_queue.h"
+#include "osx_vertex_buffer.h"
+#include "osx_window_context.h"
+
+static inline void copy_to_texture_(
+    DivisionContext* ctx,
+    id<MTLBlitCommandEncoder> blitEnc,
+    id<MTLBuffer> staging_buffer,
+    const DivisionUploadJob* job
+);
+
+bool division_engine_internal_platform_upload_queue_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        calloc(1, sizeof(DivisionUploadQueueInternalPlatform_));
+    if (upload_impl == NULL)
+    {
+        return false;
+    }
+
+    atomic_init(&upload_impl->completed_fence, 0);
+    ctx->upload_queue_context->upload_queue_impl = upload_impl;
+
+    return true;
+}
+
+void division_engine_internal_platform_upload_queue_context_free(DivisionContext* ctx)
+{
+    DivisionUploadQueueInternalPlatform_* upload_impl =
+        ctx->upload_queue_context->upload_queue_impl;
+
+    upload_impl->mtl_staging_buffer = nil;
+    free(upload_impl);
+}
+
+bool division_engine_internal_platform_upload_queue_staging_alloc(
+    DivisionContext* ctx, size_t capacity
+)
+{
+    DivisionOSXWindowContext* window_ctx = ctx->renderer_context->window_data;
+    id<MTLDevice> device = window_ctx->app_delegate->viewDelegate->device;
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+    DivisionUploadQueueInternalPlatform_* upload_impl = upload_ctx->upload_queue_impl;
+
+    upload_impl->mtl_staging_buffer =
+        [device newBufferWithLength:capacity options:MTLResourceStorageModeShared];
+    if (upload_impl->mtl_staging_buffer == nil)
+    {
+        return false;
+    }
+
+    upload_ctx->staging_data = [upload_impl->mtl_staging_buffer contents];
+    return true;
+}
+
+void division_engine_internal_platform_upload_queue_submit(
+    DivisionContext* ctx,
+    const DivisionUploadJob* jobs,
+    size_t job_count,
+    DivisionUploadFence fence
+)
+{
+    @autoreleasepool
+    {
+        DivisionOSXWindowContext* window_ctx = ctx->renderer_context->window_data;
+        id<MTLCommandQueue> commandQueue =
+            window_ctx->app_delegate->viewDelegate->commandQueue;
+        DivisionUploadQueueInternalPlatform_* upload_impl =
+            ctx->upload_queue_context->upload_queue_impl;
+        id<MTLBuffer> staging_buffer = upload_impl->mtl_staging_buffer;
+
+        const DivisionVertexBufferSystemContext* vb_ctx = ctx->vertex_buffer_context;
+        const DivisionUniformBufferSystemContext* uniform_ctx =
+            ctx->uniform_buffer_context;
+
+        id<MTLCommandBuffer> cmdBuffer = [commandQueue commandBuffer];
+        id<MTLBlitCommandEncoder> blitEnc = [cmdBuffer blitCommandEncoder];
+
+        for (size_t i = 0; i < job_count; i++)
+        {
+            const DivisionUploadJob* job = &jobs[i];
+            const DivisionVertexBuffer* vb = &vb_ctx->buffers[job->resource_id];
+            const DivisionUniformBufferInternal_* uniform_impl =
+                &uniform_ctx->uniform_buffers_impl[job->resource_id];
+            id<MTLBuffer> dst_buffer = nil;
+            size_t dst_offset = job->dst_offset;
+
+            switch (job->target)
+            {
+            case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+                dst_buffer = vb_ctx->buffers_impl[job->resource_id].mtl_vertex_buffer;
+                break;
+            case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+                dst_buffer = vb_ctx->buffers_impl[job->resource_id].mtl_vertex_buffer;
+                dst_offset += division_engine_vertex_buffer_vertices_capacity_bytes(vb);
+                break;
+            case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+                dst_buffer = vb_ctx->buffers_impl[job->resource_id].mtl_index_buffer;
+                break;
+            case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+                dst_buffer = uniform_impl->mtl_buffer;
+                break;
+            case DIVISION_UPLOAD_TARGET_TEXTURE:
+                copy_to_texture_(ctx, blitEnc, staging_buffer, job);
+                continue;
+            default:
+                DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown upload target");
+                continue;
+            }
+
+            [blitEnc copyFromBuffer:staging_buffer
+                       sourceOffset:job->staging_offset
+                           toBuffer:dst_buffer
+                  destinationOffset:dst_offset
+                               size:job->size];
+
+            // Managed buffers keep the CPU copy, which is read by the borrow functions
+            [blitEnc synchronizeResource:dst_buffer];
+        }
+
+        [blitEnc endEncoding];
+        [cmdBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+          atomic_store(&upload_impl->completed_fence, fence);
+        }];
+        [cmdBuffer commit];
+    }
+}
+
+DivisionUploadFence division_engine_internal_platform_upload_queue_completed_fence(
+    DivisionContext* ctx
+)
+{
+    return atomic_load(&ctx->upload_queue_context->upload_queue_impl->completed_fence);
+}
+
+void copy_to_texture_(
+    DivisionContext* ctx,
+    id<MTLBlitCommandEncoder> blitEnc,
+    id<MTLBuffer> staging_buffer,
+    const DivisionUploadJob* job
+)
+{
+    const DivisionTextureSystemContext* tex_ctx = ctx->texture_context;
+    const DivisionTexture* tex = &tex_ctx->textures[job->resource_id];
+    const DivisionTextureImpl_* tex_impl = &tex_ctx->textures_impl[job->resource_id];
+
+    // Formats, which are expanded for Metal, are converted on the CPU
+    if (tex_impl->bytes_per_pixel != tex_impl->src_data_bytes_per_pixel)
+    {
+        const uint8_t* staging_data = [staging_buffer contents];
+        division_engine_internal_platform_texture_set_data(
+            ctx, job->resource_id, staging_data + job->staging_offset
+        );
+        return;
+    }
+
+    size_t bytes_per_row = tex_impl->bytes_per_pixel * tex->width;
+    [blitEnc copyFromBuffer:staging_buffer
+               sourceOffset:job->staging_offset
+          sourceBytesPerRow:bytes_per_row
+        sourceBytesPerImage:bytes_per_row * tex->height
+                 sourceSize:MTLSizeMake(tex->width, tex->height, 1)
+                  toTexture:tex_impl->mtl_texture
+           destinationSlice:0
+           destinationLevel:0
+          destinationOrigin:MTLOriginMake(0, 0, 0)];
+}
@@ -80,7 +80,7 @@ bool division_engine_internal_platform_vertex_buffer_borrow_data_pointer(
     out_borrow_data->index_data_ptr = [impl_buffer->mtl_index_buffer contents];
     out_borrow_data->vertex_data_ptr = ptr;
     out_borrow_data->instance_data_ptr =
-        ptr + division_engine_vertex_buffer_vertices_bytes(vertex_buffer);
+        ptr + division_engine_vertex_buffer_vertices_capacity_bytes(vertex_buffer);
 
     return true;
 }
@@ -132,14 +132,14 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
 
     DivisionVertexBufferSystemContext* vert_buffer_ctx = ctx->vertex_buffer_context;
     const DivisionVertexBuffer* vertex_buffer = &vert_buffer_ctx->buffers[buffer_id];
-    DivisionVertexBufferSize buffer_size = vertex_buffer->settings.size;
     DivisionVertexBufferInternalPlatform_* impl_buffer =
         &vert_buffer_ctx->buffers_impl[buffer_id];
 
-    size_t idx_buffer_size = sizeof(uint32_t[buffer_size.index_count]);
+    size_t idx_buffer_size =
+        division_engine_vertex_buffer_indices_capacity_bytes(vertex_buffer);
     size_t vert_buffer_size =
-        vertex_buffer->per_vertex_data_size * buffer_size.vertex_count +
-        vertex_buffer->per_instance_data_size * buffer_size.instance_count;
+        division_engine_vertex_buffer_vertices_capacity_bytes(vertex_buffer) +
+        division_engine_vertex_buffer_instances_capacity_bytes(vertex_buffer);
 
     id<MTLBuffer> vert_buffer =
         [device newBufferWithLength:vert_buffer_size
@@ -167,6 +167,10 @@ bool division_engine_internal_platform_vertex_buffer_impl_init_element(
     impl_buffer->mtl_vertex_descriptor = vertex_descriptor;
     impl_buffer->mtl_primitive_type =
         division_topology_to_mtl_type(ctx, vertex_buffer->settings.topology);
+    impl_buffer->mtl_index_type =
+        division_engine_vertex_buffer_index_size(vertex_buffer) == sizeof(uint16_t)
+            ? MTLIndexTypeUInt16
+            : MTLIndexTypeUInt32;
 
     return true;
 }
@@ -190,8 +194,10 @@ DIVISION_EXPORT void division_engine_internal_platform_vertex_buffer_copy_data(
 
     memcpy(dst_vertex_ptr, src_vertex_ptr, DIVISION_MIN(src_vert_bytes, dst_vert_bytes));
 
-    const void* src_instance_ptr = src_vertex_ptr + src_vert_bytes;
-    void* dst_instance_ptr = dst_vertex_ptr + dst_vert_bytes;
+    const void* src_instance_ptr =
+        src_vertex_ptr + division_engine_vertex_buffer_vertices_capacity_bytes(src_buff);
+    void* dst_instance_ptr =
+        dst_vertex_ptr + division_engine_vertex_buffer_vertices_capacity_bytes(dst_buff);
     memcpy(
         dst_instance_ptr,
         src_instance_ptr,
@@ -235,6 +241,10 @@ MTLPrimitiveType division_topology_to_mtl_type(
         return MTLPrimitiveTypePoint;
     case DIVISION_TOPOLOGY_LINES:
         return MTLPrimitiveTypeLine;
+    case DIVISION_TOPOLOGY_TRIANGLE_STRIP:
+        return MTLPrimitiveTypeTriangleStrip;
+    case DIVISION_TOPOLOGY_LINE_STRIP:
+        return MTLPrimitiveTypeLineStrip;
     default:
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown topology");
         return 0;
@@ -274,7 +284,7 @@ MTLVertexDescriptor* create_vertex_descriptor(
             vertex_buffer->settings.per_instance_attributes,
             vertex_buffer->settings.per_instance_attribute_count,
             attrDescArray,
-            division_engine_vertex_buffer_vertices_bytes(vertex_buffer),
+            division_engine_vertex_buffer_vertices_capacity_bytes(vertex_buffer),
             DIVISION_MTL_VERTEX_DATA_INSTANCE_ARRAY_INDEX
         );
 
@@ -308,7 +318,7 @@ void define_msl_vertex_attributes(
         size_t comp_size = attr->base_size * gl_attr_comp_count;
         size_t offset = attributes_offset + attr->offset;
 
-        for (int comp_idx = 0; comp_idx < gl_attr_comp_count; comp_idx++)
+        for (int comp_idx = 0; comp_idx < traits.divide_by_components; comp_idx++)
         {
             MTLVertexAttributeDescriptor* attrDesc = [attr_desc_arr
                 objectAtIndexedSubscript:attr_setting->location + comp_idx];
@@ -337,6 +347,24 @@ DivisionToMslAttrTraits_ get_vert_attr_msl_traits_(
         return (DivisionToMslAttrTraits_){MTLVertexFormatFloat4, 1};
     case DIVISION_FMAT4X4:
         return (DivisionToMslAttrTraits_){MTLVertexFormatFloat4, 4};
+    case DIVISION_HVEC2:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatHalf2, 1};
+    case DIVISION_HVEC4:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatHalf4, 1};
+    case DIVISION_UBYTE4_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatUChar4Normalized, 1};
+    case DIVISION_BYTE4_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatChar4Normalized, 1};
+    case DIVISION_USHORT2_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatUShort2Normalized, 1};
+    case DIVISION_USHORT4_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatUShort4Normalized, 1};
+    case DIVISION_SHORT2_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatShort2Normalized, 1};
+    case DIVISION_SHORT4_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatShort4Normalized, 1};
+    case DIVISION_INT_2_10_10_10_REV_NORM:
+        return (DivisionToMslAttrTraits_){MTLVertexFormatInt1010102Normalized, 1};
     case DIVISION_DOUBLE:
     default:
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Unsupported attribute type");
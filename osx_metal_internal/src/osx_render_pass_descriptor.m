@@ -22,11 +22,34 @@ static inline bool try_get_mtl_blend_op(
 
 static inline MTLColorWriteMask division_to_mtl_color_mask(DivisionColorMask color_mask);
 
+static inline bool try_get_mtl_compare_func(
+    DivisionContext* ctx,
+    DivisionCompareFunction compare,
+    MTLCompareFunction* out_mtl_compare
+);
+
+static inline bool init_depth_stencil_state(
+    DivisionContext* ctx,
+    const DivisionRenderPassDescriptor* render_pass_desc,
+    DivisionRenderPassInternalPlatform_* render_pass_impl,
+    id<MTLDevice> device
+);
+
 bool division_engine_internal_platform_render_pass_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
 {
-    ctx->render_pass_context->render_passes_descriptors_impl = NULL;
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    render_pass_ctx->render_passes_descriptors_impl = NULL;
+
+    // Zeroed memory keeps the strong references nil
+    render_pass_ctx->draw_impl =
+        calloc(1, sizeof(DivisionRenderPassDrawInternalPlatform_));
+    if (render_pass_ctx->draw_impl == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the render pass draw");
+        return false;
+    }
 
     return true;
 }
@@ -38,8 +61,16 @@ void division_engine_internal_platform_render_pass_context_free(DivisionContext*
         DivisionRenderPassInternalPlatform_* pass =
             &ctx->render_pass_context->render_passes_descriptors_impl[i];
         pass->mtl_pipeline_state = nil;
+        pass->mtl_depth_stencil_state = nil;
     }
     free(ctx->render_pass_context->render_passes_descriptors_impl);
+
+    DivisionRenderPassDrawInternalPlatform_* draw_impl =
+        ctx->render_pass_context->draw_impl;
+    draw_impl->mtl_render_encoder = nil;
+    draw_impl->mtl_command_buffer = nil;
+    draw_impl->mtl_offscreen_texture = nil;
+    free(draw_impl);
 }
 
 void division_engine_internal_platform_render_pass_free(
@@ -49,6 +80,7 @@ void division_engine_internal_platform_render_pass_free(
     DivisionRenderPassInternalPlatform_* render_pass_impl =
         &ctx->render_pass_context->render_passes_descriptors_impl[pass_id];
     render_pass_impl->mtl_pipeline_state = nil;
+    render_pass_impl->mtl_depth_stencil_state = nil;
 }
 
 bool division_engine_internal_platform_render_pass_realloc(
@@ -79,6 +111,7 @@ bool division_engine_internal_platform_render_pass_impl_init_element(
         &ctx->vertex_buffer_context->buffers_impl[render_pass_desc->vertex_buffer_id];
     DivisionOSXViewDelegate* view_delegate =
         ctx->renderer_context->window_data->app_delegate->viewDelegate;
+    MTKView* view = ctx->renderer_context->window_data->app_delegate->view;
     DivisionAlphaBlendingOptions* blend_options =
         &render_pass_desc->alpha_blending_options;
 
@@ -125,6 +158,13 @@ bool division_engine_internal_platform_render_pass_impl_init_element(
         [color_attach_desc setAlphaBlendOperation:mtl_blend_op];
     }
 
+    MTLPixelFormat depth_stencil_format = [view depthStencilPixelFormat];
+    [pipeline_descriptor setDepthAttachmentPixelFormat:depth_stencil_format];
+    if (depth_stencil_format == MTLPixelFormatDepth32Float_Stencil8)
+    {
+        [pipeline_descriptor setStencilAttachmentPixelFormat:depth_stencil_format];
+    }
+
     NSError* err = nil;
     id<MTLRenderPipelineState> pipeline_state =
         [view_delegate->device newRenderPipelineStateWithDescriptor:pipeline_descriptor
@@ -143,7 +183,53 @@ bool division_engine_internal_platform_render_pass_impl_init_element(
     }
 
     render_pass_impl->mtl_pipeline_state = pipeline_state;
+    render_pass_impl->mtl_depth_stencil_state = nil;
+
+    if (depth_stencil_format == MTLPixelFormatInvalid)
+    {
+        return true;
+    }
+
+    return init_depth_stencil_state(
+        ctx, render_pass_desc, render_pass_impl, view_delegate->device
+    );
+}
 
+// Every pass gets a state, so the passes without the depth test reset the encoder
+bool init_depth_stencil_state(
+    DivisionContext* ctx,
+    const DivisionRenderPassDescriptor* render_pass_desc,
+    DivisionRenderPassInternalPlatform_* render_pass_impl,
+    id<MTLDevice> device
+)
+{
+    MTLCompareFunction mtl_compare = MTLCompareFunctionAlways;
+    if (DIVISION_MASK_HAS_FLAG(
+            render_pass_desc->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST
+        ) &&
+        !try_get_mtl_compare_func(ctx, render_pass_desc->depth_compare, &mtl_compare))
+    {
+        return false;
+    }
+
+    MTLDepthStencilDescriptor* depth_stencil_desc = [MTLDepthStencilDescriptor new];
+    [depth_stencil_desc setDepthCompareFunction:mtl_compare];
+    [depth_stencil_desc
+        setDepthWriteEnabled:DIVISION_MASK_HAS_FLAG(
+                                 render_pass_desc->capabilities_mask,
+                                 DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_WRITE
+                             )];
+
+    id<MTLDepthStencilState> depth_stencil_state =
+        [device newDepthStencilStateWithDescriptor:depth_stencil_desc];
+    if (!depth_stencil_state)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Depth stencil state is null");
+        return false;
+    }
+
+    render_pass_impl->mtl_depth_stencil_state = depth_stencil_state;
     return true;
 }
 
@@ -249,3 +335,43 @@ MTLColorWriteMask division_to_mtl_color_mask(DivisionColorMask color_mask)
 
     return result_mask;
 }
+
+bool try_get_mtl_compare_func(
+    DivisionContext* ctx,
+    DivisionCompareFunction compare,
+    MTLCompareFunction* out_mtl_compare
+)
+{
+    switch (compare)
+    {
+    case DIVISION_COMPARE_LESS:
+        *out_mtl_compare = MTLCompareFunctionLess;
+        return true;
+    case DIVISION_COMPARE_LESS_EQUAL:
+        *out_mtl_compare = MTLCompareFunctionLessEqual;
+        return true;
+    case DIVISION_COMPARE_EQUAL:
+        *out_mtl_compare = MTLCompareFunctionEqual;
+        return true;
+    case DIVISION_COMPARE_GREATER:
+        *out_mtl_compare = MTLCompareFunctionGreater;
+        return true;
+    case DIVISION_COMPARE_GREATER_EQUAL:
+        *out_mtl_compare = MTLCompareFunctionGreaterEqual;
+        return true;
+    case DIVISION_COMPARE_NOT_EQUAL:
+        *out_mtl_compare = MTLCompareFunctionNotEqual;
+        return true;
+    case DIVISION_COMPARE_ALWAYS:
+        *out_mtl_compare = MTLCompareFunctionAlways;
+        return true;
+    case DIVISION_COMPARE_NEVER:
+        *out_mtl_compare = MTLCompareFunctionNever;
+        return true;
+    default:
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Unknown CompareFunction to MTLCompareFunction mapping"
+        );
+        return false;
+    }
+}
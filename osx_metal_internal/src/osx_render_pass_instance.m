@@ -8,6 +8,7 @@
 #include <Metal/Metal.h>
 #include <MetalKit/MetalKit.h>
 
+#include <division_engine_core/binding_group.h>
 #include <division_engine_core/platform_internal/platform_render_pass_instance.h>
 #include <division_engine_core/renderer.h>
 #include <division_engine_core/texture.h>
@@ -15,35 +16,65 @@
 
 #include <division_engine_core/context.h>
 
-void division_engine_internal_platform_render_pass_instance_draw(
+static inline MTLLoadAction division_to_mtl_load_action(DivisionLoadAction load_action);
+static inline MTLStoreAction division_to_mtl_store_action(
+    DivisionStoreAction store_action
+);
+static inline void use_offscreen_target(
     DivisionContext* context,
-    const DivisionColor* clear_color,
-    const DivisionRenderPassInstance* render_pass_instances,
-    uint32_t render_pass_instance_count
+    MTKView* view,
+    MTLRenderPassDescriptor* render_pass_desc,
+    const DivisionFrameDescriptor* frame
+);
+
+// Every submit of the frame is encoded by the encoder created here
+void division_engine_internal_platform_render_pass_instance_begin_frame(
+    DivisionContext* context, const DivisionFrameDescriptor* frame
 )
 {
     @autoreleasepool
     {
         DivisionOSXWindowContext* window_context = context->renderer_context->window_data;
+        DivisionRenderPassDrawInternalPlatform_* draw_impl =
+            context->render_pass_context->draw_impl;
         MTKView* view = window_context->app_delegate->view;
         id<MTLCommandQueue> commandQueue =
             window_context->app_delegate->viewDelegate->commandQueue;
-        MTLClearColor mtl_clear_color = MTLClearColorMake(
+
+        const DivisionColor* clear_color = &frame->clear_color;
+        MTLRenderPassDescriptor* renderPassDesc = [view currentRenderPassDescriptor];
+        renderPassDesc.colorAttachments[0].loadAction =
+            division_to_mtl_load_action(frame->color_load_action);
+        // The drawable is presented, so its color is always stored
+        renderPassDesc.colorAttachments[0].storeAction = MTLStoreActionStore;
+        renderPassDesc.colorAttachments[0].clearColor = MTLClearColorMake(
             clear_color->r, clear_color->g, clear_color->b, clear_color->a
         );
-        [view setClearColor:mtl_clear_color];
 
-        id<MTLCommandBuffer> cmdBuffer = [commandQueue commandBuffer];
-        MTLRenderPassDescriptor* renderPassDesc = [view currentRenderPassDescriptor];
+        MTLPixelFormat depth_stencil_format = [view depthStencilPixelFormat];
+        if (depth_stencil_format != MTLPixelFormatInvalid)
+        {
+            renderPassDesc.depthAttachment.loadAction =
+                division_to_mtl_load_action(frame->depth_load_action);
+            renderPassDesc.depthAttachment.storeAction =
+                division_to_mtl_store_action(frame->depth_store_action);
+            renderPassDesc.depthAttachment.clearDepth = frame->clear_depth;
+        }
+        if (depth_stencil_format == MTLPixelFormatDepth32Float_Stencil8)
+        {
+            renderPassDesc.stencilAttachment.loadAction =
+                division_to_mtl_load_action(frame->depth_load_action);
+            renderPassDesc.stencilAttachment.storeAction =
+                division_to_mtl_store_action(frame->depth_store_action);
+            renderPassDesc.stencilAttachment.clearStencil = 0;
+        }
 
-        const DivisionRenderPassSystemContext* render_pass_ctx =
-            context->render_pass_context;
-        const DivisionVertexBufferSystemContext* vert_buff_ctx =
-            context->vertex_buffer_context;
-        const DivisionUniformBufferSystemContext* uniform_buff_ctx =
-            context->uniform_buffer_context;
-        const DivisionTextureSystemContext* tex_ctx = context->texture_context;
+        if (context->render_pass_context->partial_redraw)
+        {
+            use_offscreen_target(context, view, renderPassDesc, frame);
+        }
 
+        id<MTLCommandBuffer> cmdBuffer = [commandQueue commandBuffer];
         id<MTLRenderCommandEncoder> renderEnc =
             [cmdBuffer renderCommandEncoderWithDescriptor:renderPassDesc];
         const CGSize drawable_size = [view drawableSize];
@@ -57,6 +88,89 @@ void division_engine_internal_platform_render_pass_instance_draw(
                                }];
         [renderEnc setFrontFacingWinding:MTLWindingCounterClockwise];
 
+        draw_impl->mtl_command_buffer = cmdBuffer;
+        draw_impl->mtl_render_encoder = renderEnc;
+    }
+}
+
+void division_engine_internal_platform_render_pass_instance_end_frame(
+    DivisionContext* context, const DivisionFrameDescriptor* frame
+)
+{
+    @autoreleasepool
+    {
+        DivisionOSXWindowContext* window_context = context->renderer_context->window_data;
+        DivisionRenderPassDrawInternalPlatform_* draw_impl =
+            context->render_pass_context->draw_impl;
+        MTKView* view = window_context->app_delegate->view;
+
+        [draw_impl->mtl_render_encoder endEncoding];
+        if (context->render_pass_context->partial_redraw)
+        {
+            id<MTLBlitCommandEncoder> blitEnc =
+                [draw_impl->mtl_command_buffer blitCommandEncoder];
+            [blitEnc copyFromTexture:draw_impl->mtl_offscreen_texture
+                           toTexture:[[view currentDrawable] texture]];
+            [blitEnc endEncoding];
+        }
+        [draw_impl->mtl_command_buffer presentDrawable:[view currentDrawable]];
+        [draw_impl->mtl_command_buffer commit];
+
+        draw_impl->mtl_render_encoder = nil;
+        draw_impl->mtl_command_buffer = nil;
+    }
+}
+
+void division_engine_internal_platform_render_pass_instance_set_scissor(
+    DivisionContext* context, const DivisionDirtyRect* rect
+)
+{
+    const DivisionRendererSystemContext* renderer_ctx = context->renderer_context;
+    id<MTLRenderCommandEncoder> renderEnc =
+        context->render_pass_context->draw_impl->mtl_render_encoder;
+    NSUInteger frame_width = (NSUInteger) renderer_ctx->frame_buffer_width;
+    NSUInteger frame_height = (NSUInteger) renderer_ctx->frame_buffer_height;
+
+    if (rect == NULL)
+    {
+        [renderEnc setScissorRect:(MTLScissorRect){
+                                      .x = 0,
+                                      .y = 0,
+                                      .width = frame_width,
+                                      .height = frame_height,
+                                  }];
+        return;
+    }
+
+    // Origin of the Metal scissor is the top left corner
+    NSUInteger top = (NSUInteger) (rect->y + rect->height);
+    [renderEnc setScissorRect:(MTLScissorRect){
+                                  .x = (NSUInteger) rect->x,
+                                  .y = frame_height - top,
+                                  .width = (NSUInteger) rect->width,
+                                  .height = (NSUInteger) rect->height,
+                              }];
+}
+
+void division_engine_internal_platform_render_pass_instance_draw(
+    DivisionContext* context,
+    const DivisionRenderPassInstance* render_pass_instances,
+    uint32_t render_pass_instance_count
+)
+{
+    @autoreleasepool
+    {
+        const DivisionRenderPassSystemContext* render_pass_ctx =
+            context->render_pass_context;
+        const DivisionVertexBufferSystemContext* vert_buff_ctx =
+            context->vertex_buffer_context;
+        const DivisionUniformBufferSystemContext* uniform_buff_ctx =
+            context->uniform_buffer_context;
+        const DivisionTextureSystemContext* tex_ctx = context->texture_context;
+
+        id<MTLRenderCommandEncoder> renderEnc =
+            render_pass_ctx->draw_impl->mtl_render_encoder;
+
         for (size_t i = 0; i < render_pass_instance_count; i++)
         {
             const DivisionRenderPassInstance* pass = &render_pass_instances[i];
@@ -74,6 +188,10 @@ void division_engine_internal_platform_render_pass_instance_draw(
             id<MTLBuffer> vertDataMtlBuffer = vert_buffer_impl->mtl_vertex_buffer;
 
             [renderEnc setRenderPipelineState:pipelineState];
+            if (pass_desc_impl->mtl_depth_stencil_state != nil)
+            {
+                [renderEnc setDepthStencilState:pass_desc_impl->mtl_depth_stencil_state];
+            }
             [renderEnc setVertexBuffer:vertDataMtlBuffer
                                 offset:0
                                atIndex:DIVISION_MTL_VERTEX_DATA_BUFFER_INDEX];
@@ -85,11 +203,14 @@ void division_engine_internal_platform_render_pass_instance_draw(
                                    blue:blend_color[2]
                                   alpha:blend_color[3]];
 
-            size_t vert_uniform_count = pass->uniform_vertex_buffer_count;
+            DivisionBindingGroup bindings =
+                division_engine_render_pass_instance_bindings(context, pass);
+
+            size_t vert_uniform_count = bindings.uniform_vertex_buffer_count;
             for (int ubIdx = 0; ubIdx < vert_uniform_count; ubIdx++)
             {
                 const DivisionIdWithBinding* buff_binding =
-                    &pass->uniform_vertex_buffers[ubIdx];
+                    &bindings.uniform_vertex_buffers[ubIdx];
                 id<MTLBuffer> uniformBuff =
                     uniform_buff_ctx->uniform_buffers_impl[buff_binding->id].mtl_buffer;
                 [renderEnc setVertexBuffer:uniformBuff
@@ -97,12 +218,11 @@ void division_engine_internal_platform_render_pass_instance_draw(
                                    atIndex:buff_binding->shader_location];
             }
 
-            size_t frag_uniform_count =
-                pass->uniform_fragment_buffer_count;
+            size_t frag_uniform_count = bindings.uniform_fragment_buffer_count;
             for (int ubIdx = 0; ubIdx < frag_uniform_count; ubIdx++)
             {
                 const DivisionIdWithBinding* buff_binding =
-                    &pass->uniform_fragment_buffers[ubIdx];
+                    &bindings.uniform_fragment_buffers[ubIdx];
                 id<MTLBuffer> uniformBuff =
                     uniform_buff_ctx->uniform_buffers_impl[buff_binding->id].mtl_buffer;
                 [renderEnc setFragmentBuffer:uniformBuff
@@ -110,11 +230,26 @@ void division_engine_internal_platform_render_pass_instance_draw(
                                      atIndex:buff_binding->shader_location];
             }
 
-            size_t texture_count = pass->fragment_texture_count;
+            id<MTLBuffer> ringBuff = uniform_buff_ctx->ring_impl->mtl_buffer;
+            for (int ringIdx = 0; ringIdx < pass->uniform_ring_binding_count; ringIdx++)
+            {
+                const DivisionUniformRingBinding* ring_binding =
+                    &pass->uniform_ring_bindings[ringIdx];
+
+                // GL stages share the uniform bindings, so the range goes to both
+                [renderEnc setVertexBuffer:ringBuff
+                                    offset:ring_binding->offset
+                                   atIndex:ring_binding->shader_location];
+                [renderEnc setFragmentBuffer:ringBuff
+                                      offset:ring_binding->offset
+                                     atIndex:ring_binding->shader_location];
+            }
+
+            size_t texture_count = bindings.fragment_texture_count;
             for (int texIdx = 0; texIdx < texture_count; texIdx++)
             {
                 const DivisionIdWithBinding* texture_binding =
-                    &pass->fragment_textures[texIdx];
+                    &bindings.fragment_textures[texIdx];
                 const DivisionTextureImpl_* tex_impl =
                     &tex_ctx->textures_impl[texture_binding->id];
 
@@ -124,39 +259,108 @@ void division_engine_internal_platform_render_pass_instance_draw(
                                            atIndex:texture_binding->shader_location];
             }
 
-            if (DIVISION_MASK_HAS_FLAG(
-                    pass->capabilities_mask,
-                    DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
-                ))
+            bool instanced = DIVISION_MASK_HAS_FLAG(
+                pass->capabilities_mask,
+                DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
+            );
+            NSUInteger instance_count = instanced ? pass->instance_count : 1;
+            NSUInteger first_instance = instanced ? pass->first_instance : 0;
+            const DivisionVertexBuffer* vertex_buffer =
+                &vert_buff_ctx->buffers[pass_desc->vertex_buffer_id];
+
+            if (instanced)
             {
                 [renderEnc setVertexBuffer:vertDataMtlBuffer
                                     offset:0
                                    atIndex:DIVISION_MTL_VERTEX_DATA_INSTANCE_ARRAY_INDEX];
+            }
 
-                [renderEnc drawIndexedPrimitives:vert_buffer_impl->mtl_primitive_type
-                                      indexCount:pass->index_count
-                                       indexType:MTLIndexTypeUInt32
-                                     indexBuffer:vert_buffer_impl->mtl_index_buffer
-                               indexBufferOffset:0
-                                   instanceCount:pass->instance_count
-                                      baseVertex:pass->first_vertex
-                                    baseInstance:pass->first_instance];
+            if (vertex_buffer->settings.size.index_count == 0)
+            {
+                [renderEnc drawPrimitives:vert_buffer_impl->mtl_primitive_type
+                              vertexStart:pass->first_vertex
+                              vertexCount:pass->vertex_count
+                            instanceCount:instance_count
+                             baseInstance:first_instance];
             }
             else
             {
                 [renderEnc drawIndexedPrimitives:vert_buffer_impl->mtl_primitive_type
                                       indexCount:pass->index_count
-                                       indexType:MTLIndexTypeUInt32
+                                       indexType:vert_buffer_impl->mtl_index_type
                                      indexBuffer:vert_buffer_impl->mtl_index_buffer
                                indexBufferOffset:0
-                                   instanceCount:1
-                                      baseVertex:0
-                                    baseInstance:0];
+                                   instanceCount:instance_count
+                                      baseVertex:pass->first_vertex
+                                    baseInstance:first_instance];
             }
         }
 
-        [renderEnc endEncoding];
-        [cmdBuffer presentDrawable:[view currentDrawable]];
-        [cmdBuffer commit];
     }
+}
+
+/*
+ *  Drawables don't keep their contents, so the frame is drawn into the offscreen
+ *  texture. Metal has no scissored clears, the color is cleared only if the whole
+ *  frame is dirty, otherwise the draws must cover the dirty rects
+ */
+void use_offscreen_target(
+    DivisionContext* context,
+    MTKView* view,
+    MTLRenderPassDescriptor* render_pass_desc,
+    const DivisionFrameDescriptor* frame
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = context->render_pass_context;
+    DivisionRenderPassDrawInternalPlatform_* draw_impl = render_pass_ctx->draw_impl;
+    const CGSize drawable_size = [view drawableSize];
+    NSUInteger width = (NSUInteger) drawable_size.width;
+    NSUInteger height = (NSUInteger) drawable_size.height;
+
+    id<MTLTexture> texture = draw_impl->mtl_offscreen_texture;
+    if (texture == nil || [texture width] != width || [texture height] != height)
+    {
+        MTLTextureDescriptor* texture_desc = [MTLTextureDescriptor
+            texture2DDescriptorWithPixelFormat:[view colorPixelFormat]
+                                         width:width
+                                        height:height
+                                     mipmapped:NO];
+        [texture_desc setUsage:MTLTextureUsageRenderTarget];
+        [texture_desc setStorageMode:MTLStorageModePrivate];
+
+        texture = [[view device] newTextureWithDescriptor:texture_desc];
+        draw_impl->mtl_offscreen_texture = texture;
+    }
+
+    const DivisionDirtyRect* rects = render_pass_ctx->frame_dirty_rects;
+    bool whole_frame_dirty = render_pass_ctx->frame_dirty_rect_count == 1 &&
+                             rects[0].width == (int32_t) width &&
+                             rects[0].height == (int32_t) height;
+
+    render_pass_desc.colorAttachments[0].texture = texture;
+    render_pass_desc.colorAttachments[0].loadAction =
+        whole_frame_dirty && frame->color_load_action == DIVISION_LOAD_ACTION_CLEAR
+            ? MTLLoadActionClear
+            : MTLLoadActionLoad;
+    render_pass_desc.colorAttachments[0].storeAction = MTLStoreActionStore;
+}
+
+MTLLoadAction division_to_mtl_load_action(DivisionLoadAction load_action)
+{
+    switch (load_action)
+    {
+    case DIVISION_LOAD_ACTION_LOAD:
+        return MTLLoadActionLoad;
+    case DIVISION_LOAD_ACTION_DONT_CARE:
+        return MTLLoadActionDontCare;
+    case DIVISION_LOAD_ACTION_CLEAR:
+    default:
+        return MTLLoadActionClear;
+    }
+}
+
+MTLStoreAction division_to_mtl_store_action(DivisionStoreAction store_action)
+{
+    return store_action == DIVISION_STORE_ACTION_DONT_CARE ? MTLStoreActionDontCare
+                                                           : MTLStoreActionStore;
 }
\ No newline at end of file
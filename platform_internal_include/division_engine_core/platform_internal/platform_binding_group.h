@@ -0,0 +1,32 @@
+#pragma once
+
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/context.h"
+#include "division_engine_core_export.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT bool division_engine_internal_platform_binding_group_context_alloc(
+        DivisionContext* ctx, const DivisionSettings* settings
+    );
+    DIVISION_EXPORT void division_engine_internal_platform_binding_group_context_free(
+        DivisionContext* ctx
+    );
+
+    DIVISION_EXPORT bool division_engine_internal_platform_binding_group_realloc(
+        DivisionContext* ctx, size_t new_size
+    );
+    DIVISION_EXPORT bool division_engine_internal_platform_binding_group_impl_init_element(
+        DivisionContext* ctx, uint32_t binding_group_id
+    );
+
+    DIVISION_EXPORT void division_engine_internal_platform_binding_group_free(
+        DivisionContext* ctx, uint32_t binding_group_id
+    );
+
+#ifdef __cplusplus
+}
+#endif
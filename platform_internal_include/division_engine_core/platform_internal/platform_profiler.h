@@ -0,0 +1,40 @@
+#pragma once
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/profiler.h"
+#include "division_engine_core_export.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Sets has_gpu_timers of the context, the other hooks are called only if it's set
+    DIVISION_EXPORT bool division_engine_internal_platform_profiler_context_alloc(
+        DivisionContext* ctx, const DivisionSettings* settings
+    );
+
+    DIVISION_EXPORT void division_engine_internal_platform_profiler_context_free(
+        DivisionContext* ctx
+    );
+
+    // Records the GPU time, when the commands before it are finished
+    DIVISION_EXPORT void division_engine_internal_platform_profiler_timestamp(
+        DivisionContext* ctx, uint32_t query_index
+    );
+
+    /*
+     *  Reads the nanoseconds of the recorded timestamps. Returns false if they aren't
+     *  ready and `wait` is false
+     */
+    DIVISION_EXPORT bool division_engine_internal_platform_profiler_read_timestamps(
+        DivisionContext* ctx,
+        uint32_t first_query,
+        uint32_t query_count,
+        bool wait,
+        uint64_t* out_timestamps
+    );
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,13 +9,26 @@ extern "C"
 {
 #endif
 
+DIVISION_EXPORT void division_engine_internal_platform_render_pass_instance_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+);
+
+// Restricts the following draws of the frame to the rect, NULL removes the restriction
+DIVISION_EXPORT void division_engine_internal_platform_render_pass_instance_set_scissor(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+);
+
+// Draws into the begun frame
 DIVISION_EXPORT void division_engine_internal_platform_render_pass_instance_draw(
     DivisionContext* ctx,
-    const DivisionColor* clear_color,
     const DivisionRenderPassInstance* render_pass_instances,
     uint32_t render_pass_instance_count
 );
 
+DIVISION_EXPORT void division_engine_internal_platform_render_pass_instance_end_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -19,12 +19,24 @@ DIVISION_EXPORT void* division_engine_internal_platform_uniform_buffer_borrow_da
 DIVISION_EXPORT void division_engine_internal_platform_uniform_buffer_return_data_pointer(
     DivisionContext* ctx, uint32_t buffer_id, void* data_pointer);
 
+// The range is checked by the caller
+DIVISION_EXPORT void division_engine_internal_platform_uniform_buffer_update_range(
+    DivisionContext* ctx, uint32_t buffer_id, size_t offset, const void* data, size_t size);
+
 DIVISION_EXPORT bool division_engine_internal_platform_uniform_buffer_realloc(
     DivisionContext* ctx, size_t new_size);
 
 DIVISION_EXPORT bool division_engine_internal_platform_uniform_buffer_impl_init_element(
     DivisionContext* ctx, uint32_t buffer_id);
 
+// Creates the mapped ring storage, writes its pointer to the context
+DIVISION_EXPORT bool division_engine_internal_platform_uniform_buffer_ring_alloc(
+    DivisionContext* ctx, size_t capacity, size_t* out_offset_alignment);
+
+// Fences the draws of the frame, waits until the GPU has finished the next frame region
+DIVISION_EXPORT void division_engine_internal_platform_uniform_buffer_ring_end_frame(
+    DivisionContext* ctx, uint32_t frame, uint32_t next_frame);
+
 #ifdef __cplusplus
 }
 #endif
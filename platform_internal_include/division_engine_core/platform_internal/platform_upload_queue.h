@@ -0,0 +1,39 @@
+#pragma once
+
+#include "division_engine_core/context.h"
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core_export.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    DIVISION_EXPORT bool division_engine_internal_platform_upload_queue_context_alloc(
+        DivisionContext* ctx, const DivisionSettings* settings
+    );
+
+    DIVISION_EXPORT void division_engine_internal_platform_upload_queue_context_free(
+        DivisionContext* ctx
+    );
+
+    // Creates the mapped staging storage and writes its pointer to the context
+    DIVISION_EXPORT bool division_engine_internal_platform_upload_queue_staging_alloc(
+        DivisionContext* ctx, size_t capacity
+    );
+
+    // Records the copies and signals the fence, when the GPU has finished them
+    DIVISION_EXPORT void division_engine_internal_platform_upload_queue_submit(
+        DivisionContext* ctx,
+        const DivisionUploadJob* jobs,
+        size_t job_count,
+        DivisionUploadFence fence
+    );
+
+    // Returns the last signaled fence without waiting
+    DIVISION_EXPORT DivisionUploadFence
+    division_engine_internal_platform_upload_queue_completed_fence(DivisionContext* ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,179 @@
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/platform_internal/platform_binding_group.h"
+
+#include "division_engine_core/capture.h"
+
+#include <memory.h>
+#include <stdlib.h>
+
+static inline bool copy_binding_group_(
+    const DivisionBindingGroup* binding_group, DivisionBindingGroup* out_copy
+);
+
+bool division_engine_binding_group_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->binding_group_context = malloc(sizeof(DivisionBindingGroupSystemContext));
+    if (ctx->binding_group_context == NULL)
+    {
+        return false;
+    }
+
+    *ctx->binding_group_context = (DivisionBindingGroupSystemContext){
+        .binding_groups = NULL,
+        .binding_groups_impl = NULL,
+        .binding_group_count = 0,
+    };
+
+    division_unordered_id_table_alloc(&ctx->binding_group_context->id_table, 10);
+
+    return division_engine_internal_platform_binding_group_context_alloc(ctx, settings);
+}
+
+void division_engine_binding_group_system_context_free(DivisionContext* ctx)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+
+    division_engine_internal_platform_binding_group_context_free(ctx);
+
+    for (size_t i = 0; i < binding_group_ctx->binding_group_count; i++)
+    {
+        free((void*) binding_group_ctx->binding_groups[i].uniform_vertex_buffers);
+    }
+
+    division_unordered_id_table_free(&binding_group_ctx->id_table);
+    free(binding_group_ctx->binding_groups);
+    free(binding_group_ctx);
+}
+
+bool division_engine_binding_group_alloc(
+    DivisionContext* ctx,
+    const DivisionBindingGroup* binding_group,
+    uint32_t* out_binding_group_id
+)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    uint32_t group_id = division_unordered_id_table_new_id(&binding_group_ctx->id_table);
+
+    if (group_id >= binding_group_ctx->binding_group_count)
+    {
+        size_t new_count = group_id + 1;
+        DivisionBindingGroup* binding_groups = realloc(
+            binding_group_ctx->binding_groups, sizeof(DivisionBindingGroup[new_count])
+        );
+
+        if (binding_groups == NULL ||
+            !division_engine_internal_platform_binding_group_realloc(ctx, new_count))
+        {
+            if (binding_groups != NULL)
+            {
+                binding_group_ctx->binding_groups = binding_groups;
+            }
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to reallocate binding groups");
+            division_unordered_id_table_remove_id(&binding_group_ctx->id_table, group_id);
+            return false;
+        }
+
+        // Free slots have no bindings, so the context can free every slot on exit
+        for (size_t i = binding_group_ctx->binding_group_count; i < new_count; i++)
+        {
+            binding_groups[i] = (DivisionBindingGroup){0};
+        }
+        binding_group_ctx->binding_groups = binding_groups;
+        binding_group_ctx->binding_group_count = new_count;
+    }
+
+    DivisionBindingGroup* group_copy = &binding_group_ctx->binding_groups[group_id];
+    if (!copy_binding_group_(binding_group, group_copy))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to copy the binding group");
+        division_unordered_id_table_remove_id(&binding_group_ctx->id_table, group_id);
+        return false;
+    }
+
+    if (!division_engine_internal_platform_binding_group_impl_init_element(ctx, group_id))
+    {
+        free((void*) group_copy->uniform_vertex_buffers);
+        *group_copy = (DivisionBindingGroup){0};
+        division_unordered_id_table_remove_id(&binding_group_ctx->id_table, group_id);
+        return false;
+    }
+
+    *out_binding_group_id = group_id;
+    division_engine_capture_binding_group_alloc(ctx, binding_group, group_id);
+    return true;
+}
+
+void division_engine_binding_group_free(DivisionContext* ctx, uint32_t binding_group_id)
+{
+    DivisionBindingGroupSystemContext* binding_group_ctx = ctx->binding_group_context;
+    DivisionBindingGroup* binding_group =
+        &binding_group_ctx->binding_groups[binding_group_id];
+
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_BINDING_GROUP_FREE, binding_group_id
+    );
+    division_engine_internal_platform_binding_group_free(ctx, binding_group_id);
+
+    free((void*) binding_group->uniform_vertex_buffers);
+    *binding_group = (DivisionBindingGroup){0};
+    division_unordered_id_table_remove_id(&binding_group_ctx->id_table, binding_group_id);
+}
+
+// All the arrays of the copy share one allocation, which starts at the vertex buffers
+bool copy_binding_group_(
+    const DivisionBindingGroup* binding_group, DivisionBindingGroup* out_copy
+)
+{
+    size_t vertex_buffer_count = binding_group->uniform_vertex_buffer_count;
+    size_t fragment_buffer_count = binding_group->uniform_fragment_buffer_count;
+    size_t texture_count = binding_group->fragment_texture_count;
+    size_t binding_count = vertex_buffer_count + fragment_buffer_count + texture_count;
+
+    DivisionIdWithBinding* bindings =
+        malloc(sizeof(DivisionIdWithBinding[DIVISION_MAX(binding_count, 1)]));
+    if (bindings == NULL)
+    {
+        return false;
+    }
+
+    // Arrays of the empty ranges can be NULL, so they aren't copied
+    DivisionIdWithBinding* fragment_buffers = bindings + vertex_buffer_count;
+    DivisionIdWithBinding* textures = fragment_buffers + fragment_buffer_count;
+    if (vertex_buffer_count > 0)
+    {
+        memcpy(
+            bindings,
+            binding_group->uniform_vertex_buffers,
+            sizeof(DivisionIdWithBinding[vertex_buffer_count])
+        );
+    }
+    if (fragment_buffer_count > 0)
+    {
+        memcpy(
+            fragment_buffers,
+            binding_group->uniform_fragment_buffers,
+            sizeof(DivisionIdWithBinding[fragment_buffer_count])
+        );
+    }
+    if (texture_count > 0)
+    {
+        memcpy(
+            textures,
+            binding_group->fragment_textures,
+            sizeof(DivisionIdWithBinding[texture_count])
+        );
+    }
+
+    *out_copy = (DivisionBindingGroup){
+        .uniform_vertex_buffers = bindings,
+        .uniform_fragment_buffers = fragment_buffers,
+        .fragment_textures = textures,
+        .uniform_vertex_buffer_count = binding_group->uniform_vertex_buffer_count,
+        .uniform_fragment_buffer_count = binding_group->uniform_fragment_buffer_count,
+        .fragment_texture_count = binding_group->fragment_texture_count,
+    };
+
+    return true;
+}
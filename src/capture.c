@@ -0,0 +1,1496 @@
+#include "division_engine_core/capture.h"
+
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/io_utility.h"
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/render_pass_instance.h"
+#include "division_engine_core/shader.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CAPTURE_FILE_BUFFER_SIZE_ (1024 * 1024)
+
+typedef struct ShaderSourceRecord_
+{
+    uint32_t type;
+    uint32_t entry_point_size;
+    uint32_t source_size;
+} ShaderSourceRecord_;
+
+typedef struct VertexLayoutRecord_
+{
+    int32_t attribute_count;
+    int32_t stride;
+} VertexLayoutRecord_;
+
+typedef struct VertexBufferRecord_
+{
+    uint32_t vertex_buffer_id;
+    DivisionVertexBufferSize size;
+    DivisionRenderTopology topology;
+    DivisionVertexBufferCapabilityMask capabilities_mask;
+    VertexLayoutRecord_ per_vertex_layout;
+    VertexLayoutRecord_ per_instance_layout;
+} VertexBufferRecord_;
+
+typedef struct BufferUpdateRecord_
+{
+    uint32_t buffer_id;
+    uint32_t target;
+    uint64_t offset;
+    uint64_t size;
+} BufferUpdateRecord_;
+
+typedef struct BindingGroupRecord_
+{
+    uint32_t binding_group_id;
+    int32_t uniform_vertex_buffer_count;
+    int32_t uniform_fragment_buffer_count;
+    int32_t fragment_texture_count;
+} BindingGroupRecord_;
+
+typedef struct SubmitRecord_
+{
+    uint32_t render_pass_instance_count;
+} SubmitRecord_;
+
+typedef struct ReplayReader_
+{
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+} ReplayReader_;
+
+// Replay state, which is carried from a record to the next ones
+typedef struct ReplayState_
+{
+    uint8_t* scratch;
+    size_t scratch_capacity;
+
+    // Shift of the captured uniform ring offsets of the next draw
+    int64_t ring_offset_shift;
+} ReplayState_;
+
+static inline size_t align_size_(size_t size);
+static inline double get_time_ms_(void);
+
+static inline void record_begin_(DivisionContext* ctx, DivisionCaptureCommand command);
+static inline void* record_reserve_(DivisionContext* ctx, size_t size);
+static inline void record_write_(DivisionContext* ctx, const void* data, size_t size);
+static inline void record_end_(DivisionContext* ctx);
+static inline void record_layout_(
+    DivisionContext* ctx,
+    const DivisionVertexAttributeSettings* settings,
+    const DivisionVertexAttribute* attributes,
+    int32_t attribute_count
+);
+static inline void stop_capture_(DivisionContext* ctx);
+
+static inline const void* read_(ReplayReader_* reader, size_t size);
+static inline void* reserve_scratch_(ReplayState_* state, size_t size);
+static bool replay_record_(
+    DivisionContext* ctx,
+    ReplayState_* state,
+    DivisionCaptureCommand command,
+    ReplayReader_* reader
+);
+static bool replay_shader_program_alloc_(DivisionContext* ctx, ReplayReader_* reader);
+static bool replay_vertex_buffer_alloc_(DivisionContext* ctx, ReplayReader_* reader);
+static bool replay_vertex_buffer_data_(DivisionContext* ctx, ReplayReader_* reader);
+static bool replay_buffer_update_(
+    DivisionContext* ctx, DivisionCaptureCommand command, ReplayReader_* reader
+);
+static bool replay_binding_group_alloc_(DivisionContext* ctx, ReplayReader_* reader);
+static bool replay_uniform_ring_data_(
+    DivisionContext* ctx, ReplayState_* state, ReplayReader_* reader
+);
+static bool replay_submit_(
+    DivisionContext* ctx, ReplayState_* state, ReplayReader_* reader
+);
+static inline bool check_replayed_id_(
+    DivisionContext* ctx, bool is_allocated, uint32_t replayed_id, uint32_t captured_id
+);
+static inline const DivisionUnorderedIdTable* get_record_id_table_(
+    const DivisionContext* ctx, DivisionCaptureCommand command
+);
+static inline bool check_captured_id_(
+    DivisionContext* ctx, const DivisionUnorderedIdTable* id_table, uint32_t id
+);
+static inline bool check_captured_bindings_(
+    DivisionContext* ctx,
+    const DivisionUnorderedIdTable* id_table,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count
+);
+static bool check_captured_instance_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* instance
+);
+
+bool division_engine_capture_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->capture_context = malloc(sizeof(DivisionCaptureSystemContext));
+    if (ctx->capture_context == NULL)
+    {
+        return false;
+    }
+
+    *ctx->capture_context = (DivisionCaptureSystemContext){
+        .file = NULL,
+        .record = NULL,
+        .record_size = 0,
+        .record_capacity = 0,
+        .record_failed = false,
+    };
+
+    if (settings->capture_path == NULL)
+    {
+        return true;
+    }
+
+    FILE* file = fopen(settings->capture_path, "wb");
+    if (file == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to open the capture file");
+        return false;
+    }
+
+    setvbuf(file, NULL, _IOFBF, CAPTURE_FILE_BUFFER_SIZE_);
+
+    DivisionCaptureFileHeader header = {
+        .magic = DIVISION_CAPTURE_MAGIC,
+        .version = DIVISION_CAPTURE_VERSION,
+    };
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        fclose(file);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to write the capture file");
+        return false;
+    }
+
+    ctx->capture_context->file = file;
+    return true;
+}
+
+void division_engine_capture_system_context_free(DivisionContext* ctx)
+{
+    stop_capture_(ctx);
+    free(ctx->capture_context->record);
+    free(ctx->capture_context);
+}
+
+void division_engine_capture_shader_program_alloc(
+    DivisionContext* ctx,
+    const DivisionShaderSourceDescriptor* descriptors,
+    int32_t descriptor_count,
+    uint32_t shader_program_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_SHADER_PROGRAM_ALLOC);
+    record_write_(ctx, &shader_program_id, sizeof(shader_program_id));
+    record_write_(ctx, &descriptor_count, sizeof(descriptor_count));
+
+    for (int32_t i = 0; i < descriptor_count; i++)
+    {
+        const DivisionShaderSourceDescriptor* desc = &descriptors[i];
+        const char* entry_point_name = desc->entry_point_name;
+        ShaderSourceRecord_ source_record = {
+            .type = desc->type,
+            .entry_point_size =
+                entry_point_name ? (uint32_t) strlen(entry_point_name) + 1 : 0,
+            .source_size = desc->source_size,
+        };
+
+        record_write_(ctx, &source_record, sizeof(source_record));
+        record_write_(ctx, entry_point_name, source_record.entry_point_size);
+        record_write_(ctx, desc->source, source_record.source_size);
+    }
+
+    record_end_(ctx);
+}
+
+void division_engine_capture_resource_command(
+    DivisionContext* ctx, DivisionCaptureCommand command, uint32_t resource_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, command);
+    record_write_(ctx, &resource_id, sizeof(resource_id));
+    record_end_(ctx);
+}
+
+void division_engine_capture_upload_flush(DivisionContext* ctx)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_UPLOAD_FLUSH);
+    record_end_(ctx);
+}
+
+void division_engine_capture_vertex_buffer_alloc(
+    DivisionContext* ctx, uint32_t vertex_buffer_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    const DivisionVertexBuffer* vertex_buffer =
+        &ctx->vertex_buffer_context->buffers[vertex_buffer_id];
+    const DivisionVertexBufferSettings* settings = &vertex_buffer->settings;
+
+    VertexBufferRecord_ buffer_record = {
+        .vertex_buffer_id = vertex_buffer_id,
+        .size = settings->size,
+        .topology = settings->topology,
+        .capabilities_mask = settings->capabilities_mask,
+        .per_vertex_layout =
+            {
+                .attribute_count = settings->per_vertex_attribute_count,
+                .stride = (int32_t) vertex_buffer->per_vertex_data_size,
+            },
+        .per_instance_layout =
+            {
+                .attribute_count = settings->per_instance_attribute_count,
+                .stride = (int32_t) vertex_buffer->per_instance_data_size,
+            },
+    };
+
+    record_begin_(ctx, DIVISION_CAPTURE_VERTEX_BUFFER_ALLOC);
+    record_write_(ctx, &buffer_record, sizeof(buffer_record));
+    record_layout_(
+        ctx,
+        settings->per_vertex_attributes,
+        vertex_buffer->per_vertex_attributes,
+        settings->per_vertex_attribute_count
+    );
+    record_layout_(
+        ctx,
+        settings->per_instance_attributes,
+        vertex_buffer->per_instance_attributes,
+        settings->per_instance_attribute_count
+    );
+    record_end_(ctx);
+}
+
+void division_engine_capture_vertex_buffer_resize(
+    DivisionContext* ctx, uint32_t vertex_buffer_id, DivisionVertexBufferSize new_size
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_VERTEX_BUFFER_RESIZE);
+    record_write_(ctx, &vertex_buffer_id, sizeof(vertex_buffer_id));
+    record_write_(ctx, &new_size, sizeof(new_size));
+    record_end_(ctx);
+}
+
+void division_engine_capture_vertex_buffer_data(
+    DivisionContext* ctx,
+    uint32_t vertex_buffer_id,
+    const DivisionVertexBufferSize* size,
+    const void* vertex_data,
+    const void* index_data,
+    const void* instance_data
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    const DivisionVertexBuffer* vertex_buffer =
+        &ctx->vertex_buffer_context->buffers[vertex_buffer_id];
+
+    record_begin_(ctx, DIVISION_CAPTURE_VERTEX_BUFFER_DATA);
+    record_write_(ctx, &vertex_buffer_id, sizeof(vertex_buffer_id));
+    record_write_(ctx, size, sizeof(*size));
+    record_write_(
+        ctx, vertex_data, size->vertex_count * vertex_buffer->per_vertex_data_size
+    );
+    record_write_(
+        ctx,
+        index_data,
+        size->index_count * division_engine_vertex_buffer_index_size(vertex_buffer)
+    );
+    record_write_(
+        ctx, instance_data, size->instance_count * vertex_buffer->per_instance_data_size
+    );
+    record_end_(ctx);
+}
+
+void division_engine_capture_uniform_buffer_alloc(
+    DivisionContext* ctx, DivisionUniformBufferDescriptor buffer, uint32_t buffer_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_UNIFORM_BUFFER_ALLOC);
+    record_write_(ctx, &buffer_id, sizeof(buffer_id));
+    record_write_(ctx, &buffer, sizeof(buffer));
+    record_end_(ctx);
+}
+
+void division_engine_capture_uniform_buffer_update(
+    DivisionContext* ctx,
+    DivisionCaptureCommand command,
+    uint32_t buffer_id,
+    size_t offset,
+    const void* data,
+    size_t size
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    BufferUpdateRecord_ update_record = {
+        .buffer_id = buffer_id,
+        .target = DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER,
+        .offset = offset,
+        .size = size,
+    };
+
+    record_begin_(ctx, command);
+    record_write_(ctx, &update_record, sizeof(update_record));
+    record_write_(ctx, data, size);
+    record_end_(ctx);
+}
+
+void division_engine_capture_texture_alloc(
+    DivisionContext* ctx, const DivisionTexture* texture, uint32_t texture_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_TEXTURE_ALLOC);
+    record_write_(ctx, &texture_id, sizeof(texture_id));
+    record_write_(ctx, texture, sizeof(*texture));
+    record_end_(ctx);
+}
+
+void division_engine_capture_texture_data(
+    DivisionContext* ctx, uint32_t texture_id, const void* data
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    size_t data_size =
+        division_engine_texture_data_size(&ctx->texture_context->textures[texture_id]);
+
+    record_begin_(ctx, DIVISION_CAPTURE_TEXTURE_DATA);
+    record_write_(ctx, &texture_id, sizeof(texture_id));
+    record_write_(ctx, data, data_size);
+    record_end_(ctx);
+}
+
+void division_engine_capture_render_pass_descriptor(
+    DivisionContext* ctx,
+    DivisionCaptureCommand command,
+    uint32_t render_pass_id,
+    const DivisionRenderPassDescriptor* render_pass
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, command);
+    record_write_(ctx, &render_pass_id, sizeof(render_pass_id));
+    record_write_(ctx, render_pass, sizeof(*render_pass));
+    record_end_(ctx);
+}
+
+void division_engine_capture_binding_group_alloc(
+    DivisionContext* ctx, const DivisionBindingGroup* binding_group, uint32_t group_id
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    BindingGroupRecord_ group_record = {
+        .binding_group_id = group_id,
+        .uniform_vertex_buffer_count = binding_group->uniform_vertex_buffer_count,
+        .uniform_fragment_buffer_count = binding_group->uniform_fragment_buffer_count,
+        .fragment_texture_count = binding_group->fragment_texture_count,
+    };
+
+    record_begin_(ctx, DIVISION_CAPTURE_BINDING_GROUP_ALLOC);
+    record_write_(ctx, &group_record, sizeof(group_record));
+    record_write_(
+        ctx,
+        binding_group->uniform_vertex_buffers,
+        sizeof(DivisionIdWithBinding[group_record.uniform_vertex_buffer_count])
+    );
+    record_write_(
+        ctx,
+        binding_group->uniform_fragment_buffers,
+        sizeof(DivisionIdWithBinding[group_record.uniform_fragment_buffer_count])
+    );
+    record_write_(
+        ctx,
+        binding_group->fragment_textures,
+        sizeof(DivisionIdWithBinding[group_record.fragment_texture_count])
+    );
+    record_end_(ctx);
+}
+
+void division_engine_capture_upload(
+    DivisionContext* ctx,
+    const DivisionUploadStaging* staging,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t dst_offset
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    BufferUpdateRecord_ upload_record = {
+        .buffer_id = resource_id,
+        .target = target,
+        .offset = dst_offset,
+        .size = staging->size,
+    };
+
+    record_begin_(ctx, DIVISION_CAPTURE_UPLOAD);
+    record_write_(ctx, &upload_record, sizeof(upload_record));
+    record_write_(ctx, staging->data, staging->size);
+    record_end_(ctx);
+}
+
+void division_engine_capture_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_BEGIN_FRAME);
+    record_write_(ctx, frame, sizeof(DivisionFrameDescriptor));
+    record_end_(ctx);
+}
+
+void division_engine_capture_mark_dirty(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_MARK_DIRTY);
+    record_write_(ctx, rect, sizeof(DivisionDirtyRect));
+    record_end_(ctx);
+}
+
+void division_engine_capture_submit(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instances,
+    uint32_t render_pass_instance_count
+)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    // The ring ranges are written by the application after their allocation,
+    // so the data of the frame is taken right before the submit
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    if (uniform_buffer_ctx->ring_frame_offset > 0)
+    {
+        uint64_t frame_offset = (uint64_t) uniform_buffer_ctx->ring_frame *
+                                DIVISION_UNIFORM_RING_FRAME_CAPACITY;
+
+        record_begin_(ctx, DIVISION_CAPTURE_UNIFORM_RING_DATA);
+        record_write_(ctx, &frame_offset, sizeof(frame_offset));
+        record_write_(
+            ctx,
+            (const uint8_t*) uniform_buffer_ctx->ring_data + frame_offset,
+            uniform_buffer_ctx->ring_frame_offset
+        );
+        record_end_(ctx);
+    }
+
+    SubmitRecord_ submit_record = {
+        .render_pass_instance_count = render_pass_instance_count,
+    };
+
+    record_begin_(ctx, DIVISION_CAPTURE_SUBMIT);
+    record_write_(ctx, &submit_record, sizeof(submit_record));
+
+    for (uint32_t i = 0; i < render_pass_instance_count; i++)
+    {
+        // Pointers are written as they are, the replay points them to the arrays
+        DivisionRenderPassInstance instance = render_pass_instances[i];
+        if (DIVISION_MASK_HAS_FLAG(
+                instance.capabilities_mask,
+                DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+            ))
+        {
+            instance.uniform_vertex_buffer_count = 0;
+            instance.uniform_fragment_buffer_count = 0;
+            instance.fragment_texture_count = 0;
+        }
+
+        record_write_(ctx, &instance, sizeof(instance));
+        record_write_(
+            ctx,
+            instance.uniform_vertex_buffers,
+            sizeof(DivisionIdWithBinding[instance.uniform_vertex_buffer_count])
+        );
+        record_write_(
+            ctx,
+            instance.uniform_fragment_buffers,
+            sizeof(DivisionIdWithBinding[instance.uniform_fragment_buffer_count])
+        );
+        record_write_(
+            ctx,
+            instance.fragment_textures,
+            sizeof(DivisionIdWithBinding[instance.fragment_texture_count])
+        );
+        record_write_(
+            ctx,
+            instance.uniform_ring_bindings,
+            sizeof(DivisionUniformRingBinding[instance.uniform_ring_binding_count])
+        );
+    }
+
+    record_end_(ctx);
+}
+
+void division_engine_capture_end_frame(DivisionContext* ctx)
+{
+    if (ctx->capture_context->file == NULL)
+    {
+        return;
+    }
+
+    record_begin_(ctx, DIVISION_CAPTURE_END_FRAME);
+    record_end_(ctx);
+}
+
+bool division_engine_capture_replay(
+    DivisionContext* ctx, const char* path, DivisionCaptureReplayStats* out_stats
+)
+{
+    *out_stats = (DivisionCaptureReplayStats){
+        .command_count = 0,
+        .frame_count = 0,
+        .total_ms = 0,
+        .min_frame_ms = 0,
+        .max_frame_ms = 0,
+    };
+
+    void* file_data;
+    size_t file_size;
+    if (!division_io_read_all_bytes_from_file(path, &file_data, &file_size))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to read the capture file");
+        return false;
+    }
+
+    ReplayReader_ file_reader = {.data = file_data, .size = file_size, .offset = 0};
+    const DivisionCaptureFileHeader* file_header =
+        read_(&file_reader, sizeof(DivisionCaptureFileHeader));
+    if (file_header == NULL || file_header->magic != DIVISION_CAPTURE_MAGIC ||
+        file_header->version != DIVISION_CAPTURE_VERSION)
+    {
+        free(file_data);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unsupported capture file");
+        return false;
+    }
+
+    ReplayState_ state = {.scratch = NULL, .scratch_capacity = 0, .ring_offset_shift = 0};
+    double replay_begin_ms = get_time_ms_();
+    double frame_begin_ms = replay_begin_ms;
+    bool ok = true;
+
+    while (ok && file_reader.offset < file_reader.size)
+    {
+        const DivisionCaptureRecordHeader* record_header =
+            read_(&file_reader, sizeof(DivisionCaptureRecordHeader));
+        const void* payload =
+            record_header ? read_(&file_reader, record_header->payload_size) : NULL;
+        if (payload == NULL)
+        {
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "Capture file is truncated");
+            ok = false;
+            break;
+        }
+
+        ReplayReader_ record_reader = {
+            .data = payload,
+            .size = record_header->payload_size,
+            .offset = 0,
+        };
+        ok = replay_record_(ctx, &state, record_header->command, &record_reader);
+        out_stats->command_count++;
+
+        if (ok && record_header->command == DIVISION_CAPTURE_END_FRAME)
+        {
+            double frame_end_ms = get_time_ms_();
+            double frame_ms = frame_end_ms - frame_begin_ms;
+
+            out_stats->min_frame_ms =
+                out_stats->frame_count == 0
+                    ? frame_ms
+                    : DIVISION_MIN(out_stats->min_frame_ms, frame_ms);
+            out_stats->max_frame_ms = DIVISION_MAX(out_stats->max_frame_ms, frame_ms);
+            out_stats->frame_count++;
+            frame_begin_ms = frame_end_ms;
+        }
+    }
+
+    out_stats->total_ms = get_time_ms_() - replay_begin_ms;
+
+    free(state.scratch);
+    free(file_data);
+    return ok;
+}
+
+size_t align_size_(size_t size)
+{
+    return (size + DIVISION_CAPTURE_ALIGNMENT - 1) / DIVISION_CAPTURE_ALIGNMENT *
+           DIVISION_CAPTURE_ALIGNMENT;
+}
+
+double get_time_ms_(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+
+    return (double) time.tv_sec * 1000.0 + (double) time.tv_nsec / 1000000.0;
+}
+
+void record_begin_(DivisionContext* ctx, DivisionCaptureCommand command)
+{
+    DivisionCaptureSystemContext* capture_ctx = ctx->capture_context;
+    DivisionCaptureRecordHeader header = {
+        .payload_size = 0,
+        .command = command,
+        .reserved = 0,
+    };
+
+    capture_ctx->record_size = 0;
+    capture_ctx->record_failed = false;
+    record_write_(ctx, &header, sizeof(header));
+}
+
+// Fields are padded with zeros, so the replay reads them in place
+void* record_reserve_(DivisionContext* ctx, size_t size)
+{
+    DivisionCaptureSystemContext* capture_ctx = ctx->capture_context;
+    size_t aligned_size = align_size_(size);
+    size_t new_size = capture_ctx->record_size + aligned_size;
+
+    if (new_size > capture_ctx->record_capacity)
+    {
+        size_t new_capacity = DIVISION_MAX(new_size, capture_ctx->record_capacity * 2);
+        uint8_t* record = realloc(capture_ctx->record, new_capacity);
+        if (record == NULL)
+        {
+            capture_ctx->record_failed = true;
+            return NULL;
+        }
+
+        capture_ctx->record = record;
+        capture_ctx->record_capacity = new_capacity;
+    }
+
+    uint8_t* field = capture_ctx->record + capture_ctx->record_size;
+    memset(field + size, 0, aligned_size - size);
+    capture_ctx->record_size = new_size;
+    return field;
+}
+
+void record_write_(DivisionContext* ctx, const void* data, size_t size)
+{
+    void* field = record_reserve_(ctx, size);
+    if (field != NULL && size > 0)
+    {
+        memcpy(field, data, size);
+    }
+}
+
+void record_end_(DivisionContext* ctx)
+{
+    DivisionCaptureSystemContext* capture_ctx = ctx->capture_context;
+    if (capture_ctx->record_failed)
+    {
+        stop_capture_(ctx);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the capture record");
+        return;
+    }
+
+    DivisionCaptureRecordHeader* header =
+        (DivisionCaptureRecordHeader*) capture_ctx->record;
+    header->payload_size = capture_ctx->record_size - sizeof(DivisionCaptureRecordHeader);
+
+    if (fwrite(capture_ctx->record, capture_ctx->record_size, 1, capture_ctx->file) != 1)
+    {
+        stop_capture_(ctx);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to write the capture file");
+    }
+}
+
+void record_layout_(
+    DivisionContext* ctx,
+    const DivisionVertexAttributeSettings* settings,
+    const DivisionVertexAttribute* attributes,
+    int32_t attribute_count
+)
+{
+    // The replay reads the attributes as one array, so they aren't padded one by one
+    DivisionVertexLayoutAttribute* layout_attributes = record_reserve_(
+        ctx, sizeof(DivisionVertexLayoutAttribute[attribute_count])
+    );
+    if (layout_attributes == NULL)
+    {
+        return;
+    }
+
+    for (int32_t i = 0; i < attribute_count; i++)
+    {
+        layout_attributes[i] = (DivisionVertexLayoutAttribute){
+            .settings = settings[i],
+            .attribute = attributes[i],
+        };
+    }
+}
+
+void stop_capture_(DivisionContext* ctx)
+{
+    DivisionCaptureSystemContext* capture_ctx = ctx->capture_context;
+    if (capture_ctx->file != NULL)
+    {
+        fclose(capture_ctx->file);
+        capture_ctx->file = NULL;
+    }
+}
+
+// Returns NULL if the reader has less bytes left
+const void* read_(ReplayReader_* reader, size_t size)
+{
+    size_t aligned_size = align_size_(size);
+    if (aligned_size < size || aligned_size > reader->size - reader->offset)
+    {
+        return NULL;
+    }
+
+    const void* data = reader->data + reader->offset;
+    reader->offset += aligned_size;
+    return data;
+}
+
+void* reserve_scratch_(ReplayState_* state, size_t size)
+{
+    if (size > state->scratch_capacity)
+    {
+        uint8_t* scratch = realloc(state->scratch, size);
+        if (scratch == NULL)
+        {
+            return NULL;
+        }
+
+        state->scratch = scratch;
+        state->scratch_capacity = size;
+    }
+
+    return state->scratch;
+}
+
+bool replay_record_(
+    DivisionContext* ctx,
+    ReplayState_* state,
+    DivisionCaptureCommand command,
+    ReplayReader_* reader
+)
+{
+    // Records without the payload
+    switch (command)
+    {
+    case DIVISION_CAPTURE_UPLOAD_FLUSH:
+        division_engine_upload_queue_flush(ctx);
+        return true;
+    case DIVISION_CAPTURE_END_FRAME:
+        division_engine_render_pass_instance_end_frame(ctx);
+        return true;
+    default:
+        break;
+    }
+
+    // The other records start with the id of the resource, the id is read again
+    // by the replay of the whole record
+    const uint32_t* id = read_(reader, sizeof(uint32_t));
+    reader->offset = 0;
+    if (id == NULL)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Capture record is truncated");
+        return false;
+    }
+
+    // Ids of a broken or foreign capture must not index the resource arrays
+    const DivisionUnorderedIdTable* id_table = get_record_id_table_(ctx, command);
+    if (id_table != NULL && !check_captured_id_(ctx, id_table, *id))
+    {
+        return false;
+    }
+
+    switch (command)
+    {
+    case DIVISION_CAPTURE_SHADER_PROGRAM_ALLOC:
+        return replay_shader_program_alloc_(ctx, reader);
+    case DIVISION_CAPTURE_SHADER_PROGRAM_FREE:
+        division_engine_shader_program_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_VERTEX_BUFFER_ALLOC:
+        return replay_vertex_buffer_alloc_(ctx, reader);
+    case DIVISION_CAPTURE_VERTEX_BUFFER_FREE:
+        division_engine_vertex_buffer_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_VERTEX_BUFFER_RESIZE:
+    {
+        read_(reader, sizeof(uint32_t));
+        const DivisionVertexBufferSize* size =
+            read_(reader, sizeof(DivisionVertexBufferSize));
+        return size != NULL && division_engine_vertex_buffer_resize(ctx, *id, *size);
+    }
+    case DIVISION_CAPTURE_VERTEX_BUFFER_DATA:
+        return replay_vertex_buffer_data_(ctx, reader);
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_ALLOC:
+    {
+        read_(reader, sizeof(uint32_t));
+        const DivisionUniformBufferDescriptor* buffer =
+            read_(reader, sizeof(DivisionUniformBufferDescriptor));
+        if (buffer == NULL)
+        {
+            return false;
+        }
+
+        uint32_t buffer_id;
+        bool is_allocated =
+            division_engine_uniform_buffer_alloc(ctx, *buffer, &buffer_id);
+        return check_replayed_id_(ctx, is_allocated, buffer_id, *id);
+    }
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_FREE:
+        division_engine_uniform_buffer_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_DATA:
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_UPDATE:
+    case DIVISION_CAPTURE_UPLOAD:
+        return replay_buffer_update_(ctx, command, reader);
+    case DIVISION_CAPTURE_TEXTURE_ALLOC:
+    {
+        read_(reader, sizeof(uint32_t));
+        const DivisionTexture* texture = read_(reader, sizeof(DivisionTexture));
+        if (texture == NULL)
+        {
+            return false;
+        }
+
+        uint32_t texture_id;
+        bool is_allocated = division_engine_texture_alloc(ctx, texture, &texture_id);
+        return check_replayed_id_(ctx, is_allocated, texture_id, *id);
+    }
+    case DIVISION_CAPTURE_TEXTURE_FREE:
+        division_engine_texture_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_TEXTURE_DATA:
+    {
+        read_(reader, sizeof(uint32_t));
+        size_t data_size =
+            division_engine_texture_data_size(&ctx->texture_context->textures[*id]);
+        const void* data = read_(reader, data_size);
+        if (data != NULL)
+        {
+            division_engine_texture_set_data(ctx, *id, data);
+        }
+        return data != NULL;
+    }
+    case DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_ALLOC:
+    {
+        read_(reader, sizeof(uint32_t));
+        const DivisionRenderPassDescriptor* render_pass =
+            read_(reader, sizeof(DivisionRenderPassDescriptor));
+        if (render_pass == NULL)
+        {
+            return false;
+        }
+
+        uint32_t render_pass_id;
+        bool is_allocated = division_engine_render_pass_descriptor_alloc(
+            ctx, render_pass, &render_pass_id
+        );
+        return check_replayed_id_(ctx, is_allocated, render_pass_id, *id);
+    }
+    case DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_FREE:
+        division_engine_render_pass_descriptor_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_UPDATE:
+    {
+        read_(reader, sizeof(uint32_t));
+        const DivisionRenderPassDescriptor* render_pass =
+            read_(reader, sizeof(DivisionRenderPassDescriptor));
+        if (render_pass == NULL)
+        {
+            return false;
+        }
+
+        DivisionRenderPassDescriptor* borrowed =
+            division_engine_render_pass_descriptor_borrow(ctx, *id);
+        if (borrowed == NULL)
+        {
+            return false;
+        }
+
+        *borrowed = *render_pass;
+        return division_engine_render_pass_descriptor_return(ctx, *id, borrowed);
+    }
+    case DIVISION_CAPTURE_BINDING_GROUP_ALLOC:
+        return replay_binding_group_alloc_(ctx, reader);
+    case DIVISION_CAPTURE_BINDING_GROUP_FREE:
+        division_engine_binding_group_free(ctx, *id);
+        return true;
+    case DIVISION_CAPTURE_UNIFORM_RING_DATA:
+        return replay_uniform_ring_data_(ctx, state, reader);
+    case DIVISION_CAPTURE_BEGIN_FRAME:
+    {
+        const DivisionFrameDescriptor* frame =
+            read_(reader, sizeof(DivisionFrameDescriptor));
+        return frame != NULL &&
+               division_engine_render_pass_instance_begin_frame(ctx, frame);
+    }
+    case DIVISION_CAPTURE_SUBMIT:
+        return replay_submit_(ctx, state, reader);
+    case DIVISION_CAPTURE_MARK_DIRTY:
+    {
+        const DivisionDirtyRect* rect = read_(reader, sizeof(DivisionDirtyRect));
+        if (rect != NULL)
+        {
+            division_engine_render_pass_instance_mark_dirty(ctx, rect);
+        }
+        return rect != NULL;
+    }
+    default:
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown capture command");
+        return false;
+    }
+}
+
+bool replay_shader_program_alloc_(DivisionContext* ctx, ReplayReader_* reader)
+{
+    const uint32_t* captured_id = read_(reader, sizeof(uint32_t));
+    const int32_t* descriptor_count = read_(reader, sizeof(int32_t));
+    if (descriptor_count == NULL || *descriptor_count <= 0)
+    {
+        return false;
+    }
+
+    DivisionShaderSourceDescriptor* descriptors =
+        malloc(sizeof(DivisionShaderSourceDescriptor[*descriptor_count]));
+    if (descriptors == NULL)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    for (int32_t i = 0; ok && i < *descriptor_count; i++)
+    {
+        const ShaderSourceRecord_* source_record =
+            read_(reader, sizeof(ShaderSourceRecord_));
+        const char* entry_point_name =
+            source_record ? read_(reader, source_record->entry_point_size) : NULL;
+        const char* source =
+            entry_point_name ? read_(reader, source_record->source_size) : NULL;
+
+        ok = source != NULL;
+        if (ok)
+        {
+            descriptors[i] = (DivisionShaderSourceDescriptor){
+                .type = (DivisionShaderType) source_record->type,
+                .entry_point_name =
+                    source_record->entry_point_size > 0 ? entry_point_name : NULL,
+                .source = source,
+                .source_size = source_record->source_size,
+            };
+        }
+    }
+
+    uint32_t shader_program_id;
+    if (ok)
+    {
+        bool is_allocated = division_engine_shader_program_alloc(
+            ctx, descriptors, *descriptor_count, &shader_program_id
+        );
+        ok = check_replayed_id_(ctx, is_allocated, shader_program_id, *captured_id);
+    }
+
+    free(descriptors);
+    return ok;
+}
+
+bool replay_vertex_buffer_alloc_(DivisionContext* ctx, ReplayReader_* reader)
+{
+    const VertexBufferRecord_* buffer_record = read_(reader, sizeof(VertexBufferRecord_));
+    if (buffer_record == NULL)
+    {
+        return false;
+    }
+
+    const VertexLayoutRecord_* layout_records[] = {
+        &buffer_record->per_vertex_layout,
+        &buffer_record->per_instance_layout,
+    };
+    DivisionVertexLayout layouts[2];
+    for (int i = 0; i < 2; i++)
+    {
+        const VertexLayoutRecord_* layout_record = layout_records[i];
+        layouts[i] = (DivisionVertexLayout){
+            .attributes = read_(
+                reader,
+                sizeof(DivisionVertexLayoutAttribute[layout_record->attribute_count])
+            ),
+            .attribute_count = layout_record->attribute_count,
+            .stride = layout_record->stride,
+        };
+
+        if (layouts[i].attributes == NULL)
+        {
+            return false;
+        }
+    }
+
+    DivisionVertexBufferLayoutSettings settings = {
+        .size = buffer_record->size,
+        .per_vertex_layout = &layouts[0],
+        .per_instance_layout = layouts[1].attribute_count > 0 ? &layouts[1] : NULL,
+        .topology = buffer_record->topology,
+        .capabilities_mask = buffer_record->capabilities_mask,
+    };
+
+    uint32_t vertex_buffer_id;
+    bool is_allocated = division_engine_vertex_buffer_alloc_with_layout(
+        ctx, &settings, &vertex_buffer_id
+    );
+    return check_replayed_id_(
+        ctx, is_allocated, vertex_buffer_id, buffer_record->vertex_buffer_id
+    );
+}
+
+bool replay_vertex_buffer_data_(DivisionContext* ctx, ReplayReader_* reader)
+{
+    const uint32_t* vertex_buffer_id = read_(reader, sizeof(uint32_t));
+    const DivisionVertexBufferSize* size =
+        read_(reader, sizeof(DivisionVertexBufferSize));
+    if (size == NULL)
+    {
+        return false;
+    }
+
+    const DivisionVertexBuffer* vertex_buffer =
+        &ctx->vertex_buffer_context->buffers[*vertex_buffer_id];
+    size_t data_sizes[] = {
+        size->vertex_count * vertex_buffer->per_vertex_data_size,
+        size->index_count * division_engine_vertex_buffer_index_size(vertex_buffer),
+        size->instance_count * vertex_buffer->per_instance_data_size,
+    };
+    const void* data[3];
+    for (int i = 0; i < 3; i++)
+    {
+        data[i] = read_(reader, data_sizes[i]);
+        if (data[i] == NULL)
+        {
+            return false;
+        }
+    }
+
+    DivisionVertexBufferBorrowedData borrowed;
+    if (!division_engine_vertex_buffer_borrow_data(ctx, *vertex_buffer_id, &borrowed))
+    {
+        return false;
+    }
+
+    memcpy(borrowed.vertex_data_ptr, data[0], data_sizes[0]);
+    memcpy(borrowed.index_data_ptr, data[1], data_sizes[1]);
+    memcpy(borrowed.instance_data_ptr, data[2], data_sizes[2]);
+
+    division_engine_vertex_buffer_return_data(ctx, *vertex_buffer_id, &borrowed);
+    return true;
+}
+
+bool replay_buffer_update_(
+    DivisionContext* ctx, DivisionCaptureCommand command, ReplayReader_* reader
+)
+{
+    const BufferUpdateRecord_* update_record = read_(reader, sizeof(BufferUpdateRecord_));
+    const void* data = update_record ? read_(reader, update_record->size) : NULL;
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    switch (command)
+    {
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_DATA:
+    {
+        void* buffer_data = division_engine_uniform_buffer_borrow_data_pointer(
+            ctx, update_record->buffer_id
+        );
+        memcpy(buffer_data, data, update_record->size);
+        division_engine_uniform_buffer_return_data_pointer(
+            ctx, update_record->buffer_id, buffer_data
+        );
+        return true;
+    }
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_UPDATE:
+        return division_engine_uniform_buffer_update_range(
+            ctx,
+            update_record->buffer_id,
+            update_record->offset,
+            data,
+            update_record->size
+        );
+    default:
+        break;
+    }
+
+    // The staging ring is freed by the flush, when it is full
+    DivisionUploadStaging staging;
+    if (!division_engine_upload_queue_alloc_staging(ctx, update_record->size, &staging))
+    {
+        division_engine_upload_queue_flush(ctx);
+        if (!division_engine_upload_queue_alloc_staging(
+                ctx, update_record->size, &staging
+            ))
+        {
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to replay the upload");
+            return false;
+        }
+    }
+
+    memcpy(staging.data, data, update_record->size);
+
+    DivisionUploadFence fence;
+    return division_engine_upload_queue_enqueue(
+        ctx,
+        &staging,
+        (DivisionUploadTarget) update_record->target,
+        update_record->buffer_id,
+        update_record->offset,
+        &fence
+    );
+}
+
+bool replay_binding_group_alloc_(DivisionContext* ctx, ReplayReader_* reader)
+{
+    const BindingGroupRecord_* group_record = read_(reader, sizeof(BindingGroupRecord_));
+    if (group_record == NULL)
+    {
+        return false;
+    }
+
+    DivisionBindingGroup binding_group = {
+        .uniform_vertex_buffers = read_(
+            reader,
+            sizeof(DivisionIdWithBinding[group_record->uniform_vertex_buffer_count])
+        ),
+        .uniform_fragment_buffers = read_(
+            reader,
+            sizeof(DivisionIdWithBinding[group_record->uniform_fragment_buffer_count])
+        ),
+        .fragment_textures = read_(
+            reader, sizeof(DivisionIdWithBinding[group_record->fragment_texture_count])
+        ),
+        .uniform_vertex_buffer_count = group_record->uniform_vertex_buffer_count,
+        .uniform_fragment_buffer_count = group_record->uniform_fragment_buffer_count,
+        .fragment_texture_count = group_record->fragment_texture_count,
+    };
+    if (binding_group.uniform_vertex_buffers == NULL ||
+        binding_group.uniform_fragment_buffers == NULL ||
+        binding_group.fragment_textures == NULL)
+    {
+        return false;
+    }
+
+    const DivisionUnorderedIdTable* buffer_ids = &ctx->uniform_buffer_context->id_table;
+    if (!check_captured_bindings_(
+            ctx,
+            buffer_ids,
+            binding_group.uniform_vertex_buffers,
+            binding_group.uniform_vertex_buffer_count
+        ) ||
+        !check_captured_bindings_(
+            ctx,
+            buffer_ids,
+            binding_group.uniform_fragment_buffers,
+            binding_group.uniform_fragment_buffer_count
+        ) ||
+        !check_captured_bindings_(
+            ctx,
+            &ctx->texture_context->id_table,
+            binding_group.fragment_textures,
+            binding_group.fragment_texture_count
+        ))
+    {
+        return false;
+    }
+
+    uint32_t group_id;
+    bool is_allocated =
+        division_engine_binding_group_alloc(ctx, &binding_group, &group_id);
+    return check_replayed_id_(
+        ctx, is_allocated, group_id, group_record->binding_group_id
+    );
+}
+
+// The frame data is copied to one range, the submit moves the captured offsets into it
+bool replay_uniform_ring_data_(
+    DivisionContext* ctx, ReplayState_* state, ReplayReader_* reader
+)
+{
+    const uint64_t* frame_offset = read_(reader, sizeof(uint64_t));
+    size_t data_size = reader->size - reader->offset;
+    const void* data = read_(reader, data_size);
+
+    DivisionUniformRingRange range;
+    if (data == NULL ||
+        !division_engine_uniform_buffer_ring_alloc(ctx, data_size, &range))
+    {
+        return false;
+    }
+
+    memcpy(range.data, data, data_size);
+    state->ring_offset_shift = (int64_t) range.offset - (int64_t) *frame_offset;
+    return true;
+}
+
+bool replay_submit_(
+    DivisionContext* ctx, ReplayState_* state, ReplayReader_* reader
+)
+{
+    const SubmitRecord_* submit_record = read_(reader, sizeof(SubmitRecord_));
+    if (submit_record == NULL)
+    {
+        return false;
+    }
+
+    uint32_t instance_count = submit_record->render_pass_instance_count;
+    DivisionRenderPassInstance* instances =
+        reserve_scratch_(state, sizeof(DivisionRenderPassInstance[instance_count]));
+    if (instances == NULL)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < instance_count; i++)
+    {
+        const DivisionRenderPassInstance* instance =
+            read_(reader, sizeof(DivisionRenderPassInstance));
+        if (instance == NULL)
+        {
+            return false;
+        }
+
+        instances[i] = *instance;
+        instances[i].uniform_vertex_buffers = (DivisionIdWithBinding*) read_(
+            reader, sizeof(DivisionIdWithBinding[instance->uniform_vertex_buffer_count])
+        );
+        instances[i].uniform_fragment_buffers = (DivisionIdWithBinding*) read_(
+            reader, sizeof(DivisionIdWithBinding[instance->uniform_fragment_buffer_count])
+        );
+        instances[i].fragment_textures = (DivisionIdWithBinding*) read_(
+            reader, sizeof(DivisionIdWithBinding[instance->fragment_texture_count])
+        );
+
+        // Ring bindings are moved in place, the record isn't read again
+        int32_t ring_binding_count = instance->uniform_ring_binding_count;
+        DivisionUniformRingBinding* ring_bindings = (DivisionUniformRingBinding*) read_(
+            reader, sizeof(DivisionUniformRingBinding[ring_binding_count])
+        );
+        if (instances[i].uniform_vertex_buffers == NULL ||
+            instances[i].uniform_fragment_buffers == NULL ||
+            instances[i].fragment_textures == NULL || ring_bindings == NULL)
+        {
+            return false;
+        }
+
+        for (int32_t j = 0; j < ring_binding_count; j++)
+        {
+            ring_bindings[j].offset =
+                (uint32_t) ((int64_t) ring_bindings[j].offset + state->ring_offset_shift);
+        }
+        instances[i].uniform_ring_bindings = ring_bindings;
+
+        if (!check_captured_instance_(ctx, &instances[i]))
+        {
+            return false;
+        }
+    }
+
+    division_engine_render_pass_instance_submit(ctx, instances, instance_count);
+    state->ring_offset_shift = 0;
+
+    return true;
+}
+
+bool check_replayed_id_(
+    DivisionContext* ctx, bool is_allocated, uint32_t replayed_id, uint32_t captured_id
+)
+{
+    if (is_allocated && replayed_id != captured_id)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Replayed resource id doesn't match the capture"
+        );
+        return false;
+    }
+
+    return is_allocated;
+}
+
+// Table of the resource, which the record starts with, or NULL for the other records
+const DivisionUnorderedIdTable* get_record_id_table_(
+    const DivisionContext* ctx, DivisionCaptureCommand command
+)
+{
+    switch (command)
+    {
+    case DIVISION_CAPTURE_SHADER_PROGRAM_FREE:
+        return &ctx->shader_context->id_table;
+    case DIVISION_CAPTURE_VERTEX_BUFFER_FREE:
+    case DIVISION_CAPTURE_VERTEX_BUFFER_RESIZE:
+    case DIVISION_CAPTURE_VERTEX_BUFFER_DATA:
+        return &ctx->vertex_buffer_context->id_table;
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_FREE:
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_DATA:
+    case DIVISION_CAPTURE_UNIFORM_BUFFER_UPDATE:
+        return &ctx->uniform_buffer_context->id_table;
+    case DIVISION_CAPTURE_TEXTURE_FREE:
+    case DIVISION_CAPTURE_TEXTURE_DATA:
+        return &ctx->texture_context->id_table;
+    case DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_FREE:
+    case DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_UPDATE:
+        return &ctx->render_pass_context->id_table;
+    case DIVISION_CAPTURE_BINDING_GROUP_FREE:
+        return &ctx->binding_group_context->id_table;
+    // Uploads are checked by the upload queue, which knows the table of the target
+    default:
+        return NULL;
+    }
+}
+
+bool check_captured_id_(
+    DivisionContext* ctx, const DivisionUnorderedIdTable* id_table, uint32_t id
+)
+{
+    if (!division_unordered_id_table_contains(id_table, id))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Capture refers to an unknown resource id");
+        return false;
+    }
+
+    return true;
+}
+
+bool check_captured_bindings_(
+    DivisionContext* ctx,
+    const DivisionUnorderedIdTable* id_table,
+    const DivisionIdWithBinding* bindings,
+    int32_t binding_count
+)
+{
+    for (int32_t i = 0; i < binding_count; i++)
+    {
+        if (!check_captured_id_(ctx, id_table, bindings[i].id))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool check_captured_instance_(
+    DivisionContext* ctx, const DivisionRenderPassInstance* instance
+)
+{
+    if (!check_captured_id_(
+            ctx, &ctx->render_pass_context->id_table, instance->render_pass_descriptor_id
+        ))
+    {
+        return false;
+    }
+
+    if (DIVISION_MASK_HAS_FLAG(
+            instance->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+        ))
+    {
+        return check_captured_id_(
+            ctx, &ctx->binding_group_context->id_table, instance->binding_group_id
+        );
+    }
+
+    const DivisionUnorderedIdTable* buffer_ids = &ctx->uniform_buffer_context->id_table;
+    return check_captured_bindings_(
+               ctx,
+               buffer_ids,
+               instance->uniform_vertex_buffers,
+               instance->uniform_vertex_buffer_count
+           ) &&
+           check_captured_bindings_(
+               ctx,
+               buffer_ids,
+               instance->uniform_fragment_buffers,
+               instance->uniform_fragment_buffer_count
+           ) &&
+           check_captured_bindings_(
+               ctx,
+               &ctx->texture_context->id_table,
+               instance->fragment_textures,
+               instance->fragment_texture_count
+           );
+}
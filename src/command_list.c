@@ -0,0 +1,485 @@
+#include "division_engine_core/command_list.h"
+
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/render_pass_instance.h"
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core/utility.h"
+
+#include <memory.h>
+#include <stdlib.h>
+
+static inline bool bind_(
+    DivisionIdWithBinding* bindings,
+    int32_t* binding_count,
+    DivisionIdWithBinding binding,
+    bool* bindings_dirty
+);
+static inline DivisionCommand* push_command_(DivisionCommandList* list);
+static inline bool push_data_(DivisionCommandList* list, size_t size, size_t* out_offset);
+static inline bool store_bindings_(DivisionCommandList* list);
+static inline bool enqueue_copy_(
+    DivisionContext* ctx, const DivisionCommandList* list, const DivisionCommandCopy* copy
+);
+static inline bool reserve_submit_instances_(
+    DivisionRenderPassSystemContext* render_pass_ctx, size_t count
+);
+
+bool division_command_list_alloc(
+    DivisionCommandList* list, size_t command_capacity, size_t data_capacity
+)
+{
+    *list = (DivisionCommandList){
+        .commands = malloc(sizeof(DivisionCommand[command_capacity])),
+        .command_capacity = command_capacity,
+        .data = malloc(data_capacity),
+        .data_capacity = data_capacity,
+    };
+
+    if ((command_capacity > 0 && list->commands == NULL) ||
+        (data_capacity > 0 && list->data == NULL))
+    {
+        division_command_list_free(list);
+        return false;
+    }
+
+    division_command_list_reset(list);
+    return true;
+}
+
+void division_command_list_free(DivisionCommandList* list)
+{
+    free(list->commands);
+    free(list->data);
+
+    list->commands = NULL;
+    list->data = NULL;
+    list->command_capacity = 0;
+    list->data_capacity = 0;
+    division_command_list_reset(list);
+}
+
+void division_command_list_reset(DivisionCommandList* list)
+{
+    list->command_count = 0;
+    list->data_size = 0;
+    list->draw_count = 0;
+    list->render_pass_descriptor_id = DIVISION_COMMAND_LIST_NO_DESCRIPTOR;
+    division_command_list_clear_bindings(list);
+}
+
+void division_command_list_bind_render_pass_descriptor(
+    DivisionCommandList* list, uint32_t render_pass_descriptor_id
+)
+{
+    list->render_pass_descriptor_id = render_pass_descriptor_id;
+}
+
+bool division_command_list_bind_uniform_vertex_buffer(
+    DivisionCommandList* list, DivisionIdWithBinding buffer_binding
+)
+{
+    return bind_(
+        list->uniform_vertex_buffers,
+        &list->uniform_vertex_buffer_count,
+        buffer_binding,
+        &list->bindings_dirty
+    );
+}
+
+bool division_command_list_bind_uniform_fragment_buffer(
+    DivisionCommandList* list, DivisionIdWithBinding buffer_binding
+)
+{
+    return bind_(
+        list->uniform_fragment_buffers,
+        &list->uniform_fragment_buffer_count,
+        buffer_binding,
+        &list->bindings_dirty
+    );
+}
+
+bool division_command_list_bind_fragment_texture(
+    DivisionCommandList* list, DivisionIdWithBinding texture_binding
+)
+{
+    return bind_(
+        list->fragment_textures,
+        &list->fragment_texture_count,
+        texture_binding,
+        &list->bindings_dirty
+    );
+}
+
+void division_command_list_bind_binding_group(
+    DivisionCommandList* list, uint32_t binding_group_id
+)
+{
+    list->binding_group_id = binding_group_id;
+}
+
+void division_command_list_clear_bindings(DivisionCommandList* list)
+{
+    list->binding_group_id = DIVISION_COMMAND_LIST_NO_BINDING_GROUP;
+    list->uniform_vertex_buffer_count = 0;
+    list->uniform_fragment_buffer_count = 0;
+    list->fragment_texture_count = 0;
+    list->bindings_dirty = true;
+}
+
+bool division_command_list_draw(
+    DivisionCommandList* list, const DivisionCommandDrawRange* draw_range
+)
+{
+    if (list->render_pass_descriptor_id == DIVISION_COMMAND_LIST_NO_DESCRIPTOR)
+    {
+        return false;
+    }
+
+    if (list->bindings_dirty && !store_bindings_(list))
+    {
+        return false;
+    }
+
+    DivisionCommand* command = push_command_(list);
+    if (command == NULL)
+    {
+        return false;
+    }
+
+    *command = (DivisionCommand){
+        .type = DIVISION_COMMAND_DRAW,
+        .draw =
+            {
+                .range = *draw_range,
+                .render_pass_descriptor_id = list->render_pass_descriptor_id,
+                .binding_group_id = list->binding_group_id,
+                .bindings_offset = list->bindings_offset,
+                .uniform_vertex_buffer_count = list->uniform_vertex_buffer_count,
+                .uniform_fragment_buffer_count = list->uniform_fragment_buffer_count,
+                .fragment_texture_count = list->fragment_texture_count,
+            },
+    };
+    if (list->binding_group_id != DIVISION_COMMAND_LIST_NO_BINDING_GROUP)
+    {
+        command->draw.range.capabilities_mask |=
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP;
+    }
+    list->draw_count++;
+
+    return true;
+}
+
+bool division_command_list_copy(
+    DivisionCommandList* list,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t dst_offset,
+    const void* data,
+    size_t size
+)
+{
+    if (size > 0 && data == NULL)
+    {
+        return false;
+    }
+
+    size_t data_offset;
+    if (!push_data_(list, size, &data_offset))
+    {
+        return false;
+    }
+
+    DivisionCommand* command = push_command_(list);
+    if (command == NULL)
+    {
+        return false;
+    }
+
+    if (size > 0)
+    {
+        memcpy(list->data + data_offset, data, size);
+    }
+    *command = (DivisionCommand){
+        .type = DIVISION_COMMAND_COPY,
+        .copy =
+            {
+                .target = target,
+                .resource_id = resource_id,
+                .dst_offset = dst_offset,
+                .data_offset = data_offset,
+                .size = size,
+            },
+    };
+
+    return true;
+}
+
+bool division_command_list_set_uniform_data(
+    DivisionCommandList* list,
+    uint32_t uniform_buffer_id,
+    size_t dst_offset,
+    const void* data,
+    size_t size
+)
+{
+    return division_command_list_copy(
+        list,
+        DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER,
+        uniform_buffer_id,
+        dst_offset,
+        data,
+        size
+    );
+}
+
+void division_engine_command_list_submit(
+    DivisionContext* ctx,
+    const DivisionColor* clear_color,
+    const DivisionCommandList* command_lists,
+    uint32_t command_list_count
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+
+    size_t draw_count = 0;
+    for (uint32_t i = 0; i < command_list_count; i++)
+    {
+        draw_count += command_lists[i].draw_count;
+    }
+
+    if (!reserve_submit_instances_(render_pass_ctx, draw_count))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the submitted draws");
+        return;
+    }
+
+    DivisionFrameDescriptor frame = {
+        .clear_color = *clear_color,
+        .color_load_action = DIVISION_LOAD_ACTION_CLEAR,
+        .color_store_action = DIVISION_STORE_ACTION_STORE,
+        .clear_depth = 1.0f,
+        .depth_load_action = DIVISION_LOAD_ACTION_CLEAR,
+        .depth_store_action = DIVISION_STORE_ACTION_DONT_CARE,
+        .opaque_sort_order = DIVISION_OPAQUE_SORT_BY_STATE,
+    };
+    if (!division_engine_render_pass_instance_begin_frame(ctx, &frame))
+    {
+        return;
+    }
+
+    DivisionRenderPassInstance* instances = render_pass_ctx->submit_instances;
+    uint32_t instance_count = 0;
+    uint32_t submitted_count = 0;
+    for (uint32_t list_idx = 0; list_idx < command_list_count; list_idx++)
+    {
+        const DivisionCommandList* list = &command_lists[list_idx];
+
+        for (size_t cmd_idx = 0; cmd_idx < list->command_count; cmd_idx++)
+        {
+            const DivisionCommand* command = &list->commands[cmd_idx];
+            if (command->type == DIVISION_COMMAND_COPY)
+            {
+                // The draws recorded before the copy must not see its data
+                if (instance_count > submitted_count)
+                {
+                    division_engine_render_pass_instance_submit(
+                        ctx, instances + submitted_count, instance_count - submitted_count
+                    );
+                    submitted_count = instance_count;
+                }
+
+                if (!enqueue_copy_(ctx, list, &command->copy))
+                {
+                    division_engine_render_pass_instance_end_frame(ctx);
+                    return;
+                }
+                continue;
+            }
+
+            const DivisionCommandDraw* draw = &command->draw;
+            DivisionIdWithBinding* bindings =
+                (DivisionIdWithBinding*) (list->data + draw->bindings_offset);
+
+            instances[instance_count++] = (DivisionRenderPassInstance){
+                .first_vertex = draw->range.first_vertex,
+                .first_instance = draw->range.first_instance,
+                .vertex_count = draw->range.vertex_count,
+                .index_count = draw->range.index_count,
+                .instance_count = draw->range.instance_count,
+                .uniform_vertex_buffers = bindings,
+                .uniform_fragment_buffers = bindings + draw->uniform_vertex_buffer_count,
+                .fragment_textures = bindings + draw->uniform_vertex_buffer_count +
+                                     draw->uniform_fragment_buffer_count,
+                .uniform_vertex_buffer_count = draw->uniform_vertex_buffer_count,
+                .uniform_fragment_buffer_count = draw->uniform_fragment_buffer_count,
+                .fragment_texture_count = draw->fragment_texture_count,
+                .render_pass_descriptor_id = draw->render_pass_descriptor_id,
+                .binding_group_id = draw->binding_group_id,
+                .capabilities_mask = draw->range.capabilities_mask,
+            };
+        }
+    }
+
+    division_engine_render_pass_instance_submit(
+        ctx, instances + submitted_count, instance_count - submitted_count
+    );
+    division_engine_render_pass_instance_end_frame(ctx);
+}
+
+bool bind_(
+    DivisionIdWithBinding* bindings,
+    int32_t* binding_count,
+    DivisionIdWithBinding binding,
+    bool* bindings_dirty
+)
+{
+    *bindings_dirty = true;
+
+    for (int32_t i = 0; i < *binding_count; i++)
+    {
+        if (bindings[i].shader_location == binding.shader_location)
+        {
+            bindings[i].id = binding.id;
+            return true;
+        }
+    }
+
+    if (*binding_count == DIVISION_COMMAND_LIST_MAX_BINDINGS)
+    {
+        return false;
+    }
+
+    bindings[(*binding_count)++] = binding;
+    return true;
+}
+
+DivisionCommand* push_command_(DivisionCommandList* list)
+{
+    if (list->command_count == list->command_capacity)
+    {
+        size_t capacity = DIVISION_MAX(list->command_capacity * 2, 16);
+        DivisionCommand* commands =
+            realloc(list->commands, sizeof(DivisionCommand[capacity]));
+        if (commands == NULL)
+        {
+            return NULL;
+        }
+
+        list->commands = commands;
+        list->command_capacity = capacity;
+    }
+
+    return &list->commands[list->command_count++];
+}
+
+bool push_data_(DivisionCommandList* list, size_t size, size_t* out_offset)
+{
+    size_t offset = (list->data_size + DIVISION_COMMAND_LIST_DATA_ALIGNMENT - 1) &
+                    ~(size_t) (DIVISION_COMMAND_LIST_DATA_ALIGNMENT - 1);
+    size_t data_size = offset + size;
+
+    if (data_size > list->data_capacity)
+    {
+        size_t capacity = DIVISION_MAX(data_size, list->data_capacity * 2);
+        uint8_t* data = realloc(list->data, capacity);
+        if (data == NULL)
+        {
+            return false;
+        }
+
+        list->data = data;
+        list->data_capacity = capacity;
+    }
+
+    list->data_size = data_size;
+    *out_offset = offset;
+
+    return true;
+}
+
+bool store_bindings_(DivisionCommandList* list)
+{
+    size_t vertex_buffers_size =
+        sizeof(DivisionIdWithBinding[list->uniform_vertex_buffer_count]);
+    size_t fragment_buffers_size =
+        sizeof(DivisionIdWithBinding[list->uniform_fragment_buffer_count]);
+    size_t textures_size = sizeof(DivisionIdWithBinding[list->fragment_texture_count]);
+
+    size_t offset;
+    if (!push_data_(
+            list, vertex_buffers_size + fragment_buffers_size + textures_size, &offset
+        ))
+    {
+        return false;
+    }
+
+    uint8_t* dst = list->data + offset;
+    memcpy(dst, list->uniform_vertex_buffers, vertex_buffers_size);
+    memcpy(
+        dst + vertex_buffers_size, list->uniform_fragment_buffers, fragment_buffers_size
+    );
+    memcpy(
+        dst + vertex_buffers_size + fragment_buffers_size,
+        list->fragment_textures,
+        textures_size
+    );
+
+    list->bindings_offset = offset;
+    list->bindings_dirty = false;
+
+    return true;
+}
+
+bool enqueue_copy_(
+    DivisionContext* ctx, const DivisionCommandList* list, const DivisionCommandCopy* copy
+)
+{
+    if (copy->size == 0)
+    {
+        return true;
+    }
+
+    DivisionUploadStaging staging;
+    if (!division_engine_upload_queue_alloc_staging(ctx, copy->size, &staging))
+    {
+        // Submits the copies so far, their staging ranges are reused on completion
+        division_engine_upload_queue_flush(ctx);
+
+        if (!division_engine_upload_queue_alloc_staging(ctx, copy->size, &staging))
+        {
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "No upload staging space for the copy");
+            return false;
+        }
+    }
+
+    memcpy(staging.data, list->data + copy->data_offset, copy->size);
+
+    DivisionUploadFence fence;
+    return division_engine_upload_queue_enqueue(
+        ctx, &staging, copy->target, copy->resource_id, copy->dst_offset, &fence
+    );
+}
+
+bool reserve_submit_instances_(
+    DivisionRenderPassSystemContext* render_pass_ctx, size_t count
+)
+{
+    if (count <= render_pass_ctx->submit_capacity)
+    {
+        return true;
+    }
+
+    size_t capacity = DIVISION_MAX(count, render_pass_ctx->submit_capacity * 2);
+    DivisionRenderPassInstance* instances = realloc(
+        render_pass_ctx->submit_instances, sizeof(DivisionRenderPassInstance[capacity])
+    );
+    if (instances == NULL)
+    {
+        return false;
+    }
+
+    render_pass_ctx->submit_instances = instances;
+    render_pass_ctx->submit_capacity = capacity;
+
+    return true;
+}
@@ -11,13 +11,17 @@
 #include "division_engine_core/context.h"
 
 #include "division_engine_core/types/division_lifecycle.h"
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/capture.h"
 #include "division_engine_core/font.h"
 #include "division_engine_core/input.h"
+#include "division_engine_core/profiler.h"
 #include "division_engine_core/render_pass_descriptor.h"
 #include "division_engine_core/renderer.h"
 #include "division_engine_core/shader.h"
 #include "division_engine_core/texture.h"
 #include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/upload_queue.h"
 #include "division_engine_core/vertex_buffer.h"
 #include <stdlib.h>
 
@@ -28,6 +32,9 @@ bool division_engine_context_initialize(
 {
     ctx->state.delta_time = 0;
 
+    // Capture goes first, so it records the resources created by the other systems
+    if (!division_engine_capture_system_context_alloc(ctx, settings))
+        return false;
     if (!division_engine_renderer_system_context_alloc(ctx, settings))
         return false;
     if (!division_engine_shader_system_context_alloc(ctx, settings))
@@ -38,12 +45,18 @@ bool division_engine_context_initialize(
         return false;
     if (!division_engine_texture_system_context_alloc(ctx, settings))
         return false;
+    if (!division_engine_binding_group_system_context_alloc(ctx, settings))
+        return false;
     if (!division_engine_render_pass_system_context_alloc(ctx, settings))
         return false;
     if (!division_engine_input_system_alloc(ctx, settings))
         return false;
     if (!division_engine_font_system_context_alloc(ctx, settings))
         return false;
+    if (!division_engine_upload_queue_system_context_alloc(ctx, settings))
+        return false;
+    if (!division_engine_profiler_system_context_alloc(ctx, settings))
+        return false;
 
     return true;
 }
@@ -57,7 +70,10 @@ DIVISION_EXPORT void division_engine_context_register_lifecycle(
 
 void division_engine_context_finalize(DivisionContext* ctx)
 {
+    division_engine_profiler_system_context_free(ctx);
+    division_engine_upload_queue_system_context_free(ctx);
     division_engine_render_pass_system_context_free(ctx);
+    division_engine_binding_group_system_context_free(ctx);
     division_engine_texture_system_context_free(ctx);
     division_engine_uniform_buffer_system_context_free(ctx);
     division_engine_vertex_buffer_system_context_free(ctx);
@@ -65,4 +81,5 @@ void division_engine_context_finalize(DivisionContext* ctx)
     division_engine_renderer_system_context_free(ctx);
     division_engine_input_system_free(ctx);
     division_engine_font_system_context_free(ctx);
+    division_engine_capture_system_context_free(ctx);
 }
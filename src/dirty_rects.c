@@ -0,0 +1,106 @@
+#include "division_engine_core/dirty_rects.h"
+
+#include "division_engine_core/utility.h"
+
+#include <stdbool.h>
+
+static inline bool overlap_(const DivisionDirtyRect* a, const DivisionDirtyRect* b);
+static inline DivisionDirtyRect bounds_(
+    const DivisionDirtyRect* a, const DivisionDirtyRect* b
+);
+static inline uint64_t area_(const DivisionDirtyRect* rect);
+
+void division_dirty_rects_add(
+    DivisionDirtyRect* rects,
+    uint32_t* rect_count,
+    DivisionDirtyRect rect,
+    int32_t frame_width,
+    int32_t frame_height
+)
+{
+    int32_t right = DIVISION_MIN(rect.x + rect.width, frame_width);
+    int32_t top = DIVISION_MIN(rect.y + rect.height, frame_height);
+    rect.x = DIVISION_MAX(rect.x, 0);
+    rect.y = DIVISION_MAX(rect.y, 0);
+    rect.width = right - rect.x;
+    rect.height = top - rect.y;
+    if (rect.width <= 0 || rect.height <= 0)
+    {
+        return;
+    }
+
+    // Bounds can overlap the rectangles checked before, so the check restarts
+    uint32_t i = 0;
+    while (i < *rect_count)
+    {
+        if (overlap_(&rects[i], &rect))
+        {
+            rect = bounds_(&rects[i], &rect);
+            rects[i] = rects[--*rect_count];
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (*rect_count < DIVISION_DIRTY_RECT_CAPACITY)
+    {
+        rects[(*rect_count)++] = rect;
+        return;
+    }
+
+    // Bounds of the disjoint rectangles cover both, so the growth is never negative
+    uint32_t best_index = 0;
+    uint64_t best_growth = UINT64_MAX;
+    for (i = 0; i < *rect_count; i++)
+    {
+        DivisionDirtyRect merged = bounds_(&rects[i], &rect);
+        uint64_t growth = area_(&merged) - area_(&rects[i]) - area_(&rect);
+        if (growth < best_growth)
+        {
+            best_growth = growth;
+            best_index = i;
+        }
+    }
+
+    DivisionDirtyRect merged = bounds_(&rects[best_index], &rect);
+    rects[best_index] = rects[--*rect_count];
+    division_dirty_rects_add(rects, rect_count, merged, frame_width, frame_height);
+}
+
+uint64_t division_dirty_rects_area(const DivisionDirtyRect* rects, uint32_t rect_count)
+{
+    uint64_t area = 0;
+    for (uint32_t i = 0; i < rect_count; i++)
+    {
+        area += area_(&rects[i]);
+    }
+
+    return area;
+}
+
+bool overlap_(const DivisionDirtyRect* a, const DivisionDirtyRect* b)
+{
+    return a->x < b->x + b->width && b->x < a->x + a->width &&
+           a->y < b->y + b->height && b->y < a->y + a->height;
+}
+
+DivisionDirtyRect bounds_(const DivisionDirtyRect* a, const DivisionDirtyRect* b)
+{
+    int32_t x = DIVISION_MIN(a->x, b->x);
+    int32_t y = DIVISION_MIN(a->y, b->y);
+
+    return (DivisionDirtyRect){
+        .x = x,
+        .y = y,
+        .width = DIVISION_MAX(a->x + a->width, b->x + b->width) - x,
+        .height = DIVISION_MAX(a->y + a->height, b->y + b->height) - y,
+    };
+}
+
+uint64_t area_(const DivisionDirtyRect* rect)
+{
+    return (uint64_t) rect->width * (uint64_t) rect->height;
+}
@@ -0,0 +1,175 @@
+#include "division_engine_core/data_structures/free_list_allocator.h"
+
+#include <assert.h>
+#include <memory.h>
+#include <stdlib.h>
+
+static inline void insert_range_(
+    DivisionFreeListAllocator* allocator, size_t index, DivisionFreeListRange range
+);
+static inline void remove_range_(DivisionFreeListAllocator* allocator, size_t index);
+
+void division_free_list_allocator_alloc(
+    DivisionFreeListAllocator* allocator, uint32_t capacity
+)
+{
+    allocator->free_ranges_capacity = 4;
+    allocator->free_ranges =
+        malloc(sizeof(DivisionFreeListRange[allocator->free_ranges_capacity]));
+    allocator->free_ranges_count = 0;
+    allocator->capacity = capacity;
+
+    if (capacity > 0)
+    {
+        allocator->free_ranges[0] = (DivisionFreeListRange){
+            .offset = 0,
+            .size = capacity,
+        };
+        allocator->free_ranges_count = 1;
+    }
+}
+
+void division_free_list_allocator_free(DivisionFreeListAllocator* allocator)
+{
+    free(allocator->free_ranges);
+
+    allocator->free_ranges = NULL;
+    allocator->free_ranges_count = allocator->free_ranges_capacity = 0;
+    allocator->capacity = 0;
+}
+
+bool division_free_list_allocator_alloc_range(
+    DivisionFreeListAllocator* allocator, uint32_t size, uint32_t* out_offset
+)
+{
+    if (size == 0)
+    {
+        *out_offset = 0;
+        return true;
+    }
+
+    for (size_t i = 0; i < allocator->free_ranges_count; i++)
+    {
+        DivisionFreeListRange* range = &allocator->free_ranges[i];
+        if (range->size < size)
+        {
+            continue;
+        }
+
+        *out_offset = range->offset;
+
+        if (range->size == size)
+        {
+            remove_range_(allocator, i);
+        }
+        else
+        {
+            range->offset += size;
+            range->size -= size;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void division_free_list_allocator_free_range(
+    DivisionFreeListAllocator* allocator, uint32_t offset, uint32_t size
+)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    assert(offset + size <= allocator->capacity);
+
+    size_t index = 0;
+    while (index < allocator->free_ranges_count &&
+           allocator->free_ranges[index].offset < offset)
+    {
+        index++;
+    }
+
+    DivisionFreeListRange* ranges = allocator->free_ranges;
+    bool merge_prev =
+        index > 0 && ranges[index - 1].offset + ranges[index - 1].size == offset;
+    bool merge_next =
+        index < allocator->free_ranges_count && offset + size == ranges[index].offset;
+
+    if (merge_prev && merge_next)
+    {
+        ranges[index - 1].size += size + ranges[index].size;
+        remove_range_(allocator, index);
+    }
+    else if (merge_prev)
+    {
+        ranges[index - 1].size += size;
+    }
+    else if (merge_next)
+    {
+        ranges[index].offset = offset;
+        ranges[index].size += size;
+    }
+    else
+    {
+        insert_range_(
+            allocator, index, (DivisionFreeListRange){.offset = offset, .size = size}
+        );
+    }
+}
+
+void division_free_list_allocator_grow(
+    DivisionFreeListAllocator* allocator, uint32_t new_capacity
+)
+{
+    assert(new_capacity >= allocator->capacity);
+
+    uint32_t old_capacity = allocator->capacity;
+    allocator->capacity = new_capacity;
+    division_free_list_allocator_free_range(
+        allocator, old_capacity, new_capacity - old_capacity
+    );
+}
+
+bool division_free_list_allocator_is_empty(const DivisionFreeListAllocator* allocator)
+{
+    return allocator->capacity == 0 ||
+           (allocator->free_ranges_count == 1 &&
+            allocator->free_ranges[0].size == allocator->capacity);
+}
+
+void insert_range_(
+    DivisionFreeListAllocator* allocator, size_t index, DivisionFreeListRange range
+)
+{
+    if (allocator->free_ranges_count == allocator->free_ranges_capacity)
+    {
+        allocator->free_ranges_capacity *= 2;
+        allocator->free_ranges = realloc(
+            allocator->free_ranges,
+            sizeof(DivisionFreeListRange[allocator->free_ranges_capacity])
+        );
+    }
+
+    DivisionFreeListRange* ranges = allocator->free_ranges;
+    memmove(
+        ranges + index + 1,
+        ranges + index,
+        sizeof(DivisionFreeListRange[allocator->free_ranges_count - index])
+    );
+    ranges[index] = range;
+    allocator->free_ranges_count++;
+}
+
+void remove_range_(DivisionFreeListAllocator* allocator, size_t index)
+{
+    DivisionFreeListRange* ranges = allocator->free_ranges;
+    memmove(
+        ranges + index,
+        ranges + index + 1,
+        sizeof(DivisionFreeListRange[allocator->free_ranges_count - index - 1])
+    );
+    allocator->free_ranges_count--;
+}
@@ -0,0 +1,274 @@
+#include "division_engine_core/mesh_file.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static inline uint64_t align_offset_(uint64_t offset);
+static bool write_blob_(
+    FILE* file, uint64_t* position, const DivisionMeshFileBlob* blob, const void* data
+);
+static bool map_file_(const char* path, void** out_mapping, size_t* out_size);
+static void unmap_file_(void* mapping, size_t size);
+static bool validate_blob_(const DivisionMeshFileBlob* blob, size_t file_size);
+
+bool division_mesh_file_write(const char* path, const DivisionMeshFileData* data)
+{
+    const DivisionVertexBufferConstSettings* settings = &data->settings;
+    if (settings->per_vertex_attribute_count < 0 ||
+        settings->per_instance_attribute_count < 0 ||
+        (data->vertex_data_size > 0 && data->vertex_data == NULL) ||
+        (data->index_data_size > 0 && data->index_data == NULL) ||
+        (data->instance_data_size > 0 && data->instance_data == NULL))
+    {
+        fprintf(stderr, "Invalid mesh data for the file `%s`\n", path);
+        return false;
+    }
+
+    int32_t attribute_count =
+        settings->per_vertex_attribute_count + settings->per_instance_attribute_count;
+    uint64_t attributes_end = sizeof(DivisionMeshFileHeader) +
+                              sizeof(DivisionMeshFileAttribute) * attribute_count;
+
+    DivisionMeshFileHeader header = {
+        .magic = DIVISION_MESH_FILE_MAGIC,
+        .version = DIVISION_MESH_FILE_VERSION,
+        .vertex_count = settings->size.vertex_count,
+        .index_count = settings->size.index_count,
+        .instance_count = settings->size.instance_count,
+        .topology = settings->topology,
+        .capabilities_mask = settings->capabilities_mask,
+        .per_vertex_attribute_count = settings->per_vertex_attribute_count,
+        .per_instance_attribute_count = settings->per_instance_attribute_count,
+    };
+    header.vertices.offset = align_offset_(attributes_end);
+    header.vertices.size = data->vertex_data_size;
+    header.indices.offset = align_offset_(header.vertices.offset + header.vertices.size);
+    header.indices.size = data->index_data_size;
+    header.instances.offset = align_offset_(header.indices.offset + header.indices.size);
+    header.instances.size = data->instance_data_size;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to open the file `%s`\n", path);
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int32_t i = 0; ok && i < attribute_count; i++)
+    {
+        const DivisionVertexAttributeSettings* attr =
+            i < settings->per_vertex_attribute_count
+                ? &settings->per_vertex_attributes[i]
+                : &settings->per_instance_attributes
+                       [i - settings->per_vertex_attribute_count];
+
+        DivisionMeshFileAttribute file_attr = {
+            .type = attr->type,
+            .location = attr->location,
+        };
+        ok = fwrite(&file_attr, sizeof(file_attr), 1, file) == 1;
+    }
+
+    uint64_t position = attributes_end;
+    ok = ok && write_blob_(file, &position, &header.vertices, data->vertex_data) &&
+         write_blob_(file, &position, &header.indices, data->index_data) &&
+         write_blob_(file, &position, &header.instances, data->instance_data);
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        fprintf(stderr, "Failed to write the file `%s`\n", path);
+    }
+
+    return ok;
+}
+
+bool division_mesh_file_map(const char* path, DivisionMeshFile* out_file)
+{
+    void* mapping;
+    size_t size;
+    if (!map_file_(path, &mapping, &size))
+    {
+        fprintf(stderr, "Failed to map the file `%s`\n", path);
+        return false;
+    }
+
+    const DivisionMeshFileHeader* header = mapping;
+    bool valid = size >= sizeof(DivisionMeshFileHeader) &&
+                 header->magic == DIVISION_MESH_FILE_MAGIC &&
+                 header->version == DIVISION_MESH_FILE_VERSION &&
+                 header->per_vertex_attribute_count >= 0 &&
+                 header->per_instance_attribute_count >= 0;
+
+    if (valid)
+    {
+        uint64_t attribute_count = (uint64_t) header->per_vertex_attribute_count +
+                                   (uint64_t) header->per_instance_attribute_count;
+        valid = sizeof(DivisionMeshFileHeader) +
+                        attribute_count * sizeof(DivisionMeshFileAttribute) <=
+                    size &&
+                validate_blob_(&header->vertices, size) &&
+                validate_blob_(&header->indices, size) &&
+                validate_blob_(&header->instances, size);
+    }
+
+    if (!valid)
+    {
+        fprintf(stderr, "The file `%s` is not a valid mesh file\n", path);
+        unmap_file_(mapping, size);
+        return false;
+    }
+
+    const uint8_t* bytes = mapping;
+    const DivisionMeshFileAttribute* attributes =
+        (const DivisionMeshFileAttribute*) (bytes + sizeof(DivisionMeshFileHeader));
+
+    *out_file = (DivisionMeshFile){
+        .header = header,
+        .per_vertex_attributes = attributes,
+        .per_instance_attributes = attributes + header->per_vertex_attribute_count,
+        .vertex_data = bytes + header->vertices.offset,
+        .index_data = bytes + header->indices.offset,
+        .instance_data = bytes + header->instances.offset,
+        .mapping = mapping,
+        .mapping_size = size,
+    };
+
+    return true;
+}
+
+void division_mesh_file_unmap(DivisionMeshFile* file)
+{
+    if (file->mapping)
+    {
+        unmap_file_(file->mapping, file->mapping_size);
+    }
+
+    *file = (DivisionMeshFile){0};
+}
+
+uint64_t align_offset_(uint64_t offset)
+{
+    return (offset + DIVISION_MESH_FILE_BLOB_ALIGNMENT - 1) &
+           ~((uint64_t) DIVISION_MESH_FILE_BLOB_ALIGNMENT - 1);
+}
+
+bool write_blob_(
+    FILE* file, uint64_t* position, const DivisionMeshFileBlob* blob, const void* data
+)
+{
+    static const uint8_t padding[DIVISION_MESH_FILE_BLOB_ALIGNMENT] = {0};
+
+    size_t padding_size = (size_t) (blob->offset - *position);
+    if (padding_size > 0 && fwrite(padding, 1, padding_size, file) != padding_size)
+    {
+        return false;
+    }
+
+    if (blob->size > 0 && fwrite(data, 1, blob->size, file) != blob->size)
+    {
+        return false;
+    }
+
+    *position = blob->offset + blob->size;
+    return true;
+}
+
+bool validate_blob_(const DivisionMeshFileBlob* blob, size_t file_size)
+{
+    return blob->offset % DIVISION_MESH_FILE_BLOB_ALIGNMENT == 0 &&
+           blob->offset <= file_size && blob->size <= file_size - blob->offset;
+}
+
+#ifdef _WIN32
+bool map_file_(const char* path, void** out_mapping, size_t* out_size)
+{
+    HANDLE file = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (file_mapping == NULL)
+    {
+        return false;
+    }
+
+    // The view keeps the mapping object alive after its handle is closed
+    void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(file_mapping);
+    if (view == NULL)
+    {
+        return false;
+    }
+
+    *out_mapping = view;
+    *out_size = (size_t) file_size.QuadPart;
+    return true;
+}
+
+void unmap_file_(void* mapping, size_t size)
+{
+    UnmapViewOfFile(mapping);
+}
+#else
+bool map_file_(const char* path, void** out_mapping, size_t* out_size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t) file_stat.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    *out_mapping = mapping;
+    *out_size = size;
+    return true;
+}
+
+void unmap_file_(void* mapping, size_t size)
+{
+    munmap(mapping, size);
+}
+#endif
@@ -0,0 +1,638 @@
+#include "division_engine_core/mesh_optimizer.h"
+
+#include <math.h>
+#include <memory.h>
+#include <stdlib.h>
+
+#define NO_VERTEX UINT32_MAX
+
+typedef struct TipsifyState_
+{
+    const uint32_t* indices;
+    uint32_t* live_triangles;
+    uint32_t* timestamps;
+    uint32_t* dead_end_stack;
+    size_t dead_end_count;
+    uint32_t* candidates;
+    size_t candidate_count;
+    size_t vertex_count;
+    size_t cursor;
+    uint32_t time;
+    uint32_t cache_size;
+} TipsifyState_;
+
+typedef struct ClusterSortKey_
+{
+    float key;
+    uint32_t cluster;
+} ClusterSortKey_;
+
+static inline bool is_in_cache_(
+    const uint32_t* timestamps, uint32_t vertex, uint32_t time, uint32_t cache_size
+);
+static inline uint32_t touch_vertex_(
+    uint32_t* timestamps, uint32_t vertex, uint32_t* time, uint32_t cache_size
+);
+static inline bool are_indices_valid_(
+    const uint32_t* indices, size_t index_count, size_t vertex_count
+);
+static uint32_t tipsify_next_vertex_(TipsifyState_* state);
+static size_t split_clusters_(
+    const uint32_t* indices,
+    size_t triangle_count,
+    size_t vertex_count,
+    uint32_t cache_size,
+    float threshold,
+    uint32_t* out_cluster_starts
+);
+static inline const float* get_position_(
+    const float* positions, size_t position_stride, uint32_t vertex
+);
+static int compare_cluster_keys_(const void* a, const void* b);
+
+DivisionMeshCacheStats division_mesh_analyze_vertex_cache(
+    const uint32_t* indices, size_t index_count, size_t vertex_count, uint32_t cache_size
+)
+{
+    DivisionMeshCacheStats stats = {.acmr = 0, .atvr = 0, .transformed_vertex_count = 0};
+    size_t triangle_count = index_count / 3;
+
+    uint32_t* timestamps = calloc(vertex_count, sizeof(uint32_t));
+    if (triangle_count == 0 || timestamps == NULL)
+    {
+        free(timestamps);
+        return stats;
+    }
+
+    uint32_t time = cache_size + 1;
+    uint32_t misses = 0;
+    for (size_t i = 0; i < triangle_count * 3; i++)
+    {
+        misses += touch_vertex_(timestamps, indices[i], &time, cache_size);
+    }
+
+    size_t used_vertex_count = 0;
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        used_vertex_count += timestamps[v] != 0;
+    }
+
+    free(timestamps);
+
+    stats.transformed_vertex_count = misses;
+    stats.acmr = (float) misses / (float) triangle_count;
+    stats.atvr = used_vertex_count > 0 ? (float) misses / (float) used_vertex_count : 0;
+
+    return stats;
+}
+
+bool division_mesh_optimize_vertex_cache(
+    uint32_t* dst_indices,
+    const uint32_t* indices,
+    size_t index_count,
+    size_t vertex_count,
+    uint32_t cache_size
+)
+{
+    if (!are_indices_valid_(indices, index_count, vertex_count))
+    {
+        return false;
+    }
+    size_t triangle_count = index_count / 3;
+
+    TipsifyState_ state = {
+        .indices = indices,
+        .live_triangles = calloc(vertex_count, sizeof(uint32_t)),
+        .timestamps = calloc(vertex_count, sizeof(uint32_t)),
+        .dead_end_stack = malloc(sizeof(uint32_t[triangle_count * 3 + 1])),
+        .dead_end_count = 0,
+        .candidates = malloc(sizeof(uint32_t[triangle_count * 3 + 1])),
+        .candidate_count = 0,
+        .vertex_count = vertex_count,
+        .cursor = 0,
+        .time = cache_size + 1,
+        .cache_size = cache_size,
+    };
+    uint32_t* adjacency_offsets = calloc(vertex_count + 1, sizeof(uint32_t));
+    uint32_t* adjacency = malloc(sizeof(uint32_t[triangle_count * 3 + 1]));
+    uint32_t* output = malloc(sizeof(uint32_t[triangle_count * 3 + 1]));
+    bool* emitted = calloc(triangle_count + 1, sizeof(bool));
+
+    bool allocated = state.live_triangles != NULL && state.timestamps != NULL &&
+                     state.dead_end_stack != NULL && state.candidates != NULL &&
+                     adjacency_offsets != NULL && adjacency != NULL && output != NULL &&
+                     emitted != NULL;
+
+    if (allocated)
+    {
+        for (size_t i = 0; i < triangle_count * 3; i++)
+        {
+            state.live_triangles[indices[i]]++;
+        }
+
+        for (size_t v = 0; v < vertex_count; v++)
+        {
+            adjacency_offsets[v + 1] = adjacency_offsets[v] + state.live_triangles[v];
+        }
+
+        // Uses the output as the fill cursors of the adjacency lists
+        memcpy(output, adjacency_offsets, sizeof(uint32_t[vertex_count]));
+        for (size_t i = 0; i < triangle_count * 3; i++)
+        {
+            adjacency[output[indices[i]]++] = (uint32_t) (i / 3);
+        }
+
+        size_t output_count = 0;
+        uint32_t current = tipsify_next_vertex_(&state);
+
+        while (current != NO_VERTEX)
+        {
+            state.candidate_count = 0;
+
+            uint32_t adjacency_end = adjacency_offsets[current + 1];
+            for (uint32_t a = adjacency_offsets[current]; a < adjacency_end; a++)
+            {
+                uint32_t triangle = adjacency[a];
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+
+                for (int corner = 0; corner < 3; corner++)
+                {
+                    uint32_t v = indices[triangle * 3 + corner];
+                    output[output_count++] = v;
+                    state.dead_end_stack[state.dead_end_count++] = v;
+                    state.candidates[state.candidate_count++] = v;
+                    state.live_triangles[v]--;
+                    touch_vertex_(state.timestamps, v, &state.time, cache_size);
+                }
+
+                emitted[triangle] = true;
+            }
+
+            current = tipsify_next_vertex_(&state);
+        }
+
+        memcpy(dst_indices, output, sizeof(uint32_t[output_count]));
+    }
+
+    free(state.live_triangles);
+    free(state.timestamps);
+    free(state.dead_end_stack);
+    free(state.candidates);
+    free(adjacency_offsets);
+    free(adjacency);
+    free(output);
+    free(emitted);
+
+    return allocated;
+}
+
+bool division_mesh_optimize_overdraw(
+    uint32_t* dst_indices,
+    const uint32_t* indices,
+    size_t index_count,
+    const float* positions,
+    size_t position_stride,
+    size_t vertex_count,
+    uint32_t cache_size,
+    float threshold
+)
+{
+    if (!are_indices_valid_(indices, index_count, vertex_count))
+    {
+        return false;
+    }
+    size_t triangle_count = index_count / 3;
+
+    uint32_t* cluster_starts = malloc(sizeof(uint32_t[triangle_count + 1]));
+    ClusterSortKey_* keys = malloc(sizeof(ClusterSortKey_[triangle_count + 1]));
+    float* cluster_data = malloc(sizeof(float[(triangle_count + 1) * 6]));
+    uint32_t* output = malloc(sizeof(uint32_t[triangle_count * 3 + 1]));
+
+    bool allocated =
+        cluster_starts != NULL && keys != NULL && cluster_data != NULL && output != NULL;
+
+    if (allocated)
+    {
+        size_t cluster_count = split_clusters_(
+            indices, triangle_count, vertex_count, cache_size, threshold, cluster_starts
+        );
+        cluster_starts[cluster_count] = (uint32_t) triangle_count;
+
+        // Area weighted centroid and normal of every cluster and of the whole mesh
+        float mesh_centroid[3] = {0, 0, 0};
+        float mesh_area = 0;
+
+        for (size_t c = 0; c < cluster_count; c++)
+        {
+            float* centroid = &cluster_data[c * 6];
+            float* normal = &cluster_data[c * 6 + 3];
+            float area_sum = 0;
+            memset(centroid, 0, sizeof(float[6]));
+
+            for (uint32_t t = cluster_starts[c]; t < cluster_starts[c + 1]; t++)
+            {
+                const uint32_t* triangle = &indices[t * 3];
+                const float* p0 = get_position_(positions, position_stride, triangle[0]);
+                const float* p1 = get_position_(positions, position_stride, triangle[1]);
+                const float* p2 = get_position_(positions, position_stride, triangle[2]);
+
+                float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                float n[3] = {
+                    e1[1] * e2[2] - e1[2] * e2[1],
+                    e1[2] * e2[0] - e1[0] * e2[2],
+                    e1[0] * e2[1] - e1[1] * e2[0],
+                };
+                float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                for (int k = 0; k < 3; k++)
+                {
+                    centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * area;
+                    normal[k] += n[k];
+                }
+                area_sum += area;
+            }
+
+            for (int k = 0; k < 3; k++)
+            {
+                mesh_centroid[k] += centroid[k];
+                centroid[k] = area_sum > 0 ? centroid[k] / area_sum : 0;
+            }
+            mesh_area += area_sum;
+        }
+
+        for (int k = 0; k < 3; k++)
+        {
+            mesh_centroid[k] = mesh_area > 0 ? mesh_centroid[k] / mesh_area : 0;
+        }
+
+        for (size_t c = 0; c < cluster_count; c++)
+        {
+            const float* centroid = &cluster_data[c * 6];
+            const float* normal = &cluster_data[c * 6 + 3];
+            float normal_length = sqrtf(
+                normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]
+            );
+            float dot = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                dot += (centroid[k] - mesh_centroid[k]) * normal[k];
+            }
+
+            keys[c] = (ClusterSortKey_){
+                .key = normal_length > 0 ? dot / normal_length : 0,
+                .cluster = (uint32_t) c,
+            };
+        }
+
+        qsort(keys, cluster_count, sizeof(ClusterSortKey_), compare_cluster_keys_);
+
+        size_t output_count = 0;
+        for (size_t i = 0; i < cluster_count; i++)
+        {
+            uint32_t c = keys[i].cluster;
+            size_t first_index = cluster_starts[c] * 3;
+            size_t cluster_index_count = (cluster_starts[c + 1] - cluster_starts[c]) * 3;
+
+            memcpy(
+                output + output_count,
+                indices + first_index,
+                sizeof(uint32_t[cluster_index_count])
+            );
+            output_count += cluster_index_count;
+        }
+
+        memcpy(dst_indices, output, sizeof(uint32_t[output_count]));
+    }
+
+    free(cluster_starts);
+    free(keys);
+    free(cluster_data);
+    free(output);
+
+    return allocated;
+}
+
+size_t division_mesh_optimize_vertex_fetch_remap(
+    uint32_t* dst_remap, const uint32_t* indices, size_t index_count, size_t vertex_count
+)
+{
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        dst_remap[v] = DIVISION_MESH_UNUSED_VERTEX;
+    }
+
+    uint32_t next_vertex = 0;
+    for (size_t i = 0; i < index_count; i++)
+    {
+        uint32_t v = indices[i];
+        if (dst_remap[v] == DIVISION_MESH_UNUSED_VERTEX)
+        {
+            dst_remap[v] = next_vertex++;
+        }
+    }
+
+    return next_vertex;
+}
+
+void division_mesh_remap_indices(
+    uint32_t* dst_indices,
+    const uint32_t* indices,
+    size_t index_count,
+    const uint32_t* remap
+)
+{
+    for (size_t i = 0; i < index_count; i++)
+    {
+        dst_indices[i] = remap[indices[i]];
+    }
+}
+
+void division_mesh_remap_vertices(
+    void* dst_vertices,
+    const void* vertices,
+    size_t vertex_count,
+    size_t vertex_size,
+    const uint32_t* remap
+)
+{
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+        if (remap[v] == DIVISION_MESH_UNUSED_VERTEX)
+        {
+            continue;
+        }
+
+        memcpy(
+            (uint8_t*) dst_vertices + remap[v] * vertex_size,
+            (const uint8_t*) vertices + v * vertex_size,
+            vertex_size
+        );
+    }
+}
+
+bool division_mesh_optimize(
+    uint32_t* indices,
+    size_t index_count,
+    void* vertices,
+    size_t vertex_count,
+    size_t vertex_size,
+    size_t position_offset,
+    DivisionMeshOptimizeReport* out_report
+)
+{
+    const uint32_t cache_size = DIVISION_MESH_DEFAULT_CACHE_SIZE;
+    const float* positions = (const float*) ((const uint8_t*) vertices + position_offset);
+
+    out_report->before = division_mesh_analyze_vertex_cache(
+        indices, index_count, vertex_count, cache_size
+    );
+
+    if (!division_mesh_optimize_vertex_cache(
+            indices, indices, index_count, vertex_count, cache_size
+        ) ||
+        !division_mesh_optimize_overdraw(
+            indices,
+            indices,
+            index_count,
+            positions,
+            vertex_size,
+            vertex_count,
+            cache_size,
+            DIVISION_MESH_DEFAULT_OVERDRAW_THRESHOLD
+        ))
+    {
+        return false;
+    }
+
+    uint32_t* remap = malloc(sizeof(uint32_t[vertex_count + 1]));
+    void* remapped_vertices = malloc(vertex_count * vertex_size + 1);
+    if (remap == NULL || remapped_vertices == NULL)
+    {
+        free(remap);
+        free(remapped_vertices);
+        return false;
+    }
+
+    size_t used_vertex_count = division_mesh_optimize_vertex_fetch_remap(
+        remap, indices, index_count, vertex_count
+    );
+    division_mesh_remap_indices(indices, indices, index_count, remap);
+    division_mesh_remap_vertices(
+        remapped_vertices, vertices, vertex_count, vertex_size, remap
+    );
+    memcpy(vertices, remapped_vertices, used_vertex_count * vertex_size);
+
+    free(remap);
+    free(remapped_vertices);
+
+    out_report->after = division_mesh_analyze_vertex_cache(
+        indices, index_count, used_vertex_count, cache_size
+    );
+    out_report->vertex_count = used_vertex_count;
+
+    return true;
+}
+
+bool is_in_cache_(
+    const uint32_t* timestamps, uint32_t vertex, uint32_t time, uint32_t cache_size
+)
+{
+    return time - timestamps[vertex] <= cache_size;
+}
+
+uint32_t touch_vertex_(
+    uint32_t* timestamps, uint32_t vertex, uint32_t* time, uint32_t cache_size
+)
+{
+    if (is_in_cache_(timestamps, vertex, *time, cache_size))
+    {
+        return 0;
+    }
+
+    timestamps[vertex] = (*time)++;
+    return 1;
+}
+
+// Trailing indices of an incomplete triangle are rejected, not dropped
+bool are_indices_valid_(const uint32_t* indices, size_t index_count, size_t vertex_count)
+{
+    if (index_count % 3 != 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < index_count; i++)
+    {
+        if (indices[i] >= vertex_count)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t tipsify_next_vertex_(TipsifyState_* state)
+{
+    uint32_t best_vertex = NO_VERTEX;
+    int64_t best_priority = -1;
+
+    // Prefer the fanning candidates, which stay in the cache after their fan is emitted
+    for (size_t i = 0; i < state->candidate_count; i++)
+    {
+        uint32_t v = state->candidates[i];
+        uint32_t live = state->live_triangles[v];
+        if (live == 0)
+        {
+            continue;
+        }
+
+        int64_t age = (int64_t) state->time - state->timestamps[v];
+        int64_t priority = age + 2 * (int64_t) live <= state->cache_size ? age : 0;
+
+        if (priority > best_priority)
+        {
+            best_priority = priority;
+            best_vertex = v;
+        }
+    }
+
+    if (best_vertex != NO_VERTEX)
+    {
+        return best_vertex;
+    }
+
+    while (state->dead_end_count > 0)
+    {
+        uint32_t v = state->dead_end_stack[--state->dead_end_count];
+        if (state->live_triangles[v] > 0)
+        {
+            return v;
+        }
+    }
+
+    for (; state->cursor < state->vertex_count; state->cursor++)
+    {
+        if (state->live_triangles[state->cursor] > 0)
+        {
+            return (uint32_t) state->cursor;
+        }
+    }
+
+    return NO_VERTEX;
+}
+
+size_t split_clusters_(
+    const uint32_t* indices,
+    size_t triangle_count,
+    size_t vertex_count,
+    uint32_t cache_size,
+    float threshold,
+    uint32_t* out_cluster_starts
+)
+{
+    uint32_t* timestamps = calloc(vertex_count + 1, sizeof(uint32_t));
+    uint32_t* hard_cluster_starts = malloc(sizeof(uint32_t[triangle_count + 1]));
+    uint32_t time = cache_size + 1;
+    size_t hard_cluster_count = 0;
+
+    if (timestamps == NULL || hard_cluster_starts == NULL)
+    {
+        free(timestamps);
+        free(hard_cluster_starts);
+        out_cluster_starts[0] = 0;
+        return triangle_count > 0;
+    }
+
+    // Hard boundaries are where the cache order restarts: no vertex of the triangle is
+    // in the cache
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        uint32_t misses = 0;
+        for (int corner = 0; corner < 3; corner++)
+        {
+            misses +=
+                touch_vertex_(timestamps, indices[t * 3 + corner], &time, cache_size);
+        }
+
+        if (t == 0 || misses == 3)
+        {
+            hard_cluster_starts[hard_cluster_count++] = (uint32_t) t;
+        }
+    }
+
+    // Soft boundaries split the hard clusters while their acmr stays close to the
+    // acmr of the whole hard cluster. Shifting the time by the cache size flushes the
+    // cache
+    size_t cluster_count = 0;
+    for (size_t h = 0; h < hard_cluster_count; h++)
+    {
+        uint32_t start = hard_cluster_starts[h];
+        uint32_t end = h + 1 < hard_cluster_count ? hard_cluster_starts[h + 1]
+                                                  : (uint32_t) triangle_count;
+
+        time += cache_size + 1;
+        uint32_t cluster_misses = 0;
+        for (uint32_t t = start; t < end; t++)
+        {
+            for (int corner = 0; corner < 3; corner++)
+            {
+                cluster_misses +=
+                    touch_vertex_(timestamps, indices[t * 3 + corner], &time, cache_size);
+            }
+        }
+
+        float target_acmr = (float) cluster_misses / (float) (end - start) * threshold;
+
+        time += cache_size + 1;
+        out_cluster_starts[cluster_count++] = start;
+        uint32_t misses = 0;
+        uint32_t triangles = 0;
+
+        for (uint32_t t = start; t < end; t++)
+        {
+            for (int corner = 0; corner < 3; corner++)
+            {
+                misses +=
+                    touch_vertex_(timestamps, indices[t * 3 + corner], &time, cache_size);
+            }
+            triangles++;
+
+            if (t + 1 < end && (float) misses / (float) triangles <= target_acmr)
+            {
+                out_cluster_starts[cluster_count++] = t + 1;
+                time += cache_size + 1;
+                misses = 0;
+                triangles = 0;
+            }
+        }
+    }
+
+    free(timestamps);
+    free(hard_cluster_starts);
+    return cluster_count;
+}
+
+const float* get_position_(
+    const float* positions, size_t position_stride, uint32_t vertex
+)
+{
+    return (const float*) ((const uint8_t*) positions + vertex * position_stride);
+}
+
+int compare_cluster_keys_(const void* a, const void* b)
+{
+    const ClusterSortKey_* key_a = a;
+    const ClusterSortKey_* key_b = b;
+
+    if (key_a->key != key_b->key)
+    {
+        return key_a->key > key_b->key ? -1 : 1;
+    }
+
+    return key_a->cluster < key_b->cluster ? -1 : (key_a->cluster > key_b->cluster);
+}
@@ -0,0 +1,271 @@
+#include "division_engine_core/profiler.h"
+#include "division_engine_core/platform_internal/platform_profiler.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+static inline double get_cpu_time_ms_(void);
+static inline uint32_t get_query_index_(uint64_t frame, uint32_t scope_index);
+static inline bool resolve_frame_(DivisionContext* ctx, bool wait);
+static inline void drop_recorded_frames_(DivisionProfilerSystemContext* profiler_ctx);
+
+bool division_engine_profiler_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->profiler_context = calloc(1, sizeof(DivisionProfilerSystemContext));
+    if (ctx->profiler_context == NULL)
+    {
+        return false;
+    }
+
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    profiler_ctx->labels[DIVISION_PROFILER_LABEL_DRAW_CALLBACK] = "draw_callback";
+    profiler_ctx->labels[DIVISION_PROFILER_LABEL_SUBMIT] = "submit";
+    profiler_ctx->label_count = 2;
+
+    return division_engine_internal_platform_profiler_context_alloc(ctx, settings);
+}
+
+void division_engine_profiler_system_context_free(DivisionContext* ctx)
+{
+    division_engine_internal_platform_profiler_context_free(ctx);
+    free(ctx->profiler_context);
+}
+
+void division_engine_profiler_set_enabled(DivisionContext* ctx, bool enabled)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    if (profiler_ctx->enabled != enabled)
+    {
+        profiler_ctx->enabled = enabled;
+        drop_recorded_frames_(profiler_ctx);
+    }
+}
+
+bool division_engine_profiler_register_label(
+    DivisionContext* ctx, const char* name, uint32_t* out_label_id
+)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    if (profiler_ctx->label_count == DIVISION_PROFILER_MAX_LABELS)
+    {
+        return false;
+    }
+
+    *out_label_id = profiler_ctx->label_count;
+    profiler_ctx->labels[profiler_ctx->label_count++] = name;
+
+    return true;
+}
+
+void division_engine_profiler_begin(DivisionContext* ctx, uint32_t label_id)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    if (!profiler_ctx->enabled)
+    {
+        return;
+    }
+
+    if (profiler_ctx->open_scope_count == DIVISION_PROFILER_MAX_DEPTH)
+    {
+        profiler_ctx->overflow_scope_count++;
+        return;
+    }
+
+    uint64_t frame_index = profiler_ctx->recorded_frame_count;
+    DivisionProfilerFrame* frame =
+        &profiler_ctx->frames[frame_index % DIVISION_PROFILER_QUERY_FRAMES];
+
+    // Scopes above the limit still keep the pairs of begin and end
+    uint32_t scope_index = DIVISION_PROFILER_NO_SCOPE;
+    if (frame->scope_count < DIVISION_PROFILER_MAX_SCOPES &&
+        label_id < profiler_ctx->label_count)
+    {
+        scope_index = frame->scope_count++;
+        frame->scopes[scope_index] = (DivisionProfilerScope){
+            .label_id = label_id,
+            .cpu_begin_ms = get_cpu_time_ms_(),
+            .cpu_end_ms = 0,
+        };
+
+        if (profiler_ctx->has_gpu_timers)
+        {
+            division_engine_internal_platform_profiler_timestamp(
+                ctx, get_query_index_(frame_index, scope_index)
+            );
+        }
+    }
+
+    profiler_ctx->open_scopes[profiler_ctx->open_scope_count++] = scope_index;
+}
+
+void division_engine_profiler_end(DivisionContext* ctx)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    if (!profiler_ctx->enabled || profiler_ctx->open_scope_count == 0)
+    {
+        return;
+    }
+
+    // Ends of the scopes above the depth limit don't close the enclosing ones
+    if (profiler_ctx->overflow_scope_count > 0)
+    {
+        profiler_ctx->overflow_scope_count--;
+        return;
+    }
+
+    uint32_t scope_index = profiler_ctx->open_scopes[--profiler_ctx->open_scope_count];
+    if (scope_index == DIVISION_PROFILER_NO_SCOPE)
+    {
+        return;
+    }
+
+    uint64_t frame_index = profiler_ctx->recorded_frame_count;
+    DivisionProfilerFrame* frame =
+        &profiler_ctx->frames[frame_index % DIVISION_PROFILER_QUERY_FRAMES];
+
+    if (profiler_ctx->has_gpu_timers)
+    {
+        division_engine_internal_platform_profiler_timestamp(
+            ctx, get_query_index_(frame_index, scope_index) + 1
+        );
+    }
+    frame->scopes[scope_index].cpu_end_ms = get_cpu_time_ms_();
+}
+
+void division_engine_profiler_end_frame(DivisionContext* ctx)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    if (!profiler_ctx->enabled)
+    {
+        return;
+    }
+
+    // Scopes left open are closed with their frame, so every timestamp is recorded
+    while (profiler_ctx->open_scope_count > 0)
+    {
+        division_engine_profiler_end(ctx);
+    }
+    profiler_ctx->recorded_frame_count++;
+
+    while (profiler_ctx->resolved_frame_count < profiler_ctx->recorded_frame_count &&
+           resolve_frame_(ctx, false))
+    {
+    }
+
+    // The slot of the next frame must be free, so the oldest frame is awaited
+    if (profiler_ctx->recorded_frame_count - profiler_ctx->resolved_frame_count ==
+        DIVISION_PROFILER_QUERY_FRAMES)
+    {
+        resolve_frame_(ctx, true);
+    }
+
+    uint64_t next_frame = profiler_ctx->recorded_frame_count;
+    profiler_ctx->frames[next_frame % DIVISION_PROFILER_QUERY_FRAMES].scope_count = 0;
+}
+
+uint32_t division_engine_profiler_get_timings(
+    DivisionContext* ctx,
+    uint32_t label_id,
+    DivisionProfilerTiming* out_timings,
+    uint32_t max_timing_count
+)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    uint64_t resolved_count = profiler_ctx->resolved_frame_count;
+    if (label_id >= profiler_ctx->label_count)
+    {
+        return 0;
+    }
+
+    uint64_t timing_count = resolved_count;
+    if (timing_count > DIVISION_PROFILER_HISTORY_FRAMES)
+    {
+        timing_count = DIVISION_PROFILER_HISTORY_FRAMES;
+    }
+    if (timing_count > max_timing_count)
+    {
+        timing_count = max_timing_count;
+    }
+
+    for (uint64_t i = 0; i < timing_count; i++)
+    {
+        uint64_t frame_index = resolved_count - timing_count + i;
+        uint64_t history_slot = frame_index % DIVISION_PROFILER_HISTORY_FRAMES;
+        out_timings[i] = profiler_ctx->history[history_slot][label_id];
+    }
+
+    return (uint32_t) timing_count;
+}
+
+double get_cpu_time_ms_(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+
+    return (double) time.tv_sec * 1000.0 + (double) time.tv_nsec / 1000000.0;
+}
+
+// Every scope has a pair of timestamps, every frame slot has the queries of all scopes
+uint32_t get_query_index_(uint64_t frame, uint32_t scope_index)
+{
+    uint32_t frame_slot = (uint32_t) (frame % DIVISION_PROFILER_QUERY_FRAMES);
+    return (frame_slot * DIVISION_PROFILER_MAX_SCOPES + scope_index) * 2;
+}
+
+bool resolve_frame_(DivisionContext* ctx, bool wait)
+{
+    DivisionProfilerSystemContext* profiler_ctx = ctx->profiler_context;
+    uint64_t frame_index = profiler_ctx->resolved_frame_count;
+    const DivisionProfilerFrame* frame =
+        &profiler_ctx->frames[frame_index % DIVISION_PROFILER_QUERY_FRAMES];
+
+    uint64_t timestamps[DIVISION_PROFILER_MAX_SCOPES * 2];
+    bool has_gpu_time = profiler_ctx->has_gpu_timers && frame->scope_count > 0;
+    if (has_gpu_time && !division_engine_internal_platform_profiler_read_timestamps(
+                            ctx,
+                            get_query_index_(frame_index, 0),
+                            frame->scope_count * 2,
+                            wait,
+                            timestamps
+                        ))
+    {
+        return false;
+    }
+
+    DivisionProfilerTiming* timings =
+        profiler_ctx->history[frame_index % DIVISION_PROFILER_HISTORY_FRAMES];
+    for (uint32_t i = 0; i < profiler_ctx->label_count; i++)
+    {
+        timings[i] = (DivisionProfilerTiming){
+            .frame_index = frame_index,
+            .cpu_ms = 0,
+            .gpu_ms = 0,
+        };
+    }
+
+    for (uint32_t i = 0; i < frame->scope_count; i++)
+    {
+        const DivisionProfilerScope* scope = &frame->scopes[i];
+        DivisionProfilerTiming* timing = &timings[scope->label_id];
+
+        timing->cpu_ms += scope->cpu_end_ms - scope->cpu_begin_ms;
+        if (has_gpu_time)
+        {
+            timing->gpu_ms += (double) (timestamps[i * 2 + 1] - timestamps[i * 2]) / 1e6;
+        }
+    }
+
+    profiler_ctx->resolved_frame_count++;
+    return true;
+}
+
+void drop_recorded_frames_(DivisionProfilerSystemContext* profiler_ctx)
+{
+    profiler_ctx->resolved_frame_count = profiler_ctx->recorded_frame_count;
+    profiler_ctx->open_scope_count = 0;
+    profiler_ctx->overflow_scope_count = 0;
+    uint64_t frame_index = profiler_ctx->recorded_frame_count;
+    profiler_ctx->frames[frame_index % DIVISION_PROFILER_QUERY_FRAMES].scope_count = 0;
+}
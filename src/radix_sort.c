@@ -0,0 +1,81 @@
+#include "division_engine_core/radix_sort.h"
+
+#include <memory.h>
+
+#define KEY_BYTE_COUNT_ ((int) sizeof(uint64_t))
+
+static inline uint32_t key_digit_(uint64_t key, int pass);
+
+void division_radix_sort_u64(
+    uint64_t* keys,
+    uint32_t* values,
+    uint64_t* tmp_keys,
+    uint32_t* tmp_values,
+    size_t count
+)
+{
+    if (count < 2)
+    {
+        return;
+    }
+
+    // Histograms of all passes are built with a single read of the keys
+    size_t histograms[KEY_BYTE_COUNT_][DIVISION_RADIX_SORT_BUCKET_COUNT];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (int pass = 0; pass < KEY_BYTE_COUNT_; pass++)
+        {
+            histograms[pass][key_digit_(keys[i], pass)]++;
+        }
+    }
+
+    uint64_t* src_keys = keys;
+    uint32_t* src_values = values;
+    uint64_t* dst_keys = tmp_keys;
+    uint32_t* dst_values = tmp_values;
+
+    for (int pass = 0; pass < KEY_BYTE_COUNT_; pass++)
+    {
+        size_t* histogram = histograms[pass];
+        if (histogram[key_digit_(src_keys[0], pass)] == count)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < DIVISION_RADIX_SORT_BUCKET_COUNT; bucket++)
+        {
+            size_t bucket_size = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucket_size;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t dst_index = histogram[key_digit_(src_keys[i], pass)]++;
+            dst_keys[dst_index] = src_keys[i];
+            dst_values[dst_index] = src_values[i];
+        }
+
+        uint64_t* swap_keys = src_keys;
+        uint32_t* swap_values = src_values;
+        src_keys = dst_keys;
+        src_values = dst_values;
+        dst_keys = swap_keys;
+        dst_values = swap_values;
+    }
+
+    if (src_keys != keys)
+    {
+        memcpy(keys, src_keys, sizeof(uint64_t[count]));
+        memcpy(values, src_values, sizeof(uint32_t[count]));
+    }
+}
+
+uint32_t key_digit_(uint64_t key, int pass)
+{
+    return (uint32_t) (key >> (pass * DIVISION_RADIX_SORT_BITS)) &
+           (DIVISION_RADIX_SORT_BUCKET_COUNT - 1);
+}
@@ -1,4 +1,5 @@
 #include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/capture.h"
 
 #include <memory.h>
 #include <stdint.h>
@@ -7,20 +8,74 @@
 #include "division_engine_core/context.h"
 #include "division_engine_core/data_structures/unordered_id_table.h"
 #include "division_engine_core/platform_internal/platform_render_pass_descriptor.h"
+#include "division_engine_core/renderer.h"
+#include "division_engine_core/utility.h"
+
+#define FNV_OFFSET_BASIS_ 2166136261u
+#define FNV_PRIME_ 16777619u
+
+#define SHARED_BUCKET_EMPTY_ 0u
+#define SHARED_BUCKET_DELETED_ UINT32_MAX
+#define SHARED_BUCKET_MIN_CAPACITY_ 16
 
 static inline void handle_render_pass_alloc_error(
     DivisionContext* ctx,
     uint32_t render_pass_id,
     DivisionRenderPassDescriptor* render_pass_copy
 );
+static inline uint32_t hash_render_pass_(const DivisionRenderPassDescriptor* render_pass);
+static inline uint32_t hash_u32_(uint32_t hash, uint32_t value);
+static inline bool is_same_state_(
+    const DivisionRenderPassDescriptor* left, const DivisionRenderPassDescriptor* right
+);
+static inline bool try_find_shared_(
+    const DivisionRenderPassSystemContext* pass_ctx,
+    const DivisionRenderPassDescriptor* render_pass,
+    uint32_t hash,
+    uint32_t* out_render_pass_id
+);
+static inline bool insert_shared_(
+    DivisionRenderPassSystemContext* pass_ctx, uint32_t render_pass_id
+);
+static inline void remove_shared_(
+    DivisionRenderPassSystemContext* pass_ctx, uint32_t render_pass_id
+);
+static inline bool grow_shared_buckets_(DivisionRenderPassSystemContext* pass_ctx);
 
 bool division_engine_render_pass_system_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
 {
     ctx->render_pass_context = malloc(sizeof(DivisionRenderPassSystemContext));
-    *ctx->render_pass_context =
-        (DivisionRenderPassSystemContext){.render_pass_descriptors = NULL, .render_pass_count = 0};
+    *ctx->render_pass_context = (DivisionRenderPassSystemContext){
+        .render_pass_descriptors = NULL,
+        .render_pass_hashes = NULL,
+        .render_pass_ref_counts = NULL,
+        .render_pass_count = 0,
+        .shared_buckets = NULL,
+        .shared_bucket_capacity = 0,
+        .shared_bucket_count = 0,
+        .borrowed_render_pass_id = 0,
+        .is_render_pass_borrowed = false,
+        .draw_impl = NULL,
+        .state_stats = {0},
+        .merge_stats = {0},
+        .frame_begun = false,
+        .partial_redraw = settings->partial_redraw,
+        .dirty_rect_count = 0,
+        .frame_dirty_rect_count = 0,
+        .redraw_width = 0,
+        .redraw_height = 0,
+        .redraw_stats = {0},
+        .sort_keys = NULL,
+        .sort_indices = NULL,
+        .sorted_instances = NULL,
+        .sort_capacity = 0,
+        .submit_instances = NULL,
+        .submit_capacity = 0,
+        .merged_instances = NULL,
+        .merge_capacity = 0,
+    };
 
     division_unordered_id_table_alloc(&ctx->render_pass_context->id_table, 10);
 
@@ -34,6 +89,14 @@ void division_engine_render_pass_system_context_free(DivisionContext* ctx)
     division_engine_internal_platform_render_pass_context_free(ctx);
     division_unordered_id_table_free(&ctx->render_pass_context->id_table);
     free(render_pass_ctx->render_pass_descriptors);
+    free(render_pass_ctx->render_pass_hashes);
+    free(render_pass_ctx->render_pass_ref_counts);
+    free(render_pass_ctx->shared_buckets);
+    free(render_pass_ctx->sort_keys);
+    free(render_pass_ctx->sort_indices);
+    free(render_pass_ctx->sorted_instances);
+    free(render_pass_ctx->submit_instances);
+    free(render_pass_ctx->merged_instances);
     free(render_pass_ctx);
 }
 
@@ -44,19 +107,53 @@ bool division_engine_render_pass_descriptor_alloc(
 )
 {
     DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
-    uint32_t render_pass_id = division_unordered_id_table_new_id(&pass_ctx->id_table);
+    if ((render_pass->capabilities_mask &
+         (DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST |
+          DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_WRITE)) != 0 &&
+        ctx->renderer_context->depth_stencil_format == DIVISION_DEPTH_STENCIL_FORMAT_NONE)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Depth capabilities require the depth attachment in the settings"
+        );
+        return false;
+    }
+
+    uint32_t hash = hash_render_pass_(render_pass);
+    uint32_t render_pass_id;
+    if (try_find_shared_(pass_ctx, render_pass, hash, &render_pass_id))
+    {
+        pass_ctx->render_pass_ref_counts[render_pass_id]++;
+        *out_render_pass_id = render_pass_id;
+
+        division_engine_capture_render_pass_descriptor(
+            ctx,
+            DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_ALLOC,
+            render_pass_id,
+            render_pass
+        );
+        return true;
+    }
+
+    render_pass_id = division_unordered_id_table_new_id(&pass_ctx->id_table);
 
     DivisionRenderPassDescriptor render_pass_copy = *render_pass;
 
-    int32_t render_pass_count = pass_ctx->render_pass_count;
-    int32_t new_render_pass_count = render_pass_count + 1;
+    int32_t new_render_pass_count = pass_ctx->render_pass_count + 1;
     if (render_pass_id >= pass_ctx->render_pass_count)
     {
         pass_ctx->render_pass_descriptors = realloc(
             pass_ctx->render_pass_descriptors,
             sizeof(DivisionRenderPassDescriptor) * new_render_pass_count
         );
+        pass_ctx->render_pass_hashes = realloc(
+            pass_ctx->render_pass_hashes, sizeof(uint32_t) * new_render_pass_count
+        );
+        pass_ctx->render_pass_ref_counts = realloc(
+            pass_ctx->render_pass_ref_counts, sizeof(uint32_t) * new_render_pass_count
+        );
         if (pass_ctx->render_pass_descriptors == NULL ||
+            pass_ctx->render_pass_hashes == NULL ||
+            pass_ctx->render_pass_ref_counts == NULL ||
             !division_engine_internal_platform_render_pass_realloc(
                 ctx, new_render_pass_count
             ))
@@ -69,11 +166,26 @@ bool division_engine_render_pass_descriptor_alloc(
     }
 
     *out_render_pass_id = render_pass_id;
-    pass_ctx->render_pass_descriptors[render_pass_count] = render_pass_copy;
+    pass_ctx->render_pass_descriptors[render_pass_id] = render_pass_copy;
+    pass_ctx->render_pass_hashes[render_pass_id] = hash;
+    pass_ctx->render_pass_ref_counts[render_pass_id] = 0;
+
+    if (!division_engine_internal_platform_render_pass_impl_init_element(
+            ctx, render_pass_id
+        ))
+    {
+        division_unordered_id_table_remove_id(&pass_ctx->id_table, render_pass_id);
+        return false;
+    }
+    pass_ctx->render_pass_ref_counts[render_pass_id] = 1;
 
-    return division_engine_internal_platform_render_pass_impl_init_element(
-        ctx, render_pass_id
+    // Sharing is an optimization, the descriptor is allocated without it
+    insert_shared_(pass_ctx, render_pass_id);
+
+    division_engine_capture_render_pass_descriptor(
+        ctx, DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_ALLOC, render_pass_id, render_pass
     );
+    return true;
 }
 
 void handle_render_pass_alloc_error(
@@ -94,23 +206,281 @@ DivisionRenderPassDescriptor* division_engine_render_pass_descriptor_borrow(
     DivisionContext* ctx, uint32_t render_pass_id
 )
 {
-    return DIVISION_GET_RENDER_PASS_DESCRIPTOR(ctx, render_pass_id);
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    if (pass_ctx->is_render_pass_borrowed)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Another render pass descriptor is borrowed");
+        return NULL;
+    }
+
+    // Changes would apply to all of the owners of the shared id
+    if (pass_ctx->render_pass_ref_counts[render_pass_id] > 1)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Shared render pass descriptor can't be borrowed"
+        );
+        return NULL;
+    }
+
+    DivisionRenderPassDescriptor* render_pass =
+        DIVISION_GET_RENDER_PASS_DESCRIPTOR(ctx, render_pass_id);
+    pass_ctx->borrowed_render_pass = *render_pass;
+    pass_ctx->borrowed_render_pass_id = render_pass_id;
+    pass_ctx->is_render_pass_borrowed = true;
+
+    return render_pass;
 }
 
-void division_engine_render_pass_descriptor_return(
+bool division_engine_render_pass_descriptor_return(
     DivisionContext* ctx,
     uint32_t render_pass_id,
     DivisionRenderPassDescriptor* render_pass_ptr
 )
 {
+    DivisionRenderPassSystemContext* pass_ctx = ctx->render_pass_context;
+    if (!pass_ctx->is_render_pass_borrowed ||
+        pass_ctx->borrowed_render_pass_id != render_pass_id)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Render pass descriptor isn't borrowed");
+        return false;
+    }
+    pass_ctx->is_render_pass_borrowed = false;
+
+    // The platform state is resolved from the descriptor, so it is made again
+    division_engine_internal_platform_render_pass_free(ctx, render_pass_id);
+    if (!division_engine_internal_platform_render_pass_impl_init_element(
+            ctx, render_pass_id
+        ))
+    {
+        *render_pass_ptr = pass_ctx->borrowed_render_pass;
+        division_engine_internal_platform_render_pass_impl_init_element(
+            ctx, render_pass_id
+        );
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Returned render pass descriptor has an invalid state"
+        );
+        return false;
+    }
+
+    // The next allocations of the new state get the id
+    remove_shared_(pass_ctx, render_pass_id);
+    pass_ctx->render_pass_hashes[render_pass_id] = hash_render_pass_(render_pass_ptr);
+    insert_shared_(pass_ctx, render_pass_id);
+
+    division_engine_capture_render_pass_descriptor(
+        ctx,
+        DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_UPDATE,
+        render_pass_id,
+        render_pass_ptr
+    );
+    return true;
 }
 
 void division_engine_render_pass_descriptor_free(
     DivisionContext* ctx, uint32_t render_pass_id
 )
 {
-    division_engine_internal_platform_render_pass_free(ctx, render_pass_id);
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_RENDER_PASS_DESCRIPTOR_FREE, render_pass_id
+    );
 
     DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    if (--render_pass_ctx->render_pass_ref_counts[render_pass_id] > 0)
+    {
+        return;
+    }
+
+    remove_shared_(render_pass_ctx, render_pass_id);
+    division_engine_internal_platform_render_pass_free(ctx, render_pass_id);
     division_unordered_id_table_remove_id(&render_pass_ctx->id_table, render_pass_id);
 }
+
+bool try_find_shared_(
+    const DivisionRenderPassSystemContext* pass_ctx,
+    const DivisionRenderPassDescriptor* render_pass,
+    uint32_t hash,
+    uint32_t* out_render_pass_id
+)
+{
+    size_t capacity = pass_ctx->shared_bucket_capacity;
+    for (size_t i = 0; i < capacity; i++)
+    {
+        uint32_t bucket = pass_ctx->shared_buckets[(hash + i) % capacity];
+        if (bucket == SHARED_BUCKET_EMPTY_)
+        {
+            return false;
+        }
+
+        // The borrowed descriptor is about to change, so it isn't shared
+        uint32_t render_pass_id = bucket - 1;
+        if (bucket != SHARED_BUCKET_DELETED_ &&
+            pass_ctx->render_pass_hashes[render_pass_id] == hash &&
+            !(pass_ctx->is_render_pass_borrowed &&
+              pass_ctx->borrowed_render_pass_id == render_pass_id) &&
+            is_same_state_(
+                &pass_ctx->render_pass_descriptors[render_pass_id], render_pass
+            ))
+        {
+            *out_render_pass_id = render_pass_id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool insert_shared_(DivisionRenderPassSystemContext* pass_ctx, uint32_t render_pass_id)
+{
+    // Deleted buckets are counted too, so the probes always meet an empty bucket
+    if ((pass_ctx->shared_bucket_count + 1) * 2 > pass_ctx->shared_bucket_capacity &&
+        !grow_shared_buckets_(pass_ctx))
+    {
+        return false;
+    }
+
+    size_t capacity = pass_ctx->shared_bucket_capacity;
+    uint32_t hash = pass_ctx->render_pass_hashes[render_pass_id];
+    for (size_t i = 0;; i++)
+    {
+        uint32_t* bucket = &pass_ctx->shared_buckets[(hash + i) % capacity];
+        if (*bucket == SHARED_BUCKET_EMPTY_)
+        {
+            *bucket = render_pass_id + 1;
+            pass_ctx->shared_bucket_count++;
+            return true;
+        }
+    }
+}
+
+void remove_shared_(DivisionRenderPassSystemContext* pass_ctx, uint32_t render_pass_id)
+{
+    size_t capacity = pass_ctx->shared_bucket_capacity;
+    uint32_t hash = pass_ctx->render_pass_hashes[render_pass_id];
+    for (size_t i = 0; i < capacity; i++)
+    {
+        uint32_t* bucket = &pass_ctx->shared_buckets[(hash + i) % capacity];
+        if (*bucket == SHARED_BUCKET_EMPTY_)
+        {
+            return;
+        }
+        if (*bucket == render_pass_id + 1)
+        {
+            *bucket = SHARED_BUCKET_DELETED_;
+            return;
+        }
+    }
+}
+
+// Rehashes the live ids, the deleted buckets are dropped
+bool grow_shared_buckets_(DivisionRenderPassSystemContext* pass_ctx)
+{
+    size_t old_capacity = pass_ctx->shared_bucket_capacity;
+    uint32_t* old_buckets = pass_ctx->shared_buckets;
+    size_t new_capacity = DIVISION_MAX(SHARED_BUCKET_MIN_CAPACITY_, old_capacity * 2);
+
+    uint32_t* buckets = calloc(new_capacity, sizeof(uint32_t));
+    if (buckets == NULL)
+    {
+        return false;
+    }
+
+    pass_ctx->shared_buckets = buckets;
+    pass_ctx->shared_bucket_capacity = new_capacity;
+    pass_ctx->shared_bucket_count = 0;
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_buckets[i] != SHARED_BUCKET_EMPTY_ &&
+            old_buckets[i] != SHARED_BUCKET_DELETED_)
+        {
+            insert_shared_(pass_ctx, old_buckets[i] - 1);
+        }
+    }
+
+    free(old_buckets);
+    return true;
+}
+
+// Options of the disabled capabilities don't affect the state, so they are skipped
+uint32_t hash_render_pass_(const DivisionRenderPassDescriptor* render_pass)
+{
+    uint32_t hash = FNV_OFFSET_BASIS_;
+    hash = hash_u32_(hash, render_pass->shader_program);
+    hash = hash_u32_(hash, render_pass->vertex_buffer_id);
+    hash = hash_u32_(hash, (uint32_t) render_pass->capabilities_mask);
+    hash = hash_u32_(hash, (uint32_t) render_pass->color_mask);
+
+    if (DIVISION_MASK_HAS_FLAG(
+            render_pass->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND
+        ))
+    {
+        const DivisionAlphaBlendingOptions* blend = &render_pass->alpha_blending_options;
+        hash = hash_u32_(hash, (uint32_t) blend->src);
+        hash = hash_u32_(hash, (uint32_t) blend->dst);
+        hash = hash_u32_(hash, (uint32_t) blend->operation);
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t color_bits;
+            memcpy(&color_bits, &blend->constant_blend_color[i], sizeof(uint32_t));
+            hash = hash_u32_(hash, color_bits);
+        }
+    }
+
+    if (DIVISION_MASK_HAS_FLAG(
+            render_pass->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST
+        ))
+    {
+        hash = hash_u32_(hash, (uint32_t) render_pass->depth_compare);
+    }
+
+    return hash;
+}
+
+uint32_t hash_u32_(uint32_t hash, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * FNV_PRIME_;
+    }
+
+    return hash;
+}
+
+bool is_same_state_(
+    const DivisionRenderPassDescriptor* left, const DivisionRenderPassDescriptor* right
+)
+{
+    if (left->shader_program != right->shader_program ||
+        left->vertex_buffer_id != right->vertex_buffer_id ||
+        left->capabilities_mask != right->capabilities_mask ||
+        left->color_mask != right->color_mask)
+    {
+        return false;
+    }
+
+    if (DIVISION_MASK_HAS_FLAG(
+            left->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND
+        ))
+    {
+        const DivisionAlphaBlendingOptions* left_blend = &left->alpha_blending_options;
+        const DivisionAlphaBlendingOptions* right_blend = &right->alpha_blending_options;
+        if (left_blend->src != right_blend->src || left_blend->dst != right_blend->dst ||
+            left_blend->operation != right_blend->operation ||
+            memcmp(
+                left_blend->constant_blend_color,
+                right_blend->constant_blend_color,
+                sizeof(left_blend->constant_blend_color)
+            ) != 0)
+        {
+            return false;
+        }
+    }
+
+    return !DIVISION_MASK_HAS_FLAG(
+               left->capabilities_mask,
+               DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_DEPTH_TEST
+           ) ||
+           left->depth_compare == right->depth_compare;
+}
@@ -1,5 +1,177 @@
 #include "division_engine_core/platform_internal/platform_render_pass_instance.h"
+#include <division_engine_core/binding_group.h>
+#include <division_engine_core/capture.h>
+#include <division_engine_core/dirty_rects.h>
+#include <division_engine_core/profiler.h>
+#include <division_engine_core/radix_sort.h>
+#include <division_engine_core/render_pass_descriptor.h>
 #include <division_engine_core/render_pass_instance.h>
+#include <division_engine_core/renderer.h>
+#include <division_engine_core/uniform_buffer.h>
+#include <division_engine_core/upload_queue.h>
+#include <division_engine_core/utility.h>
+#include <division_engine_core/vertex_buffer.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET_BASIS_ 2166136261u
+#define FNV_PRIME_ 16777619u
+
+static inline bool are_states_equal_(
+    const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+);
+static inline bool are_bindings_equal_(
+    const DivisionIdWithBinding* first,
+    const DivisionIdWithBinding* second,
+    int32_t first_count,
+    int32_t second_count
+);
+static inline uint32_t hash_texture_set_(
+    const DivisionIdWithBinding* textures, int32_t texture_count
+);
+static inline bool reserve_sort_buffers_(
+    DivisionRenderPassSystemContext* render_pass_ctx, size_t count
+);
+static inline bool reserve_merged_instances_(
+    DivisionRenderPassSystemContext* render_pass_ctx, size_t count
+);
+static inline uint32_t merge_instances_(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* instances,
+    uint32_t instance_count,
+    DivisionRenderPassInstance* out_instances
+);
+static inline bool can_merge_(
+    const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+);
+static inline void begin_frame_redraw_(DivisionContext* ctx);
+static inline DivisionFrameDescriptor make_clear_frame_(const DivisionColor* clear_color);
+
+bool division_engine_render_pass_instance_begin_frame(
+    DivisionContext* ctx, const DivisionFrameDescriptor* frame
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    if (render_pass_ctx->frame_begun)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Frame is begun already");
+        return false;
+    }
+
+    // The color of the window is presented, so it can't be dropped
+    if (frame->color_store_action != DIVISION_STORE_ACTION_STORE)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Color store action of the frame isn't STORE");
+        return false;
+    }
+
+    division_engine_capture_begin_frame(ctx, frame);
+    render_pass_ctx->frame = *frame;
+    render_pass_ctx->frame_begun = true;
+    begin_frame_redraw_(ctx);
+    division_engine_internal_platform_render_pass_instance_begin_frame(ctx, frame);
+
+    return true;
+}
+
+void division_engine_render_pass_instance_submit(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instances,
+    uint32_t render_pass_instance_count
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    if (!render_pass_ctx->frame_begun)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Instances are submitted outside of a frame");
+        return;
+    }
+
+    DIVISION_PROFILER_BEGIN(ctx, DIVISION_PROFILER_LABEL_SUBMIT);
+    division_engine_capture_submit(
+        ctx, render_pass_instances, render_pass_instance_count
+    );
+    division_engine_upload_queue_flush(ctx);
+
+    // Merging is an optimization, the instances are drawn as they are without memory
+    const DivisionRenderPassInstance* instances = render_pass_instances;
+    uint32_t instance_count = render_pass_instance_count;
+    if (reserve_merged_instances_(render_pass_ctx, render_pass_instance_count))
+    {
+        instances = render_pass_ctx->merged_instances;
+        instance_count = merge_instances_(
+            ctx,
+            render_pass_instances,
+            render_pass_instance_count,
+            render_pass_ctx->merged_instances
+        );
+    }
+
+    render_pass_ctx->merge_stats.submitted_draws += render_pass_instance_count;
+    render_pass_ctx->merge_stats.merged_draws +=
+        render_pass_instance_count - instance_count;
+
+    if (render_pass_ctx->partial_redraw)
+    {
+        for (uint32_t i = 0; i < render_pass_ctx->frame_dirty_rect_count; i++)
+        {
+            division_engine_internal_platform_render_pass_instance_set_scissor(
+                ctx, &render_pass_ctx->frame_dirty_rects[i]
+            );
+            division_engine_internal_platform_render_pass_instance_draw(
+                ctx, instances, instance_count
+            );
+        }
+    }
+    else
+    {
+        division_engine_internal_platform_render_pass_instance_draw(
+            ctx, instances, instance_count
+        );
+    }
+    DIVISION_PROFILER_END(ctx);
+}
+
+void division_engine_render_pass_instance_mark_dirty(
+    DivisionContext* ctx, const DivisionDirtyRect* rect
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionRendererSystemContext* renderer_ctx = ctx->renderer_context;
+
+    division_engine_capture_mark_dirty(ctx, rect);
+    if (!render_pass_ctx->partial_redraw)
+    {
+        return;
+    }
+
+    division_dirty_rects_add(
+        render_pass_ctx->dirty_rects,
+        &render_pass_ctx->dirty_rect_count,
+        *rect,
+        renderer_ctx->frame_buffer_width,
+        renderer_ctx->frame_buffer_height
+    );
+}
+
+void division_engine_render_pass_instance_end_frame(DivisionContext* ctx)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    if (!render_pass_ctx->frame_begun)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Frame is ended without the beginning");
+        return;
+    }
+
+    division_engine_capture_end_frame(ctx);
+    division_engine_internal_platform_render_pass_instance_end_frame(
+        ctx, &render_pass_ctx->frame
+    );
+    render_pass_ctx->frame_begun = false;
+
+    division_engine_uniform_buffer_ring_end_frame(ctx);
+}
 
 void division_engine_render_pass_instance_draw(
     DivisionContext* ctx,
@@ -8,7 +180,395 @@ void division_engine_render_pass_instance_draw(
     uint32_t render_pass_instance_count
 )
 {
-    division_engine_internal_platform_render_pass_instance_draw(
-        ctx, clear_color, render_pass_instances, render_pass_instance_count
+    DivisionFrameDescriptor frame = make_clear_frame_(clear_color);
+    if (!division_engine_render_pass_instance_begin_frame(ctx, &frame))
+    {
+        return;
+    }
+
+    division_engine_render_pass_instance_submit(
+        ctx, render_pass_instances, render_pass_instance_count
+    );
+    division_engine_render_pass_instance_end_frame(ctx);
+}
+
+void division_engine_render_pass_instance_submit_sorted(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instances,
+    const DivisionRenderPassInstanceSortInfo* sort_infos,
+    uint32_t render_pass_instance_count
+)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    size_t count = render_pass_instance_count;
+
+    if (!reserve_sort_buffers_(render_pass_ctx, count))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the sort buffers");
+        return;
+    }
+
+    bool front_to_back =
+        render_pass_ctx->frame.opaque_sort_order == DIVISION_OPAQUE_SORT_FRONT_TO_BACK;
+    uint64_t* keys = render_pass_ctx->sort_keys;
+    uint32_t* indices = render_pass_ctx->sort_indices;
+    for (uint32_t i = 0; i < render_pass_instance_count; i++)
+    {
+        keys[i] = division_engine_render_pass_instance_sort_key(
+            ctx, &render_pass_instances[i], sort_infos ? &sort_infos[i] : NULL
+        );
+        if (front_to_back)
+        {
+            keys[i] = division_engine_render_pass_instance_depth_first_sort_key(keys[i]);
+        }
+        indices[i] = i;
+    }
+
+    division_radix_sort_u64(keys, indices, keys + count, indices + count, count);
+
+    DivisionRenderPassInstance* sorted_instances = render_pass_ctx->sorted_instances;
+    for (size_t i = 0; i < count; i++)
+    {
+        sorted_instances[i] = render_pass_instances[indices[i]];
+    }
+
+    division_engine_render_pass_instance_submit(
+        ctx, sorted_instances, render_pass_instance_count
+    );
+}
+
+void division_engine_render_pass_instance_draw_sorted(
+    DivisionContext* ctx,
+    const DivisionColor* clear_color,
+    const DivisionRenderPassInstance* render_pass_instances,
+    const DivisionRenderPassInstanceSortInfo* sort_infos,
+    uint32_t render_pass_instance_count
+)
+{
+    DivisionFrameDescriptor frame = make_clear_frame_(clear_color);
+    if (!division_engine_render_pass_instance_begin_frame(ctx, &frame))
+    {
+        return;
+    }
+
+    division_engine_render_pass_instance_submit_sorted(
+        ctx, render_pass_instances, sort_infos, render_pass_instance_count
+    );
+    division_engine_render_pass_instance_end_frame(ctx);
+}
+
+uint64_t division_engine_render_pass_instance_sort_key(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* render_pass_instance,
+    const DivisionRenderPassInstanceSortInfo* sort_info
+)
+{
+    uint32_t pass_desc_id = render_pass_instance->render_pass_descriptor_id;
+    const DivisionRenderPassDescriptor* pass_desc =
+        DIVISION_GET_RENDER_PASS_DESCRIPTOR(ctx, pass_desc_id);
+
+    DivisionBindingGroup bindings =
+        division_engine_render_pass_instance_bindings(ctx, render_pass_instance);
+
+    return division_engine_render_pass_instance_pack_sort_key(
+        sort_info ? sort_info->layer : 0,
+        DIVISION_MASK_HAS_FLAG(
+            pass_desc->capabilities_mask,
+            DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND
+        ),
+        pass_desc->shader_program,
+        pass_desc->vertex_buffer_id,
+        pass_desc_id,
+        hash_texture_set_(bindings.fragment_textures, bindings.fragment_texture_count),
+        sort_info ? sort_info->depth : 0
+    );
+}
+
+bool division_engine_render_pass_instance_can_batch(
+    const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+)
+{
+    return DIVISION_MASK_HAS_FLAG(
+               first->capabilities_mask,
+               DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_MULTI_DRAW_INDIRECT
+           ) &&
+           are_states_equal_(first, second);
+}
+
+// Instances with the same textures get the same value, different sets rarely collide
+uint32_t hash_texture_set_(const DivisionIdWithBinding* textures, int32_t texture_count)
+{
+    uint32_t hash = FNV_OFFSET_BASIS_;
+    for (int32_t i = 0; i < texture_count; i++)
+    {
+        hash = (hash ^ textures[i].id) * FNV_PRIME_;
+        hash = (hash ^ textures[i].shader_location) * FNV_PRIME_;
+    }
+
+    // Folds the hash, so all of its bits affect the truncated key field
+    return hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24);
+}
+
+bool reserve_sort_buffers_(DivisionRenderPassSystemContext* render_pass_ctx, size_t count)
+{
+    if (count <= render_pass_ctx->sort_capacity)
+    {
+        return true;
+    }
+
+    size_t capacity = DIVISION_MAX(count, render_pass_ctx->sort_capacity * 2);
+    uint64_t* keys = realloc(render_pass_ctx->sort_keys, sizeof(uint64_t[capacity * 2]));
+    if (keys == NULL)
+    {
+        return false;
+    }
+    render_pass_ctx->sort_keys = keys;
+
+    uint32_t* indices =
+        realloc(render_pass_ctx->sort_indices, sizeof(uint32_t[capacity * 2]));
+    if (indices == NULL)
+    {
+        return false;
+    }
+    render_pass_ctx->sort_indices = indices;
+
+    DivisionRenderPassInstance* instances = realloc(
+        render_pass_ctx->sorted_instances, sizeof(DivisionRenderPassInstance[capacity])
+    );
+    if (instances == NULL)
+    {
+        return false;
+    }
+    render_pass_ctx->sorted_instances = instances;
+    render_pass_ctx->sort_capacity = capacity;
+
+    return true;
+}
+
+// Same descriptor, capabilities and bindings, the ranges can be different
+bool are_states_equal_(
+    const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+)
+{
+    if (first->capabilities_mask != second->capabilities_mask ||
+        first->render_pass_descriptor_id != second->render_pass_descriptor_id ||
+        first->uniform_ring_binding_count != second->uniform_ring_binding_count)
+    {
+        return false;
+    }
+
+    int32_t ring_binding_count = first->uniform_ring_binding_count;
+    if (ring_binding_count > 0 &&
+        memcmp(
+            first->uniform_ring_bindings,
+            second->uniform_ring_bindings,
+            sizeof(DivisionUniformRingBinding[ring_binding_count])
+        ) != 0)
+    {
+        return false;
+    }
+
+    // Binding groups are immutable, so the same group means the same bindings
+    if (DIVISION_MASK_HAS_FLAG(
+            first->capabilities_mask,
+            DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP
+        ))
+    {
+        return first->binding_group_id == second->binding_group_id;
+    }
+
+    return are_bindings_equal_(
+               first->uniform_vertex_buffers,
+               second->uniform_vertex_buffers,
+               first->uniform_vertex_buffer_count,
+               second->uniform_vertex_buffer_count
+           ) &&
+           are_bindings_equal_(
+               first->uniform_fragment_buffers,
+               second->uniform_fragment_buffers,
+               first->uniform_fragment_buffer_count,
+               second->uniform_fragment_buffer_count
+           ) &&
+           are_bindings_equal_(
+               first->fragment_textures,
+               second->fragment_textures,
+               first->fragment_texture_count,
+               second->fragment_texture_count
+           );
+}
+
+bool are_bindings_equal_(
+    const DivisionIdWithBinding* first,
+    const DivisionIdWithBinding* second,
+    int32_t first_count,
+    int32_t second_count
+)
+{
+    return first_count == second_count &&
+           (first == second || first_count == 0 ||
+            memcmp(first, second, sizeof(DivisionIdWithBinding[first_count])) == 0);
+}
+
+bool reserve_merged_instances_(
+    DivisionRenderPassSystemContext* render_pass_ctx, size_t count
+)
+{
+    if (count <= render_pass_ctx->merge_capacity)
+    {
+        return true;
+    }
+
+    size_t capacity = DIVISION_MAX(count, render_pass_ctx->merge_capacity * 2);
+    DivisionRenderPassInstance* instances = realloc(
+        render_pass_ctx->merged_instances, sizeof(DivisionRenderPassInstance[capacity])
+    );
+    if (instances == NULL)
+    {
+        return false;
+    }
+
+    render_pass_ctx->merged_instances = instances;
+    render_pass_ctx->merge_capacity = capacity;
+
+    return true;
+}
+
+uint32_t merge_instances_(
+    DivisionContext* ctx,
+    const DivisionRenderPassInstance* instances,
+    uint32_t instance_count,
+    DivisionRenderPassInstance* out_instances
+)
+{
+    DivisionVertexBufferSystemContext* vert_buff_ctx = ctx->vertex_buffer_context;
+    uint32_t out_count = 0;
+
+    for (uint32_t i = 0; i < instance_count; i++)
+    {
+        const DivisionRenderPassInstance* instance = &instances[i];
+
+        if (out_count > 0 && can_merge_(&out_instances[out_count - 1], instance))
+        {
+            const DivisionRenderPassDescriptor* pass_desc =
+                DIVISION_GET_RENDER_PASS_DESCRIPTOR(
+                    ctx, instance->render_pass_descriptor_id
+                );
+            const DivisionVertexBuffer* vertex_buffer =
+                &vert_buff_ctx->buffers[pass_desc->vertex_buffer_id];
+
+            if (division_engine_render_pass_instance_merge_ranges(
+                    &out_instances[out_count - 1],
+                    instance,
+                    vertex_buffer->settings.topology,
+                    vertex_buffer->settings.size.index_count > 0
+                ))
+            {
+                continue;
+            }
+        }
+
+        out_instances[out_count++] = *instance;
+    }
+
+    return out_count;
+}
+
+bool can_merge_(
+    const DivisionRenderPassInstance* first, const DivisionRenderPassInstance* second
+)
+{
+    // Batched draws rely on gl_DrawID, they are joined by the indirect draws instead
+    DivisionRenderPassInstanceCapabilityMask no_merge_mask =
+        DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NO_MERGE |
+        DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_MULTI_DRAW_INDIRECT;
+
+    return (first->capabilities_mask & no_merge_mask) == 0 &&
+           are_states_equal_(first, second);
+}
+
+void division_engine_render_pass_instance_redraw_whole_frame(DivisionContext* ctx)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionRendererSystemContext* renderer_ctx = ctx->renderer_context;
+    DivisionRedrawStats* stats = &render_pass_ctx->redraw_stats;
+
+    render_pass_ctx->frame_dirty_rects[0] = (DivisionDirtyRect){
+        .x = 0,
+        .y = 0,
+        .width = renderer_ctx->frame_buffer_width,
+        .height = renderer_ctx->frame_buffer_height,
+    };
+    render_pass_ctx->frame_dirty_rect_count = 1;
+
+    // No size matches, so the next frame is dirty as a whole
+    render_pass_ctx->redraw_width = -1;
+    render_pass_ctx->redraw_height = -1;
+
+    stats->dirty_rect_count = 1;
+    stats->touched_pixels = stats->frame_pixels;
+    stats->touched_percent = 100.0f;
+}
+
+// Takes the dirty rects of the frame and counts the pixels touched by it
+void begin_frame_redraw_(DivisionContext* ctx)
+{
+    DivisionRenderPassSystemContext* render_pass_ctx = ctx->render_pass_context;
+    DivisionRendererSystemContext* renderer_ctx = ctx->renderer_context;
+    DivisionRedrawStats* stats = &render_pass_ctx->redraw_stats;
+    int32_t width = renderer_ctx->frame_buffer_width;
+    int32_t height = renderer_ctx->frame_buffer_height;
+
+    stats->frame_pixels = (uint64_t) DIVISION_MAX(width, 0) * DIVISION_MAX(height, 0);
+    if (!render_pass_ctx->partial_redraw)
+    {
+        stats->dirty_rect_count = 0;
+        stats->touched_pixels = stats->frame_pixels;
+        stats->touched_percent = 100.0f;
+        return;
+    }
+
+    if (render_pass_ctx->redraw_width != width ||
+        render_pass_ctx->redraw_height != height)
+    {
+        render_pass_ctx->dirty_rect_count = 0;
+        division_dirty_rects_add(
+            render_pass_ctx->dirty_rects,
+            &render_pass_ctx->dirty_rect_count,
+            (DivisionDirtyRect){.x = 0, .y = 0, .width = width, .height = height},
+            width,
+            height
+        );
+        render_pass_ctx->redraw_width = width;
+        render_pass_ctx->redraw_height = height;
+    }
+
+    memcpy(
+        render_pass_ctx->frame_dirty_rects,
+        render_pass_ctx->dirty_rects,
+        sizeof(DivisionDirtyRect) * render_pass_ctx->dirty_rect_count
+    );
+    render_pass_ctx->frame_dirty_rect_count = render_pass_ctx->dirty_rect_count;
+    render_pass_ctx->dirty_rect_count = 0;
+
+    stats->dirty_rect_count = render_pass_ctx->frame_dirty_rect_count;
+    stats->touched_pixels = division_dirty_rects_area(
+        render_pass_ctx->frame_dirty_rects, render_pass_ctx->frame_dirty_rect_count
     );
+    stats->touched_percent =
+        stats->frame_pixels > 0
+            ? (float) (100.0 * (double) stats->touched_pixels / stats->frame_pixels)
+            : 0.0f;
+}
+
+DivisionFrameDescriptor make_clear_frame_(const DivisionColor* clear_color)
+{
+    return (DivisionFrameDescriptor){
+        .clear_color = *clear_color,
+        .color_load_action = DIVISION_LOAD_ACTION_CLEAR,
+        .color_store_action = DIVISION_STORE_ACTION_STORE,
+        .clear_depth = 1.0f,
+        .depth_load_action = DIVISION_LOAD_ACTION_CLEAR,
+        .depth_store_action = DIVISION_STORE_ACTION_DONT_CARE,
+        .opaque_sort_order = DIVISION_OPAQUE_SORT_BY_STATE,
+    };
 }
@@ -1,5 +1,8 @@
 #include "division_engine_core/renderer.h"
 #include "division_engine_core/platform_internal/platform_renderer.h"
+#include "division_engine_core/profiler.h"
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/render_pass_instance.h"
 
 #include <stdlib.h>
 
@@ -8,6 +11,7 @@ bool division_engine_renderer_system_context_alloc(
 )
 {
     ctx->renderer_context = malloc(sizeof(DivisionRendererSystemContext));
+    ctx->renderer_context->depth_stencil_format = settings->depth_stencil_format;
 
     return division_engine_internal_platform_renderer_alloc(ctx, settings);
 }
@@ -17,6 +21,20 @@ void division_engine_renderer_run_loop(DivisionContext* ctx)
     division_engine_internal_platform_renderer_run_loop(ctx);
 }
 
+void division_engine_renderer_draw(DivisionContext* ctx)
+{
+    DIVISION_PROFILER_BEGIN(ctx, DIVISION_PROFILER_LABEL_DRAW_CALLBACK);
+    ctx->lifecycle.draw_callback(ctx);
+    DIVISION_PROFILER_END(ctx);
+
+    // The frame left open by the callback is presented, like the profiler scopes
+    if (ctx->render_pass_context->frame_begun)
+    {
+        division_engine_render_pass_instance_end_frame(ctx);
+    }
+    division_engine_profiler_end_frame(ctx);
+}
+
 void division_engine_renderer_system_context_free(DivisionContext* ctx)
 {
     division_engine_internal_platform_renderer_free(ctx);
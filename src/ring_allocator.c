@@ -0,0 +1,61 @@
+#include "division_engine_core/data_structures/ring_allocator.h"
+
+void division_ring_allocator_init(DivisionRingAllocator* allocator, size_t capacity)
+{
+    allocator->head = 0;
+    allocator->tail = 0;
+    allocator->capacity = capacity;
+}
+
+bool division_ring_allocator_alloc_range(
+    DivisionRingAllocator* allocator, size_t size, size_t alignment, size_t* out_offset
+)
+{
+    size_t capacity = allocator->capacity;
+    if (size > capacity)
+    {
+        return false;
+    }
+
+    // The empty storage starts over, so the allocation can take all of it
+    if (allocator->head == allocator->tail && allocator->head % capacity != 0)
+    {
+        allocator->head += capacity - allocator->head % capacity;
+        allocator->tail = allocator->head;
+    }
+
+    size_t head_offset = (size_t) (allocator->head % capacity);
+    size_t offset = (head_offset + alignment - 1) & ~(alignment - 1);
+
+    if (offset + size > capacity)
+    {
+        offset = 0;
+    }
+
+    uint64_t skipped =
+        offset >= head_offset ? offset - head_offset : capacity - head_offset;
+    uint64_t new_head = allocator->head + skipped + size;
+
+    if (new_head - allocator->tail > capacity)
+    {
+        return false;
+    }
+
+    allocator->head = new_head;
+    *out_offset = offset;
+
+    return true;
+}
+
+void division_ring_allocator_release(DivisionRingAllocator* allocator, uint64_t position)
+{
+    if (position > allocator->tail && position <= allocator->head)
+    {
+        allocator->tail = position;
+    }
+}
+
+size_t division_ring_allocator_used_size(const DivisionRingAllocator* allocator)
+{
+    return (size_t) (allocator->head - allocator->tail);
+}
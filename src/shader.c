@@ -1,6 +1,8 @@
 #include "division_engine_core/shader.h"
 #include "division_engine_core/platform_internal/platfrom_shader.h"
 
+#include "division_engine_core/capture.h"
+
 #include <stdbool.h>
 #include <stdlib.h>
 
@@ -32,12 +34,23 @@ bool division_engine_shader_program_alloc(
     uint32_t* out_shader_program_id
 )
 {
-    return division_engine_internal_platform_shader_program_alloc(
-        ctx, descriptors, descriptor_count, out_shader_program_id
+    if (!division_engine_internal_platform_shader_program_alloc(
+            ctx, descriptors, descriptor_count, out_shader_program_id
+        ))
+    {
+        return false;
+    }
+
+    division_engine_capture_shader_program_alloc(
+        ctx, descriptors, descriptor_count, *out_shader_program_id
     );
+    return true;
 }
 
 void division_engine_shader_program_free(DivisionContext* ctx, uint32_t shader_program_id)
 {
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_SHADER_PROGRAM_FREE, shader_program_id
+    );
     division_engine_internal_platform_shader_program_free(ctx, shader_program_id);
 }
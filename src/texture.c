@@ -1,6 +1,8 @@
 #include "division_engine_core/texture.h"
 #include "division_engine_core/platform_internal/platform_texture.h"
 
+#include "division_engine_core/capture.h"
+
 #include <stdlib.h>
 
 bool division_engine_texture_system_context_alloc(
@@ -44,15 +46,26 @@ bool division_engine_texture_alloc(
             );
             return false;
         }
+
+        tex_ctx->texture_count = (uint32_t) new_size;
     }
 
     tex_ctx->textures[tex_id] = *texture;
     *out_texture_id = tex_id;
-    return division_engine_internal_platform_texture_impl_init_new_element(ctx, tex_id);
+    if (!division_engine_internal_platform_texture_impl_init_new_element(ctx, tex_id))
+    {
+        return false;
+    }
+
+    division_engine_capture_texture_alloc(ctx, texture, tex_id);
+    return true;
 }
 
 void division_engine_texture_free(DivisionContext* ctx, uint32_t texture_id)
 {
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_TEXTURE_FREE, texture_id
+    );
     division_engine_internal_platform_texture_free(ctx, texture_id);
     division_unordered_id_table_remove_id(&ctx->texture_context->id_table, texture_id);
 }
@@ -61,5 +74,6 @@ void division_engine_texture_set_data(
     DivisionContext* ctx, uint32_t texture_id, const void* data
 )
 {
+    division_engine_capture_texture_data(ctx, texture_id, data);
     division_engine_internal_platform_texture_set_data(ctx, texture_id, data);
 }
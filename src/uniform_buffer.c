@@ -1,6 +1,9 @@
 #include "division_engine_core/uniform_buffer.h"
 #include "division_engine_core/platform_internal/platform_uniform_buffer.h"
 
+#include "division_engine_core/capture.h"
+
+#include <stdint.h>
 #include <stdlib.h>
 
 bool division_engine_uniform_buffer_system_context_alloc(
@@ -8,8 +11,17 @@ bool division_engine_uniform_buffer_system_context_alloc(
 )
 {
     ctx->uniform_buffer_context = malloc(sizeof(DivisionUniformBufferSystemContext));
-    *ctx->uniform_buffer_context = (DivisionUniformBufferSystemContext
-    ){.uniform_buffers = NULL, .uniform_buffer_count = 0};
+    *ctx->uniform_buffer_context = (DivisionUniformBufferSystemContext){
+        .uniform_buffers = NULL,
+        .uniform_buffer_count = 0,
+        .pools_impl = NULL,
+        .pools_count = 0,
+        .ring_data = NULL,
+        .ring_alignment = 1,
+        .ring_frame_offset = 0,
+        .ring_frame = 0,
+        .ring_impl = NULL,
+    };
 
     division_unordered_id_table_alloc(&ctx->uniform_buffer_context->id_table, 10);
 
@@ -58,13 +70,22 @@ bool division_engine_uniform_buffer_alloc(
 
     *out_buffer_id = buff_id;
     uniform_buffer_ctx->uniform_buffers[buff_id] = buffer;
-    return division_engine_internal_platform_uniform_buffer_impl_init_element(
-        ctx, buff_id
-    );
+    if (!division_engine_internal_platform_uniform_buffer_impl_init_element(
+            ctx, buff_id
+        ))
+    {
+        return false;
+    }
+
+    division_engine_capture_uniform_buffer_alloc(ctx, buffer, buff_id);
+    return true;
 }
 
 void division_engine_uniform_buffer_free(DivisionContext* ctx, uint32_t buffer_id)
 {
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_UNIFORM_BUFFER_FREE, buffer_id
+    );
     division_engine_internal_platform_uniform_buffer_free(ctx, buffer_id);
     division_unordered_id_table_remove_id(&ctx->uniform_buffer_context->id_table, buffer_id);
 }
@@ -82,7 +103,114 @@ void division_engine_uniform_buffer_return_data_pointer(
     DivisionContext* ctx, uint32_t buffer_id, void* data_pointer
 )
 {
+    division_engine_capture_uniform_buffer_update(
+        ctx,
+        DIVISION_CAPTURE_UNIFORM_BUFFER_DATA,
+        buffer_id,
+        0,
+        data_pointer,
+        ctx->uniform_buffer_context->uniform_buffers[buffer_id].data_bytes
+    );
     division_engine_internal_platform_uniform_buffer_return_data_pointer(
         ctx, buffer_id, data_pointer
     );
 }
+
+bool division_engine_uniform_buffer_set_data(
+    DivisionContext* ctx, uint32_t buffer_id, const void* data
+)
+{
+    size_t data_bytes =
+        ctx->uniform_buffer_context->uniform_buffers[buffer_id].data_bytes;
+    return division_engine_uniform_buffer_update_range(
+        ctx, buffer_id, 0, data, data_bytes
+    );
+}
+
+bool division_engine_uniform_buffer_update_range(
+    DivisionContext* ctx,
+    uint32_t buffer_id,
+    size_t offset,
+    const void* data,
+    size_t size
+)
+{
+    size_t data_bytes =
+        ctx->uniform_buffer_context->uniform_buffers[buffer_id].data_bytes;
+    if (offset > data_bytes || size > data_bytes - offset)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Update is out of the uniform buffer bounds");
+        return false;
+    }
+
+    if (size > 0)
+    {
+        division_engine_capture_uniform_buffer_update(
+            ctx, DIVISION_CAPTURE_UNIFORM_BUFFER_UPDATE, buffer_id, offset, data, size
+        );
+        division_engine_internal_platform_uniform_buffer_update_range(
+            ctx, buffer_id, offset, data, size
+        );
+    }
+
+    return true;
+}
+
+bool division_engine_uniform_buffer_ring_alloc(
+    DivisionContext* ctx, size_t size, DivisionUniformRingRange* out_range
+)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+
+    // The ring storage is created with the first allocation, when the device is ready
+    if (uniform_buffer_ctx->ring_data == NULL &&
+        !division_engine_internal_platform_uniform_buffer_ring_alloc(
+            ctx,
+            DIVISION_UNIFORM_RING_FRAME_CAPACITY * DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT,
+            &uniform_buffer_ctx->ring_alignment
+        ))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to create the uniform ring");
+        return false;
+    }
+
+    // The device alignment isn't required to be a power of two
+    size_t alignment = uniform_buffer_ctx->ring_alignment;
+    size_t offset =
+        (uniform_buffer_ctx->ring_frame_offset + alignment - 1) / alignment * alignment;
+    if (offset > DIVISION_UNIFORM_RING_FRAME_CAPACITY ||
+        size > DIVISION_UNIFORM_RING_FRAME_CAPACITY - offset)
+    {
+        return false;
+    }
+
+    uniform_buffer_ctx->ring_frame_offset = offset + size;
+
+    size_t ring_offset =
+        uniform_buffer_ctx->ring_frame * DIVISION_UNIFORM_RING_FRAME_CAPACITY + offset;
+    *out_range = (DivisionUniformRingRange){
+        .data = (uint8_t*) uniform_buffer_ctx->ring_data + ring_offset,
+        .offset = (uint32_t) ring_offset,
+        .size = (uint32_t) size,
+    };
+
+    return true;
+}
+
+void division_engine_uniform_buffer_ring_end_frame(DivisionContext* ctx)
+{
+    DivisionUniformBufferSystemContext* uniform_buffer_ctx = ctx->uniform_buffer_context;
+    if (uniform_buffer_ctx->ring_data == NULL)
+    {
+        return;
+    }
+
+    uint32_t next_frame =
+        (uniform_buffer_ctx->ring_frame + 1) % DIVISION_UNIFORM_RING_FRAMES_IN_FLIGHT;
+    division_engine_internal_platform_uniform_buffer_ring_end_frame(
+        ctx, uniform_buffer_ctx->ring_frame, next_frame
+    );
+
+    uniform_buffer_ctx->ring_frame = next_frame;
+    uniform_buffer_ctx->ring_frame_offset = 0;
+}
@@ -0,0 +1,323 @@
+#include "division_engine_core/upload_queue.h"
+#include "division_engine_core/platform_internal/platform_upload_queue.h"
+
+#include "division_engine_core/capture.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/utility.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include <memory.h>
+#include <stdlib.h>
+
+static inline bool get_target_size_(
+    DivisionContext* ctx,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t* out_size
+);
+static inline void update_completed_fence_(DivisionContext* ctx);
+static inline bool reserve_(
+    void** array, size_t* capacity, size_t count, size_t item_size
+);
+
+bool division_engine_upload_queue_system_context_alloc(
+    DivisionContext* ctx, const DivisionSettings* settings
+)
+{
+    ctx->upload_queue_context = malloc(sizeof(DivisionUploadQueueSystemContext));
+    if (ctx->upload_queue_context == NULL)
+    {
+        return false;
+    }
+
+    *ctx->upload_queue_context = (DivisionUploadQueueSystemContext){
+        .staging_data = NULL,
+        .jobs = NULL,
+        .jobs_count = 0,
+        .jobs_capacity = 0,
+        .pending_batches = NULL,
+        .pending_batches_count = 0,
+        .pending_batches_capacity = 0,
+        .next_fence = 1,
+        .completed_fence = 0,
+        .upload_queue_impl = NULL,
+    };
+    division_ring_allocator_init(
+        &ctx->upload_queue_context->staging_ring, DIVISION_UPLOAD_QUEUE_STAGING_CAPACITY
+    );
+
+    return division_engine_internal_platform_upload_queue_context_alloc(ctx, settings);
+}
+
+void division_engine_upload_queue_system_context_free(DivisionContext* ctx)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+
+    division_engine_internal_platform_upload_queue_context_free(ctx);
+
+    free(upload_ctx->jobs);
+    free(upload_ctx->pending_batches);
+    free(upload_ctx);
+}
+
+bool division_engine_upload_queue_alloc_staging(
+    DivisionContext* ctx, size_t size, DivisionUploadStaging* out_staging
+)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+
+    // The staging storage is created with the first upload, when the device is ready
+    if (upload_ctx->staging_data == NULL &&
+        !division_engine_internal_platform_upload_queue_staging_alloc(
+            ctx, upload_ctx->staging_ring.capacity
+        ))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to create the upload staging buffer");
+        return false;
+    }
+
+    size_t offset;
+    if (!division_ring_allocator_alloc_range(
+            &upload_ctx->staging_ring,
+            size,
+            DIVISION_UPLOAD_QUEUE_STAGING_ALIGNMENT,
+            &offset
+        ))
+    {
+        update_completed_fence_(ctx);
+
+        if (!division_ring_allocator_alloc_range(
+                &upload_ctx->staging_ring,
+                size,
+                DIVISION_UPLOAD_QUEUE_STAGING_ALIGNMENT,
+                &offset
+            ))
+        {
+            return false;
+        }
+    }
+
+    *out_staging = (DivisionUploadStaging){
+        .data = (uint8_t*) upload_ctx->staging_data + offset,
+        .offset = offset,
+        .size = size,
+    };
+
+    return true;
+}
+
+bool division_engine_upload_queue_enqueue(
+    DivisionContext* ctx,
+    const DivisionUploadStaging* staging,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t dst_offset,
+    DivisionUploadFence* out_fence
+)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+
+    size_t target_size;
+    if (!get_target_size_(ctx, target, resource_id, &target_size))
+    {
+        return false;
+    }
+
+    bool is_in_bounds =
+        target == DIVISION_UPLOAD_TARGET_TEXTURE
+            ? dst_offset == 0 && staging->size == target_size
+            : dst_offset <= target_size && staging->size <= target_size - dst_offset;
+    if (!is_in_bounds)
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Upload is out of the target bounds");
+        return false;
+    }
+
+    if (!reserve_(
+            (void**) &upload_ctx->jobs,
+            &upload_ctx->jobs_capacity,
+            upload_ctx->jobs_count + 1,
+            sizeof(DivisionUploadJob)
+        ))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to reallocate upload jobs");
+        return false;
+    }
+
+    upload_ctx->jobs[upload_ctx->jobs_count++] = (DivisionUploadJob){
+        .target = target,
+        .resource_id = resource_id,
+        .staging_offset = staging->offset,
+        .dst_offset = dst_offset,
+        .size = staging->size,
+    };
+    *out_fence = upload_ctx->next_fence;
+
+    division_engine_capture_upload(ctx, staging, target, resource_id, dst_offset);
+    return true;
+}
+
+void division_engine_upload_queue_flush(DivisionContext* ctx)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+
+    division_engine_capture_upload_flush(ctx);
+    if (upload_ctx->jobs_count > 0)
+    {
+        if (!reserve_(
+                (void**) &upload_ctx->pending_batches,
+                &upload_ctx->pending_batches_capacity,
+                upload_ctx->pending_batches_count + 1,
+                sizeof(DivisionUploadBatch)
+            ))
+        {
+            DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to reallocate upload batches");
+            return;
+        }
+
+        division_engine_internal_platform_upload_queue_submit(
+            ctx, upload_ctx->jobs, upload_ctx->jobs_count, upload_ctx->next_fence
+        );
+
+        upload_ctx->pending_batches[upload_ctx->pending_batches_count++] =
+            (DivisionUploadBatch){
+                .fence = upload_ctx->next_fence,
+                .staging_end = upload_ctx->staging_ring.head,
+            };
+        upload_ctx->next_fence++;
+        upload_ctx->jobs_count = 0;
+    }
+
+    update_completed_fence_(ctx);
+}
+
+bool division_engine_upload_queue_is_complete(
+    DivisionContext* ctx, DivisionUploadFence fence
+)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+    if (fence > upload_ctx->completed_fence)
+    {
+        update_completed_fence_(ctx);
+    }
+
+    return fence <= upload_ctx->completed_fence;
+}
+
+bool get_target_size_(
+    DivisionContext* ctx,
+    DivisionUploadTarget target,
+    uint32_t resource_id,
+    size_t* out_size
+)
+{
+    const DivisionUnorderedIdTable* id_table;
+    switch (target)
+    {
+    case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+    case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+    case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+        id_table = &ctx->vertex_buffer_context->id_table;
+        break;
+    case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+        id_table = &ctx->uniform_buffer_context->id_table;
+        break;
+    case DIVISION_UPLOAD_TARGET_TEXTURE:
+        id_table = &ctx->texture_context->id_table;
+        break;
+    default:
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown upload target");
+        return false;
+    }
+
+    if (!division_unordered_id_table_contains(id_table, resource_id))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown resource id of the upload target");
+        return false;
+    }
+
+    DivisionVertexBufferSystemContext* vb_ctx = ctx->vertex_buffer_context;
+    const DivisionVertexBuffer* vb =
+        id_table == &vb_ctx->id_table ? &vb_ctx->buffers[resource_id] : NULL;
+    switch (target)
+    {
+    case DIVISION_UPLOAD_TARGET_VERTEX_DATA:
+        *out_size = vb->per_vertex_data_size * vb->settings.size.vertex_count;
+        return true;
+    case DIVISION_UPLOAD_TARGET_INSTANCE_DATA:
+        *out_size = vb->per_instance_data_size * vb->settings.size.instance_count;
+        return true;
+    case DIVISION_UPLOAD_TARGET_INDEX_DATA:
+        *out_size =
+            division_engine_vertex_buffer_index_size(vb) * vb->settings.size.index_count;
+        return true;
+    case DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER:
+        *out_size = ctx->uniform_buffer_context->uniform_buffers[resource_id].data_bytes;
+        return true;
+    case DIVISION_UPLOAD_TARGET_TEXTURE:
+        *out_size = division_engine_texture_data_size(
+            &ctx->texture_context->textures[resource_id]
+        );
+        return true;
+    default:
+        return false;
+    }
+}
+
+void update_completed_fence_(DivisionContext* ctx)
+{
+    DivisionUploadQueueSystemContext* upload_ctx = ctx->upload_queue_context;
+    if (upload_ctx->pending_batches_count == 0)
+    {
+        return;
+    }
+
+    upload_ctx->completed_fence =
+        division_engine_internal_platform_upload_queue_completed_fence(ctx);
+
+    DivisionUploadFence completed_fence = upload_ctx->completed_fence;
+    size_t completed_count = 0;
+    while (completed_count < upload_ctx->pending_batches_count &&
+           upload_ctx->pending_batches[completed_count].fence <= completed_fence)
+    {
+        completed_count++;
+    }
+
+    if (completed_count == 0)
+    {
+        return;
+    }
+
+    division_ring_allocator_release(
+        &upload_ctx->staging_ring,
+        upload_ctx->pending_batches[completed_count - 1].staging_end
+    );
+
+    upload_ctx->pending_batches_count -= completed_count;
+    memmove(
+        upload_ctx->pending_batches,
+        upload_ctx->pending_batches + completed_count,
+        sizeof(DivisionUploadBatch[upload_ctx->pending_batches_count])
+    );
+}
+
+bool reserve_(void** array, size_t* capacity, size_t count, size_t item_size)
+{
+    if (count <= *capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = DIVISION_MAX(count, *capacity * 2);
+    void* new_array = realloc(*array, new_capacity * item_size);
+    if (new_array == NULL)
+    {
+        return false;
+    }
+
+    *array = new_array;
+    *capacity = new_capacity;
+
+    return true;
+}
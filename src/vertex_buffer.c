@@ -1,5 +1,7 @@
 #include "division_engine_core/vertex_buffer.h"
+#include "division_engine_core/capture.h"
 #include "division_engine_core/context.h"
+#include "division_engine_core/mesh_file.h"
 #include "division_engine_core/platform_internal/platform_vertex_buffer.h"
 #include "division_engine_core/types/vertex_buffer.h"
 #include "division_engine_core/utility.h"
@@ -32,6 +34,51 @@ static inline bool alloc_vert_attrs_(
     size_t* output_all_attributes_data_size
 );
 
+static inline bool alloc_layout_attrs_(
+    DivisionContext* ctx,
+    const DivisionVertexLayout* layout,
+    DivisionVertexAttribute** output_attributes,
+    DivisionVertexAttributeSettings** output_settings,
+    int32_t* output_attr_count,
+    size_t* output_all_attributes_data_size
+);
+
+static inline bool copy_vert_attrs_(
+    const DivisionVertexAttribute* input_attributes,
+    const DivisionVertexAttributeSettings* input_attribute_settings,
+    int32_t attr_count,
+    DivisionVertexAttribute** output_attributes,
+    DivisionVertexAttributeSettings** output_settings
+);
+
+static bool alloc_vertex_buffer_with_capacity_(
+    DivisionContext* ctx,
+    const DivisionVertexBufferConstSettings* vertex_buffer_settings,
+    DivisionVertexBufferSize capacity,
+    uint32_t* out_vertex_buffer_id
+);
+
+static bool add_vertex_buffer_(
+    DivisionContext* ctx,
+    DivisionVertexBuffer* vertex_buffer,
+    uint32_t vertex_buffer_id,
+    uint32_t* out_vertex_buffer_id
+);
+
+static void free_vertex_buffer_(DivisionContext* ctx, uint32_t vertex_buffer_id);
+static bool alloc_file_attrs_(
+    const DivisionMeshFileAttribute* file_attributes,
+    int32_t attr_count,
+    DivisionVertexAttributeSettings** out_attributes
+);
+static bool upload_mesh_file_data_(
+    DivisionContext* ctx, uint32_t vertex_buffer_id, const DivisionMeshFile* file
+);
+
+static inline uint32_t calc_capacity_(
+    uint32_t capacity, uint32_t size, bool allow_shrink
+);
+
 bool division_engine_vertex_buffer_system_context_alloc(
     DivisionContext* ctx, const DivisionSettings* settings
 )
@@ -41,6 +88,8 @@ bool division_engine_vertex_buffer_system_context_alloc(
         .buffers = NULL,
         .buffers_impl = NULL,
         .buffers_count = 0,
+        .pools_impl = NULL,
+        .pools_count = 0,
     };
 
     division_unordered_id_table_alloc(&ctx->vertex_buffer_context->id_table, 10);
@@ -73,6 +122,219 @@ bool division_engine_vertex_buffer_alloc(
     const DivisionVertexBufferConstSettings* vertex_buffer_settings,
     uint32_t* out_vertex_buffer_id
 )
+{
+    if (!alloc_vertex_buffer_with_capacity_(
+            ctx,
+            vertex_buffer_settings,
+            vertex_buffer_settings->size,
+            out_vertex_buffer_id
+        ))
+    {
+        return false;
+    }
+
+    division_engine_capture_vertex_buffer_alloc(ctx, *out_vertex_buffer_id);
+    return true;
+}
+
+bool division_engine_vertex_buffer_alloc_with_layout(
+    DivisionContext* ctx,
+    const DivisionVertexBufferLayoutSettings* vertex_buffer_settings,
+    uint32_t* out_vertex_buffer_id
+)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+
+    uint32_t vertex_buffer_id = division_unordered_id_table_new_id(&vertex_ctx->id_table);
+
+    DivisionVertexBuffer vertex_buffer = {
+        .per_vertex_attributes = NULL,
+        .per_instance_attributes = NULL,
+        .settings =
+            {
+                .size = vertex_buffer_settings->size,
+                .topology = vertex_buffer_settings->topology,
+                .capabilities_mask = vertex_buffer_settings->capabilities_mask,
+            },
+        .capacity = vertex_buffer_settings->size,
+    };
+    vertex_buffer.settings.per_vertex_attributes = NULL;
+    vertex_buffer.settings.per_instance_attributes = NULL;
+
+    if (!alloc_layout_attrs_(
+            ctx,
+            vertex_buffer_settings->per_vertex_layout,
+            &vertex_buffer.per_vertex_attributes,
+            &vertex_buffer.settings.per_vertex_attributes,
+            &vertex_buffer.settings.per_vertex_attribute_count,
+            &vertex_buffer.per_vertex_data_size
+        ) ||
+        !alloc_layout_attrs_(
+            ctx,
+            vertex_buffer_settings->per_instance_layout,
+            &vertex_buffer.per_instance_attributes,
+            &vertex_buffer.settings.per_instance_attributes,
+            &vertex_buffer.settings.per_instance_attribute_count,
+            &vertex_buffer.per_instance_data_size
+        ))
+    {
+        free_buffer_data_and_handle_error(ctx, &vertex_buffer, vertex_buffer_id);
+        return false;
+    }
+
+    if (!add_vertex_buffer_(ctx, &vertex_buffer, vertex_buffer_id, out_vertex_buffer_id))
+    {
+        return false;
+    }
+
+    division_engine_capture_vertex_buffer_alloc(ctx, *out_vertex_buffer_id);
+    return true;
+}
+
+bool division_engine_vertex_buffer_alloc_from_file(
+    DivisionContext* ctx, const char* path, uint32_t* out_vertex_buffer_id
+)
+{
+    DivisionMeshFile file;
+    if (!division_mesh_file_map(path, &file))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to map the mesh file");
+        return false;
+    }
+
+    const DivisionMeshFileHeader* header = file.header;
+    DivisionVertexAttributeSettings* per_vertex_attributes = NULL;
+    DivisionVertexAttributeSettings* per_instance_attributes = NULL;
+    if (!alloc_file_attrs_(
+            file.per_vertex_attributes,
+            header->per_vertex_attribute_count,
+            &per_vertex_attributes
+        ) ||
+        !alloc_file_attrs_(
+            file.per_instance_attributes,
+            header->per_instance_attribute_count,
+            &per_instance_attributes
+        ))
+    {
+        free(per_vertex_attributes);
+        division_mesh_file_unmap(&file);
+        DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to allocate the mesh file attributes");
+        return false;
+    }
+
+    DivisionVertexBufferConstSettings settings = {
+        .size =
+            {
+                .vertex_count = header->vertex_count,
+                .index_count = header->index_count,
+                .instance_count = header->instance_count,
+            },
+        .per_vertex_attributes = per_vertex_attributes,
+        .per_instance_attributes = per_instance_attributes,
+        .per_vertex_attribute_count = header->per_vertex_attribute_count,
+        .per_instance_attribute_count = header->per_instance_attribute_count,
+        .topology = (DivisionRenderTopology) header->topology,
+        .capabilities_mask =
+            (DivisionVertexBufferCapabilityMask) header->capabilities_mask,
+    };
+
+    // The buffer keeps its own copy of the attribute settings
+    bool ok = division_engine_vertex_buffer_alloc(ctx, &settings, out_vertex_buffer_id);
+    free(per_vertex_attributes);
+    free(per_instance_attributes);
+
+    if (ok && !upload_mesh_file_data_(ctx, *out_vertex_buffer_id, &file))
+    {
+        division_engine_vertex_buffer_free(ctx, *out_vertex_buffer_id);
+        ok = false;
+    }
+
+    division_mesh_file_unmap(&file);
+    return ok;
+}
+
+bool alloc_file_attrs_(
+    const DivisionMeshFileAttribute* file_attributes,
+    int32_t attr_count,
+    DivisionVertexAttributeSettings** out_attributes
+)
+{
+    *out_attributes = NULL;
+    if (attr_count == 0)
+    {
+        return true;
+    }
+
+    DivisionVertexAttributeSettings* attributes =
+        malloc(sizeof(DivisionVertexAttributeSettings[attr_count]));
+    if (attributes == NULL)
+    {
+        return false;
+    }
+
+    for (int32_t i = 0; i < attr_count; i++)
+    {
+        attributes[i] = (DivisionVertexAttributeSettings){
+            .type = (DivisionShaderVariableType) file_attributes[i].type,
+            .location = file_attributes[i].location,
+        };
+    }
+
+    *out_attributes = attributes;
+    return true;
+}
+
+bool upload_mesh_file_data_(
+    DivisionContext* ctx, uint32_t vertex_buffer_id, const DivisionMeshFile* file
+)
+{
+    const DivisionVertexBuffer* vertex_buffer =
+        &ctx->vertex_buffer_context->buffers[vertex_buffer_id];
+    const DivisionMeshFileHeader* header = file->header;
+
+    if (header->vertices.size !=
+            division_engine_vertex_buffer_vertices_bytes(vertex_buffer) ||
+        header->indices.size !=
+            division_engine_vertex_buffer_indices_bytes(vertex_buffer) ||
+        header->instances.size !=
+            division_engine_vertex_buffer_instances_bytes(vertex_buffer))
+    {
+        DIVISION_THROW_INTERNAL_ERROR(
+            ctx, "Mesh file data sizes don't match the vertex buffer layout"
+        );
+        return false;
+    }
+
+    DivisionVertexBufferBorrowedData borrowed;
+    if (!division_engine_vertex_buffer_borrow_data(ctx, vertex_buffer_id, &borrowed))
+    {
+        return false;
+    }
+
+    // Empty sections have no data pointers
+    if (header->vertices.size > 0)
+    {
+        memcpy(borrowed.vertex_data_ptr, file->vertex_data, header->vertices.size);
+    }
+    if (header->indices.size > 0)
+    {
+        memcpy(borrowed.index_data_ptr, file->index_data, header->indices.size);
+    }
+    if (header->instances.size > 0)
+    {
+        memcpy(borrowed.instance_data_ptr, file->instance_data, header->instances.size);
+    }
+
+    division_engine_vertex_buffer_return_data(ctx, vertex_buffer_id, &borrowed);
+    return true;
+}
+
+bool alloc_vertex_buffer_with_capacity_(
+    DivisionContext* ctx,
+    const DivisionVertexBufferConstSettings* vertex_buffer_settings,
+    DivisionVertexBufferSize capacity,
+    uint32_t* out_vertex_buffer_id
+)
 {
     DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
 
@@ -89,7 +351,9 @@ bool division_engine_vertex_buffer_alloc(
                     vertex_buffer_settings->per_vertex_attribute_count,
                 .per_instance_attribute_count =
                     vertex_buffer_settings->per_instance_attribute_count,
+                .capabilities_mask = vertex_buffer_settings->capabilities_mask,
             },
+        .capacity = capacity,
     };
     vertex_buffer.settings.per_vertex_attributes = NULL;
     vertex_buffer.settings.per_instance_attributes = NULL;
@@ -120,6 +384,20 @@ bool division_engine_vertex_buffer_alloc(
         return false;
     }
 
+    return add_vertex_buffer_(
+        ctx, &vertex_buffer, vertex_buffer_id, out_vertex_buffer_id
+    );
+}
+
+bool add_vertex_buffer_(
+    DivisionContext* ctx,
+    DivisionVertexBuffer* vertex_buffer,
+    uint32_t vertex_buffer_id,
+    uint32_t* out_vertex_buffer_id
+)
+{
+    DivisionVertexBufferSystemContext* vertex_ctx = ctx->vertex_buffer_context;
+
     if (vertex_buffer_id >= vertex_ctx->buffers_count)
     {
         uint32_t new_buffers_count = vertex_buffer_id + 1;
@@ -132,13 +410,13 @@ bool division_engine_vertex_buffer_alloc(
                 ctx, new_buffers_count
             ))
         {
-            free_buffer_data_and_handle_error(ctx, &vertex_buffer, vertex_buffer_id);
+            free_buffer_data_and_handle_error(ctx, vertex_buffer, vertex_buffer_id);
             return false;
         }
     }
 
     *out_vertex_buffer_id = vertex_buffer_id;
-    vertex_ctx->buffers[vertex_buffer_id] = vertex_buffer;
+    vertex_ctx->buffers[vertex_buffer_id] = *vertex_buffer;
     return division_engine_internal_platform_vertex_buffer_impl_init_element(
         ctx, vertex_buffer_id
     );
@@ -168,6 +446,15 @@ void free_buffer_data_and_handle_error(
 }
 
 void division_engine_vertex_buffer_free(DivisionContext* ctx, uint32_t vertex_buffer_id)
+{
+    division_engine_capture_resource_command(
+        ctx, DIVISION_CAPTURE_VERTEX_BUFFER_FREE, vertex_buffer_id
+    );
+    free_vertex_buffer_(ctx, vertex_buffer_id);
+}
+
+// Resizing frees the temporary buffer with it, so the free isn't captured
+void free_vertex_buffer_(DivisionContext* ctx, uint32_t vertex_buffer_id)
 {
     division_engine_internal_platform_vertex_buffer_free(ctx, vertex_buffer_id);
     DivisionVertexBuffer* vb = &ctx->vertex_buffer_context->buffers[vertex_buffer_id];
@@ -211,6 +498,14 @@ void division_engine_vertex_buffer_return_data(
     DivisionVertexBufferBorrowedData* borrow_data
 )
 {
+    division_engine_capture_vertex_buffer_data(
+        ctx,
+        vertex_buffer,
+        &borrow_data->size,
+        borrow_data->vertex_data_ptr,
+        borrow_data->index_data_ptr,
+        borrow_data->instance_data_ptr
+    );
     division_engine_internal_platform_vertex_buffer_return_data_pointer(
         ctx, vertex_buffer, borrow_data
     );
@@ -221,14 +516,61 @@ bool division_engine_vertex_buffer_resize(
 )
 {
     DivisionVertexBufferSystemContext* vb_ctx = ctx->vertex_buffer_context;
-    const DivisionVertexBuffer* src_buffer = &vb_ctx->buffers[vertex_buffer_id];
-    DivisionVertexBufferSettings new_settings = src_buffer->settings;
-    new_settings.size = new_size;
+    DivisionVertexBuffer* src_buffer = &vb_ctx->buffers[vertex_buffer_id];
+    DivisionVertexBufferSize capacity = src_buffer->capacity;
+    bool allow_shrink = DIVISION_MASK_HAS_FLAG(
+        src_buffer->settings.capabilities_mask,
+        DIVISION_VERTEX_BUFFER_CAPABILITY_SHRINK_ON_RESIZE
+    );
 
-    uint32_t new_buffer_id;
-    if (!division_engine_vertex_buffer_alloc(
-            ctx, (DivisionVertexBufferConstSettings*) &new_settings, &new_buffer_id
+    DivisionVertexBufferSize new_capacity = {
+        .vertex_count =
+            calc_capacity_(capacity.vertex_count, new_size.vertex_count, allow_shrink),
+        .index_count =
+            calc_capacity_(capacity.index_count, new_size.index_count, allow_shrink),
+        .instance_count = calc_capacity_(
+            capacity.instance_count, new_size.instance_count, allow_shrink
+        ),
+    };
+
+    if (new_capacity.vertex_count == capacity.vertex_count &&
+        new_capacity.index_count == capacity.index_count &&
+        new_capacity.instance_count == capacity.instance_count)
+    {
+        src_buffer->settings.size = new_size;
+        division_engine_capture_vertex_buffer_resize(ctx, vertex_buffer_id, new_size);
+        return true;
+    }
+
+    // The attributes are copied as is, so buffers with a baked layout keep their offsets
+    uint32_t new_buffer_id = division_unordered_id_table_new_id(&vb_ctx->id_table);
+    DivisionVertexBuffer new_buffer = *src_buffer;
+    new_buffer.settings.size = new_size;
+    new_buffer.capacity = new_capacity;
+    new_buffer.per_vertex_attributes = new_buffer.per_instance_attributes = NULL;
+    new_buffer.settings.per_vertex_attributes = NULL;
+    new_buffer.settings.per_instance_attributes = NULL;
+
+    if (!copy_vert_attrs_(
+            src_buffer->per_vertex_attributes,
+            src_buffer->settings.per_vertex_attributes,
+            src_buffer->settings.per_vertex_attribute_count,
+            &new_buffer.per_vertex_attributes,
+            &new_buffer.settings.per_vertex_attributes
+        ) ||
+        !copy_vert_attrs_(
+            src_buffer->per_instance_attributes,
+            src_buffer->settings.per_instance_attributes,
+            src_buffer->settings.per_instance_attribute_count,
+            &new_buffer.per_instance_attributes,
+            &new_buffer.settings.per_instance_attributes
         ))
+    {
+        free_buffer_data_and_handle_error(ctx, &new_buffer, new_buffer_id);
+        return false;
+    }
+
+    if (!add_vertex_buffer_(ctx, &new_buffer, new_buffer_id, &new_buffer_id))
     {
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Failed to resize vertex buffer");
         return false;
@@ -246,11 +588,29 @@ bool division_engine_vertex_buffer_resize(
     division_engine_internal_platform_vertex_buffer_swap_data(
         ctx, vertex_buffer_id, new_buffer_id
     );
-    division_engine_vertex_buffer_free(ctx, new_buffer_id);
+    free_vertex_buffer_(ctx, new_buffer_id);
 
+    division_engine_capture_vertex_buffer_resize(ctx, vertex_buffer_id, new_size);
     return true;
 }
 
+uint32_t calc_capacity_(uint32_t capacity, uint32_t size, bool allow_shrink)
+{
+    if (size > capacity)
+    {
+        uint64_t grown = (uint64_t) capacity * DIVISION_VERTEX_BUFFER_GROWTH_FACTOR;
+        return (uint32_t) DIVISION_MIN(DIVISION_MAX(grown, size), UINT32_MAX);
+    }
+
+    if (allow_shrink &&
+        (uint64_t) size * DIVISION_VERTEX_BUFFER_SHRINK_THRESHOLD < capacity)
+    {
+        return size * DIVISION_VERTEX_BUFFER_GROWTH_FACTOR;
+    }
+
+    return capacity;
+}
+
 bool alloc_vert_attrs_(
     DivisionContext* ctx,
     const DivisionVertexAttributeSettings* input_attribute_settings,
@@ -309,6 +669,105 @@ bool alloc_vert_attrs_(
     return true;
 }
 
+bool alloc_layout_attrs_(
+    DivisionContext* ctx,
+    const DivisionVertexLayout* layout,
+    DivisionVertexAttribute** output_attributes,
+    DivisionVertexAttributeSettings** output_settings,
+    int32_t* output_attr_count,
+    size_t* output_all_attributes_data_size
+)
+{
+    *output_attributes = NULL;
+    *output_settings = NULL;
+    *output_attr_count = 0;
+    *output_all_attributes_data_size = 0;
+
+    if (layout == NULL || layout->attribute_count <= 0)
+    {
+        return true;
+    }
+
+    int32_t attr_count = layout->attribute_count;
+    DivisionVertexAttribute* attrs = malloc(sizeof(DivisionVertexAttribute[attr_count]));
+    DivisionVertexAttributeSettings* attr_settings =
+        malloc(sizeof(DivisionVertexAttributeSettings[attr_count]));
+
+    if (attrs == NULL || attr_settings == NULL)
+    {
+        free(attrs);
+        free(attr_settings);
+
+        return false;
+    }
+
+    // The offsets are baked already, only check that they are inside of the stride
+    // and that the sizes are the ones of the attribute type
+    for (int32_t i = 0; i < attr_count; i++)
+    {
+        const DivisionVertexLayoutAttribute* layout_attr = &layout->attributes[i];
+        const DivisionVertexAttribute* at = &layout_attr->attribute;
+        AttrTraits_ attr_traits =
+            division_attribute_get_traits(ctx, layout_attr->settings.type);
+
+        if (at->base_size != attr_traits.base_size ||
+            at->component_count != attr_traits.component_count || at->offset < 0 ||
+            at->offset + at->base_size * at->component_count > layout->stride)
+        {
+            free(attrs);
+            free(attr_settings);
+
+            return false;
+        }
+
+        attrs[i] = *at;
+        attr_settings[i] = layout_attr->settings;
+    }
+
+    *output_attributes = attrs;
+    *output_settings = attr_settings;
+    *output_attr_count = attr_count;
+    *output_all_attributes_data_size = (size_t) layout->stride;
+    return true;
+}
+
+bool copy_vert_attrs_(
+    const DivisionVertexAttribute* input_attributes,
+    const DivisionVertexAttributeSettings* input_attribute_settings,
+    int32_t attr_count,
+    DivisionVertexAttribute** output_attributes,
+    DivisionVertexAttributeSettings** output_settings
+)
+{
+    *output_attributes = NULL;
+    *output_settings = NULL;
+
+    if (attr_count <= 0)
+    {
+        return true;
+    }
+
+    const size_t attrs_bytes = sizeof(DivisionVertexAttribute[attr_count]);
+    const size_t settings_bytes = sizeof(DivisionVertexAttributeSettings[attr_count]);
+    DivisionVertexAttribute* attrs = malloc(attrs_bytes);
+    DivisionVertexAttributeSettings* attr_settings = malloc(settings_bytes);
+
+    if (attrs == NULL || attr_settings == NULL)
+    {
+        free(attrs);
+        free(attr_settings);
+
+        return false;
+    }
+
+    memcpy(attrs, input_attributes, attrs_bytes);
+    memcpy(attr_settings, input_attribute_settings, settings_bytes);
+
+    *output_attributes = attrs;
+    *output_settings = attr_settings;
+    return true;
+}
+
 AttrTraits_ division_attribute_get_traits(
     DivisionContext* ctx, DivisionShaderVariableType attributeType
 )
@@ -329,6 +788,21 @@ AttrTraits_ division_attribute_get_traits(
         return (AttrTraits_){4, 4};
     case DIVISION_FMAT4X4:
         return (AttrTraits_){4, 16};
+    case DIVISION_HVEC2:
+        return (AttrTraits_){2, 2};
+    case DIVISION_HVEC4:
+        return (AttrTraits_){2, 4};
+    case DIVISION_UBYTE4_NORM:
+    case DIVISION_BYTE4_NORM:
+        return (AttrTraits_){1, 4};
+    case DIVISION_USHORT2_NORM:
+    case DIVISION_SHORT2_NORM:
+        return (AttrTraits_){2, 2};
+    case DIVISION_USHORT4_NORM:
+    case DIVISION_SHORT4_NORM:
+        return (AttrTraits_){2, 4};
+    case DIVISION_INT_2_10_10_10_REV_NORM:
+        return (AttrTraits_){4, 1};
     default: {
         DIVISION_THROW_INTERNAL_ERROR(ctx, "Unknown attribute type");
     }
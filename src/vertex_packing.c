@@ -0,0 +1,627 @@
+#include "division_engine_core/vertex_packing.h"
+
+#include <float.h>
+#include <math.h>
+#include <memory.h>
+#include <stdbool.h>
+
+#if defined(__AVX2__) && defined(__F16C__)
+#define DIVISION_PACKING_AVX2
+#define DIVISION_PACKING_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define DIVISION_PACKING_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define DIVISION_PACKING_NEON
+#include <arm_neon.h>
+#endif
+
+#define SNORM16_SCALE 32767.0f
+#define UNORM8_SCALE 255.0f
+
+static inline uint32_t float_bits_(float f);
+static inline float bits_float_(uint32_t u);
+static inline uint16_t float_to_half_(float f);
+static inline int16_t float_to_snorm16_(float f);
+static inline uint8_t float_to_unorm8_(float f);
+static inline void normal_to_octahedral_(const float* normal, int16_t* out);
+
+static inline bool is_packed_(
+    size_t dst_stride, size_t dst_size, size_t src_stride, size_t components
+);
+static size_t pack_half_simd_(uint16_t* dst, const float* src, size_t count);
+static size_t pack_snorm16_simd_(int16_t* dst, const float* src, size_t count);
+static size_t pack_unorm8_simd_(uint8_t* dst, const float* src, size_t count);
+static size_t pack_normal_octahedral_simd_(int16_t* dst, const float* src, size_t count);
+
+const char* division_vertex_packing_simd_name(void)
+{
+#if defined(DIVISION_PACKING_AVX2)
+    return "avx2";
+#elif defined(DIVISION_PACKING_SSE2)
+    return "sse2";
+#elif defined(DIVISION_PACKING_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void division_vertex_pack_half(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    if (is_packed_(dst_stride, sizeof(uint16_t), src_stride, components))
+    {
+        size_t value_count = count * components;
+        size_t done = pack_half_simd_(dst, src, value_count);
+        division_vertex_pack_half_scalar(
+            (uint16_t*) dst + done,
+            sizeof(uint16_t),
+            src + done,
+            sizeof(float),
+            value_count - done,
+            1
+        );
+        return;
+    }
+
+    division_vertex_pack_half_scalar(dst, dst_stride, src, src_stride, count, components);
+}
+
+void division_vertex_pack_snorm16(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    if (is_packed_(dst_stride, sizeof(int16_t), src_stride, components))
+    {
+        size_t value_count = count * components;
+        size_t done = pack_snorm16_simd_(dst, src, value_count);
+        division_vertex_pack_snorm16_scalar(
+            (int16_t*) dst + done,
+            sizeof(int16_t),
+            src + done,
+            sizeof(float),
+            value_count - done,
+            1
+        );
+        return;
+    }
+
+    division_vertex_pack_snorm16_scalar(
+        dst, dst_stride, src, src_stride, count, components
+    );
+}
+
+void division_vertex_pack_unorm8(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    if (is_packed_(dst_stride, sizeof(uint8_t), src_stride, components))
+    {
+        size_t value_count = count * components;
+        size_t done = pack_unorm8_simd_(dst, src, value_count);
+        division_vertex_pack_unorm8_scalar(
+            (uint8_t*) dst + done,
+            sizeof(uint8_t),
+            src + done,
+            sizeof(float),
+            value_count - done,
+            1
+        );
+        return;
+    }
+
+    division_vertex_pack_unorm8_scalar(
+        dst, dst_stride, src, src_stride, count, components
+    );
+}
+
+void division_vertex_pack_normal_octahedral(
+    void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+)
+{
+    if (dst_stride == sizeof(int16_t[2]) && src_stride == sizeof(float[3]))
+    {
+        size_t done = pack_normal_octahedral_simd_(dst, src, count);
+        division_vertex_pack_normal_octahedral_scalar(
+            (int16_t*) dst + done * 2,
+            dst_stride,
+            src + done * 3,
+            src_stride,
+            count - done
+        );
+        return;
+    }
+
+    division_vertex_pack_normal_octahedral_scalar(
+        dst, dst_stride, src, src_stride, count
+    );
+}
+
+void division_vertex_pack_color_rgba8(
+    void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+)
+{
+    division_vertex_pack_unorm8(dst, dst_stride, src, src_stride, count, 4);
+}
+
+void division_vertex_pack_half_scalar(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* src_elem = (const float*) ((const uint8_t*) src + i * src_stride);
+        uint16_t* dst_elem = (uint16_t*) ((uint8_t*) dst + i * dst_stride);
+
+        for (size_t c = 0; c < components; c++)
+        {
+            dst_elem[c] = float_to_half_(src_elem[c]);
+        }
+    }
+}
+
+void division_vertex_pack_snorm16_scalar(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* src_elem = (const float*) ((const uint8_t*) src + i * src_stride);
+        int16_t* dst_elem = (int16_t*) ((uint8_t*) dst + i * dst_stride);
+
+        for (size_t c = 0; c < components; c++)
+        {
+            dst_elem[c] = float_to_snorm16_(src_elem[c]);
+        }
+    }
+}
+
+void division_vertex_pack_unorm8_scalar(
+    void* dst,
+    size_t dst_stride,
+    const float* src,
+    size_t src_stride,
+    size_t count,
+    size_t components
+)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* src_elem = (const float*) ((const uint8_t*) src + i * src_stride);
+        uint8_t* dst_elem = (uint8_t*) dst + i * dst_stride;
+
+        for (size_t c = 0; c < components; c++)
+        {
+            dst_elem[c] = float_to_unorm8_(src_elem[c]);
+        }
+    }
+}
+
+void division_vertex_pack_normal_octahedral_scalar(
+    void* dst, size_t dst_stride, const float* src, size_t src_stride, size_t count
+)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* src_elem = (const float*) ((const uint8_t*) src + i * src_stride);
+        int16_t* dst_elem = (int16_t*) ((uint8_t*) dst + i * dst_stride);
+
+        normal_to_octahedral_(src_elem, dst_elem);
+    }
+}
+
+uint32_t float_bits_(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float bits_float_(uint32_t u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+uint16_t float_to_half_(float f)
+{
+    uint32_t x = float_bits_(f);
+    uint32_t sign = (x >> 16) & 0x8000;
+    uint32_t abs = x & 0x7FFFFFFF;
+
+    // NaN keeps the truncated payload and becomes quiet
+    if (abs > 0x7F800000)
+    {
+        return (uint16_t) (sign | 0x7E00 | ((abs >> 13) & 0x3FF));
+    }
+
+    // Everything from 65520 rounds to infinity
+    if (abs >= 0x477FF000)
+    {
+        return (uint16_t) (sign | 0x7C00);
+    }
+
+    // Half subnormals. Adding 0.5 aligns the mantissa, the fpu does the rounding
+    if (abs < 0x38800000)
+    {
+        float aligned = bits_float_(abs) + 0.5f;
+        return (uint16_t) (sign | (float_bits_(aligned) - 0x3F000000));
+    }
+
+    // Rebias the exponent and round the mantissa to the nearest even
+    uint32_t mantissa_odd = (abs >> 13) & 1;
+    return (uint16_t) (sign | ((abs + 0xC8000FFF + mantissa_odd) >> 13));
+}
+
+int16_t float_to_snorm16_(float f)
+{
+    f = f > -1.0f ? f : -1.0f;
+    f = f < 1.0f ? f : 1.0f;
+    return (int16_t) lrintf(f * SNORM16_SCALE);
+}
+
+uint8_t float_to_unorm8_(float f)
+{
+    f = f > 0.0f ? f : 0.0f;
+    f = f < 1.0f ? f : 1.0f;
+    return (uint8_t) lrintf(f * UNORM8_SCALE);
+}
+
+void normal_to_octahedral_(const float* normal, int16_t* out)
+{
+    float x = normal[0], y = normal[1], z = normal[2];
+    float l1 = fabsf(x) + fabsf(y) + fabsf(z);
+    l1 = l1 > FLT_MIN ? l1 : FLT_MIN;
+
+    float ox = x / l1;
+    float oy = y / l1;
+
+    if (z < 0.0f)
+    {
+        float sign_x = ox >= 0.0f ? 1.0f : -1.0f;
+        float sign_y = oy >= 0.0f ? 1.0f : -1.0f;
+        float fold_x = (1.0f - fabsf(oy)) * sign_x;
+        float fold_y = (1.0f - fabsf(ox)) * sign_y;
+        ox = fold_x;
+        oy = fold_y;
+    }
+
+    out[0] = float_to_snorm16_(ox);
+    out[1] = float_to_snorm16_(oy);
+}
+
+bool is_packed_(size_t dst_stride, size_t dst_size, size_t src_stride, size_t components)
+{
+    return dst_stride == dst_size * components &&
+           src_stride == sizeof(float) * components;
+}
+
+#if defined(DIVISION_PACKING_SSE2)
+
+static inline __m128 select_ps_(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128i select_si128_(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// The same steps as float_to_half_, results are in the low 16 bits of each lane
+static inline __m128i float_to_half_sse2_(__m128 v)
+{
+    __m128i x = _mm_castps_si128(v);
+    __m128i sign = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x8000));
+    __m128i abs = _mm_and_si128(x, _mm_set1_epi32(0x7FFFFFFF));
+    __m128i mantissa = _mm_srli_epi32(abs, 13);
+
+    __m128i nan_result = _mm_or_si128(
+        _mm_set1_epi32(0x7E00), _mm_and_si128(mantissa, _mm_set1_epi32(0x3FF))
+    );
+    __m128i aligned =
+        _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(abs), _mm_set1_ps(0.5f)));
+    __m128i subnormal_result = _mm_sub_epi32(aligned, _mm_set1_epi32(0x3F000000));
+    __m128i mantissa_odd = _mm_and_si128(mantissa, _mm_set1_epi32(1));
+    __m128i normal_result = _mm_srli_epi32(
+        _mm_add_epi32(_mm_add_epi32(abs, _mm_set1_epi32((int) 0xC8000FFF)), mantissa_odd),
+        13
+    );
+
+    __m128i is_nan = _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x7F800000));
+    __m128i is_inf = _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x477FEFFF));
+    __m128i is_subnormal = _mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000));
+
+    __m128i result = select_si128_(is_subnormal, subnormal_result, normal_result);
+    result = select_si128_(is_inf, _mm_set1_epi32(0x7C00), result);
+    result = select_si128_(is_nan, nan_result, result);
+
+    return _mm_or_si128(result, sign);
+}
+
+// Packs the low 16 bits of the lanes without saturation
+static inline __m128i pack_low_u16_sse2_(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+static inline __m128i float_to_snorm16_sse2_(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_set1_ps(-1.0f));
+    v = _mm_min_ps(v, _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(SNORM16_SCALE)));
+}
+
+static inline __m128i float_to_unorm8_sse2_(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_setzero_ps());
+    v = _mm_min_ps(v, _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(UNORM8_SCALE)));
+}
+
+size_t pack_half_simd_(uint16_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+#if defined(DIVISION_PACKING_AVX2)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half =
+            _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*) (dst + i), half);
+    }
+#endif
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = float_to_half_sse2_(_mm_loadu_ps(src + i));
+        __m128i hi = float_to_half_sse2_(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128((__m128i*) (dst + i), pack_low_u16_sse2_(lo, hi));
+    }
+
+    return i;
+}
+
+size_t pack_snorm16_simd_(int16_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+#if defined(DIVISION_PACKING_AVX2)
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256 scale = _mm256_set1_ps(SNORM16_SCALE);
+        __m256 lower = _mm256_set1_ps(-1.0f);
+        __m256 upper = _mm256_set1_ps(1.0f);
+        __m256 lo = _mm256_loadu_ps(src + i);
+        __m256 hi = _mm256_loadu_ps(src + i + 8);
+        lo = _mm256_min_ps(_mm256_max_ps(lo, lower), upper);
+        hi = _mm256_min_ps(_mm256_max_ps(hi, lower), upper);
+
+        __m256i packed = _mm256_packs_epi32(
+            _mm256_cvtps_epi32(_mm256_mul_ps(lo, scale)),
+            _mm256_cvtps_epi32(_mm256_mul_ps(hi, scale))
+        );
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*) (dst + i), packed);
+    }
+#endif
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = float_to_snorm16_sse2_(_mm_loadu_ps(src + i));
+        __m128i hi = float_to_snorm16_sse2_(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_packs_epi32(lo, hi));
+    }
+
+    return i;
+}
+
+size_t pack_unorm8_simd_(uint8_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = float_to_unorm8_sse2_(_mm_loadu_ps(src + i));
+        __m128i b = float_to_unorm8_sse2_(_mm_loadu_ps(src + i + 4));
+        __m128i c = float_to_unorm8_sse2_(_mm_loadu_ps(src + i + 8));
+        __m128i d = float_to_unorm8_sse2_(_mm_loadu_ps(src + i + 12));
+
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128((__m128i*) (dst + i), packed);
+    }
+
+    return i;
+}
+
+size_t pack_normal_octahedral_simd_(int16_t* dst, const float* src, size_t count)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* s = src + i * 3;
+        __m128 x = _mm_setr_ps(s[0], s[3], s[6], s[9]);
+        __m128 y = _mm_setr_ps(s[1], s[4], s[7], s[10]);
+        __m128 z = _mm_setr_ps(s[2], s[5], s[8], s[11]);
+
+        __m128 l1 = _mm_add_ps(
+            _mm_add_ps(_mm_and_ps(x, abs_mask), _mm_and_ps(y, abs_mask)),
+            _mm_and_ps(z, abs_mask)
+        );
+        l1 = _mm_max_ps(l1, _mm_set1_ps(FLT_MIN));
+
+        __m128 ox = _mm_div_ps(x, l1);
+        __m128 oy = _mm_div_ps(y, l1);
+
+        __m128 sign_x = select_ps_(_mm_cmpge_ps(ox, zero), one, minus_one);
+        __m128 sign_y = select_ps_(_mm_cmpge_ps(oy, zero), one, minus_one);
+        __m128 fold_x = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(oy, abs_mask)), sign_x);
+        __m128 fold_y = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(ox, abs_mask)), sign_y);
+
+        __m128 lower_hemisphere = _mm_cmplt_ps(z, zero);
+        ox = select_ps_(lower_hemisphere, fold_x, ox);
+        oy = select_ps_(lower_hemisphere, fold_y, oy);
+
+        __m128i packed =
+            _mm_packs_epi32(float_to_snorm16_sse2_(ox), float_to_snorm16_sse2_(oy));
+        __m128i interleaved = _mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8));
+        _mm_storeu_si128((__m128i*) (dst + i * 2), interleaved);
+    }
+
+    return i;
+}
+
+#elif defined(DIVISION_PACKING_NEON)
+
+// vmaxq/vminq propagate NaN, the selects clamp it like the scalar code does
+static inline float32x4_t clamp_neon_(float32x4_t v, float lo, float hi)
+{
+    float32x4_t lo_v = vdupq_n_f32(lo);
+    float32x4_t hi_v = vdupq_n_f32(hi);
+    v = vbslq_f32(vcgtq_f32(v, lo_v), v, lo_v);
+    return vbslq_f32(vcltq_f32(v, hi_v), v, hi_v);
+}
+
+static inline int32x4_t float_to_snorm16_neon_(float32x4_t v)
+{
+    return vcvtnq_s32_f32(vmulq_n_f32(clamp_neon_(v, -1.0f, 1.0f), SNORM16_SCALE));
+}
+
+size_t pack_half_simd_(uint16_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        float16x4_t lo = vcvt_f16_f32(vld1q_f32(src + i));
+        float16x4_t hi = vcvt_f16_f32(vld1q_f32(src + i + 4));
+        vst1q_u16(dst + i, vreinterpretq_u16_f16(vcombine_f16(lo, hi)));
+    }
+
+    return i;
+}
+
+size_t pack_snorm16_simd_(int16_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x4_t lo = vqmovn_s32(float_to_snorm16_neon_(vld1q_f32(src + i)));
+        int16x4_t hi = vqmovn_s32(float_to_snorm16_neon_(vld1q_f32(src + i + 4)));
+        vst1q_s16(dst + i, vcombine_s16(lo, hi));
+    }
+
+    return i;
+}
+
+size_t pack_unorm8_simd_(uint8_t* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        float32x4_t lo = clamp_neon_(vld1q_f32(src + i), 0.0f, 1.0f);
+        float32x4_t hi = clamp_neon_(vld1q_f32(src + i + 4), 0.0f, 1.0f);
+        uint16x4_t lo16 = vqmovn_u32(vcvtnq_u32_f32(vmulq_n_f32(lo, UNORM8_SCALE)));
+        uint16x4_t hi16 = vqmovn_u32(vcvtnq_u32_f32(vmulq_n_f32(hi, UNORM8_SCALE)));
+        vst1_u8(dst + i, vqmovn_u16(vcombine_u16(lo16, hi16)));
+    }
+
+    return i;
+}
+
+size_t pack_normal_octahedral_simd_(int16_t* dst, const float* src, size_t count)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4x3_t xyz = vld3q_f32(src + i * 3);
+        float32x4_t x = xyz.val[0], y = xyz.val[1], z = xyz.val[2];
+
+        float32x4_t l1 = vaddq_f32(vaddq_f32(vabsq_f32(x), vabsq_f32(y)), vabsq_f32(z));
+        float32x4_t min_l1 = vdupq_n_f32(FLT_MIN);
+        l1 = vbslq_f32(vcgtq_f32(l1, min_l1), l1, min_l1);
+
+        float32x4_t ox = vdivq_f32(x, l1);
+        float32x4_t oy = vdivq_f32(y, l1);
+
+        float32x4_t sign_x = vbslq_f32(vcgeq_f32(ox, zero), one, minus_one);
+        float32x4_t sign_y = vbslq_f32(vcgeq_f32(oy, zero), one, minus_one);
+        float32x4_t fold_x = vmulq_f32(vsubq_f32(one, vabsq_f32(oy)), sign_x);
+        float32x4_t fold_y = vmulq_f32(vsubq_f32(one, vabsq_f32(ox)), sign_y);
+
+        uint32x4_t lower_hemisphere = vcltq_f32(z, zero);
+        ox = vbslq_f32(lower_hemisphere, fold_x, ox);
+        oy = vbslq_f32(lower_hemisphere, fold_y, oy);
+
+        int16x4x2_t packed = {{
+            vqmovn_s32(float_to_snorm16_neon_(ox)),
+            vqmovn_s32(float_to_snorm16_neon_(oy)),
+        }};
+        vst2_s16(dst + i * 2, packed);
+    }
+
+    return i;
+}
+
+#else
+
+size_t pack_half_simd_(uint16_t* dst, const float* src, size_t count)
+{
+    return 0;
+}
+
+size_t pack_snorm16_simd_(int16_t* dst, const float* src, size_t count)
+{
+    return 0;
+}
+
+size_t pack_unorm8_simd_(uint8_t* dst, const float* src, size_t count)
+{
+    return 0;
+}
+
+size_t pack_normal_octahedral_simd_(int16_t* dst, const float* src, size_t count)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,218 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/command_list.h"
+
+#include <cstring>
+
+static DivisionCommandDrawRange make_draw_range(uint32_t first_vertex)
+{
+    DivisionCommandDrawRange range;
+    range.first_vertex = first_vertex;
+    range.first_instance = 0;
+    range.vertex_count = 3;
+    range.index_count = 0;
+    range.instance_count = 0;
+    range.capabilities_mask = DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NONE;
+
+    return range;
+}
+
+static const DivisionIdWithBinding* get_bindings(
+    const DivisionCommandList* list, const DivisionCommandDraw* draw
+)
+{
+    return (const DivisionIdWithBinding*) (list->data + draw->bindings_offset);
+}
+
+TEST_CASE("Command list records draws with the current bindings")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 4, 64));
+
+    DivisionCommandDrawRange range = make_draw_range(0);
+    REQUIRE_FALSE(division_command_list_draw(&list, &range));
+
+    division_command_list_bind_render_pass_descriptor(&list, 3);
+    REQUIRE(division_command_list_bind_uniform_vertex_buffer(&list, {10, 0}));
+    REQUIRE(division_command_list_bind_uniform_fragment_buffer(&list, {11, 1}));
+    REQUIRE(division_command_list_bind_fragment_texture(&list, {12, 2}));
+    REQUIRE(division_command_list_draw(&list, &range));
+
+    REQUIRE(list.command_count == 1);
+    REQUIRE(list.draw_count == 1);
+
+    const DivisionCommandDraw* draw = &list.commands[0].draw;
+    REQUIRE(list.commands[0].type == DIVISION_COMMAND_DRAW);
+    REQUIRE(draw->render_pass_descriptor_id == 3);
+    REQUIRE(draw->uniform_vertex_buffer_count == 1);
+    REQUIRE(draw->uniform_fragment_buffer_count == 1);
+    REQUIRE(draw->fragment_texture_count == 1);
+
+    const DivisionIdWithBinding* bindings = get_bindings(&list, draw);
+    REQUIRE(bindings[0].id == 10);
+    REQUIRE(bindings[1].id == 11);
+    REQUIRE(bindings[2].id == 12);
+    REQUIRE(bindings[2].shader_location == 2);
+
+    division_command_list_free(&list);
+}
+
+TEST_CASE("Command list draws share the bindings until they change")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 4, 64));
+    division_command_list_bind_render_pass_descriptor(&list, 0);
+    REQUIRE(division_command_list_bind_fragment_texture(&list, {1, 0}));
+
+    DivisionCommandDrawRange first = make_draw_range(0);
+    DivisionCommandDrawRange second = make_draw_range(3);
+    REQUIRE(division_command_list_draw(&list, &first));
+    REQUIRE(division_command_list_draw(&list, &second));
+
+    // Rebinding the same location replaces the texture
+    REQUIRE(division_command_list_bind_fragment_texture(&list, {2, 0}));
+    REQUIRE(division_command_list_draw(&list, &first));
+
+    const DivisionCommandDraw* draws[] = {
+        &list.commands[0].draw, &list.commands[1].draw, &list.commands[2].draw
+    };
+    REQUIRE(draws[0]->bindings_offset == draws[1]->bindings_offset);
+    REQUIRE(draws[1]->range.first_vertex == 3);
+    REQUIRE(draws[2]->bindings_offset != draws[1]->bindings_offset);
+    REQUIRE(draws[2]->fragment_texture_count == 1);
+    REQUIRE(get_bindings(&list, draws[0])[0].id == 1);
+    REQUIRE(get_bindings(&list, draws[2])[0].id == 2);
+
+    division_command_list_clear_bindings(&list);
+    REQUIRE(division_command_list_draw(&list, &first));
+    REQUIRE(list.commands[3].draw.fragment_texture_count == 0);
+    REQUIRE(list.commands[3].draw.render_pass_descriptor_id == 0);
+
+    division_command_list_free(&list);
+}
+
+TEST_CASE("Command list limits the count of bindings")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 0, 0));
+
+    for (uint32_t i = 0; i < DIVISION_COMMAND_LIST_MAX_BINDINGS; i++)
+    {
+        REQUIRE(division_command_list_bind_uniform_vertex_buffer(&list, {i, i}));
+    }
+    REQUIRE_FALSE(division_command_list_bind_uniform_vertex_buffer(&list, {0, 100}));
+    REQUIRE(division_command_list_bind_uniform_vertex_buffer(&list, {7, 0}));
+
+    division_command_list_free(&list);
+}
+
+TEST_CASE("Command list stores the copied data")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 0, 0));
+
+    float uniform_data[] = {1, 2, 3, 4};
+    uint8_t vertex_data[] = {5, 6, 7};
+    REQUIRE(division_command_list_set_uniform_data(
+        &list, 4, 16, uniform_data, sizeof(uniform_data)
+    ));
+    REQUIRE(division_command_list_copy(
+        &list, DIVISION_UPLOAD_TARGET_VERTEX_DATA, 2, 0, vertex_data, sizeof(vertex_data)
+    ));
+    uniform_data[0] = 100;
+
+    REQUIRE(list.command_count == 2);
+    REQUIRE(list.draw_count == 0);
+
+    const DivisionCommandCopy* uniform_copy = &list.commands[0].copy;
+    REQUIRE(list.commands[0].type == DIVISION_COMMAND_COPY);
+    REQUIRE(uniform_copy->target == DIVISION_UPLOAD_TARGET_UNIFORM_BUFFER);
+    REQUIRE(uniform_copy->resource_id == 4);
+    REQUIRE(uniform_copy->dst_offset == 16);
+    REQUIRE(uniform_copy->size == sizeof(uniform_data));
+    REQUIRE(((const float*) (list.data + uniform_copy->data_offset))[0] == 1);
+
+    const DivisionCommandCopy* vertex_copy = &list.commands[1].copy;
+    REQUIRE(vertex_copy->data_offset % DIVISION_COMMAND_LIST_DATA_ALIGNMENT == 0);
+    REQUIRE(memcmp(list.data + vertex_copy->data_offset, vertex_data, 3) == 0);
+
+    REQUIRE_FALSE(division_command_list_set_uniform_data(&list, 4, 0, NULL, 16));
+    REQUIRE(division_command_list_set_uniform_data(&list, 4, 0, NULL, 0));
+    REQUIRE(list.command_count == 3);
+
+    division_command_list_free(&list);
+}
+
+TEST_CASE("Command list keeps its memory after a reset")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 0, 0));
+    float data[16] = {};
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+        division_command_list_reset(&list);
+        division_command_list_bind_render_pass_descriptor(&list, 1);
+
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            DivisionCommandDrawRange range = make_draw_range(i);
+            REQUIRE(division_command_list_bind_uniform_vertex_buffer(&list, {i, 0}));
+            REQUIRE(division_command_list_set_uniform_data(&list, i, 0, data, sizeof(data)));
+            REQUIRE(division_command_list_draw(&list, &range));
+        }
+
+        REQUIRE(list.command_count == 200);
+        REQUIRE(list.draw_count == 100);
+    }
+
+    const DivisionCommand* commands = list.commands;
+    const uint8_t* list_data = list.data;
+    size_t data_size = list.data_size;
+
+    division_command_list_reset(&list);
+    REQUIRE(list.command_count == 0);
+    REQUIRE(list.data_size == 0);
+    REQUIRE(list.render_pass_descriptor_id == DIVISION_COMMAND_LIST_NO_DESCRIPTOR);
+
+    division_command_list_bind_render_pass_descriptor(&list, 1);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        DivisionCommandDrawRange range = make_draw_range(i);
+        REQUIRE(division_command_list_bind_uniform_vertex_buffer(&list, {i, 0}));
+        REQUIRE(division_command_list_set_uniform_data(&list, i, 0, data, sizeof(data)));
+        REQUIRE(division_command_list_draw(&list, &range));
+    }
+
+    REQUIRE(list.commands == commands);
+    REQUIRE(list.data == list_data);
+    REQUIRE(list.data_size == data_size);
+
+    division_command_list_free(&list);
+}
+
+TEST_CASE("Command list draws take the bound binding group")
+{
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 4, 64));
+    division_command_list_bind_render_pass_descriptor(&list, 0);
+    division_command_list_bind_binding_group(&list, 5);
+
+    DivisionCommandDrawRange range = make_draw_range(0);
+    REQUIRE(division_command_list_draw(&list, &range));
+    division_command_list_clear_bindings(&list);
+    REQUIRE(division_command_list_draw(&list, &range));
+
+    const DivisionCommandDraw* group_draw = &list.commands[0].draw;
+    REQUIRE(group_draw->binding_group_id == 5);
+    REQUIRE(
+        (group_draw->range.capabilities_mask &
+         DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP) != 0
+    );
+    REQUIRE(
+        (list.commands[1].draw.range.capabilities_mask &
+         DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP) == 0
+    );
+
+    division_command_list_free(&list);
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/dirty_rects.h"
+
+#define FRAME_SIZE 100
+
+static DivisionDirtyRect make_rect(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    return DivisionDirtyRect{x, y, width, height};
+}
+
+static void add(DivisionDirtyRect* rects, uint32_t* count, DivisionDirtyRect rect)
+{
+    division_dirty_rects_add(rects, count, rect, FRAME_SIZE, FRAME_SIZE);
+}
+
+TEST_CASE("Dirty rects are clipped by the frame")
+{
+    DivisionDirtyRect rects[DIVISION_DIRTY_RECT_CAPACITY];
+    uint32_t count = 0;
+
+    add(rects, &count, make_rect(-10, 90, 20, 20));
+    add(rects, &count, make_rect(100, 0, 10, 10));
+    add(rects, &count, make_rect(5, 5, 0, 10));
+
+    REQUIRE(count == 1);
+    REQUIRE(rects[0].x == 0);
+    REQUIRE(rects[0].y == 90);
+    REQUIRE(rects[0].width == 10);
+    REQUIRE(rects[0].height == 10);
+}
+
+TEST_CASE("Overlapping dirty rects are merged into their bounds")
+{
+    DivisionDirtyRect rects[DIVISION_DIRTY_RECT_CAPACITY];
+    uint32_t count = 0;
+
+    add(rects, &count, make_rect(0, 0, 10, 10));
+    add(rects, &count, make_rect(12, 8, 10, 10));
+    REQUIRE(count == 2);
+
+    // Bounds of the bridge and the first rect overlap the second one too
+    add(rects, &count, make_rect(5, 5, 8, 2));
+    REQUIRE(count == 1);
+    REQUIRE(rects[0].x == 0);
+    REQUIRE(rects[0].y == 0);
+    REQUIRE(rects[0].width == 22);
+    REQUIRE(rects[0].height == 18);
+
+    // Touching rects stay apart, so no pixels are added
+    add(rects, &count, make_rect(22, 0, 5, 5));
+    REQUIRE(count == 2);
+    REQUIRE(division_dirty_rects_area(rects, count) == 22 * 18 + 25);
+}
+
+TEST_CASE("Full dirty rect set merges the nearest rects")
+{
+    DivisionDirtyRect rects[DIVISION_DIRTY_RECT_CAPACITY];
+    uint32_t count = 0;
+
+    for (int32_t i = 0; i < DIVISION_DIRTY_RECT_CAPACITY; i++)
+    {
+        add(rects, &count, make_rect(i * 12, 0, 2, 2));
+    }
+    REQUIRE(count == DIVISION_DIRTY_RECT_CAPACITY);
+
+    add(rects, &count, make_rect(0, 3, 2, 2));
+    REQUIRE(count == DIVISION_DIRTY_RECT_CAPACITY);
+    // The new rect is joined with the one below it, the others are left as they are
+    uint64_t other_area = (DIVISION_DIRTY_RECT_CAPACITY - 1) * 4;
+    REQUIRE(division_dirty_rects_area(rects, count) == 10 + other_area);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        for (uint32_t j = i + 1; j < count; j++)
+        {
+            bool disjoint = rects[i].x + rects[i].width <= rects[j].x ||
+                            rects[j].x + rects[j].width <= rects[i].x ||
+                            rects[i].y + rects[i].height <= rects[j].y ||
+                            rects[j].y + rects[j].height <= rects[i].y;
+            REQUIRE(disjoint);
+        }
+    }
+}
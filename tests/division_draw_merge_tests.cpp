@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/render_pass_instance.h"
+
+static DivisionRenderPassInstance make_instance(
+    uint32_t first_vertex, uint32_t vertex_count, uint32_t first_instance, uint32_t count
+)
+{
+    DivisionRenderPassInstance instance = {};
+    instance.first_vertex = first_vertex;
+    instance.vertex_count = vertex_count;
+    instance.first_instance = first_instance;
+    instance.instance_count = count;
+    instance.capabilities_mask =
+        count > 0 ? DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_INSTANCED_RENDERING
+                  : DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NONE;
+
+    return instance;
+}
+
+TEST_CASE("Adjacent instance ranges are merged")
+{
+    DivisionRenderPassInstance merged = make_instance(0, 6, 0, 10);
+    DivisionRenderPassInstance next = make_instance(0, 6, 10, 5);
+    merged.index_count = next.index_count = 6;
+
+    REQUIRE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &next, DIVISION_TOPOLOGY_TRIANGLES, true
+    ));
+    REQUIRE(merged.first_instance == 0);
+    REQUIRE(merged.instance_count == 15);
+
+    DivisionRenderPassInstance gap = make_instance(0, 6, 16, 1);
+    DivisionRenderPassInstance other_mesh = make_instance(6, 6, 15, 1);
+    gap.index_count = other_mesh.index_count = 6;
+
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &gap, DIVISION_TOPOLOGY_TRIANGLES, true
+    ));
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &other_mesh, DIVISION_TOPOLOGY_TRIANGLES, true
+    ));
+    REQUIRE(merged.instance_count == 15);
+}
+
+TEST_CASE("Adjacent vertex ranges of list topologies are merged")
+{
+    DivisionRenderPassInstance merged = make_instance(0, 6, 0, 0);
+    DivisionRenderPassInstance next = make_instance(6, 3, 0, 0);
+
+    REQUIRE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &next, DIVISION_TOPOLOGY_TRIANGLES, false
+    ));
+    REQUIRE(merged.first_vertex == 0);
+    REQUIRE(merged.vertex_count == 9);
+
+    // Strips would connect the ranges with extra primitives
+    DivisionRenderPassInstance strip = make_instance(0, 4, 0, 0);
+    DivisionRenderPassInstance next_strip = make_instance(4, 4, 0, 0);
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &strip, &next_strip, DIVISION_TOPOLOGY_TRIANGLE_STRIP, false
+    ));
+
+    // Index ranges always start at the first index
+    DivisionRenderPassInstance indexed = make_instance(0, 6, 0, 0);
+    DivisionRenderPassInstance next_indexed = make_instance(6, 6, 0, 0);
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &indexed, &next_indexed, DIVISION_TOPOLOGY_TRIANGLES, true
+    ));
+}
+
+TEST_CASE("Vertex ranges are merged only on primitive boundaries")
+{
+    DivisionRenderPassInstance triangles = make_instance(0, 4, 0, 0);
+    DivisionRenderPassInstance next_triangles = make_instance(4, 3, 0, 0);
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &triangles, &next_triangles, DIVISION_TOPOLOGY_TRIANGLES, false
+    ));
+
+    DivisionRenderPassInstance lines = make_instance(0, 4, 0, 0);
+    DivisionRenderPassInstance next_lines = make_instance(4, 3, 0, 0);
+    REQUIRE(division_engine_render_pass_instance_merge_ranges(
+        &lines, &next_lines, DIVISION_TOPOLOGY_LINES, false
+    ));
+    REQUIRE(lines.vertex_count == 7);
+}
+
+TEST_CASE("Instanced vertex ranges are merged with the same instances")
+{
+    DivisionRenderPassInstance merged = make_instance(0, 3, 2, 4);
+    DivisionRenderPassInstance next = make_instance(3, 3, 2, 4);
+    DivisionRenderPassInstance other_instances = make_instance(6, 3, 0, 4);
+
+    REQUIRE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &next, DIVISION_TOPOLOGY_TRIANGLES, false
+    ));
+    REQUIRE(merged.vertex_count == 6);
+    REQUIRE(merged.instance_count == 4);
+    REQUIRE_FALSE(division_engine_render_pass_instance_merge_ranges(
+        &merged, &other_instances, DIVISION_TOPOLOGY_TRIANGLES, false
+    ));
+}
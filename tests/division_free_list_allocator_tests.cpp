@@ -0,0 +1,92 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/data_structures/free_list_allocator.h"
+
+#define FREE_LIST_CAPACITY 100
+
+TEST_CASE("Free list allocator alloc check")
+{
+    DivisionFreeListAllocator allocator;
+    division_free_list_allocator_alloc(&allocator, FREE_LIST_CAPACITY);
+
+    REQUIRE(allocator.capacity == FREE_LIST_CAPACITY);
+    REQUIRE(allocator.free_ranges_count == 1);
+    REQUIRE(allocator.free_ranges[0].offset == 0);
+    REQUIRE(allocator.free_ranges[0].size == FREE_LIST_CAPACITY);
+    REQUIRE(division_free_list_allocator_is_empty(&allocator));
+
+    division_free_list_allocator_free(&allocator);
+}
+
+TEST_CASE("Free list allocator takes ranges first fit")
+{
+    DivisionFreeListAllocator allocator;
+    division_free_list_allocator_alloc(&allocator, FREE_LIST_CAPACITY);
+
+    uint32_t offset0, offset1, offset2;
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 10, &offset0));
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 20, &offset1));
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 30, &offset2));
+
+    REQUIRE(offset0 == 0);
+    REQUIRE(offset1 == 10);
+    REQUIRE(offset2 == 30);
+    REQUIRE_FALSE(division_free_list_allocator_is_empty(&allocator));
+
+    division_free_list_allocator_free_range(&allocator, offset1, 20);
+
+    uint32_t offset3;
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 15, &offset3));
+    REQUIRE(offset3 == 10);
+
+    uint32_t offset4;
+    REQUIRE_FALSE(division_free_list_allocator_alloc_range(&allocator, 50, &offset4));
+
+    division_free_list_allocator_free(&allocator);
+}
+
+TEST_CASE("Free list allocator merges freed ranges")
+{
+    DivisionFreeListAllocator allocator;
+    division_free_list_allocator_alloc(&allocator, FREE_LIST_CAPACITY);
+
+    uint32_t offsets[4];
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(division_free_list_allocator_alloc_range(&allocator, 25, &offsets[i]));
+    }
+    REQUIRE(allocator.free_ranges_count == 0);
+
+    division_free_list_allocator_free_range(&allocator, offsets[0], 25);
+    division_free_list_allocator_free_range(&allocator, offsets[2], 25);
+    REQUIRE(allocator.free_ranges_count == 2);
+
+    division_free_list_allocator_free_range(&allocator, offsets[1], 25);
+    REQUIRE(allocator.free_ranges_count == 1);
+    REQUIRE(allocator.free_ranges[0].offset == 0);
+    REQUIRE(allocator.free_ranges[0].size == 75);
+
+    division_free_list_allocator_free_range(&allocator, offsets[3], 25);
+    REQUIRE(division_free_list_allocator_is_empty(&allocator));
+
+    division_free_list_allocator_free(&allocator);
+}
+
+TEST_CASE("Free list allocator grow")
+{
+    DivisionFreeListAllocator allocator;
+    division_free_list_allocator_alloc(&allocator, FREE_LIST_CAPACITY);
+
+    uint32_t offset0, offset1;
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 90, &offset0));
+    REQUIRE_FALSE(division_free_list_allocator_alloc_range(&allocator, 20, &offset1));
+
+    division_free_list_allocator_grow(&allocator, FREE_LIST_CAPACITY * 2);
+    REQUIRE(allocator.capacity == FREE_LIST_CAPACITY * 2);
+    REQUIRE(allocator.free_ranges_count == 1);
+
+    REQUIRE(division_free_list_allocator_alloc_range(&allocator, 20, &offset1));
+    REQUIRE(offset1 == 90);
+
+    division_free_list_allocator_free(&allocator);
+}
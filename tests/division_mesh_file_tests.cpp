@@ -0,0 +1,184 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/mesh_file.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct MeshVertex
+{
+    float position[3];
+    float uv[2];
+};
+
+struct MeshInstance
+{
+    float offset[2];
+};
+
+static std::vector<uint8_t> read_file(const std::string& path)
+{
+    std::vector<uint8_t> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    REQUIRE(file != nullptr);
+
+    uint8_t buffer[256];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    return bytes;
+}
+
+static void write_file(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    REQUIRE(file != nullptr);
+    REQUIRE(fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+    fclose(file);
+}
+
+static std::string write_test_mesh(const char* path)
+{
+    static const DivisionVertexAttributeSettings per_vertex[] = {
+        {DIVISION_FVEC3, 0},
+        {DIVISION_FVEC2, 1},
+    };
+    static const DivisionVertexAttributeSettings per_instance[] = {{DIVISION_FVEC2, 2}};
+    static const MeshVertex vertices[] = {
+        {{0, 0, 0}, {0, 0}},
+        {{1, 0, 0}, {1, 0}},
+        {{0, 1, 0}, {0, 1}},
+    };
+    static const uint16_t indices[] = {0, 1, 2};
+    static const MeshInstance instances[] = {{{5, 6}}, {{7, 8}}};
+
+    DivisionMeshFileData data = {};
+    data.settings.size = {3, 3, 2};
+    data.settings.per_vertex_attributes = per_vertex;
+    data.settings.per_instance_attributes = per_instance;
+    data.settings.per_vertex_attribute_count = 2;
+    data.settings.per_instance_attribute_count = 1;
+    data.settings.topology = DIVISION_TOPOLOGY_TRIANGLES;
+    data.settings.capabilities_mask = DIVISION_VERTEX_BUFFER_CAPABILITY_UINT16_INDICES;
+    data.vertex_data = vertices;
+    data.index_data = indices;
+    data.instance_data = instances;
+    data.vertex_data_size = sizeof(vertices);
+    data.index_data_size = sizeof(indices);
+    data.instance_data_size = sizeof(instances);
+
+    REQUIRE(division_mesh_file_write(path, &data));
+
+    return path;
+}
+
+TEST_CASE("Mesh file round trip keeps the layout and the data")
+{
+    std::string path = write_test_mesh("division_mesh_file_round_trip.dmsh");
+    DivisionMeshFile file;
+
+    REQUIRE(division_mesh_file_map(path.c_str(), &file));
+
+    const DivisionMeshFileHeader* header = file.header;
+    REQUIRE(header->vertex_count == 3);
+    REQUIRE(header->index_count == 3);
+    REQUIRE(header->instance_count == 2);
+    REQUIRE(header->topology == DIVISION_TOPOLOGY_TRIANGLES);
+    REQUIRE(
+        header->capabilities_mask == DIVISION_VERTEX_BUFFER_CAPABILITY_UINT16_INDICES
+    );
+    REQUIRE(header->per_vertex_attribute_count == 2);
+    REQUIRE(header->per_instance_attribute_count == 1);
+
+    REQUIRE(file.per_vertex_attributes[0].type == DIVISION_FVEC3);
+    REQUIRE(file.per_vertex_attributes[1].location == 1);
+    REQUIRE(file.per_instance_attributes[0].type == DIVISION_FVEC2);
+    REQUIRE(file.per_instance_attributes[0].location == 2);
+
+    REQUIRE(header->vertices.offset % DIVISION_MESH_FILE_BLOB_ALIGNMENT == 0);
+    REQUIRE(header->indices.offset % DIVISION_MESH_FILE_BLOB_ALIGNMENT == 0);
+    REQUIRE(header->instances.offset % DIVISION_MESH_FILE_BLOB_ALIGNMENT == 0);
+    REQUIRE(header->vertices.size == sizeof(MeshVertex[3]));
+    REQUIRE(header->indices.size == sizeof(uint16_t[3]));
+    REQUIRE(header->instances.size == sizeof(MeshInstance[2]));
+
+    auto vertices = static_cast<const MeshVertex*>(file.vertex_data);
+    auto indices = static_cast<const uint16_t*>(file.index_data);
+    auto instances = static_cast<const MeshInstance*>(file.instance_data);
+    REQUIRE(vertices[1].position[0] == 1.0f);
+    REQUIRE(vertices[2].uv[1] == 1.0f);
+    REQUIRE(indices[2] == 2);
+    REQUIRE(instances[1].offset[0] == 7.0f);
+
+    division_mesh_file_unmap(&file);
+    REQUIRE(file.mapping == nullptr);
+
+    remove(path.c_str());
+}
+
+TEST_CASE("Mesh file without instances and indices has empty blobs")
+{
+    const DivisionVertexAttributeSettings per_vertex[] = {{DIVISION_FVEC4, 0}};
+    const float vertices[] = {1, 2, 3, 4};
+    DivisionMeshFileData data = {};
+    data.settings.size = {1, 0, 0};
+    data.settings.per_vertex_attributes = per_vertex;
+    data.settings.per_vertex_attribute_count = 1;
+    data.settings.topology = DIVISION_TOPOLOGY_POINTS;
+    data.vertex_data = vertices;
+    data.vertex_data_size = sizeof(vertices);
+
+    std::string path = "division_mesh_file_points.dmsh";
+    REQUIRE(division_mesh_file_write(path.c_str(), &data));
+
+    DivisionMeshFile file;
+    REQUIRE(division_mesh_file_map(path.c_str(), &file));
+    REQUIRE(file.header->indices.size == 0);
+    REQUIRE(file.header->instances.size == 0);
+    REQUIRE(memcmp(file.vertex_data, vertices, sizeof(vertices)) == 0);
+
+    division_mesh_file_unmap(&file);
+    remove(path.c_str());
+}
+
+TEST_CASE("Mesh file mapping rejects invalid files")
+{
+    std::string path = write_test_mesh("division_mesh_file_invalid.dmsh");
+    std::vector<uint8_t> bytes = read_file(path);
+    DivisionMeshFile file;
+
+    SECTION("Wrong magic")
+    {
+        bytes[0] ^= 0xFF;
+    }
+
+    SECTION("Unknown version")
+    {
+        uint32_t version = DIVISION_MESH_FILE_VERSION + 1;
+        size_t offset = offsetof(DivisionMeshFileHeader, version);
+        memcpy(&bytes[offset], &version, sizeof(version));
+    }
+
+    SECTION("Truncated data")
+    {
+        bytes.resize(bytes.size() - 1);
+    }
+
+    SECTION("Truncated header")
+    {
+        bytes.resize(sizeof(DivisionMeshFileHeader) - 1);
+    }
+
+    write_file(path, bytes);
+    REQUIRE_FALSE(division_mesh_file_map(path.c_str(), &file));
+
+    remove(path.c_str());
+    REQUIRE_FALSE(division_mesh_file_map(path.c_str(), &file));
+}
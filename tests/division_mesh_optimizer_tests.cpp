@@ -0,0 +1,303 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#define GRID_SIZE 64
+#define BENCHMARK_GRID_SIZE 512
+
+struct MeshVertex
+{
+    float position[3];
+    float uv[2];
+};
+
+static uint32_t next_random(uint32_t* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+// A grid of (size + 1)^2 vertices with the triangles in a random order
+static void make_shuffled_grid(
+    size_t size, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices
+)
+{
+    vertices.clear();
+    indices.clear();
+
+    for (size_t y = 0; y <= size; y++)
+    {
+        for (size_t x = 0; x <= size; x++)
+        {
+            vertices.push_back({{(float) x, (float) y, 0}, {(float) x, (float) y}});
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t i = y * (uint32_t) (size + 1) + x;
+            uint32_t row = (uint32_t) size + 1;
+            triangles.push_back({i, i + 1, i + row});
+            triangles.push_back({i + 1, i + row + 1, i + row});
+        }
+    }
+
+    uint32_t state = 1;
+    for (size_t i = triangles.size() - 1; i > 0; i--)
+    {
+        std::swap(triangles[i], triangles[next_random(&state) % (i + 1)]);
+    }
+
+    for (auto& t : triangles)
+    {
+        indices.insert(indices.end(), t.begin(), t.end());
+    }
+}
+
+static std::vector<std::array<uint32_t, 3>> sorted_triangles(
+    const std::vector<uint32_t>& indices
+)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+    }
+    std::sort(triangles.begin(), triangles.end());
+
+    return triangles;
+}
+
+TEST_CASE("Vertex cache analysis of a single triangle")
+{
+    uint32_t indices[] = {0, 1, 2};
+
+    DivisionMeshCacheStats stats = division_mesh_analyze_vertex_cache(indices, 3, 3, 16);
+
+    REQUIRE(stats.transformed_vertex_count == 3);
+    REQUIRE(stats.acmr == 3.0f);
+    REQUIRE(stats.atvr == 1.0f);
+}
+
+TEST_CASE("Vertex cache analysis counts the FIFO evictions")
+{
+    uint32_t indices[] = {0, 1, 2, 2, 1, 3, 0, 1, 2};
+
+    DivisionMeshCacheStats stats = division_mesh_analyze_vertex_cache(indices, 9, 4, 3);
+
+    // Vertex 3 evicts vertex 0, which then evicts vertex 1 and so on
+    REQUIRE(stats.transformed_vertex_count == 7);
+}
+
+TEST_CASE("Vertex cache optimization keeps the triangles and improves the acmr")
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    make_shuffled_grid(GRID_SIZE, vertices, indices);
+    std::vector<uint32_t> optimized(indices.size());
+
+    REQUIRE(division_mesh_optimize_vertex_cache(
+        optimized.data(), indices.data(), indices.size(), vertices.size(), 16
+    ));
+
+    DivisionMeshCacheStats before = division_mesh_analyze_vertex_cache(
+        indices.data(), indices.size(), vertices.size(), 16
+    );
+    DivisionMeshCacheStats after = division_mesh_analyze_vertex_cache(
+        optimized.data(), optimized.size(), vertices.size(), 16
+    );
+
+    REQUIRE(before.acmr > 2.0f);
+    REQUIRE(after.acmr < 1.0f);
+    REQUIRE(after.atvr < before.atvr);
+    REQUIRE(sorted_triangles(optimized) == sorted_triangles(indices));
+}
+
+TEST_CASE("Vertex cache optimization rejects out of range indices")
+{
+    uint32_t indices[] = {0, 1, 5};
+    uint32_t optimized[3];
+
+    REQUIRE_FALSE(division_mesh_optimize_vertex_cache(optimized, indices, 3, 3, 16));
+}
+
+TEST_CASE("Mesh optimizations reject incomplete triangles")
+{
+    uint32_t indices[] = {0, 1, 2, 2, 1};
+    float positions[] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    uint32_t optimized[5];
+
+    REQUIRE_FALSE(division_mesh_optimize_vertex_cache(optimized, indices, 5, 3, 16));
+    REQUIRE_FALSE(division_mesh_optimize_overdraw(
+        optimized, indices, 4, positions, sizeof(float[3]), 3, 16, 1.05f
+    ));
+
+    DivisionMeshOptimizeReport report;
+    REQUIRE_FALSE(
+        division_mesh_optimize(indices, 5, positions, 3, sizeof(float[3]), 0, &report)
+    );
+    REQUIRE(indices[3] == 2);
+    REQUIRE(indices[4] == 1);
+}
+
+TEST_CASE("Overdraw optimization keeps the triangles within the acmr threshold")
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    make_shuffled_grid(GRID_SIZE, vertices, indices);
+
+    REQUIRE(division_mesh_optimize_vertex_cache(
+        indices.data(), indices.data(), indices.size(), vertices.size(), 16
+    ));
+    std::vector<uint32_t> optimized(indices.size());
+
+    REQUIRE(division_mesh_optimize_overdraw(
+        optimized.data(),
+        indices.data(),
+        indices.size(),
+        vertices[0].position,
+        sizeof(MeshVertex),
+        vertices.size(),
+        16,
+        1.05f
+    ));
+
+    DivisionMeshCacheStats cache_only = division_mesh_analyze_vertex_cache(
+        indices.data(), indices.size(), vertices.size(), 16
+    );
+    DivisionMeshCacheStats overdraw = division_mesh_analyze_vertex_cache(
+        optimized.data(), optimized.size(), vertices.size(), 16
+    );
+
+    REQUIRE(overdraw.acmr < cache_only.acmr * 1.25f);
+    REQUIRE(sorted_triangles(optimized) == sorted_triangles(indices));
+}
+
+TEST_CASE("Vertex fetch remap follows the first reference order")
+{
+    uint32_t indices[] = {4, 2, 0, 2, 4, 3};
+    uint32_t remap[6];
+    uint32_t remapped[6];
+
+    size_t used = division_mesh_optimize_vertex_fetch_remap(remap, indices, 6, 6);
+    division_mesh_remap_indices(remapped, indices, 6, remap);
+
+    REQUIRE(used == 4);
+    REQUIRE(remap[4] == 0);
+    REQUIRE(remap[2] == 1);
+    REQUIRE(remap[0] == 2);
+    REQUIRE(remap[3] == 3);
+    REQUIRE(remap[1] == DIVISION_MESH_UNUSED_VERTEX);
+    REQUIRE(remap[5] == DIVISION_MESH_UNUSED_VERTEX);
+
+    uint32_t expected[] = {0, 1, 2, 1, 0, 3};
+    for (int i = 0; i < 6; i++)
+    {
+        REQUIRE(remapped[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Full mesh optimization is deterministic and keeps the geometry")
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    make_shuffled_grid(GRID_SIZE, vertices, indices);
+
+    // An unreferenced vertex must be dropped
+    vertices.push_back({{-1, -1, -1}, {0, 0}});
+
+    std::vector<MeshVertex> source_vertices = vertices;
+    std::vector<uint32_t> source_indices = indices;
+    std::vector<MeshVertex> second_vertices = vertices;
+    std::vector<uint32_t> second_indices = indices;
+    DivisionMeshOptimizeReport report, second_report;
+
+    REQUIRE(division_mesh_optimize(
+        indices.data(),
+        indices.size(),
+        vertices.data(),
+        vertices.size(),
+        sizeof(MeshVertex),
+        offsetof(MeshVertex, position),
+        &report
+    ));
+    REQUIRE(division_mesh_optimize(
+        second_indices.data(),
+        second_indices.size(),
+        second_vertices.data(),
+        second_vertices.size(),
+        sizeof(MeshVertex),
+        offsetof(MeshVertex, position),
+        &second_report
+    ));
+
+    REQUIRE(report.vertex_count == source_vertices.size() - 1);
+    REQUIRE(report.after.acmr < report.before.acmr);
+    REQUIRE(report.after.atvr < report.before.atvr);
+    REQUIRE(indices == second_indices);
+
+    // Compares the triangles by their vertex positions
+    auto to_positions = [](const std::vector<uint32_t>& idx,
+                           const std::vector<MeshVertex>& v) {
+        std::vector<std::array<float, 9>> triangles;
+        for (size_t i = 0; i < idx.size(); i += 3)
+        {
+            std::array<float, 9> t;
+            for (int c = 0; c < 3; c++)
+            {
+                REQUIRE(idx[i + c] < v.size());
+                std::copy_n(v[idx[i + c]].position, 3, t.begin() + c * 3);
+            }
+            triangles.push_back(t);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+
+    vertices.resize(report.vertex_count);
+    REQUIRE(
+        to_positions(indices, vertices) == to_positions(source_indices, source_vertices)
+    );
+
+    // The vertices are fetched in order
+    uint32_t next_vertex = 0;
+    for (uint32_t index : indices)
+    {
+        REQUIRE(index <= next_vertex);
+        next_vertex = std::max(next_vertex, index + 1);
+    }
+}
+
+TEST_CASE("Mesh optimizer benchmark", "[.][benchmark]")
+{
+    std::vector<MeshVertex> source_vertices;
+    std::vector<uint32_t> source_indices;
+    make_shuffled_grid(BENCHMARK_GRID_SIZE, source_vertices, source_indices);
+
+    // The mesh is optimized in place, so every run starts from the shuffled copy
+    DivisionMeshOptimizeReport report;
+    BENCHMARK("Mesh optimization")
+    {
+        std::vector<MeshVertex> vertices = source_vertices;
+        std::vector<uint32_t> indices = source_indices;
+        division_mesh_optimize(
+            indices.data(),
+            indices.size(),
+            vertices.data(),
+            vertices.size(),
+            sizeof(MeshVertex),
+            offsetof(MeshVertex, position),
+            &report
+        );
+        return indices[0];
+    };
+
+    REQUIRE(report.after.acmr <= report.before.acmr);
+}
@@ -0,0 +1,635 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/binding_group.h"
+#include "division_engine_core/capture.h"
+#include "division_engine_core/command_list.h"
+#include "division_engine_core/context.h"
+#include "division_engine_core/profiler.h"
+#include "division_engine_core/render_pass_descriptor.h"
+#include "division_engine_core/render_pass_instance.h"
+#include "division_engine_core/renderer.h"
+#include "division_engine_core/shader.h"
+#include "division_engine_core/texture.h"
+#include "division_engine_core/uniform_buffer.h"
+#include "division_engine_core/vertex_buffer.h"
+
+#include <null_binding_group.h>
+#include <null_call_stats.h>
+
+#include <chrono>
+#include <cstring>
+
+struct NullPlatformSceneOptions
+{
+    uint32_t frame_limit = 1;
+    bool borrow_in_draw = false;
+    // Draws the instances with two submits of a frame, which loads the previous one
+    bool split_frame = false;
+    // Marks the same small rect of the next frame every frame
+    bool partial_redraw = false;
+    // Allocates the render pass descriptors of the same and the other states
+    bool share_descriptors = false;
+};
+
+struct NullPlatformScene
+{
+    NullPlatformSceneOptions options;
+    uint32_t render_pass_descriptor_id;
+    uint32_t vertex_buffer_id;
+    uint32_t shared_render_pass_descriptor_id;
+    uint32_t reused_render_pass_descriptor_id;
+    int error_count;
+    DivisionNullCallStats stats;
+    DivisionRedrawStats redraw_stats;
+};
+
+static const char* SHADER_SOURCE = "void main() {}";
+
+static void alloc_scene(DivisionContext* ctx)
+{
+    auto* scene = static_cast<NullPlatformScene*>(ctx->user_data);
+
+    DivisionShaderSourceDescriptor shaders[2];
+    shaders[0].type = DIVISION_SHADER_VERTEX;
+    shaders[0].entry_point_name = nullptr;
+    shaders[0].source = SHADER_SOURCE;
+    shaders[0].source_size = (uint32_t) strlen(SHADER_SOURCE);
+    shaders[1] = shaders[0];
+    shaders[1].type = DIVISION_SHADER_FRAGMENT;
+
+    uint32_t shader_id;
+    REQUIRE(division_engine_shader_program_alloc(ctx, shaders, 2, &shader_id));
+
+    DivisionVertexAttributeSettings attribute;
+    attribute.type = DIVISION_FVEC3;
+    attribute.location = 0;
+
+    DivisionVertexBufferConstSettings vertex_buffer;
+    vertex_buffer.size.vertex_count = 6;
+    vertex_buffer.size.index_count = 0;
+    vertex_buffer.size.instance_count = 0;
+    vertex_buffer.per_vertex_attributes = &attribute;
+    vertex_buffer.per_instance_attributes = nullptr;
+    vertex_buffer.per_vertex_attribute_count = 1;
+    vertex_buffer.per_instance_attribute_count = 0;
+    vertex_buffer.topology = DIVISION_TOPOLOGY_TRIANGLES;
+    vertex_buffer.capabilities_mask = DIVISION_VERTEX_BUFFER_CAPABILITY_NONE;
+    REQUIRE(
+        division_engine_vertex_buffer_alloc(ctx, &vertex_buffer, &scene->vertex_buffer_id)
+    );
+
+    DivisionRenderPassDescriptor render_pass;
+    memset(&render_pass, 0, sizeof(render_pass));
+    render_pass.shader_program = shader_id;
+    render_pass.vertex_buffer_id = scene->vertex_buffer_id;
+    render_pass.capabilities_mask = DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_NONE;
+    render_pass.color_mask = DIVISION_COLOR_MASK_RGBA;
+    REQUIRE(division_engine_render_pass_descriptor_alloc(
+        ctx, &render_pass, &scene->render_pass_descriptor_id
+    ));
+
+    if (scene->options.share_descriptors)
+    {
+        // The blend options are skipped without the alpha blend capability
+        render_pass.alpha_blending_options.src = DIVISION_ALPHA_BLEND_SRC_ALPHA;
+        REQUIRE(division_engine_render_pass_descriptor_alloc(
+            ctx, &render_pass, &scene->shared_render_pass_descriptor_id
+        ));
+
+        // Freed ids are reused after the preallocated ones of the id table,
+        // so the descriptors of the other color masks take them first
+        uint32_t freed_id;
+        for (int color_mask = DIVISION_COLOR_MASK_R;
+             color_mask < DIVISION_COLOR_MASK_RGBA;
+             color_mask++)
+        {
+            uint32_t other_id;
+            render_pass.color_mask = (DivisionColorMask) color_mask;
+            REQUIRE(
+                division_engine_render_pass_descriptor_alloc(ctx, &render_pass, &other_id)
+            );
+            if (color_mask == DIVISION_COLOR_MASK_R)
+            {
+                freed_id = other_id;
+            }
+        }
+        division_engine_render_pass_descriptor_free(ctx, freed_id);
+
+        render_pass.color_mask = DIVISION_COLOR_MASK_NONE;
+        REQUIRE(division_engine_render_pass_descriptor_alloc(
+            ctx, &render_pass, &scene->reused_render_pass_descriptor_id
+        ));
+        REQUIRE(scene->reused_render_pass_descriptor_id == freed_id);
+        REQUIRE(
+            DIVISION_GET_RENDER_PASS_DESCRIPTOR(
+                ctx, scene->reused_render_pass_descriptor_id
+            )->color_mask == DIVISION_COLOR_MASK_NONE
+        );
+
+        // The draws use the shared id, which is alive until its last owner frees it
+        division_engine_render_pass_descriptor_free(
+            ctx, scene->shared_render_pass_descriptor_id
+        );
+    }
+}
+
+static void draw_scene(DivisionContext* ctx)
+{
+    auto* scene = static_cast<NullPlatformScene*>(ctx->user_data);
+
+    DivisionVertexBufferBorrowedData borrowed;
+    if (scene->options.borrow_in_draw)
+    {
+        REQUIRE(division_engine_vertex_buffer_borrow_data(
+            ctx, scene->vertex_buffer_id, &borrowed
+        ));
+    }
+
+    // The second instance continues the first one, so they are drawn as one batch
+    DivisionRenderPassInstance instances[2];
+    memset(instances, 0, sizeof(instances));
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        instances[i].first_vertex = i * 3;
+        instances[i].vertex_count = 3;
+        instances[i].render_pass_descriptor_id = scene->render_pass_descriptor_id;
+        instances[i].capabilities_mask = DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_NONE;
+    }
+
+    if (scene->options.partial_redraw)
+    {
+        DivisionDirtyRect dirty_rect = {8, 8, 16, 16};
+        division_engine_render_pass_instance_mark_dirty(ctx, &dirty_rect);
+    }
+
+    DivisionColor clear_color = {0, 0, 0, 1};
+    if (scene->options.split_frame)
+    {
+        DivisionFrameDescriptor frame;
+        frame.clear_color = clear_color;
+        frame.color_load_action = DIVISION_LOAD_ACTION_LOAD;
+        frame.color_store_action = DIVISION_STORE_ACTION_STORE;
+        frame.clear_depth = 1.0f;
+        frame.depth_load_action = DIVISION_LOAD_ACTION_DONT_CARE;
+        frame.depth_store_action = DIVISION_STORE_ACTION_DONT_CARE;
+        frame.opaque_sort_order = DIVISION_OPAQUE_SORT_BY_STATE;
+
+        REQUIRE(division_engine_render_pass_instance_begin_frame(ctx, &frame));
+        division_engine_render_pass_instance_submit(ctx, &instances[0], 1);
+        division_engine_render_pass_instance_submit(ctx, &instances[1], 1);
+        // The frame is ended by the renderer after the draw callback
+    }
+    else
+    {
+        division_engine_render_pass_instance_draw(ctx, &clear_color, instances, 2);
+    }
+
+    if (scene->options.borrow_in_draw)
+    {
+        division_engine_vertex_buffer_return_data(
+            ctx, scene->vertex_buffer_id, &borrowed
+        );
+    }
+}
+
+static void free_scene(DivisionContext* ctx)
+{
+    auto* scene = static_cast<NullPlatformScene*>(ctx->user_data);
+    scene->stats = *division_engine_null_get_call_stats(ctx);
+    scene->redraw_stats = ctx->render_pass_context->redraw_stats;
+
+    division_engine_context_finalize(ctx);
+}
+
+static void count_error(DivisionContext* ctx, int error_code, const char* message)
+{
+    static_cast<NullPlatformScene*>(ctx->user_data)->error_count++;
+}
+
+static NullPlatformScene run_scene(const NullPlatformSceneOptions& options)
+{
+    DivisionSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.window_width = 64;
+    settings.window_height = 64;
+    settings.window_title = "Null platform tests";
+    settings.frame_limit = options.frame_limit;
+    settings.partial_redraw = options.partial_redraw;
+
+    DivisionLifecycle lifecycle;
+    lifecycle.init_callback = alloc_scene;
+    lifecycle.draw_callback = draw_scene;
+    lifecycle.free_callback = free_scene;
+    lifecycle.error_callback = count_error;
+
+    NullPlatformScene scene = {};
+    scene.options = options;
+
+    // The errors of the initialization are reported to the lifecycle
+    DivisionContext ctx;
+    ctx.user_data = &scene;
+    division_engine_context_register_lifecycle(&ctx, &lifecycle);
+    REQUIRE(division_engine_context_initialize(&settings, &ctx));
+    division_engine_renderer_run_loop(&ctx);
+
+    return scene;
+}
+
+TEST_CASE("Null platform runs the frame limit and counts the calls")
+{
+    NullPlatformSceneOptions options;
+    options.frame_limit = 3;
+    NullPlatformScene scene = run_scene(options);
+
+    REQUIRE(scene.error_count == 0);
+    REQUIRE(scene.stats.frame_count == 3);
+    REQUIRE(scene.stats.clear_count == 3);
+    REQUIRE(scene.stats.submit_count == 3);
+    REQUIRE(scene.stats.draw_call_count == 3);
+    REQUIRE(scene.stats.validation_error_count == 0);
+    REQUIRE(scene.stats.resource_alloc_count >= 2);
+    REQUIRE(scene.redraw_stats.touched_percent == 100.0f);
+}
+
+TEST_CASE("Null platform reports the draws of borrowed vertex buffers")
+{
+    NullPlatformSceneOptions options;
+    options.frame_limit = 2;
+    options.borrow_in_draw = true;
+    NullPlatformScene scene = run_scene(options);
+
+    REQUIRE(scene.stats.frame_count == 2);
+    REQUIRE(scene.stats.borrow_count == 2);
+    REQUIRE(scene.stats.validation_error_count > 0);
+    REQUIRE(scene.error_count >= (int) scene.stats.validation_error_count);
+    REQUIRE(scene.stats.draw_call_count == 0);
+}
+
+TEST_CASE("Null platform appends the submits to the begun frame")
+{
+    NullPlatformSceneOptions options;
+    options.frame_limit = 2;
+    options.split_frame = true;
+    NullPlatformScene scene = run_scene(options);
+
+    REQUIRE(scene.error_count == 0);
+    REQUIRE(scene.stats.frame_count == 2);
+    REQUIRE(scene.stats.clear_count == 0);
+    REQUIRE(scene.stats.submit_count == 4);
+    REQUIRE(scene.stats.draw_call_count == 4);
+}
+
+TEST_CASE("Null platform redraws the dirty rects only")
+{
+    NullPlatformSceneOptions options;
+    options.frame_limit = 3;
+    options.partial_redraw = true;
+    NullPlatformScene scene = run_scene(options);
+
+    // The first frame is dirty as a whole, the next ones draw the marked rect
+    REQUIRE(scene.error_count == 0);
+    REQUIRE(scene.stats.frame_count == 3);
+    REQUIRE(scene.stats.submit_count == 3);
+    REQUIRE(scene.redraw_stats.dirty_rect_count == 1);
+    REQUIRE(scene.redraw_stats.touched_pixels == 16 * 16);
+    REQUIRE(scene.redraw_stats.frame_pixels == 64 * 64);
+    REQUIRE(scene.redraw_stats.touched_percent == 6.25f);
+}
+
+TEST_CASE("Null platform shares the render pass descriptors of the same state")
+{
+    NullPlatformSceneOptions options;
+    options.frame_limit = 2;
+    options.share_descriptors = true;
+    NullPlatformScene scene = run_scene(options);
+
+    REQUIRE(scene.error_count == 0);
+    REQUIRE(scene.shared_render_pass_descriptor_id == scene.render_pass_descriptor_id);
+    // Shader, vertex buffer and the descriptors of all 16 color masks
+    REQUIRE(scene.stats.resource_alloc_count == 18);
+    REQUIRE(scene.stats.resource_free_count == 1);
+    REQUIRE(scene.stats.draw_call_count == 2);
+}
+
+// Context without the run loop, the calls of the test are made outside of frames
+static void initialize_context(DivisionContext* ctx, NullPlatformScene* scene)
+{
+    DivisionSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.window_width = 64;
+    settings.window_height = 64;
+    settings.window_title = "Null platform tests";
+    settings.frame_limit = 1;
+
+    DivisionLifecycle lifecycle;
+    memset(&lifecycle, 0, sizeof(lifecycle));
+    lifecycle.error_callback = count_error;
+
+    ctx->user_data = scene;
+    division_engine_context_register_lifecycle(ctx, &lifecycle);
+    REQUIRE(division_engine_context_initialize(&settings, ctx));
+}
+
+TEST_CASE("Null platform refuses to drop the color of the window")
+{
+    NullPlatformScene scene = {};
+    DivisionContext ctx;
+    initialize_context(&ctx, &scene);
+
+    DivisionFrameDescriptor frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.color_load_action = DIVISION_LOAD_ACTION_DONT_CARE;
+    frame.color_store_action = DIVISION_STORE_ACTION_DONT_CARE;
+    frame.depth_store_action = DIVISION_STORE_ACTION_DONT_CARE;
+
+    REQUIRE_FALSE(division_engine_render_pass_instance_begin_frame(&ctx, &frame));
+    REQUIRE(scene.error_count == 1);
+
+    // Only the depth and stencil can be dropped
+    frame.color_store_action = DIVISION_STORE_ACTION_STORE;
+    REQUIRE(division_engine_render_pass_instance_begin_frame(&ctx, &frame));
+    division_engine_render_pass_instance_end_frame(&ctx);
+    REQUIRE(scene.error_count == 1);
+
+    division_engine_context_finalize(&ctx);
+}
+
+TEST_CASE("Null platform replays the command lists in the recording order")
+{
+    NullPlatformScene scene = {};
+    DivisionContext ctx;
+    initialize_context(&ctx, &scene);
+    alloc_scene(&ctx);
+
+    DivisionUniformBufferDescriptor uniform_buffer;
+    memset(&uniform_buffer, 0, sizeof(uniform_buffer));
+    uniform_buffer.data_bytes = sizeof(float[4]);
+    uint32_t uniform_buffer_id;
+    REQUIRE(
+        division_engine_uniform_buffer_alloc(&ctx, uniform_buffer, &uniform_buffer_id)
+    );
+
+    DivisionCommandDrawRange range;
+    memset(&range, 0, sizeof(range));
+    range.vertex_count = 3;
+
+    DivisionCommandList list;
+    REQUIRE(division_command_list_alloc(&list, 0, 0));
+    division_command_list_bind_render_pass_descriptor(
+        &list, scene.render_pass_descriptor_id
+    );
+    for (int i = 0; i < 2; i++)
+    {
+        float color[4] = {(float) i, 0, 0, 1};
+        REQUIRE(division_command_list_set_uniform_data(
+            &list, uniform_buffer_id, 0, color, sizeof(color)
+        ));
+        REQUIRE(division_command_list_draw(&list, &range));
+    }
+
+    DivisionColor clear_color = {0, 0, 0, 1};
+    division_engine_command_list_submit(&ctx, &clear_color, &list, 1);
+
+    // The second copy waits for the first draw, so the draws are split
+    const DivisionNullCallStats* stats = division_engine_null_get_call_stats(&ctx);
+    REQUIRE(scene.error_count == 0);
+    REQUIRE(stats->submit_count == 2);
+    REQUIRE(stats->draw_call_count == 2);
+    REQUIRE(stats->upload_job_count == 2);
+
+    division_command_list_free(&list);
+    division_engine_context_finalize(&ctx);
+}
+
+TEST_CASE("Null platform replay of a missing capture reports no commands")
+{
+    NullPlatformScene scene = {};
+    DivisionContext ctx;
+    initialize_context(&ctx, &scene);
+
+    DivisionCaptureReplayStats stats;
+    memset(&stats, 0x7F, sizeof(stats));
+    REQUIRE_FALSE(division_engine_capture_replay(&ctx, "/nonexistent", &stats));
+    REQUIRE(scene.error_count == 1);
+    REQUIRE(stats.command_count == 0);
+    REQUIRE(stats.frame_count == 0);
+
+    division_engine_context_finalize(&ctx);
+}
+
+TEST_CASE("Null platform keeps the state of the shared render pass descriptors")
+{
+    NullPlatformScene scene = {};
+    DivisionContext ctx;
+    initialize_context(&ctx, &scene);
+    alloc_scene(&ctx);
+
+    uint32_t id = scene.render_pass_descriptor_id;
+    DivisionRenderPassDescriptor render_pass =
+        ctx.render_pass_context->render_pass_descriptors[id];
+
+    // Descriptors of the distinct blend colors fill the map past its growth
+    DivisionRenderPassDescriptor blend_pass = render_pass;
+    blend_pass.capabilities_mask = DIVISION_RENDER_PASS_DESCRIPTOR_CAPABILITY_ALPHA_BLEND;
+    uint32_t blend_ids[40];
+    for (int i = 0; i < 40; i++)
+    {
+        blend_pass.alpha_blending_options.constant_blend_color[0] = (float) i;
+        REQUIRE(
+            division_engine_render_pass_descriptor_alloc(&ctx, &blend_pass, &blend_ids[i])
+        );
+    }
+    for (int i = 0; i < 40; i += 2)
+    {
+        division_engine_render_pass_descriptor_free(&ctx, blend_ids[i]);
+    }
+    for (int i = 0; i < 40; i++)
+    {
+        uint32_t blend_id;
+        blend_pass.alpha_blending_options.constant_blend_color[0] = (float) i;
+        REQUIRE(
+            division_engine_render_pass_descriptor_alloc(&ctx, &blend_pass, &blend_id)
+        );
+        REQUIRE((i % 2 == 0 || blend_id == blend_ids[i]));
+    }
+
+    uint32_t shared_id;
+    REQUIRE(division_engine_render_pass_descriptor_alloc(&ctx, &render_pass, &shared_id));
+    REQUIRE(shared_id == id);
+    REQUIRE(division_engine_render_pass_descriptor_borrow(&ctx, id) == NULL);
+    REQUIRE(scene.error_count == 1);
+
+    // The only owner edits the descriptor, an invalid state is rolled back
+    division_engine_render_pass_descriptor_free(&ctx, shared_id);
+    DivisionRenderPassDescriptor* borrowed =
+        division_engine_render_pass_descriptor_borrow(&ctx, id);
+    REQUIRE(borrowed != NULL);
+    borrowed->shader_program = 1000;
+    REQUIRE_FALSE(division_engine_render_pass_descriptor_return(&ctx, id, borrowed));
+    const DivisionRenderPassDescriptor* descriptors =
+        ctx.render_pass_context->render_pass_descriptors;
+    REQUIRE(descriptors[id].shader_program == render_pass.shader_program);
+
+    borrowed = division_engine_render_pass_descriptor_borrow(&ctx, id);
+    borrowed->color_mask = DIVISION_COLOR_MASK_R;
+    REQUIRE(division_engine_render_pass_descriptor_return(&ctx, id, borrowed));
+
+    // The new state is shared, the old one gets another id
+    uint32_t other_id;
+    REQUIRE(division_engine_render_pass_descriptor_alloc(&ctx, &render_pass, &other_id));
+    REQUIRE(other_id != id);
+    render_pass.color_mask = DIVISION_COLOR_MASK_R;
+    REQUIRE(division_engine_render_pass_descriptor_alloc(&ctx, &render_pass, &shared_id));
+    REQUIRE(shared_id == id);
+
+    division_engine_context_finalize(&ctx);
+}
+
+TEST_CASE("Null platform draws with binding groups and rejects the freed ones")
+{
+    NullPlatformScene scene = {};
+    DivisionContext ctx;
+    initialize_context(&ctx, &scene);
+    alloc_scene(&ctx);
+
+    DivisionUniformBufferDescriptor uniform_buffer;
+    memset(&uniform_buffer, 0, sizeof(uniform_buffer));
+    uniform_buffer.data_bytes = sizeof(float[4]);
+    uint32_t uniform_buffer_id;
+    REQUIRE(
+        division_engine_uniform_buffer_alloc(&ctx, uniform_buffer, &uniform_buffer_id)
+    );
+
+    DivisionTexture texture;
+    memset(&texture, 0, sizeof(texture));
+    texture.texture_format = DIVISION_TEXTURE_FORMAT_R8Uint;
+    texture.width = 4;
+    texture.height = 4;
+    uint32_t texture_id;
+    REQUIRE(division_engine_texture_alloc(&ctx, &texture, &texture_id));
+
+    // The fragment buffers are a gap between the vertex buffers and the textures
+    DivisionIdWithBinding vertex_buffers[] = {{uniform_buffer_id, 1}};
+    DivisionIdWithBinding textures[] = {{texture_id, 0}, {texture_id, 2}};
+    DivisionBindingGroup binding_group;
+    memset(&binding_group, 0, sizeof(binding_group));
+    binding_group.uniform_vertex_buffers = vertex_buffers;
+    binding_group.fragment_textures = textures;
+    binding_group.uniform_vertex_buffer_count = 1;
+    binding_group.fragment_texture_count = 2;
+
+    uint32_t group_id;
+    REQUIRE(division_engine_binding_group_alloc(&ctx, &binding_group, &group_id));
+    const DivisionBindingGroup* group_copy =
+        &ctx.binding_group_context->binding_groups[group_id];
+    REQUIRE(group_copy->uniform_vertex_buffers != vertex_buffers);
+    REQUIRE(group_copy->uniform_vertex_buffers[0].shader_location == 1);
+    REQUIRE(group_copy->uniform_fragment_buffer_count == 0);
+    REQUIRE(group_copy->fragment_textures[1].shader_location == 2);
+
+    DivisionRenderPassInstance instance;
+    memset(&instance, 0, sizeof(instance));
+    instance.vertex_count = 3;
+    instance.render_pass_descriptor_id = scene.render_pass_descriptor_id;
+    instance.binding_group_id = group_id;
+    instance.capabilities_mask = DIVISION_RENDER_PASS_INSTANCE_CAPABILITY_BINDING_GROUP;
+
+    DivisionColor clear_color = {0, 0, 0, 1};
+    division_engine_render_pass_instance_draw(&ctx, &clear_color, &instance, 1);
+    REQUIRE(ctx.binding_group_context->binding_groups_impl[group_id].draw_count == 1);
+
+    division_engine_binding_group_free(&ctx, group_id);
+    division_engine_render_pass_instance_draw(&ctx, &clear_color, &instance, 1);
+
+    const DivisionNullCallStats* stats = division_engine_null_get_call_stats(&ctx);
+    REQUIRE(stats->draw_call_count == 1);
+    REQUIRE(stats->validation_error_count == 1);
+    REQUIRE(scene.error_count == 1);
+
+    // Groups of the freed resources are refused too
+    division_engine_texture_free(&ctx, texture_id);
+    REQUIRE_FALSE(division_engine_binding_group_alloc(&ctx, &binding_group, &group_id));
+    REQUIRE(stats->validation_error_count == 2);
+
+    division_engine_context_finalize(&ctx);
+}
+
+struct NullPlatformProfilerScene
+{
+    uint32_t outer_label;
+    uint32_t inner_label;
+};
+
+static const double PROFILER_BODY_MS = 5;
+
+static void register_profiler_labels(DivisionContext* ctx)
+{
+    auto* scene = static_cast<NullPlatformProfilerScene*>(ctx->user_data);
+    division_engine_profiler_set_enabled(ctx, true);
+    REQUIRE(division_engine_profiler_register_label(ctx, "outer", &scene->outer_label));
+    REQUIRE(division_engine_profiler_register_label(ctx, "inner", &scene->inner_label));
+}
+
+static void draw_nested_scopes(DivisionContext* ctx)
+{
+    auto* scene = static_cast<NullPlatformProfilerScene*>(ctx->user_data);
+    const int inner_depth = DIVISION_PROFILER_MAX_DEPTH + 3;
+
+    division_engine_profiler_begin(ctx, scene->outer_label);
+    for (int i = 0; i < inner_depth; i++)
+    {
+        division_engine_profiler_begin(ctx, scene->inner_label);
+    }
+    for (int i = 0; i < inner_depth; i++)
+    {
+        division_engine_profiler_end(ctx);
+    }
+
+    // The rest of the outer body must still be timed by the outer scope
+    auto body_begin = std::chrono::steady_clock::now();
+    while (std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - body_begin
+           )
+               .count() < PROFILER_BODY_MS)
+    {
+    }
+    division_engine_profiler_end(ctx);
+}
+
+static void free_profiler_scene(DivisionContext* ctx)
+{
+}
+
+TEST_CASE("Null platform profiler keeps the outer scope past the depth limit")
+{
+    DivisionSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.window_width = 64;
+    settings.window_height = 64;
+    settings.window_title = "Null platform tests";
+    settings.frame_limit = 1;
+
+    DivisionLifecycle lifecycle;
+    memset(&lifecycle, 0, sizeof(lifecycle));
+    lifecycle.init_callback = register_profiler_labels;
+    lifecycle.draw_callback = draw_nested_scopes;
+    lifecycle.free_callback = free_profiler_scene;
+
+    NullPlatformProfilerScene scene = {};
+    DivisionContext ctx;
+    ctx.user_data = &scene;
+    division_engine_context_register_lifecycle(&ctx, &lifecycle);
+    REQUIRE(division_engine_context_initialize(&settings, &ctx));
+    division_engine_renderer_run_loop(&ctx);
+
+    DivisionProfilerTiming outer;
+    DivisionProfilerTiming inner;
+    REQUIRE(division_engine_profiler_get_timings(&ctx, scene.outer_label, &outer, 1));
+    REQUIRE(division_engine_profiler_get_timings(&ctx, scene.inner_label, &inner, 1));
+    REQUIRE(outer.cpu_ms >= PROFILER_BODY_MS);
+    REQUIRE(inner.cpu_ms < PROFILER_BODY_MS);
+    REQUIRE(ctx.profiler_context->open_scope_count == 0);
+    REQUIRE(ctx.profiler_context->overflow_scope_count == 0);
+
+    division_engine_context_finalize(&ctx);
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/radix_sort.h"
+#include "division_engine_core/render_pass_instance.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#define RADIX_SORT_TEST_COUNT 10007
+#define RADIX_SORT_BENCHMARK_COUNT (1 << 20)
+
+static uint64_t next_random(uint64_t* state)
+{
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    return *state;
+}
+
+static void radix_sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values)
+{
+    std::vector<uint64_t> tmp_keys(keys.size());
+    std::vector<uint32_t> tmp_values(values.size());
+
+    division_radix_sort_u64(
+        keys.data(), values.data(), tmp_keys.data(), tmp_values.data(), keys.size()
+    );
+}
+
+TEST_CASE("Radix sort matches a stable sort")
+{
+    uint64_t state = 3;
+    std::vector<uint64_t> keys(RADIX_SORT_TEST_COUNT);
+    std::vector<uint32_t> values(keys.size());
+
+    // Few distinct keys with random high bytes give both equal keys and skipped passes
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        keys[i] = (next_random(&state) % 64) << 40 | 0xAB;
+        values[i] = (uint32_t) i;
+    }
+
+    std::vector<std::pair<uint64_t, uint32_t>> expected;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        expected.emplace_back(keys[i], values[i]);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](auto& a, auto& b) {
+        return a.first < b.first;
+    });
+
+    radix_sort(keys, values);
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        REQUIRE(keys[i] == expected[i].first);
+        REQUIRE(values[i] == expected[i].second);
+    }
+}
+
+TEST_CASE("Radix sort handles full width keys and odd pass counts")
+{
+    std::vector<uint64_t> keys = {UINT64_MAX, 0, 1ull << 63, 255, 256, 1ull << 63};
+    std::vector<uint32_t> values = {0, 1, 2, 3, 4, 5};
+
+    radix_sort(keys, values);
+
+    std::vector<uint64_t> expected = {0, 255, 256, 1ull << 63, 1ull << 63, UINT64_MAX};
+    REQUIRE(keys == expected);
+    REQUIRE(values == std::vector<uint32_t>{1, 3, 4, 2, 5, 0});
+}
+
+TEST_CASE("Radix sort of equal keys keeps the order")
+{
+    std::vector<uint64_t> keys(100, 42);
+    std::vector<uint32_t> values(keys.size());
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<uint32_t> expected = values;
+
+    radix_sort(keys, values);
+
+    REQUIRE(values == expected);
+}
+
+TEST_CASE("Sort key orders layers, translucency, state and depth")
+{
+    auto opaque = [](uint32_t layer, uint32_t shader, uint32_t texture_set, float depth) {
+        return division_engine_render_pass_instance_pack_sort_key(
+            layer, false, shader, 1, 1, texture_set, depth
+        );
+    };
+    auto translucent = [](uint32_t layer, uint32_t shader, float depth) {
+        return division_engine_render_pass_instance_pack_sort_key(
+            layer, true, shader, 1, 1, 0, depth
+        );
+    };
+
+    REQUIRE(opaque(0, 100, 0, 50.0f) < opaque(1, 0, 0, 0.0f));
+    REQUIRE(opaque(0, 100, 0, 50.0f) < translucent(0, 0, 0.0f));
+    REQUIRE(translucent(0, 0, 0.0f) < opaque(1, 0, 0, 0.0f));
+    REQUIRE(opaque(0, 1, 200, 50.0f) < opaque(0, 2, 0, 0.0f));
+    REQUIRE(opaque(0, 1, 1, 50.0f) < opaque(0, 1, 2, 0.0f));
+
+    // Front to back for the opaque, the submission order for the translucent
+    REQUIRE(opaque(0, 1, 1, 0.5f) < opaque(0, 1, 1, 10.0f));
+    REQUIRE(opaque(0, 1, 1, -1.0f) == opaque(0, 1, 1, 0.0f));
+    REQUIRE(translucent(0, 1, 0.5f) == translucent(0, 2, 10.0f));
+}
+
+TEST_CASE("Depth first sort key orders the opaque front to back")
+{
+    auto depth_first = [](uint32_t layer, bool translucent, uint32_t shader, float depth) {
+        return division_engine_render_pass_instance_depth_first_sort_key(
+            division_engine_render_pass_instance_pack_sort_key(
+                layer, translucent, shader, 1, 1, 0, depth
+            )
+        );
+    };
+
+    REQUIRE(depth_first(0, false, 2, 0.5f) < depth_first(0, false, 1, 10.0f));
+    REQUIRE(depth_first(0, false, 1, 5.0f) < depth_first(0, false, 2, 5.0f));
+    REQUIRE(depth_first(0, false, 1, 50.0f) < depth_first(0, true, 0, 0.0f));
+    REQUIRE(depth_first(0, true, 0, 0.0f) < depth_first(1, false, 0, 0.0f));
+    REQUIRE(
+        depth_first(0, true, 1, 0.5f) ==
+        division_engine_render_pass_instance_pack_sort_key(0, true, 1, 1, 1, 0, 0.5f)
+    );
+}
+
+TEST_CASE("Sorted instances keep the translucent submission order")
+{
+    struct Instance
+    {
+        bool translucent;
+        uint32_t shader;
+        float depth;
+    };
+    const Instance instances[] = {
+        {true, 2, 1.0f},
+        {false, 2, 5.0f},
+        {true, 1, 3.0f},
+        {false, 1, 9.0f},
+        {false, 2, 1.0f},
+        {true, 2, 2.0f},
+    };
+
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const Instance& it = instances[i];
+        keys.push_back(division_engine_render_pass_instance_pack_sort_key(
+            0, it.translucent, it.shader, 0, 0, 0, it.depth
+        ));
+        values.push_back(i);
+    }
+
+    radix_sort(keys, values);
+
+    REQUIRE(values == std::vector<uint32_t>{3, 4, 1, 0, 2, 5});
+}
+
+TEST_CASE("Radix sort benchmark", "[.][benchmark]")
+{
+    uint64_t state = 1;
+    std::vector<uint64_t> source(RADIX_SORT_BENCHMARK_COUNT);
+    for (uint64_t& key : source)
+    {
+        key = next_random(&state);
+    }
+
+    // The keys are sorted in place, so every run starts from the unsorted copy
+    BENCHMARK("Radix sort")
+    {
+        std::vector<uint64_t> keys = source;
+        std::vector<uint32_t> values(keys.size());
+        std::iota(values.begin(), values.end(), 0);
+        radix_sort(keys, values);
+        return values[0];
+    };
+
+    BENCHMARK("std::stable_sort")
+    {
+        std::vector<uint64_t> keys = source;
+        std::stable_sort(keys.begin(), keys.end());
+        return keys[0];
+    };
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/data_structures/ring_allocator.h"
+
+#define RING_CAPACITY 100
+
+TEST_CASE("Ring allocator allocates sequentially with alignment")
+{
+    DivisionRingAllocator allocator;
+    division_ring_allocator_init(&allocator, RING_CAPACITY);
+
+    size_t offset0, offset1, offset2;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 10, 1, &offset0));
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 10, 16, &offset1));
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 3, 4, &offset2));
+
+    REQUIRE(offset0 == 0);
+    REQUIRE(offset1 == 16);
+    REQUIRE(offset2 == 28);
+    REQUIRE(division_ring_allocator_used_size(&allocator) == 31);
+}
+
+TEST_CASE("Ring allocator fails when the storage is full")
+{
+    DivisionRingAllocator allocator;
+    division_ring_allocator_init(&allocator, RING_CAPACITY);
+
+    size_t offset;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 60, 1, &offset));
+    REQUIRE_FALSE(division_ring_allocator_alloc_range(&allocator, 50, 1, &offset));
+    REQUIRE_FALSE(division_ring_allocator_alloc_range(&allocator, 101, 1, &offset));
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 40, 1, &offset));
+    REQUIRE(offset == 60);
+    REQUIRE_FALSE(division_ring_allocator_alloc_range(&allocator, 1, 1, &offset));
+}
+
+TEST_CASE("Ring allocator wraps around after release")
+{
+    DivisionRingAllocator allocator;
+    division_ring_allocator_init(&allocator, RING_CAPACITY);
+
+    size_t offset;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 40, 1, &offset));
+    uint64_t first_batch_end = allocator.head;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 40, 1, &offset));
+    uint64_t second_batch_end = allocator.head;
+
+    // The range doesn't fit at the end and the start is still used
+    REQUIRE_FALSE(division_ring_allocator_alloc_range(&allocator, 30, 1, &offset));
+
+    division_ring_allocator_release(&allocator, first_batch_end);
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 30, 1, &offset));
+    REQUIRE(offset == 0);
+
+    REQUIRE(division_ring_allocator_used_size(&allocator) == 90);
+
+    // The skipped end of the storage belongs to the wrapped range
+    division_ring_allocator_release(&allocator, second_batch_end);
+    REQUIRE(division_ring_allocator_used_size(&allocator) == 50);
+}
+
+TEST_CASE("Ring allocator gives the whole storage when empty")
+{
+    DivisionRingAllocator allocator;
+    division_ring_allocator_init(&allocator, RING_CAPACITY);
+
+    size_t offset;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 70, 1, &offset));
+    division_ring_allocator_release(&allocator, allocator.head);
+
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, RING_CAPACITY, 1, &offset));
+    REQUIRE(offset == 0);
+    REQUIRE(division_ring_allocator_used_size(&allocator) == RING_CAPACITY);
+}
+
+TEST_CASE("Ring allocator ignores stale release positions")
+{
+    DivisionRingAllocator allocator;
+    division_ring_allocator_init(&allocator, RING_CAPACITY);
+
+    size_t offset;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 20, 1, &offset));
+    uint64_t position = allocator.head;
+    REQUIRE(division_ring_allocator_alloc_range(&allocator, 20, 1, &offset));
+
+    division_ring_allocator_release(&allocator, allocator.head);
+    division_ring_allocator_release(&allocator, position);
+
+    REQUIRE(division_ring_allocator_used_size(&allocator) == 0);
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/vertex_layout.h"
+
+#include <cstdint>
+
+struct LayoutVertex
+{
+    float position[3];
+    uint8_t color[4];
+    double weight;
+    float uv[2];
+};
+
+struct LayoutInstance
+{
+    float local_to_world[4][4];
+    int32_t id;
+};
+
+static const DivisionVertexLayoutAttribute c_vertex_attributes[] = {
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(LayoutVertex, position, DIVISION_FVEC3, 0),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(LayoutVertex, color, DIVISION_UBYTE4_NORM, 1),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(LayoutVertex, weight, DIVISION_DOUBLE, 2),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(LayoutVertex, uv, DIVISION_FVEC2, 3),
+};
+static const DivisionVertexLayout c_vertex_layout =
+    DIVISION_VERTEX_LAYOUT(LayoutVertex, c_vertex_attributes);
+
+static constexpr auto vertex_layout = division::make_vertex_layout<LayoutVertex>(
+    DIVISION_VERTEX_LAYOUT_MEMBER(LayoutVertex, position, 0),
+    DIVISION_VERTEX_LAYOUT_ATTRIBUTE(LayoutVertex, color, DIVISION_UBYTE4_NORM, 1),
+    DIVISION_VERTEX_LAYOUT_MEMBER(LayoutVertex, weight, 2),
+    DIVISION_VERTEX_LAYOUT_MEMBER(LayoutVertex, uv, 3)
+);
+static_assert(vertex_layout.is_valid(), "Vertex layout must be valid");
+static_assert(vertex_layout.stride == sizeof(LayoutVertex), "Stride is the vertex size");
+static_assert(vertex_layout.attribute_count == 4, "All members are attributes");
+static_assert(
+    vertex_layout.attributes[2].attribute.offset == offsetof(LayoutVertex, weight),
+    "Offsets follow the struct padding"
+);
+
+static constexpr auto instance_layout = division::make_vertex_layout<LayoutInstance>(
+    DIVISION_VERTEX_LAYOUT_MEMBER(LayoutInstance, local_to_world, 4),
+    DIVISION_VERTEX_LAYOUT_MEMBER(LayoutInstance, id, 8)
+);
+static_assert(instance_layout.is_valid(), "Instance layout must be valid");
+
+TEST_CASE("Shader variable size macros match the attribute formats")
+{
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_FLOAT) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_DOUBLE) == 8);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_INTEGER) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_FVEC2) == 8);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_FVEC3) == 12);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_FVEC4) == 16);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_FMAT4X4) == 64);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_HVEC2) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_HVEC4) == 8);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_UBYTE4_NORM) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_BYTE4_NORM) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_USHORT2_NORM) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_USHORT4_NORM) == 8);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_SHORT2_NORM) == 4);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_SHORT4_NORM) == 8);
+    REQUIRE(DIVISION_SHADER_VARIABLE_SIZE(DIVISION_INT_2_10_10_10_REV_NORM) == 4);
+}
+
+TEST_CASE("Macro layout takes the offsets and the stride from the struct")
+{
+    REQUIRE(c_vertex_layout.attribute_count == 4);
+    REQUIRE(c_vertex_layout.stride == sizeof(LayoutVertex));
+
+    const DivisionVertexLayoutAttribute* attrs = c_vertex_layout.attributes;
+    REQUIRE(attrs[0].attribute.offset == offsetof(LayoutVertex, position));
+    REQUIRE(attrs[1].attribute.offset == offsetof(LayoutVertex, color));
+    REQUIRE(attrs[2].attribute.offset == offsetof(LayoutVertex, weight));
+    REQUIRE(attrs[3].attribute.offset == offsetof(LayoutVertex, uv));
+
+    REQUIRE(attrs[1].settings.type == DIVISION_UBYTE4_NORM);
+    REQUIRE(attrs[1].settings.location == 1);
+    REQUIRE(attrs[1].attribute.base_size == 1);
+    REQUIRE(attrs[1].attribute.component_count == 4);
+}
+
+TEST_CASE("Template layout matches the macro layout")
+{
+    DivisionVertexLayout layout = vertex_layout.get();
+
+    REQUIRE(layout.attribute_count == c_vertex_layout.attribute_count);
+    REQUIRE(layout.stride == c_vertex_layout.stride);
+
+    for (int32_t i = 0; i < layout.attribute_count; i++)
+    {
+        const DivisionVertexLayoutAttribute& a = layout.attributes[i];
+        const DivisionVertexLayoutAttribute& b = c_vertex_layout.attributes[i];
+
+        REQUIRE(a.settings.type == b.settings.type);
+        REQUIRE(a.settings.location == b.settings.location);
+        REQUIRE(a.attribute.offset == b.attribute.offset);
+        REQUIRE(a.attribute.base_size == b.attribute.base_size);
+        REQUIRE(a.attribute.component_count == b.attribute.component_count);
+    }
+
+    REQUIRE(instance_layout.attributes[0].settings.type == DIVISION_FMAT4X4);
+    REQUIRE(instance_layout.attributes[1].settings.type == DIVISION_INTEGER);
+}
+
+TEST_CASE("Template layout validation finds overlapping attributes")
+{
+    constexpr auto overlapping = division::make_vertex_layout<LayoutVertex>(
+        DIVISION_VERTEX_LAYOUT_MEMBER(LayoutVertex, position, 0),
+        division::make_vertex_layout_attribute<float[4]>(4, 1)
+    );
+    constexpr auto out_of_vertex = division::make_vertex_layout<LayoutVertex>(
+        division::make_vertex_layout_attribute<float[4]>(sizeof(LayoutVertex) - 8, 0)
+    );
+
+    STATIC_REQUIRE_FALSE(overlapping.is_valid());
+    STATIC_REQUIRE_FALSE(out_of_vertex.is_valid());
+}
@@ -0,0 +1,340 @@
+#include <catch2/catch_all.hpp>
+
+#include "division_engine_core/vertex_packing.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#define PACKING_TEST_VALUE_COUNT 100003
+#define PACKING_BENCHMARK_VALUE_COUNT (1 << 20)
+
+static float bits_to_float(uint32_t bits)
+{
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static uint32_t next_random(uint32_t* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+// Arbitrary bit patterns, including NaNs, infinities and subnormals
+static std::vector<float> make_any_floats(size_t count)
+{
+    std::vector<float> values = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        65504.0f,
+        65519.0f,
+        65520.0f,
+        5.9604645e-08f,
+        2.9802322e-08f,
+        6.1035156e-05f,
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+        bits_to_float(0x7F800001),
+        bits_to_float(0xFFC12345),
+        std::numeric_limits<float>::denorm_min(),
+    };
+
+    uint32_t state = 42;
+    while (values.size() < count)
+    {
+        values.push_back(bits_to_float(next_random(&state)));
+    }
+
+    return values;
+}
+
+// Values around the normalized range
+static std::vector<float> make_unit_floats(size_t count, float min, float max)
+{
+    std::vector<float> values = {
+        0.0f,
+        -0.0f,
+        0.5f,
+        -0.5f,
+        1.0f,
+        -1.0f,
+        1.5f,
+        -1.5f,
+        0.5f / 32767.0f,
+        0.5f / 255.0f,
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+    };
+
+    uint32_t state = 7;
+    while (values.size() < count)
+    {
+        float t = (float) (next_random(&state) >> 8) / (float) (1 << 24);
+        values.push_back(min + (max - min) * t);
+    }
+
+    return values;
+}
+
+TEST_CASE("Half packing known values")
+{
+    const float src[] = {
+        0.0f, -0.0f, 1.0f, -2.0f, 65504.0f, 65520.0f, 5.9604645e-08f, 0.33333334f,
+    };
+    const uint16_t expected[] = {
+        0x0000, 0x8000, 0x3C00, 0xC000, 0x7BFF, 0x7C00, 0x0001, 0x3555,
+    };
+    uint16_t dst[8];
+
+    division_vertex_pack_half_scalar(dst, sizeof(uint16_t), src, sizeof(float), 8, 1);
+
+    for (int i = 0; i < 8; i++)
+    {
+        REQUIRE(dst[i] == expected[i]);
+    }
+
+    uint16_t nan;
+    float nan_src = std::numeric_limits<float>::quiet_NaN();
+    division_vertex_pack_half_scalar(
+        &nan, sizeof(uint16_t), &nan_src, sizeof(float), 1, 1
+    );
+    REQUIRE((nan & 0x7C00) == 0x7C00);
+    REQUIRE((nan & 0x03FF) != 0);
+}
+
+TEST_CASE("Normalized packing known values")
+{
+    const float src[] = {-2.0f, -1.0f, 0.0f, 0.5f, 1.0f, 2.0f};
+    const int16_t expected_snorm[] = {-32767, -32767, 0, 16384, 32767, 32767};
+    const uint8_t expected_unorm[] = {0, 0, 0, 128, 255, 255};
+    int16_t snorm[6];
+    uint8_t unorm[6];
+
+    division_vertex_pack_snorm16_scalar(snorm, sizeof(int16_t), src, sizeof(float), 6, 1);
+    division_vertex_pack_unorm8_scalar(unorm, sizeof(uint8_t), src, sizeof(float), 6, 1);
+
+    for (int i = 0; i < 6; i++)
+    {
+        REQUIRE(snorm[i] == expected_snorm[i]);
+        REQUIRE(unorm[i] == expected_unorm[i]);
+    }
+}
+
+TEST_CASE("Octahedral normal packing known values")
+{
+    const float src[] = {
+        0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, -1.0f,
+        1.0f, 0.0f, 0.0f,
+        0.0f, -1.0f, 0.0f,
+    };
+    const int16_t expected[] = {0, 0, 32767, 32767, 32767, 0, 0, -32767};
+    int16_t dst[8];
+
+    division_vertex_pack_normal_octahedral_scalar(
+        dst, sizeof(int16_t[2]), src, sizeof(float[3]), 4
+    );
+
+    for (int i = 0; i < 8; i++)
+    {
+        REQUIRE(dst[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Half packing matches the scalar reference")
+{
+    std::vector<float> src = make_any_floats(PACKING_TEST_VALUE_COUNT);
+    std::vector<uint16_t> simd(src.size()), scalar(src.size());
+
+    division_vertex_pack_half(
+        simd.data(), sizeof(uint16_t), src.data(), sizeof(float), src.size(), 1
+    );
+    division_vertex_pack_half_scalar(
+        scalar.data(), sizeof(uint16_t), src.data(), sizeof(float), src.size(), 1
+    );
+
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        INFO("value " << src[i] << " index " << i);
+        REQUIRE(simd[i] == scalar[i]);
+    }
+}
+
+TEST_CASE("Snorm16 and unorm8 packing match the scalar reference")
+{
+    std::vector<float> src = make_unit_floats(PACKING_TEST_VALUE_COUNT, -1.5f, 1.5f);
+    std::vector<int16_t> simd_snorm(src.size()), scalar_snorm(src.size());
+    std::vector<uint8_t> simd_unorm(src.size()), scalar_unorm(src.size());
+    size_t count = src.size() / 4;
+    size_t src_stride = sizeof(float[4]);
+
+    division_vertex_pack_snorm16(
+        simd_snorm.data(), sizeof(int16_t[4]), src.data(), src_stride, count, 4
+    );
+    division_vertex_pack_snorm16_scalar(
+        scalar_snorm.data(), sizeof(int16_t[4]), src.data(), src_stride, count, 4
+    );
+    division_vertex_pack_color_rgba8(
+        simd_unorm.data(), sizeof(uint8_t[4]), src.data(), src_stride, count
+    );
+    division_vertex_pack_unorm8_scalar(
+        scalar_unorm.data(), sizeof(uint8_t[4]), src.data(), src_stride, count, 4
+    );
+
+    for (size_t i = 0; i < count * 4; i++)
+    {
+        INFO("value " << src[i] << " index " << i);
+        REQUIRE(simd_snorm[i] == scalar_snorm[i]);
+        REQUIRE(simd_unorm[i] == scalar_unorm[i]);
+    }
+}
+
+TEST_CASE("Octahedral packing matches the scalar reference")
+{
+    std::vector<float> src = make_unit_floats(PACKING_TEST_VALUE_COUNT * 3, -1.0f, 1.0f);
+    size_t count = src.size() / 3;
+    std::vector<int16_t> simd(count * 2), scalar(count * 2);
+
+    division_vertex_pack_normal_octahedral(
+        simd.data(), sizeof(int16_t[2]), src.data(), sizeof(float[3]), count
+    );
+    division_vertex_pack_normal_octahedral_scalar(
+        scalar.data(), sizeof(int16_t[2]), src.data(), sizeof(float[3]), count
+    );
+
+    for (size_t i = 0; i < count * 2; i++)
+    {
+        INFO("normal index " << i / 2);
+        REQUIRE(simd[i] == scalar[i]);
+    }
+}
+
+TEST_CASE("Packing writes into interleaved vertices")
+{
+    struct Vertex
+    {
+        uint16_t position[4];
+        uint8_t color[4];
+    };
+    const float positions[] = {1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f};
+    const float colors[] = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.5f};
+    Vertex vertices[2];
+
+    division_vertex_pack_half(
+        vertices, sizeof(Vertex), positions, sizeof(float[4]), 2, 4
+    );
+    division_vertex_pack_color_rgba8(
+        &vertices[0].color, sizeof(Vertex), colors, sizeof(float[4]), 2
+    );
+
+    REQUIRE(vertices[0].position[0] == 0x3C00);
+    REQUIRE(vertices[1].position[3] == 0xC400);
+    REQUIRE(vertices[0].color[0] == 255);
+    REQUIRE(vertices[1].color[3] == 128);
+}
+
+// Catch2 doesn't expose its estimates, so the throughput is timed on its own
+template <typename Fn>
+static void benchmark_throughput(const std::string& name, size_t src_bytes, Fn&& pack)
+{
+    BENCHMARK(name + ", " + std::to_string(src_bytes) + " bytes")
+    {
+        return pack();
+    };
+
+    const int iterations = 20;
+    pack();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        pack();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double gigabytes_per_second = (double) src_bytes * iterations / elapsed.count() / 1e9;
+    WARN(name << ": " << gigabytes_per_second << " GB/s");
+}
+
+TEST_CASE("Vertex packing benchmark", "[.][benchmark]")
+{
+    std::vector<float> src = make_unit_floats(PACKING_BENCHMARK_VALUE_COUNT, -1.0f, 1.0f);
+    std::vector<uint16_t> half(src.size());
+    std::vector<int16_t> snorm(src.size());
+    std::vector<uint8_t> unorm(src.size());
+    size_t normal_count = src.size() / 3;
+    size_t src_bytes = src.size() * sizeof(float);
+    size_t normal_bytes = normal_count * sizeof(float[3]);
+
+    WARN("Vertex packing with " << division_vertex_packing_simd_name());
+
+    benchmark_throughput("half", src_bytes, [&] {
+        division_vertex_pack_half(
+            half.data(), sizeof(uint16_t), src.data(), sizeof(float), src.size(), 1
+        );
+        return half[0];
+    });
+
+    benchmark_throughput("half scalar", src_bytes, [&] {
+        division_vertex_pack_half_scalar(
+            half.data(), sizeof(uint16_t), src.data(), sizeof(float), src.size(), 1
+        );
+        return half[0];
+    });
+
+    benchmark_throughput("snorm16", src_bytes, [&] {
+        division_vertex_pack_snorm16(
+            snorm.data(), sizeof(int16_t), src.data(), sizeof(float), src.size(), 1
+        );
+        return snorm[0];
+    });
+
+    benchmark_throughput("snorm16 scalar", src_bytes, [&] {
+        division_vertex_pack_snorm16_scalar(
+            snorm.data(), sizeof(int16_t), src.data(), sizeof(float), src.size(), 1
+        );
+        return snorm[0];
+    });
+
+    benchmark_throughput("rgba8", src_bytes, [&] {
+        division_vertex_pack_color_rgba8(
+            unorm.data(), sizeof(uint8_t[4]), src.data(), sizeof(float[4]), src.size() / 4
+        );
+        return unorm[0];
+    });
+
+    benchmark_throughput("rgba8 scalar", src_bytes, [&] {
+        division_vertex_pack_unorm8_scalar(
+            unorm.data(),
+            sizeof(uint8_t[4]),
+            src.data(),
+            sizeof(float[4]),
+            src.size() / 4,
+            4
+        );
+        return unorm[0];
+    });
+
+    benchmark_throughput("octahedral", normal_bytes, [&] {
+        division_vertex_pack_normal_octahedral(
+            snorm.data(), sizeof(int16_t[2]), src.data(), sizeof(float[3]), normal_count
+        );
+        return snorm[0];
+    });
+
+    benchmark_throughput("octahedral scalar", normal_bytes, [&] {
+        division_vertex_pack_normal_octahedral_scalar(
+            snorm.data(), sizeof(int16_t[2]), src.data(), sizeof(float[3]), normal_count
+        );
+        return snorm[0];
+    });
+}
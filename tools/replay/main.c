@@ -0,0 +1,73 @@
+#include <division_engine_core/capture.h>
+#include <division_engine_core/context.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void error_callback(DivisionContext* ctx, int error_code, const char* message);
+static void empty_callback(DivisionContext* ctx);
+
+/*
+ *  Replays a capture made with DivisionSettings.capture_path and prints the timings:
+ *  division_replay <capture file> [window width] [window height]
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <capture file> [width] [height]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    DivisionSettings settings = {
+        .window_width = argc > 2 ? (uint32_t) strtoul(argv[2], NULL, 10) : 512,
+        .window_height = argc > 3 ? (uint32_t) strtoul(argv[3], NULL, 10) : 512,
+        .window_title = "Division replay",
+        .capture_path = NULL,
+        // Depth of the frames is ignored by the descriptors without the depth test
+        .depth_stencil_format = DIVISION_DEPTH_STENCIL_FORMAT_DEPTH24_STENCIL8,
+    };
+
+    DivisionLifecycle lifecycle = {
+        .init_callback = empty_callback,
+        .draw_callback = empty_callback,
+        .free_callback = empty_callback,
+        .error_callback = error_callback,
+    };
+
+    DivisionContext ctx;
+    division_engine_context_register_lifecycle(&ctx, &lifecycle);
+    if (!division_engine_context_initialize(&settings, &ctx))
+    {
+        return EXIT_FAILURE;
+    }
+
+    DivisionCaptureReplayStats stats;
+    bool ok = division_engine_capture_replay(&ctx, argv[1], &stats);
+
+    printf("Commands: %llu\n", (unsigned long long) stats.command_count);
+    printf("Frames: %u\n", stats.frame_count);
+    printf("Total: %.3f ms\n", stats.total_ms);
+    if (stats.frame_count > 0)
+    {
+        printf(
+            "Frame: avg %.3f ms, min %.3f ms, max %.3f ms\n",
+            stats.total_ms / stats.frame_count,
+            stats.min_frame_ms,
+            stats.max_frame_ms
+        );
+    }
+
+    division_engine_context_finalize(&ctx);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void error_callback(DivisionContext* ctx, int error_code, const char* message)
+{
+    fprintf(stderr, "Error code: %d, error message: %s\n", error_code, message);
+}
+
+void empty_callback(DivisionContext* ctx)
+{
+}